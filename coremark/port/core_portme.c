@@ -11,6 +11,13 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "esp_timer.h"
+#if (MULTITHREAD > 1)
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#endif
 
 #if VALIDATION_RUN
 volatile ee_s32 seed1_volatile = 0x3415;
@@ -98,7 +105,86 @@ secs_ret time_in_secs(CORE_TICKS ticks)
     return retval;
 }
 
-ee_u32 default_num_contexts = 1;
+ee_u32 default_num_contexts = MULTITHREAD;
+
+#if (MULTITHREAD > 1)
+#define CONTEXT_TASK_STACK_SIZE 4096
+#define ALL_CONTEXTS_BITS ((1 << MULTITHREAD) - 1)
+
+/* Timing of each context, reported by portable_fini */
+typedef struct {
+    BaseType_t core_id;
+    ee_u32 iterations;
+    int64_t start_us;
+    int64_t stop_us;
+} context_stats_t;
+
+static EventGroupHandle_t s_start_barrier;
+static context_stats_t s_context_stats[MULTITHREAD];
+static ee_u8 s_num_started_contexts;
+
+static void context_task(void *arg)
+{
+    core_results *res = (core_results *)arg;
+    context_stats_t *stats = &s_context_stats[res->port.context_id];
+
+    /* Wait until the task of every context is ready, so that all the cores start together */
+    xEventGroupSync(s_start_barrier, 1 << res->port.context_id, ALL_CONTEXTS_BITS, portMAX_DELAY);
+    stats->core_id = xPortGetCoreID();
+    stats->start_us = esp_timer_get_time();
+    iterate(res);
+    stats->stop_us = esp_timer_get_time();
+    stats->iterations = res->iterations;
+
+    xSemaphoreGive(res->port.done);
+    vTaskDelete(NULL);
+}
+
+/* Function : core_start_parallel
+    Start the execution of a context on its own core.
+*/
+ee_u8 core_start_parallel(core_results *res)
+{
+    ee_u8 context_id = s_num_started_contexts++;
+
+    res->port.context_id = context_id;
+    res->port.done = xSemaphoreCreateBinary();
+    if (res->port.done == NULL ||
+            xTaskCreatePinnedToCore(context_task, "coremark", CONTEXT_TASK_STACK_SIZE, res,
+                                    uxTaskPriorityGet(NULL), NULL, context_id % portNUM_PROCESSORS) != pdPASS) {
+        ee_printf("ERROR! Failed to start context %d\n", context_id);
+        abort();
+    }
+    return 0;
+}
+
+/* Function : core_stop_parallel
+    Wait for a context to finish its iterations.
+*/
+ee_u8 core_stop_parallel(core_results *res)
+{
+    xSemaphoreTake(res->port.done, portMAX_DELAY);
+    vSemaphoreDelete(res->port.done);
+    res->port.done = NULL;
+    return 0;
+}
+
+/* Function : portable_malloc
+    Allocate the data block of a context.
+*/
+void *portable_malloc(ee_size_t size)
+{
+    return malloc(size);
+}
+
+/* Function : portable_free
+    Free the data block of a context.
+*/
+void portable_free(void *p)
+{
+    free(p);
+}
+#endif
 
 /* Function : portable_init
     Target specific initialization code
@@ -112,6 +198,14 @@ void portable_init(core_portable *p, int *argc, char *argv[])
     if (sizeof(ee_u32) != 4) {
         ee_printf("ERROR! Please define ee_u32 to a 32b unsigned type!\n");
     }
+#if (MULTITHREAD > 1)
+    s_start_barrier = xEventGroupCreate();
+    if (s_start_barrier == NULL) {
+        ee_printf("ERROR! Failed to create the start barrier!\n");
+        abort();
+    }
+    s_num_started_contexts = 0;
+#endif
     p->portable_id = 1;
 }
 /* Function : portable_fini
@@ -119,5 +213,16 @@ void portable_init(core_portable *p, int *argc, char *argv[])
 */
 void portable_fini(core_portable *p)
 {
+#if (MULTITHREAD > 1)
+    /* Per core results, a core slower than the others shows the interference between them */
+    for (int i = 0; i < MULTITHREAD; i++) {
+        const context_stats_t *stats = &s_context_stats[i];
+        double secs = (stats->stop_us - stats->start_us) / 1000000.0;
+        ee_printf("[%d]core %d       : %lu iterations in %f secs, %f iterations/sec\n",
+                  i, stats->core_id, stats->iterations, secs, secs > 0 ? stats->iterations / secs : 0);
+    }
+    vEventGroupDelete(s_start_barrier);
+    s_start_barrier = NULL;
+#endif
     p->portable_id = 0;
 }
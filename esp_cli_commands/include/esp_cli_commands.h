@@ -79,6 +79,8 @@ esp_err_t esp_cli_commands_execute(const char *cmdline, int *cmd_ret, esp_cli_co
  * @brief Find a command by name within a specific command set.
  *
  * This function searches a command whose name matches the provided string.
+ * When cmd_set is NULL, the search is a binary search over the sorted static
+ * commands and the sorted index of dynamic commands.
  *
  * @param cmd_set Handle to the command set to search in. Must be a valid
  * `esp_cli_command_set_handle_t` or `NULL` if the search should be performed
@@ -92,6 +94,9 @@ esp_cli_command_t *esp_cli_commands_find_command(esp_cli_command_set_handle_t cm
 /**
  * @brief Provide command completion for linenoise library
  *
+ * When cmd_set is NULL, only the commands starting with buf are visited and
+ * the completion callback is called in alphabetical order, static commands first.
+ *
  * @param cmd_set Set of commands allowed for completion. If NULL, all registered commands are used
  * @param buf Input string typed by the user
  * @param cb_ctx context passed to the completion callback
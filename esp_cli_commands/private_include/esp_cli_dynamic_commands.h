@@ -127,6 +127,20 @@ esp_err_t esp_cli_dynamic_commands_replace(esp_cli_command_t *item_cmd);
  */
 esp_err_t esp_cli_dynamic_commands_remove(esp_cli_command_t *item_cmd);
 
+/**
+ * @brief Get the sorted index of the dynamic commands.
+ *
+ * The index holds pointers to the commands of the dynamic command list,
+ * sorted by name (same order as the list), for binary search.
+ *
+ * @param[out] out_count Number of commands in the index.
+ * @return Pointer to the first entry of the index (NULL if no command was ever registered).
+ *
+ * @warning The caller must hold the dynamic commands lock while using the index,
+ *          it is reallocated when commands are added.
+ */
+esp_cli_command_t *const *esp_cli_dynamic_commands_get_index(size_t *out_count);
+
 /**
  * @brief Get the number of registered dynamic commands.
  *
@@ -169,6 +169,98 @@ bool compare_command_name(void *ctx, esp_cli_command_t *cmd)
     return true;
 }
 
+/* state of the check that the static commands are sorted by name */
+typedef enum {
+    STATIC_ORDER_UNKNOWN = 0,
+    STATIC_ORDER_SORTED,
+    STATIC_ORDER_UNSORTED,
+} static_order_t;
+
+static static_order_t s_static_order = STATIC_ORDER_UNKNOWN;
+
+/**
+ * @brief check whether the commands of the .esp_cli_commands section are
+ * sorted by name, which allows binary search on them.
+ *
+ * The linker fragment sorts the input sections by name (see linker.lf), so the
+ * check is only there to fall back to the linear search if a toolchain or linker
+ * script does not honor it. The result is computed once and cached.
+ */
+static bool static_commands_are_sorted(void)
+{
+    if (s_static_order == STATIC_ORDER_UNKNOWN) {
+        static_order_t order = STATIC_ORDER_SORTED;
+        for (size_t i = 1; i < ESP_CLI_COMMANDS_COUNT; i++) {
+            if (strcmp((&_esp_cli_commands_start)[i - 1].name, (&_esp_cli_commands_start)[i].name) > 0) {
+                order = STATIC_ORDER_UNSORTED;
+                break;
+            }
+        }
+        /* concurrent callers compute the same value, no need to lock */
+        s_static_order = order;
+    }
+    return s_static_order == STATIC_ORDER_SORTED;
+}
+
+typedef const char *(*name_at_t)(const void *cmds, size_t index);
+
+static const char *static_name_at(const void *cmds, size_t index)
+{
+    return ((const esp_cli_command_t *)cmds)[index].name;
+}
+
+static const char *dynamic_name_at(const void *cmds, size_t index)
+{
+    return ((esp_cli_command_t *const *)cmds)[index]->name;
+}
+
+/**
+ * @brief return the index of the first command of a sorted array which
+ * name is not lower than key (or than the key_len first characters of key
+ * if key_len is not 0), count if there is no such command.
+ */
+static size_t lower_bound(const void *cmds, size_t count, name_at_t name_at, const char *key, size_t key_len)
+{
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const char *name = name_at(cmds, mid);
+        const int cmp = key_len ? strncmp(name, key, key_len) : strcmp(name, key);
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief find a command by name among all the registered commands, using binary
+ * search on the static commands and on the sorted index of dynamic commands.
+ */
+static esp_cli_command_t *find_registered_command(const char *name)
+{
+    const size_t static_count = ESP_CLI_COMMANDS_COUNT;
+    size_t pos = lower_bound(&_esp_cli_commands_start, static_count, static_name_at, name, 0);
+    if (pos < static_count && strcmp((&_esp_cli_commands_start)[pos].name, name) == 0) {
+        return &_esp_cli_commands_start + pos;
+    }
+
+    esp_cli_command_t *cmd = NULL;
+    size_t dynamic_count = 0;
+    esp_cli_dynamic_commands_lock();
+    esp_cli_command_t *const *dynamic_cmds = esp_cli_dynamic_commands_get_index(&dynamic_count);
+    pos = lower_bound(dynamic_cmds, dynamic_count, dynamic_name_at, name, 0);
+    if (pos < dynamic_count && strcmp(dynamic_cmds[pos]->name, name) == 0) {
+        cmd = dynamic_cmds[pos];
+    }
+    esp_cli_dynamic_commands_unlock();
+
+    return cmd;
+}
+
 void *esp_cli_commands_malloc(const size_t malloc_size)
 {
     esp_cli_commands_lock();
@@ -321,6 +413,12 @@ esp_cli_command_t *esp_cli_commands_find_command(esp_cli_command_set_handle_t cm
         return NULL;
     }
 
+    /* when looking through all the registered commands, use the sorted
+     * arrays instead of walking every command */
+    if (!cmd_set && static_commands_are_sorted()) {
+        return find_registered_command(name);
+    }
+
     find_cmd_ctx_t ctx = { .cmd = NULL, .name = name };
     go_through_commands(cmd_set, &ctx, compare_command_name);
 
@@ -532,6 +630,26 @@ void esp_cli_commands_get_completion(esp_cli_command_set_handle_t cmd_set, const
         return;
     }
 
+    if (!cmd_set && static_commands_are_sorted()) {
+        /* the commands starting with buf are contiguous in the sorted arrays,
+         * only go through that range */
+        const size_t static_count = ESP_CLI_COMMANDS_COUNT;
+        for (size_t i = lower_bound(&_esp_cli_commands_start, static_count, static_name_at, buf, len);
+                i < static_count && strncmp((&_esp_cli_commands_start)[i].name, buf, len) == 0; i++) {
+            completion_cb(cb_ctx, (&_esp_cli_commands_start)[i].name);
+        }
+
+        size_t dynamic_count = 0;
+        esp_cli_dynamic_commands_lock();
+        esp_cli_command_t *const *dynamic_cmds = esp_cli_dynamic_commands_get_index(&dynamic_count);
+        for (size_t i = lower_bound(dynamic_cmds, dynamic_count, dynamic_name_at, buf, len);
+                i < dynamic_count && strncmp(dynamic_cmds[i]->name, buf, len) == 0; i++) {
+            completion_cb(cb_ctx, dynamic_cmds[i]->name);
+        }
+        esp_cli_dynamic_commands_unlock();
+        return;
+    }
+
     call_completion_cb_ctx_t ctx = {
         .buf = buf,
         .buf_len = len,
@@ -19,6 +19,10 @@
 
 static esp_cli_command_internal_ll_t s_dynamic_cmd_list = SLIST_HEAD_INITIALIZER(esp_cli_command_internal);
 static size_t s_number_of_registered_commands = 0;
+/* pointers to the commands of s_dynamic_cmd_list, in the same (sorted by name) order,
+ * so that commands can be looked up by binary search */
+static esp_cli_command_t **s_dynamic_cmd_index = NULL;
+static size_t s_dynamic_cmd_index_capacity = 0;
 static SemaphoreHandle_t s_esp_cli_commands_dyn_mutex = NULL;
 static StaticSemaphore_t s_esp_cli_commands_dyn_mutex_buf;
 
@@ -62,16 +66,35 @@ esp_err_t esp_cli_dynamic_commands_add(esp_cli_command_t *cmd)
 
     esp_cli_command_internal_t *last = NULL;
     esp_cli_command_internal_t *it =  NULL;
+    size_t index_pos = 0;
 
     /* this could be called on an empty list, make sure the
      * mutex is initialized */
     esp_cli_dynamic_commands_lock();
 
+    /* make room in the index for the new command */
+    if (s_number_of_registered_commands == s_dynamic_cmd_index_capacity) {
+        const size_t new_capacity = s_dynamic_cmd_index_capacity ? s_dynamic_cmd_index_capacity * 2 : 8;
+        esp_cli_command_t **new_index = esp_cli_commands_malloc(sizeof(esp_cli_command_t *) * new_capacity);
+        if (!new_index) {
+            esp_cli_dynamic_commands_unlock();
+            free(list_item);
+            return ESP_ERR_NO_MEM;
+        }
+        if (s_dynamic_cmd_index) {
+            memcpy(new_index, s_dynamic_cmd_index, sizeof(esp_cli_command_t *) * s_number_of_registered_commands);
+            free(s_dynamic_cmd_index);
+        }
+        s_dynamic_cmd_index = new_index;
+        s_dynamic_cmd_index_capacity = new_capacity;
+    }
+
     SLIST_FOREACH(it, &s_dynamic_cmd_list, next_item) {
         if (strcmp(it->cmd.name, list_item->cmd.name) > 0) {
             break;
         }
         last = it;
+        index_pos++;
     }
 
     if (last == NULL) {
@@ -80,6 +103,11 @@ esp_err_t esp_cli_dynamic_commands_add(esp_cli_command_t *cmd)
         SLIST_INSERT_AFTER(last, list_item, next_item);
     }
 
+    /* keep the index in the same order as the list */
+    memmove(&s_dynamic_cmd_index[index_pos + 1], &s_dynamic_cmd_index[index_pos],
+            sizeof(esp_cli_command_t *) * (s_number_of_registered_commands - index_pos));
+    s_dynamic_cmd_index[index_pos] = &list_item->cmd;
+
     s_number_of_registered_commands++;
 
     esp_cli_dynamic_commands_unlock();
@@ -106,8 +134,24 @@ esp_err_t esp_cli_dynamic_commands_remove(esp_cli_command_t *item_cmd)
     esp_cli_command_internal_t *list_item = CONTAINER_OF(item_cmd, esp_cli_command_internal_t, cmd);
     SLIST_REMOVE(&s_dynamic_cmd_list, list_item, esp_cli_command_internal, next_item);
 
+    for (size_t i = 0; i < s_number_of_registered_commands; i++) {
+        if (s_dynamic_cmd_index[i] == &list_item->cmd) {
+            memmove(&s_dynamic_cmd_index[i], &s_dynamic_cmd_index[i + 1],
+                    sizeof(esp_cli_command_t *) * (s_number_of_registered_commands - i - 1));
+            break;
+        }
+    }
+
     s_number_of_registered_commands--;
 
+    /* release the index with the last command, so no memory is held
+     * when no command is registered */
+    if (s_number_of_registered_commands == 0) {
+        free(s_dynamic_cmd_index);
+        s_dynamic_cmd_index = NULL;
+        s_dynamic_cmd_index_capacity = 0;
+    }
+
     esp_cli_dynamic_commands_unlock();
 
     free(list_item);
@@ -122,3 +166,9 @@ size_t esp_cli_dynamic_commands_get_number_of_cmd(void)
     esp_cli_dynamic_commands_unlock();
     return nb_of_registered_cmd;
 }
+
+esp_cli_command_t *const *esp_cli_dynamic_commands_get_index(size_t *out_count)
+{
+    *out_count = s_number_of_registered_commands;
+    return s_dynamic_cmd_index;
+}
@@ -460,3 +460,86 @@ TEST_CASE("test hint and glossary callbacks", "[esp_cli_commands]")
 
     esp_cli_commands_destroy_cmd_set(&handle_set);
 }
+
+#define LOOKUP_TEST_NB_OF_CMDS 40
+
+TEST_CASE("test lookup and completion with many dynamic commands", "[esp_cli_commands]")
+{
+    test_setup();
+
+    /* the names have to outlive the registration since only the pointers are stored */
+    static char names[LOOKUP_TEST_NB_OF_CMDS][16];
+
+    /* register the commands in a non sorted order, so that the index has
+     * to insert commands in the middle */
+    for (size_t i = 0; i < LOOKUP_TEST_NB_OF_CMDS; i++) {
+        const size_t id = (i * 7) % LOOKUP_TEST_NB_OF_CMDS;
+        snprintf(names[id], sizeof(names[id]), "%s_%02u", (id % 2 == 0) ? "lookup_even" : "lookup_odd", (unsigned)id);
+        esp_cli_command_t cmd = {
+            .name = names[id],
+            .group = "lookup_group",
+            .help = "dummy help",
+            .func = dummy_cmd_func,
+            .func_ctx = NULL,
+            .hint_cb = NULL,
+            .glossary_cb = NULL
+        };
+        TEST_ASSERT_EQUAL(ESP_OK, esp_cli_commands_register_cmd(&cmd));
+    }
+
+    /* every command can be found, static commands are still found */
+    for (size_t i = 0; i < LOOKUP_TEST_NB_OF_CMDS; i++) {
+        esp_cli_command_t *cmd = esp_cli_commands_find_command(NULL, names[i]);
+        TEST_ASSERT_NOT_NULL(cmd);
+        TEST_ASSERT_EQUAL_STRING(names[i], cmd->name);
+    }
+    TEST_ASSERT_NOT_NULL(esp_cli_commands_find_command(NULL, "cmd_a"));
+    TEST_ASSERT_NOT_NULL(esp_cli_commands_find_command(NULL, "cmd_h"));
+    TEST_ASSERT_NULL(esp_cli_commands_find_command(NULL, "lookup"));
+    TEST_ASSERT_NULL(esp_cli_commands_find_command(NULL, "lookup_even_0"));
+    TEST_ASSERT_NULL(esp_cli_commands_find_command(NULL, "zzz"));
+
+    /* a static command cannot be registered dynamically */
+    esp_cli_command_t static_cmd = {
+        .name = "cmd_c",
+        .group = "lookup_group",
+        .help = "dummy help",
+        .func = dummy_cmd_func,
+    };
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_cli_commands_register_cmd(&static_cmd));
+
+    completion_nb_of_calls = 0;
+    esp_cli_commands_get_completion(NULL, "lookup_", NULL, test_completion_cb);
+    TEST_ASSERT_EQUAL(LOOKUP_TEST_NB_OF_CMDS, completion_nb_of_calls);
+
+    completion_nb_of_calls = 0;
+    esp_cli_commands_get_completion(NULL, "lookup_odd", NULL, test_completion_cb);
+    TEST_ASSERT_EQUAL(LOOKUP_TEST_NB_OF_CMDS / 2, completion_nb_of_calls);
+
+    completion_nb_of_calls = 0;
+    esp_cli_commands_get_completion(NULL, "lookup_even_1", NULL, test_completion_cb);
+    TEST_ASSERT_EQUAL(5, completion_nb_of_calls); /* 10, 12, 14, 16 and 18 */
+
+    /* unregister the odd commands, the even ones must still be found */
+    for (size_t i = 1; i < LOOKUP_TEST_NB_OF_CMDS; i += 2) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_cli_commands_unregister_cmd(names[i]));
+    }
+    for (size_t i = 0; i < LOOKUP_TEST_NB_OF_CMDS; i++) {
+        esp_cli_command_t *cmd = esp_cli_commands_find_command(NULL, names[i]);
+        if (i % 2 == 0) {
+            TEST_ASSERT_NOT_NULL(cmd);
+            TEST_ASSERT_EQUAL_STRING(names[i], cmd->name);
+        } else {
+            TEST_ASSERT_NULL(cmd);
+        }
+    }
+
+    completion_nb_of_calls = 0;
+    esp_cli_commands_get_completion(NULL, "lookup_", NULL, test_completion_cb);
+    TEST_ASSERT_EQUAL(LOOKUP_TEST_NB_OF_CMDS / 2, completion_nb_of_calls);
+
+    for (size_t i = 0; i < LOOKUP_TEST_NB_OF_CMDS; i += 2) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_cli_commands_unregister_cmd(names[i]));
+    }
+    completion_nb_of_calls = 0;
+}
@@ -43,6 +43,32 @@ bool esp_daylight_calc_sunrise_sunset_utc(int year, int month, int day,
         double latitude, double longitude,
         time_t *sunrise_utc, time_t *sunset_utc);
 
+/**
+ * @brief Calculate sunrise and sunset times in single precision
+ *
+ * Same NOAA equations as esp_daylight_calc_sunrise_sunset_utc(), evaluated with
+ * float arithmetic and 7 trigonometric calls instead of 15 in double precision.
+ * This is several times faster on targets whose FPU has no double precision support.
+ *
+ * Compared to the double precision version, the results differ by at most 2 seconds
+ * (measured for all the days of 2024 and 2025, every 0.25° of latitude). Only on the first
+ * and last day of a polar day/night, when cos(H0) is within float rounding of ±1, the two
+ * versions may disagree on whether the sun rises and sets.
+ *
+ * @param[in] year Year (e.g., 2024)
+ * @param[in] month Month (1-12)
+ * @param[in] day Day of month (1-31)
+ * @param[in] latitude Latitude in decimal degrees (-90 to +90, positive North)
+ * @param[in] longitude Longitude in decimal degrees (-180 to +180, positive East)
+ * @param[out] sunrise_utc Sunrise time as UTC timestamp (seconds since epoch)
+ * @param[out] sunset_utc Sunset time as UTC timestamp (seconds since epoch)
+ *
+ * @return true on success, false if sun doesn't rise/set (polar day/night)
+ */
+bool esp_daylight_calc_sunrise_sunset_utc_fast(int year, int month, int day,
+        float latitude, float longitude,
+        time_t *sunrise_utc, time_t *sunset_utc);
+
 /**
  * @brief Calculate sunrise and sunset times using location struct
  *
@@ -89,6 +115,63 @@ bool esp_daylight_get_sunrise_today(const esp_daylight_location_t *location, tim
  */
 bool esp_daylight_get_sunset_today(const esp_daylight_location_t *location, time_t *sunset_utc);
 
+/**
+ * @brief Number of days cached by a table
+ */
+#define ESP_DAYLIGHT_TABLE_DAYS 366
+
+/**
+ * @brief Table entry value of the days without sunrise/sunset
+ */
+#define ESP_DAYLIGHT_TABLE_NO_EVENT 0xFFFF
+
+/**
+ * @brief Yearly sunrise/sunset table of a location
+ *
+ * The sunrise and sunset of each day of the year are computed with the double precision
+ * NOAA equations the first time they are requested, and cached with a 2 seconds resolution.
+ * Use one table per location when the solar times of many locations are recomputed often.
+ *
+ * @note A table is not thread safe
+ */
+typedef struct {
+    double latitude;                                        /**< Latitude in decimal degrees */
+    double longitude;                                       /**< Longitude in decimal degrees */
+    int year;                                               /**< Year of the cached entries, 0 if none */
+    uint32_t cached[(ESP_DAYLIGHT_TABLE_DAYS + 31) / 32];   /**< Bitmap of the days already computed */
+    uint16_t sunrise[ESP_DAYLIGHT_TABLE_DAYS];              /**< Sunrise, in units of 2 s since UTC midnight */
+    uint16_t sunset[ESP_DAYLIGHT_TABLE_DAYS];               /**< Sunset, in units of 2 s since UTC midnight */
+} esp_daylight_table_t;
+
+/**
+ * @brief Initialize a yearly table for a location
+ *
+ * No entry is computed here, each day is computed when it's requested for the first time.
+ *
+ * @param[out] table Table to initialize
+ * @param[in] latitude Latitude in decimal degrees (-90 to +90, positive North)
+ * @param[in] longitude Longitude in decimal degrees (-180 to +180, positive East)
+ */
+void esp_daylight_table_init(esp_daylight_table_t *table, double latitude, double longitude);
+
+/**
+ * @brief Get sunrise and sunset times from a yearly table
+ *
+ * The result is within 1 second of esp_daylight_calc_sunrise_sunset_utc().
+ * Requesting a day of another year than the cached one clears the table.
+ *
+ * @param[in,out] table Table of the location
+ * @param[in] year Year (e.g., 2024)
+ * @param[in] month Month (1-12)
+ * @param[in] day Day of month (1-31)
+ * @param[out] sunrise_utc Sunrise time as UTC timestamp (seconds since epoch)
+ * @param[out] sunset_utc Sunset time as UTC timestamp (seconds since epoch)
+ *
+ * @return true on success, false if sun doesn't rise/set (polar day/night) or on invalid argument
+ */
+bool esp_daylight_table_get(esp_daylight_table_t *table, int year, int month, int day,
+                            time_t *sunrise_utc, time_t *sunset_utc);
+
 #ifdef __cplusplus
 }
 #endif
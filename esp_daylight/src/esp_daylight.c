@@ -50,12 +50,10 @@ static double clamp(double v, double lo, double hi)
 }
 
 /**
- * @brief Calculate fractional year gamma in radians
- * Used for NOAA solar equations
+ * @brief Get day of year N (1..365/366) and length of the year
  */
-static double fractional_year_gamma(int year, int month, int day)
+static int day_of_year(int year, int month, int day, int *year_len)
 {
-    // Day-of-year N (1..365/366)
     static const int mdays[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
     int ly = ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0));
     int N = day;
@@ -65,9 +63,21 @@ static double fractional_year_gamma(int year, int month, int day)
     if (ly && month > 2) {
         N += 1;
     }
+    *year_len = ly ? 366 : 365;
+    return N;
+}
+
+/**
+ * @brief Calculate fractional year gamma in radians
+ * Used for NOAA solar equations
+ */
+static double fractional_year_gamma(int year, int month, int day)
+{
+    int year_len;
+    int N = day_of_year(year, month, day, &year_len);
 
     // NOAA form with hour≈0 -> gamma ~= 2π/365 * (N-1 - 12/24)
-    return 2.0 * M_PI / (ly ? 366.0 : 365.0) * ((double)N - 1.0 - 0.5);
+    return 2.0 * M_PI / (double)year_len * ((double)N - 1.0 - 0.5);
 }
 
 /**
@@ -104,9 +114,27 @@ static double solar_declination_rad(double gamma)
            + 0.000907 * s2 - 0.002697 * c3 + 0.001480 * s3;
 }
 
-bool esp_daylight_calc_sunrise_sunset_utc(int year, int month, int day,
-        double latitude, double longitude,
-        time_t *sunrise_utc, time_t *sunset_utc)
+/**
+ * @brief Normalize minutes to [0,1440) to stay within the same civil day in UTC
+ * (Edge cases near poles can roll into prev/next day; we keep them bounded.)
+ */
+static double normalize_day_minutes(double minutes)
+{
+    while (minutes < 0) {
+        minutes += 1440.0;
+    }
+    while (minutes >= 1440.0) {
+        minutes -= 1440.0;
+    }
+    return minutes;
+}
+
+/**
+ * @brief Calculate sunrise and sunset in minutes from UTC midnight
+ */
+static bool calc_sunrise_sunset_min(int year, int month, int day,
+                                    double latitude, double longitude,
+                                    double *sunrise_min_utc, double *sunset_min_utc)
 {
     // Constants
     const double ZENITH_DEG = 90.833; // geometric zenith for sunrise/sunset
@@ -142,22 +170,20 @@ bool esp_daylight_calc_sunrise_sunset_utc(int year, int month, int day,
     // 4) Sunrise/Sunset UTC minutes
     // Daylength (minutes) = 8 * H0 (deg)   [since 1 deg hour angle = 4 minutes]
     double delta_min = 4.0 * H0_deg; // minutes from noon to event
-    double sunrise_min_utc = solar_noon_min_utc - delta_min;
-    double sunset_min_utc  = solar_noon_min_utc + delta_min;
+    *sunrise_min_utc = normalize_day_minutes(solar_noon_min_utc - delta_min);
+    *sunset_min_utc  = normalize_day_minutes(solar_noon_min_utc + delta_min);
 
-    // Normalize to [0,1440) to stay within the same civil day in UTC.
-    // (Edge cases near poles can roll into prev/next day; we keep them bounded.)
-    while (sunrise_min_utc < 0) {
-        sunrise_min_utc += 1440.0;
-    }
-    while (sunrise_min_utc >= 1440.0) {
-        sunrise_min_utc -= 1440.0;
-    }
-    while (sunset_min_utc < 0) {
-        sunset_min_utc += 1440.0;
-    }
-    while (sunset_min_utc >= 1440.0) {
-        sunset_min_utc -= 1440.0;
+    return true;
+}
+
+bool esp_daylight_calc_sunrise_sunset_utc(int year, int month, int day,
+        double latitude, double longitude,
+        time_t *sunrise_utc, time_t *sunset_utc)
+{
+    double sunrise_min_utc, sunset_min_utc;
+
+    if (!calc_sunrise_sunset_min(year, month, day, latitude, longitude, &sunrise_min_utc, &sunset_min_utc)) {
+        return false;
     }
 
     // 5) Convert to epoch seconds (UTC)
@@ -172,6 +198,118 @@ bool esp_daylight_calc_sunrise_sunset_utc(int year, int month, int day,
     return true;
 }
 
+static float normalize_day_minutes_f(float minutes)
+{
+    while (minutes < 0) {
+        minutes += 1440.0f;
+    }
+    while (minutes >= 1440.0f) {
+        minutes -= 1440.0f;
+    }
+    return minutes;
+}
+
+bool esp_daylight_calc_sunrise_sunset_utc_fast(int year, int month, int day,
+        float latitude, float longitude,
+        time_t *sunrise_utc, time_t *sunset_utc)
+{
+    // cos(90.833°), the zenith for sunrise/sunset
+    const float COS_Z = -0.01453808f;
+    const float DEG_TO_RAD = (float)(M_PI / 180.0);
+    const float phi = latitude * DEG_TO_RAD;
+
+    // 1) Day parameters, the multiple angles are derived from sin(γ) and cos(γ)
+    int year_len;
+    int N = day_of_year(year, month, day, &year_len);
+    float gamma = 2.0f * (float)M_PI / (float)year_len * ((float)N - 1.5f);
+    float s  = sinf(gamma);
+    float c  = cosf(gamma);
+    float s2 = 2.0f * s * c;
+    float c2 = 1.0f - 2.0f * s * s;
+    float s3 = s * (3.0f - 4.0f * s * s);
+    float c3 = c * (4.0f * c * c - 3.0f);
+
+    float EoT_min = 229.18f * (0.000075f + 0.001868f * c - 0.032077f * s - 0.014615f * c2 - 0.040849f * s2);
+    float decl = 0.006918f - 0.399912f * c + 0.070257f * s - 0.006758f * c2
+                 + 0.000907f * s2 - 0.002697f * c3 + 0.001480f * s3;
+
+    // 2) Hour angle at sunrise/sunset
+    float cosH0 = (COS_Z - sinf(phi) * sinf(decl)) / (cosf(phi) * cosf(decl));
+    if (cosH0 < -1.0f || cosH0 > 1.0f) {
+        // midnight sun or polar night
+        return false;
+    }
+    float H0_deg = acosf(cosH0) / DEG_TO_RAD;
+
+    // 3) Solar noon, sunrise and sunset in UTC minutes
+    float solar_noon_min_utc = 720.0f - 4.0f * longitude - EoT_min;
+    float sunrise_min_utc = normalize_day_minutes_f(solar_noon_min_utc - 4.0f * H0_deg);
+    float sunset_min_utc  = normalize_day_minutes_f(solar_noon_min_utc + 4.0f * H0_deg);
+
+    // 4) Convert to epoch seconds (UTC)
+    time_t midnight_utc = utc_midnight_epoch(year, month, day);
+    if (sunrise_utc) {
+        *sunrise_utc = midnight_utc + (time_t)lroundf(sunrise_min_utc * 60.0f);
+    }
+    if (sunset_utc) {
+        *sunset_utc  = midnight_utc + (time_t)lroundf(sunset_min_utc  * 60.0f);
+    }
+
+    return true;
+}
+
+void esp_daylight_table_init(esp_daylight_table_t *table, double latitude, double longitude)
+{
+    if (!table) {
+        return;
+    }
+    table->latitude = latitude;
+    table->longitude = longitude;
+    table->year = 0;
+    memset(table->cached, 0, sizeof(table->cached));
+}
+
+bool esp_daylight_table_get(esp_daylight_table_t *table, int year, int month, int day,
+                            time_t *sunrise_utc, time_t *sunset_utc)
+{
+    if (!table || month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+
+    // the entries of another year are dropped, as the NOAA equations depend on the length of the year
+    if (table->year != year) {
+        table->year = year;
+        memset(table->cached, 0, sizeof(table->cached));
+    }
+
+    int year_len;
+    int i = day_of_year(year, month, day, &year_len) - 1;
+    if (!(table->cached[i / 32] & (1UL << (i % 32)))) {
+        double sunrise_min_utc, sunset_min_utc;
+        if (calc_sunrise_sunset_min(year, month, day, table->latitude, table->longitude,
+                                    &sunrise_min_utc, &sunset_min_utc)) {
+            table->sunrise[i] = (uint16_t)lround(sunrise_min_utc * 30.0);
+            table->sunset[i] = (uint16_t)lround(sunset_min_utc * 30.0);
+        } else {
+            table->sunrise[i] = ESP_DAYLIGHT_TABLE_NO_EVENT;
+            table->sunset[i] = ESP_DAYLIGHT_TABLE_NO_EVENT;
+        }
+        table->cached[i / 32] |= 1UL << (i % 32);
+    }
+
+    if (table->sunrise[i] == ESP_DAYLIGHT_TABLE_NO_EVENT) {
+        return false;
+    }
+    time_t midnight_utc = utc_midnight_epoch(year, month, day);
+    if (sunrise_utc) {
+        *sunrise_utc = midnight_utc + (time_t)table->sunrise[i] * 2;
+    }
+    if (sunset_utc) {
+        *sunset_utc = midnight_utc + (time_t)table->sunset[i] * 2;
+    }
+    return true;
+}
+
 bool esp_daylight_calc_sunrise_sunset_location(int year, int month, int day,
         const esp_daylight_location_t *location,
         time_t *sunrise_utc, time_t *sunset_utc)
@@ -4,10 +4,13 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "sdkconfig.h"
 #include "unity.h"
 #include "unity_test_runner.h"
 #include "esp_heap_caps.h"
+#if !CONFIG_IDF_TARGET_LINUX
 #include "esp_newlib.h"
+#endif
 #include "unity_test_utils_memory.h"
 
 void setUp(void)
@@ -17,7 +20,9 @@ void setUp(void)
 
 void tearDown(void)
 {
+#if !CONFIG_IDF_TARGET_LINUX
     esp_reent_cleanup();    /* clean up some of the newlib's lazy allocations */
+#endif
     unity_utils_evaluate_leaks_direct(50);
 }
 
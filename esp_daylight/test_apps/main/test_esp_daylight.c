@@ -5,7 +5,12 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
 #include <math.h>
+#include <sys/param.h>
+#include <sys/time.h>
+#include "sdkconfig.h"
 #include "unity.h"
 #include "esp_log.h"
 #include "esp_daylight.h"
@@ -282,3 +287,128 @@ TEST_CASE("Test NULL pointer handling", "[esp_daylight]")
 
     ESP_LOGI(TAG, "NULL pointer handling tests completed");
 }
+
+/* Maximum difference between the single and double precision versions, as documented */
+#define FAST_TOLERANCE_SEC 2
+/* Maximum difference between the table and the double precision version */
+#define TABLE_TOLERANCE_SEC 1
+
+static int64_t get_time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+TEST_CASE("Test single precision accuracy", "[esp_daylight]")
+{
+    static const double longitudes[] = { -122.4194, 73.8567 };
+    int max_diff = 0;
+
+    for (int lat = -65; lat <= 65; lat += 5) {
+        for (size_t l = 0; l < sizeof(longitudes) / sizeof(longitudes[0]); l++) {
+            for (int month = 1; month <= 12; month++) {
+                for (int day = 1; day <= 28; day++) {
+                    time_t sunrise_ref, sunset_ref, sunrise_fast, sunset_fast;
+                    bool ref = esp_daylight_calc_sunrise_sunset_utc(2025, month, day, lat, longitudes[l],
+                               &sunrise_ref, &sunset_ref);
+                    bool fast = esp_daylight_calc_sunrise_sunset_utc_fast(2025, month, day, lat, (float)longitudes[l],
+                                &sunrise_fast, &sunset_fast);
+                    TEST_ASSERT_EQUAL(ref, fast);
+                    if (!ref) {
+                        continue;
+                    }
+                    TEST_ASSERT_TRUE(time_within_tolerance(sunrise_fast, sunrise_ref, FAST_TOLERANCE_SEC));
+                    TEST_ASSERT_TRUE(time_within_tolerance(sunset_fast, sunset_ref, FAST_TOLERANCE_SEC));
+                    max_diff = MAX(max_diff, abs((int)(sunrise_fast - sunrise_ref)));
+                    max_diff = MAX(max_diff, abs((int)(sunset_fast - sunset_ref)));
+                }
+            }
+        }
+    }
+    ESP_LOGI(TAG, "Single precision max difference: %d s", max_diff);
+}
+
+TEST_CASE("Test yearly table", "[esp_daylight]")
+{
+    /* Tromsø has polar night and midnight sun, the other ones have sunrise/sunset every day */
+    static const esp_daylight_location_t locations[] = {
+        { .latitude = 18.5204, .longitude = 73.8567, .name = "Pune" },
+        { .latitude = -33.8688, .longitude = 151.2093, .name = "Sydney" },
+        { .latitude = 69.6492, .longitude = 18.9553, .name = "Tromso" },
+    };
+    static const int mdays[] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    esp_daylight_table_t *table = malloc(sizeof(esp_daylight_table_t));
+    TEST_ASSERT_NOT_NULL(table);
+
+    for (size_t i = 0; i < sizeof(locations) / sizeof(locations[0]); i++) {
+        esp_daylight_table_init(table, locations[i].latitude, locations[i].longitude);
+        int no_event_days = 0;
+        /* leap year then a common one, to check the table is refreshed when the year changes */
+        for (int year = 2024; year <= 2025; year++) {
+            for (int month = 1; month <= 12; month++) {
+                int days = (month == 2 && year != 2024) ? 28 : mdays[month - 1];
+                for (int day = 1; day <= days; day++) {
+                    time_t sunrise_ref, sunset_ref, sunrise, sunset;
+                    bool ref = esp_daylight_calc_sunrise_sunset_utc(year, month, day,
+                               locations[i].latitude, locations[i].longitude, &sunrise_ref, &sunset_ref);
+                    /* twice, the second time from the cached entry */
+                    for (int pass = 0; pass < 2; pass++) {
+                        TEST_ASSERT_EQUAL(ref, esp_daylight_table_get(table, year, month, day, &sunrise, &sunset));
+                        if (ref) {
+                            TEST_ASSERT_TRUE(time_within_tolerance(sunrise, sunrise_ref, TABLE_TOLERANCE_SEC));
+                            TEST_ASSERT_TRUE(time_within_tolerance(sunset, sunset_ref, TABLE_TOLERANCE_SEC));
+                        }
+                    }
+                    no_event_days += !ref;
+                }
+            }
+        }
+        ESP_LOGI(TAG, "%s: %d days without sunrise/sunset", locations[i].name, no_event_days);
+    }
+
+    TEST_ASSERT_FALSE(esp_daylight_table_get(NULL, 2025, 1, 1, NULL, NULL));
+    TEST_ASSERT_FALSE(esp_daylight_table_get(table, 2025, 13, 1, NULL, NULL));
+    TEST_ASSERT_FALSE(esp_daylight_table_get(table, 2025, 1, 0, NULL, NULL));
+    free(table);
+}
+
+TEST_CASE("Test solar calculation performance", "[esp_daylight]")
+{
+    const int iterations = 1000;
+    esp_daylight_table_t *table = malloc(sizeof(esp_daylight_table_t));
+    TEST_ASSERT_NOT_NULL(table);
+    esp_daylight_table_init(table, 51.5074, -0.1278);
+    time_t sunrise, sunset;
+
+    int64_t start = get_time_us();
+    for (int i = 0; i < iterations; i++) {
+        esp_daylight_calc_sunrise_sunset_utc(2025, 1 + i % 12, 1 + i % 28, 51.5074, -0.1278, &sunrise, &sunset);
+    }
+    int64_t double_us = get_time_us() - start;
+
+    start = get_time_us();
+    for (int i = 0; i < iterations; i++) {
+        esp_daylight_calc_sunrise_sunset_utc_fast(2025, 1 + i % 12, 1 + i % 28, 51.5074f, -0.1278f, &sunrise, &sunset);
+    }
+    int64_t fast_us = get_time_us() - start;
+
+    /* fill the table first, so that only cached entries are measured */
+    for (int i = 0; i < iterations; i++) {
+        esp_daylight_table_get(table, 2025, 1 + i % 12, 1 + i % 28, &sunrise, &sunset);
+    }
+    start = get_time_us();
+    for (int i = 0; i < iterations; i++) {
+        esp_daylight_table_get(table, 2025, 1 + i % 12, 1 + i % 28, &sunrise, &sunset);
+    }
+    int64_t table_us = get_time_us() - start;
+    free(table);
+
+    ESP_LOGI(TAG, "%d calculations: double %" PRId64 " us, single %" PRId64 " us, table %" PRId64 " us",
+             iterations, double_us, fast_us, table_us);
+    TEST_ASSERT_LESS_THAN(double_us, table_us);
+#if !CONFIG_IDF_TARGET_LINUX
+    /* on the host, double precision is as fast as single precision */
+    TEST_ASSERT_LESS_THAN(double_us, fast_us);
+#endif
+}
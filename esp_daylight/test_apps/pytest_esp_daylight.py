@@ -13,3 +13,11 @@ def test_esp_daylight(dut: Dut) -> None:
     """
     dut.run_all_single_board_cases(timeout=60)
 
+
+@pytest.mark.host_test
+@pytest.mark.parametrize('target', ['linux'], indirect=['target'])
+def test_esp_daylight_host(dut: Dut) -> None:
+    """
+    Test esp_daylight component functionality, accuracy and performance on the host
+    """
+    dut.run_all_single_board_cases(timeout=60)
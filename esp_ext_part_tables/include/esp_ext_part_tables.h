@@ -59,11 +59,12 @@ typedef enum {
 } esp_ext_part_list_flags_t;
 
 typedef enum {
-    ESP_EXT_PART_LIST_SIGNATURE_MBR, /*!< MBR signature type */
+    ESP_EXT_PART_LIST_SIGNATURE_MBR, /*!< MBR signature type (32-bit disk signature) */
+    ESP_EXT_PART_LIST_SIGNATURE_GPT, /*!< GPT signature type (16-byte disk GUID, on-disk byte order) */
 } esp_ext_part_signature_type_t;
 
 typedef struct {
-    uint32_t data[1];
+    uint32_t data[4]; /*!< Signature data, only the first word is used for MBR */
     esp_ext_part_signature_type_t type;
 } esp_ext_part_list_signature_t;
 
@@ -88,6 +89,18 @@ typedef struct {
     esp_ext_part_sector_size_t sector_size; /*!< Sector size (storage medium property) */
 } esp_ext_part_list_t;
 
+typedef struct {
+    uint64_t start_lba; /*!< First LBA of the partition */
+    uint64_t end_lba; /*!< Last LBA of the partition (inclusive) */
+    esp_ext_part_list_item_t *item; /*!< Partition list item the range belongs to */
+} esp_ext_part_index_entry_t;
+
+typedef struct {
+    esp_ext_part_index_entry_t *entries; /*!< Entries sorted by `start_lba` */
+    size_t count; /*!< Number of entries */
+    esp_ext_part_sector_size_t sector_size; /*!< Sector size used to convert partition addresses to LBAs */
+} esp_ext_part_index_t;
+
 /**
  * @brief Convert bytes to sector count based on the sector size.
  *
@@ -185,7 +198,7 @@ esp_ext_part_list_item_t *esp_ext_part_list_item_next(esp_ext_part_list_item_t *
  * This function retrieves the disk signature or identifier from the partition list.
  *
  * @param[in] part_list Pointer to the partition list structure.
- * @param[out] signature Pointer to a buffer where the signature will be stored.
+ * @param[out] signature Pointer to a buffer where the signature will be stored (4 bytes for MBR, 16 bytes for GPT).
  *
  * @return
  *     - ESP_OK: Signature retrieval was successful.
@@ -200,7 +213,7 @@ esp_err_t esp_ext_part_list_signature_get(esp_ext_part_list_t *part_list, void *
  *
  * @param[in] part_list Pointer to the partition list structure.
  * @param[in] signature Pointer to the signature data to set.
- * @param[in] type      Type of the signature (e.g., MBR).
+ * @param[in] type      Type of the signature (e.g., MBR or GPT).
  *
  * @return
  *     - ESP_OK: Signature was successfully set.
@@ -209,6 +222,47 @@ esp_err_t esp_ext_part_list_signature_get(esp_ext_part_list_t *part_list, void *
  */
 esp_err_t esp_ext_part_list_signature_set(esp_ext_part_list_t *part_list, const void *signature, esp_ext_part_signature_type_t type);
 
+/**
+ * @brief Build a sorted LBA interval index of a partition list.
+ *
+ * The index maps an LBA to the partition containing it in O(log n) (see `esp_ext_part_index_find`),
+ * which is meant for block-layer routing done on every I/O. Partitions of zero size are skipped.
+ *
+ * @note The index points to the items of `part_list`, it has to be rebuilt whenever the list is modified or deinitialized.
+ * @note This function is not thread-safe.
+ *
+ * @param[out] index     Pointer to the index structure to be filled (free with `esp_ext_part_index_deinit`).
+ * @param[in]  part_list Pointer to the partition list structure (with a known sector size).
+ *
+ * @return
+ *     - ESP_OK: Index was built successfully.
+ *     - ESP_ERR_INVALID_ARG: `index` or `part_list` is NULL or the sector size of the list is unknown.
+ *     - ESP_ERR_INVALID_STATE: Partitions in the list overlap.
+ *     - ESP_ERR_NO_MEM: Memory allocation failed.
+ */
+esp_err_t esp_ext_part_index_build(esp_ext_part_index_t *index, esp_ext_part_list_t *part_list);
+
+/**
+ * @brief Find the partition containing an LBA.
+ *
+ * @param[in] index Pointer to an index built by `esp_ext_part_index_build`.
+ * @param[in] lba   Logical block address to look up.
+ *
+ * @return Pointer to the partition list item containing `lba`, or NULL if the LBA is not inside any partition.
+ */
+esp_ext_part_list_item_t *esp_ext_part_index_find(const esp_ext_part_index_t *index, uint64_t lba);
+
+/**
+ * @brief Free the resources of an LBA interval index.
+ *
+ * @param[in] index Pointer to the index structure.
+ *
+ * @return
+ *     - ESP_OK: Deinitialization was successful.
+ *     - ESP_ERR_INVALID_ARG: `index` is NULL.
+ */
+esp_err_t esp_ext_part_index_deinit(esp_ext_part_index_t *index);
+
 #ifdef __cplusplus
 }
 #endif
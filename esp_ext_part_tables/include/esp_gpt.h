@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_ext_part_tables.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPT_SIGNATURE 0x5452415020494645ULL // "EFI PART"
+#define GPT_REVISION 0x00010000
+#define GPT_HEADER_SIZE 92
+#define GPT_HEADER_LBA 1
+#define GPT_ENTRY_SIZE 128
+#define GPT_DEFAULT_ENTRY_COUNT 128
+#define GPT_GUID_SIZE 16
+#define GPT_NAME_LENGTH 36 // Partition name length in UTF-16LE code units
+#define GPT_ATTR_LEGACY_BIOS_BOOTABLE (1ULL << 2)
+
+// GPT header structure - https://en.wikipedia.org/wiki/GUID_Partition_Table#Partition_table_header_(LBA_1)
+#pragma pack(push, 1)
+typedef struct {
+    uint64_t signature;
+    uint32_t revision;
+    uint32_t header_size;
+    uint32_t header_crc32;
+    uint32_t _reserved;
+    uint64_t my_lba;
+    uint64_t alternate_lba;
+    uint64_t first_usable_lba;
+    uint64_t last_usable_lba;
+    uint8_t disk_guid[GPT_GUID_SIZE];
+    uint64_t partition_entry_lba;
+    uint32_t num_partition_entries;
+    uint32_t partition_entry_size;
+    uint32_t partition_entry_array_crc32;
+} gpt_header_t;
+#pragma pack(pop)
+
+// GPT partition entry structure - https://en.wikipedia.org/wiki/GUID_Partition_Table#Partition_entries_(LBA_2%E2%80%9333)
+#pragma pack(push, 1)
+typedef struct {
+    uint8_t type_guid[GPT_GUID_SIZE]; // GUIDs are stored in their on-disk (mixed-endian) byte order
+    uint8_t unique_guid[GPT_GUID_SIZE];
+    uint64_t first_lba;
+    uint64_t last_lba; // Inclusive
+    uint64_t attributes;
+    uint16_t name[GPT_NAME_LENGTH]; // UTF-16LE
+} gpt_entry_t;
+#pragma pack(pop)
+
+typedef struct {
+    esp_ext_part_sector_size_t sector_size; // Sector size hint, pulled from a storage device driver query
+    bool (*esp_gpt_parse_custom_supported_partition_types)(const uint8_t *, uint8_t *); // Custom function for parsing supported GPT partition type GUIDs, optional
+} esp_gpt_parse_extra_args_t;
+
+typedef struct {
+    esp_ext_part_sector_size_t sector_size; // Sector size hint for correct LBA alignment
+    esp_ext_part_align_t alignment; // Alignment hint for correct LBA alignment
+    bool keep_signature; // If true, the disk GUID will be preserved in the generated GPT and not overwritten with a random value
+    uint32_t entry_count; // Number of entries in the partition entry array, 0 for the default of `GPT_DEFAULT_ENTRY_COUNT`
+    bool (*esp_gpt_generate_custom_supported_partition_types)(uint8_t, uint8_t *); // Custom function for generating supported GPT partition type GUIDs, optional
+} esp_gpt_generate_extra_args_t;
+
+/**
+ * @brief Parses a GUID Partition Table (GPT) and extracts partition information.
+ *
+ * The buffer must contain the beginning of the disk: the protective MBR (LBA 0), the primary GPT header (LBA 1)
+ * and the whole partition entry array the header points to (usually LBA 2 to LBA 33 for 512 B sectors).
+ * The CRC32 of both the header and the partition entry array are validated.
+ *
+ * The partition labels are converted from UTF-16LE to UTF-8. The disk GUID is stored as the partition list signature
+ * (`ESP_EXT_PART_LIST_SIGNATURE_GPT`).
+ *
+ * @note This function is not thread-safe.
+ *
+ * @param[in]  gpt_buf    Pointer to a buffer containing the raw data starting at LBA 0.
+ * @param[in]  buf_size   Size of the buffer in bytes.
+ * @param[out] part_list  Pointer to the partition list structure to be filled with parsed entries.
+ * @param[in]  extra_args Optional extra arguments for parsing (can be NULL for defaults).
+ *
+ * @return
+ *     - ESP_OK:               Parsing was successful.
+ *     - ESP_ERR_INVALID_ARG:  Invalid arguments were provided.
+ *     - ESP_ERR_NOT_FOUND:    GPT signature not found or invalid GPT header.
+ *     - ESP_ERR_INVALID_SIZE: The buffer does not contain the whole GPT header or partition entry array.
+ *     - ESP_ERR_INVALID_CRC:  CRC32 of the header or of the partition entry array does not match.
+ *     - ESP_ERR_NO_MEM:       Memory allocation failed during parsing.
+ *     - Other error codes from `esp_ext_part_list_insert`.
+ */
+esp_err_t esp_gpt_parse(const void *gpt_buf,
+                        size_t buf_size,
+                        esp_ext_part_list_t *part_list,
+                        esp_gpt_parse_extra_args_t *extra_args);
+
+/**
+ * @brief Generates a GUID Partition Table (GPT) from a partition list.
+ *
+ * This function fills the buffer with the protective MBR (LBA 0), the primary GPT header (LBA 1)
+ * and the partition entry array (from LBA 2). The buffer must be at least `esp_gpt_primary_size()` bytes.
+ * The backup GPT at the end of the disk can be produced from the result by `esp_gpt_generate_backup()`.
+ *
+ * @note This function is not thread-safe.
+ *
+ * @param[out] gpt_buf           Pointer to the buffer to be filled.
+ * @param[in]  buf_size          Size of the buffer in bytes.
+ * @param[in]  disk_sector_count Total number of sectors of the disk.
+ * @param[in]  part_list         Pointer to the partition list structure containing partition entries to encode.
+ * @param[in]  extra_args        Optional extra arguments for generation (can be NULL for defaults).
+ *
+ * @return
+ *     - ESP_OK:                Generation was successful.
+ *     - ESP_ERR_INVALID_ARG:   Invalid arguments were provided.
+ *     - ESP_ERR_INVALID_SIZE:  The buffer is too small, there are more partitions than entries or a partition does not fit the usable area of the disk.
+ *     - ESP_ERR_NOT_SUPPORTED: No type GUID known for a partition type.
+ *     - ESP_ERR_INVALID_STATE: `keep_signature` is set but the list does not hold a GPT disk GUID, or two partitions overlap once aligned.
+ *     - Other error codes from `esp_ext_part_list_signature_get`.
+ */
+esp_err_t esp_gpt_generate(void *gpt_buf,
+                           size_t buf_size,
+                           uint64_t disk_sector_count,
+                           esp_ext_part_list_t *part_list,
+                           esp_gpt_generate_extra_args_t *extra_args);
+
+/**
+ * @brief Generates the backup GPT (partition entry array followed by the backup header) from a primary GPT.
+ *
+ * The backup has to be written at the end of the disk, starting at the LBA returned in `out_lba`.
+ *
+ * @param[in]  gpt_buf          Pointer to a buffer containing the primary GPT (as filled by `esp_gpt_generate()`).
+ * @param[in]  buf_size         Size of the primary GPT buffer in bytes.
+ * @param[out] backup_buf       Pointer to the buffer to be filled with the backup GPT.
+ * @param[in]  backup_buf_size  Size of the backup buffer in bytes (at least `esp_gpt_primary_size()` minus one sector).
+ * @param[in]  sector_size      Sector size of the disk.
+ * @param[out] out_lba          LBA at which the backup has to be written.
+ *
+ * @return
+ *     - ESP_OK:               Generation was successful.
+ *     - ESP_ERR_INVALID_ARG:  Invalid arguments were provided.
+ *     - ESP_ERR_NOT_FOUND:    The primary GPT header is not valid.
+ *     - ESP_ERR_INVALID_SIZE: One of the buffers is too small.
+ */
+esp_err_t esp_gpt_generate_backup(const void *gpt_buf,
+                                  size_t buf_size,
+                                  void *backup_buf,
+                                  size_t backup_buf_size,
+                                  esp_ext_part_sector_size_t sector_size,
+                                  uint64_t *out_lba);
+
+/**
+ * @brief Get the size of the primary GPT (protective MBR, header and partition entry array) in bytes.
+ *
+ * @param[in] sector_size Sector size of the disk.
+ * @param[in] entry_count Number of partition entries, 0 for the default of `GPT_DEFAULT_ENTRY_COUNT`.
+ *
+ * @return Size in bytes, 0 if the sector size is unknown.
+ */
+size_t esp_gpt_primary_size(esp_ext_part_sector_size_t sector_size, uint32_t entry_count);
+
+/**
+ * @brief Compute the CRC32 (IEEE 802.3, as used by GPT) of a buffer.
+ *
+ * @param[in] crc  Initial value, 0 for a new computation or the result of the previous call to continue one.
+ * @param[in] buf  Pointer to the data.
+ * @param[in] len  Length of the data in bytes.
+ *
+ * @return CRC32 value.
+ */
+uint32_t esp_gpt_crc32(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief Parse default supported GPT partition type GUIDs into internal types (`esp_ext_part_type_known_t`).
+ *
+ * @param[in]  type_guid        Partition type GUID (16 bytes, on-disk byte order).
+ * @param[out] out_type_parsed  Pointer to store the parsed internal partition type (from `esp_ext_part_type_known_t`).
+ * @return true if the partition type is known and supported, false otherwise.
+ */
+bool esp_gpt_parse_default_supported_partition_types(const uint8_t *type_guid, uint8_t *out_type_parsed);
+
+/**
+ * @brief Generate default supported GPT partition type GUIDs for a given internal type.
+ *
+ * @param[in]  type            Internal partition type from `esp_ext_part_type_known_t` enum.
+ * @param[out] out_type_guid   Buffer of 16 bytes to store the partition type GUID (on-disk byte order).
+ * @return true if a type GUID is known for the type, false otherwise.
+ */
+bool esp_gpt_generate_default_supported_partition_types(uint8_t type, uint8_t *out_type_guid);
+
+#ifdef __cplusplus
+}
+#endif
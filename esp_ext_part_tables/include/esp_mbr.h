@@ -121,7 +121,7 @@ esp_err_t esp_mbr_parse(void *mbr_buf,
  * @return
  *     - ESP_OK:                Generation was successful.
  *     - ESP_ERR_INVALID_ARG:   Invalid arguments were provided.
- *     - ESP_ERR_INVALID_STATE: Error filling partition entry.
+ *     - ESP_ERR_INVALID_STATE: Error filling partition entry or `keep_signature` is set but the list does not hold an MBR disk signature.
  *     - ESP_ERR_NOT_SUPPORTED: Partition address or size (sector count) exceeds 32-bit limit of MBR.
  *     - Other error codes from `esp_ext_part_list_signature_get` or `esp_mbr_partition_set`.
  */
@@ -5,6 +5,7 @@
  */
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "esp_err.h"
@@ -131,6 +132,9 @@ esp_err_t esp_ext_part_list_signature_get(esp_ext_part_list_t *part_list, void *
         out = (uint32_t) part_list->signature.data[0];
         memcpy(signature, &out, sizeof(uint32_t));
         break;
+    case ESP_EXT_PART_LIST_SIGNATURE_GPT:
+        memcpy(signature, part_list->signature.data, sizeof(part_list->signature.data));
+        break;
     default:
         return ESP_ERR_NOT_SUPPORTED; // Unsupported signature type
     }
@@ -148,8 +152,97 @@ esp_err_t esp_ext_part_list_signature_set(esp_ext_part_list_t *part_list, const
     case ESP_EXT_PART_LIST_SIGNATURE_MBR:
         part_list->signature.data[0] = *((const uint32_t *) signature);
         break;
+    case ESP_EXT_PART_LIST_SIGNATURE_GPT:
+        memcpy(part_list->signature.data, signature, sizeof(part_list->signature.data));
+        break;
     default:
         return ESP_ERR_NOT_SUPPORTED; // Unsupported signature type
     }
     return ESP_OK;
 }
+
+static int esp_ext_part_index_entry_cmp(const void *a, const void *b)
+{
+    const esp_ext_part_index_entry_t *ea = (const esp_ext_part_index_entry_t *) a;
+    const esp_ext_part_index_entry_t *eb = (const esp_ext_part_index_entry_t *) b;
+    if (ea->start_lba < eb->start_lba) {
+        return -1;
+    }
+    return ea->start_lba > eb->start_lba ? 1 : 0;
+}
+
+esp_err_t esp_ext_part_index_build(esp_ext_part_index_t *index, esp_ext_part_list_t *part_list)
+{
+    if (index == NULL || part_list == NULL || part_list->sector_size == ESP_EXT_PART_SECTOR_SIZE_UNKNOWN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(index, 0, sizeof(esp_ext_part_index_t));
+    index->sector_size = part_list->sector_size;
+
+    size_t count = 0;
+    esp_ext_part_list_item_t *it = NULL;
+    SLIST_FOREACH(it, &part_list->head, next) {
+        count++;
+    }
+    if (count == 0) {
+        return ESP_OK;
+    }
+
+    index->entries = (esp_ext_part_index_entry_t *) calloc(count, sizeof(esp_ext_part_index_entry_t));
+    if (index->entries == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    SLIST_FOREACH(it, &part_list->head, next) {
+        if (it->info.size == 0) {
+            continue; // Nothing to route to an empty partition
+        }
+        esp_ext_part_index_entry_t *entry = &index->entries[index->count++];
+        entry->start_lba = it->info.address / part_list->sector_size;
+        entry->end_lba = entry->start_lba + esp_ext_part_bytes_to_sector_count(it->info.size, part_list->sector_size) - 1;
+        entry->item = it;
+    }
+
+    qsort(index->entries, index->count, sizeof(esp_ext_part_index_entry_t), esp_ext_part_index_entry_cmp);
+    for (size_t i = 1; i < index->count; i++) {
+        if (index->entries[i].start_lba <= index->entries[i - 1].end_lba) {
+            esp_ext_part_index_deinit(index);
+            return ESP_ERR_INVALID_STATE; // Overlapping partitions, an LBA would map to more than one partition
+        }
+    }
+    return ESP_OK;
+}
+
+esp_ext_part_list_item_t *esp_ext_part_index_find(const esp_ext_part_index_t *index, uint64_t lba)
+{
+    if (index == NULL || index->count == 0) {
+        return NULL;
+    }
+
+    // Find the last entry starting at or before `lba`
+    size_t lo = 0;
+    size_t hi = index->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->entries[mid].start_lba <= lba) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return NULL; // Before the first partition
+    }
+    const esp_ext_part_index_entry_t *entry = &index->entries[lo - 1];
+    return lba <= entry->end_lba ? entry->item : NULL;
+}
+
+esp_err_t esp_ext_part_index_deinit(esp_ext_part_index_t *index)
+{
+    if (index == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    free(index->entries);
+    memset(index, 0, sizeof(esp_ext_part_index_t));
+    return ESP_OK;
+}
@@ -0,0 +1,509 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_random.h"
+
+#include "esp_ext_part_tables.h"
+#include "esp_mbr.h"
+#include "esp_gpt.h"
+
+static const char *TAG = "esp_gpt";
+
+// Partition type GUIDs in on-disk byte order - https://en.wikipedia.org/wiki/GUID_Partition_Table#Partition_type_GUIDs
+static const uint8_t s_guid_basic_data[GPT_GUID_SIZE] = { // EBD0A0A2-B9E5-4433-87C0-68B6B72699C7
+    0xA2, 0xA0, 0xD0, 0xEB, 0xE5, 0xB9, 0x33, 0x44, 0x87, 0xC0, 0x68, 0xB6, 0xB7, 0x26, 0x99, 0xC7
+};
+static const uint8_t s_guid_efi_system[GPT_GUID_SIZE] = { // C12A7328-F81F-11D2-BA4B-00A0C93EC93B
+    0x28, 0x73, 0x2A, 0xC1, 0x1F, 0xF8, 0xD2, 0x11, 0xBA, 0x4B, 0x00, 0xA0, 0xC9, 0x3E, 0xC9, 0x3B
+};
+static const uint8_t s_guid_linux_fs[GPT_GUID_SIZE] = { // 0FC63DAF-8483-4772-8E79-3D69D8477DE4
+    0xAF, 0x3D, 0xC6, 0x0F, 0x83, 0x84, 0x72, 0x47, 0x8E, 0x79, 0x3D, 0x69, 0xD8, 0x47, 0x7D, 0xE4
+};
+static const uint8_t s_guid_unused[GPT_GUID_SIZE] = { 0 };
+
+// Nibble-wise CRC32 table for the reflected IEEE 802.3 polynomial 0xEDB88320
+static const uint32_t s_crc32_nibble_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t esp_gpt_crc32(uint32_t crc, const void *buf, size_t len)
+{
+    const uint8_t *p = (const uint8_t *) buf;
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ s_crc32_nibble_table[crc & 0x0F];
+        crc = (crc >> 4) ^ s_crc32_nibble_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+size_t esp_gpt_primary_size(esp_ext_part_sector_size_t sector_size, uint32_t entry_count)
+{
+    if (sector_size == ESP_EXT_PART_SECTOR_SIZE_UNKNOWN) {
+        return 0;
+    }
+    if (entry_count == 0) {
+        entry_count = GPT_DEFAULT_ENTRY_COUNT;
+    }
+    uint64_t entry_sectors = esp_ext_part_bytes_to_sector_count((uint64_t) entry_count * GPT_ENTRY_SIZE, sector_size);
+    return (size_t) esp_ext_part_sector_count_to_bytes(2 + entry_sectors, sector_size);
+}
+
+bool esp_gpt_parse_default_supported_partition_types(const uint8_t *type_guid, uint8_t *out_type_parsed)
+{
+    bool supported = true;
+    esp_ext_part_type_known_t parsed_type = ESP_EXT_PART_TYPE_NONE;
+
+    if (memcmp(type_guid, s_guid_basic_data, GPT_GUID_SIZE) == 0 ||
+            memcmp(type_guid, s_guid_efi_system, GPT_GUID_SIZE) == 0) {
+        // Basic data can hold any FAT variant (or exFAT/NTFS), the FAT driver figures out which one
+        parsed_type = ESP_EXT_PART_TYPE_FAT32;
+    } else if (memcmp(type_guid, s_guid_linux_fs, GPT_GUID_SIZE) == 0) {
+        parsed_type = ESP_EXT_PART_TYPE_LINUX_ANY;
+        supported = false; // Not supported
+    } else {
+        supported = false;
+    }
+
+    if (out_type_parsed != NULL) {
+        *out_type_parsed = (uint8_t) parsed_type;
+    }
+    return supported;
+}
+
+bool esp_gpt_generate_default_supported_partition_types(uint8_t type, uint8_t *out_type_guid)
+{
+    const uint8_t *guid;
+    switch ((esp_ext_part_type_known_t) type) {
+    case ESP_EXT_PART_TYPE_FAT12:
+    case ESP_EXT_PART_TYPE_FAT16:
+    case ESP_EXT_PART_TYPE_FAT32:
+    case ESP_EXT_PART_TYPE_EXFAT_OR_NTFS:
+        guid = s_guid_basic_data;
+        break;
+    case ESP_EXT_PART_TYPE_LINUX_ANY:
+        guid = s_guid_linux_fs;
+        break;
+    default:
+        return false; // No GUID for this type (LittleFS block size hack is MBR only)
+    }
+    memcpy(out_type_guid, guid, GPT_GUID_SIZE);
+    return true;
+}
+
+static char *gpt_name_to_utf8(const uint16_t name[GPT_NAME_LENGTH])
+{
+    // Worst case is 3 bytes of UTF-8 per UTF-16 code unit (surrogate pairs take 4 bytes for 2 units)
+    char buf[GPT_NAME_LENGTH * 3 + 1];
+    size_t len = 0;
+    for (int i = 0; i < GPT_NAME_LENGTH && name[i] != 0; i++) {
+        uint32_t cp = name[i];
+        if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < GPT_NAME_LENGTH && name[i + 1] >= 0xDC00 && name[i + 1] <= 0xDFFF) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (name[i + 1] - 0xDC00);
+            i++;
+        }
+        if (cp < 0x80) {
+            buf[len++] = (char) cp;
+        } else if (cp < 0x800) {
+            buf[len++] = (char)(0xC0 | (cp >> 6));
+            buf[len++] = (char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            buf[len++] = (char)(0xE0 | (cp >> 12));
+            buf[len++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+            buf[len++] = (char)(0x80 | (cp & 0x3F));
+        } else {
+            buf[len++] = (char)(0xF0 | (cp >> 18));
+            buf[len++] = (char)(0x80 | ((cp >> 12) & 0x3F));
+            buf[len++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+            buf[len++] = (char)(0x80 | (cp & 0x3F));
+        }
+    }
+    if (len == 0) {
+        return NULL; // No label
+    }
+    buf[len] = '\0';
+    return strdup(buf);
+}
+
+static void gpt_name_from_utf8(uint16_t name[GPT_NAME_LENGTH], const char *label)
+{
+    const uint8_t *p = (const uint8_t *) label;
+    int i = 0;
+    while (*p && i < GPT_NAME_LENGTH) {
+        uint32_t cp;
+        if (p[0] < 0x80) {
+            cp = p[0];
+            p += 1;
+        } else if ((p[0] & 0xE0) == 0xC0 && p[1]) {
+            cp = ((p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+            p += 2;
+        } else if ((p[0] & 0xF0) == 0xE0 && p[1] && p[2]) {
+            cp = ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+            p += 3;
+        } else if ((p[0] & 0xF8) == 0xF0 && p[1] && p[2] && p[3]) {
+            cp = ((uint32_t)(p[0] & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+            p += 4;
+        } else {
+            cp = '?'; // Invalid UTF-8
+            p += 1;
+        }
+        if (cp >= 0x10000) {
+            if (i + 1 >= GPT_NAME_LENGTH) {
+                break; // Surrogate pair does not fit
+            }
+            cp -= 0x10000;
+            name[i++] = (uint16_t)(0xD800 + (cp >> 10));
+            name[i++] = (uint16_t)(0xDC00 + (cp & 0x3FF));
+        } else {
+            name[i++] = (uint16_t) cp;
+        }
+    }
+}
+
+// Check the header signature, size and CRC32, `avail` is the number of bytes readable at `header`
+static esp_err_t gpt_header_validate(const gpt_header_t *header, esp_ext_part_sector_size_t sector_size, size_t avail)
+{
+    if (header->signature != GPT_SIGNATURE) {
+        ESP_LOGE(TAG, "GPT signature not found");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (header->header_size < GPT_HEADER_SIZE || header->header_size > (uint32_t) sector_size ||
+            header->partition_entry_size < GPT_ENTRY_SIZE || header->partition_entry_size % 8 != 0) {
+        ESP_LOGE(TAG, "Invalid GPT header");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (header->header_size > avail) {
+        ESP_LOGE(TAG, "Buffer does not contain the whole GPT header");
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // The CRC is computed with the CRC field zeroed, feed the bytes around it and 4 zero bytes instead of copying the header
+    const uint8_t *raw = (const uint8_t *) header;
+    const uint8_t zero_crc[sizeof(header->header_crc32)] = { 0 };
+    size_t crc_offset = offsetof(gpt_header_t, header_crc32);
+    size_t rest_offset = crc_offset + sizeof(zero_crc);
+    uint32_t crc = esp_gpt_crc32(0, raw, crc_offset);
+    crc = esp_gpt_crc32(crc, zero_crc, sizeof(zero_crc));
+    crc = esp_gpt_crc32(crc, raw + rest_offset, header->header_size - rest_offset);
+    if (crc != header->header_crc32) {
+        ESP_LOGE(TAG, "GPT header CRC32 mismatch");
+        return ESP_ERR_INVALID_CRC;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_gpt_parse(const void *gpt_buf,
+                        size_t buf_size,
+                        esp_ext_part_list_t *part_list,
+                        esp_gpt_parse_extra_args_t *extra_args)
+{
+    if (gpt_buf == NULL || part_list == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Set defaults
+    part_list->sector_size = ESP_EXT_PART_SECTOR_SIZE_512B; // Default sector size
+    bool (*f_parse_supported_partition_types)(const uint8_t *, uint8_t *) = esp_gpt_parse_default_supported_partition_types;
+
+    // Load extra arguments if provided
+    if (extra_args) {
+        if (extra_args->sector_size != ESP_EXT_PART_SECTOR_SIZE_UNKNOWN) {
+            part_list->sector_size = extra_args->sector_size; // Use the sector size hint from extra_args
+        }
+        if (extra_args->esp_gpt_parse_custom_supported_partition_types) {
+            f_parse_supported_partition_types = extra_args->esp_gpt_parse_custom_supported_partition_types; // Use a custom function for supported partition types
+        }
+    }
+
+    const uint8_t *buf = (const uint8_t *) gpt_buf;
+    size_t header_offset = (size_t) esp_ext_part_sector_count_to_bytes(GPT_HEADER_LBA, part_list->sector_size);
+    if (buf_size < header_offset + GPT_HEADER_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    const gpt_header_t *header = (const gpt_header_t *)(buf + header_offset);
+    esp_err_t err = gpt_header_validate(header, part_list->sector_size, buf_size - header_offset);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // Check the LBA first, so that the offset of the entries cannot overflow
+    uint64_t entries_size = (uint64_t) header->num_partition_entries * header->partition_entry_size;
+    if (header->partition_entry_lba > buf_size / part_list->sector_size) {
+        ESP_LOGE(TAG, "Buffer does not contain the whole partition entry array");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint64_t entries_offset = esp_ext_part_sector_count_to_bytes(header->partition_entry_lba, part_list->sector_size);
+    if (entries_size > buf_size - entries_offset) {
+        ESP_LOGE(TAG, "Buffer does not contain the whole partition entry array");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    const uint8_t *entries = buf + entries_offset;
+    if (esp_gpt_crc32(0, entries, (size_t) entries_size) != header->partition_entry_array_crc32) {
+        ESP_LOGE(TAG, "GPT partition entry array CRC32 mismatch");
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    err = esp_ext_part_list_signature_set(part_list, header->disk_guid, ESP_EXT_PART_LIST_SIGNATURE_GPT);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set partition list (disk) signature");
+        return err;
+    }
+
+    for (uint32_t i = 0; i < header->num_partition_entries; i++) {
+        gpt_entry_t entry;
+        memcpy(&entry, entries + (size_t) i * header->partition_entry_size, sizeof(entry)); // Entries may be unaligned
+
+        // Unused entries can be anywhere in the array, unlike in MBR
+        if (memcmp(entry.type_guid, s_guid_unused, GPT_GUID_SIZE) == 0) {
+            continue;
+        }
+        if (entry.last_lba < entry.first_lba) {
+            ESP_LOGW(TAG, "Skipping partition entry %" PRIu32 " with invalid LBA range", i);
+            continue;
+        }
+
+        // If the partition entry is not supported, skip it
+        uint8_t parsed_type = ESP_EXT_PART_TYPE_NONE;
+        if (!f_parse_supported_partition_types(entry.type_guid, &parsed_type)) {
+            continue;
+        }
+
+        esp_ext_part_list_item_t item = {
+            .info = {
+                .address = esp_ext_part_sector_count_to_bytes(entry.first_lba, part_list->sector_size),
+                .size = esp_ext_part_sector_count_to_bytes(entry.last_lba - entry.first_lba + 1, part_list->sector_size),
+                .extra = 0,
+                .label = gpt_name_to_utf8(entry.name),
+                .flags = ESP_EXT_PART_FLAG_NONE,
+                .type = parsed_type,
+            }
+        };
+        if (entry.attributes & GPT_ATTR_LEGACY_BIOS_BOOTABLE) {
+            item.info.flags |= ESP_EXT_PART_FLAG_ACTIVE;
+        }
+
+        // Add the partition info to the output table (the label is copied)
+        err = esp_ext_part_list_insert(part_list, &item);
+        free(item.info.label);
+        if (err != ESP_OK) {
+            ESP_LOGD(TAG, "Failed to add partition info to list");
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+static void gpt_random_guid(uint8_t guid[GPT_GUID_SIZE])
+{
+    esp_fill_random(guid, GPT_GUID_SIZE);
+    guid[7] = (guid[7] & 0x0F) | 0x40; // Version 4 (random), the 3rd group is stored little-endian
+    guid[8] = (guid[8] & 0x3F) | 0x80; // Variant 1
+}
+
+static uint64_t gpt_lba_align(uint64_t lba, esp_ext_part_sector_size_t sector_size, esp_ext_part_align_t alignment)
+{
+    if (sector_size == 0 || alignment == 0 || (uint32_t) alignment <= (uint32_t) sector_size) {
+        return lba; // No alignment
+    }
+    uint64_t alignment_sectors = (uint64_t) alignment / sector_size;
+    return (lba + alignment_sectors - 1) / alignment_sectors * alignment_sectors;
+}
+
+esp_err_t esp_gpt_generate(void *gpt_buf,
+                           size_t buf_size,
+                           uint64_t disk_sector_count,
+                           esp_ext_part_list_t *part_list,
+                           esp_gpt_generate_extra_args_t *extra_args)
+{
+    if (gpt_buf == NULL || part_list == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Set default arguments for GPT generation
+    esp_gpt_generate_extra_args_t args = {
+        .sector_size = part_list->sector_size != ESP_EXT_PART_SECTOR_SIZE_UNKNOWN ? part_list->sector_size : ESP_EXT_PART_SECTOR_SIZE_512B, // Default sector size
+        .alignment = ESP_EXT_PART_ALIGN_1MiB, // Default alignment
+        .keep_signature = false, // Default is to generate a new disk GUID
+        .entry_count = GPT_DEFAULT_ENTRY_COUNT,
+        .esp_gpt_generate_custom_supported_partition_types = esp_gpt_generate_default_supported_partition_types,
+    };
+
+    // Load extra arguments if provided
+    if (extra_args) {
+        if (extra_args->sector_size != ESP_EXT_PART_SECTOR_SIZE_UNKNOWN) {
+            args.sector_size = extra_args->sector_size;
+        }
+        if (extra_args->alignment != ESP_EXT_PART_ALIGN_NONE) {
+            args.alignment = extra_args->alignment;
+        }
+        args.keep_signature = extra_args->keep_signature;
+        if (extra_args->entry_count != 0) {
+            args.entry_count = extra_args->entry_count;
+        }
+        if (extra_args->esp_gpt_generate_custom_supported_partition_types) {
+            args.esp_gpt_generate_custom_supported_partition_types = extra_args->esp_gpt_generate_custom_supported_partition_types;
+        }
+    }
+
+    size_t primary_size = esp_gpt_primary_size(args.sector_size, args.entry_count);
+    uint64_t entry_sectors = esp_ext_part_bytes_to_sector_count((uint64_t) args.entry_count * GPT_ENTRY_SIZE, args.sector_size);
+    if (buf_size < primary_size) {
+        ESP_LOGE(TAG, "Buffer too small for the primary GPT (%u bytes needed)", (unsigned) primary_size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (disk_sector_count < 2 * (2 + entry_sectors)) {
+        ESP_LOGE(TAG, "Disk too small for GPT");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memset(gpt_buf, 0, primary_size);
+
+    uint8_t *buf = (uint8_t *) gpt_buf;
+    gpt_header_t *header = (gpt_header_t *)(buf + args.sector_size);
+    uint8_t *entries = buf + esp_ext_part_sector_count_to_bytes(GPT_HEADER_LBA + 1, args.sector_size);
+
+    // Protective MBR covering the whole disk, so that MBR-only tools don't treat it as empty
+    mbr_t *mbr = (mbr_t *) buf;
+    mbr->boot_signature = MBR_SIGNATURE;
+    mbr->partition_table[0].type = 0xEE; // GPT protective MBR
+    mbr->partition_table[0].chs_start[1] = 0x02;
+    memset(mbr->partition_table[0].chs_end, 0xFF, sizeof(mbr->partition_table[0].chs_end));
+    mbr->partition_table[0].lba_start = GPT_HEADER_LBA;
+    mbr->partition_table[0].sector_count = disk_sector_count - 1 > UINT32_MAX ? UINT32_MAX : (uint32_t)(disk_sector_count - 1);
+
+    header->signature = GPT_SIGNATURE;
+    header->revision = GPT_REVISION;
+    header->header_size = GPT_HEADER_SIZE;
+    header->my_lba = GPT_HEADER_LBA;
+    header->alternate_lba = disk_sector_count - 1;
+    header->first_usable_lba = GPT_HEADER_LBA + 1 + entry_sectors;
+    header->last_usable_lba = disk_sector_count - 2 - entry_sectors;
+    header->partition_entry_lba = GPT_HEADER_LBA + 1;
+    header->num_partition_entries = args.entry_count;
+    header->partition_entry_size = GPT_ENTRY_SIZE;
+
+    esp_err_t err;
+    if (args.keep_signature) {
+        if (part_list->signature.type != ESP_EXT_PART_LIST_SIGNATURE_GPT) {
+            ESP_LOGE(TAG, "Partition list signature is not a GPT disk GUID");
+            return ESP_ERR_INVALID_STATE;
+        }
+        err = esp_ext_part_list_signature_get(part_list, header->disk_guid);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to get disk signature from partition list");
+            return err;
+        }
+    } else {
+        gpt_random_guid(header->disk_guid);
+    }
+
+    esp_ext_part_list_item_t *it = NULL;
+    uint32_t i = 0;
+    SLIST_FOREACH(it, &part_list->head, next) {
+        if (it->info.type == ESP_EXT_PART_TYPE_NONE) {
+            continue; // Empty entry
+        }
+        if (i >= args.entry_count) {
+            ESP_LOGE(TAG, "More partitions than GPT entries (%" PRIu32 ")", args.entry_count);
+            return ESP_ERR_INVALID_SIZE;
+        }
+
+        gpt_entry_t entry = {0};
+        if (!args.esp_gpt_generate_custom_supported_partition_types(it->info.type, entry.type_guid)) {
+            ESP_LOGE(TAG, "No GPT type GUID for partition %" PRIu32 " of type %d", i, it->info.type);
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        gpt_random_guid(entry.unique_guid);
+
+        uint64_t sector_count = esp_ext_part_bytes_to_sector_count(it->info.size, args.sector_size);
+        entry.first_lba = gpt_lba_align(esp_ext_part_bytes_to_sector_count(it->info.address, args.sector_size), args.sector_size, args.alignment);
+        entry.last_lba = entry.first_lba + sector_count - 1;
+        if (sector_count == 0 || entry.first_lba < header->first_usable_lba || entry.last_lba > header->last_usable_lba) {
+            ESP_LOGE(TAG, "Partition %" PRIu32 " does not fit the usable area of the disk", i);
+            return ESP_ERR_INVALID_SIZE;
+        }
+        // Compare against the entries already written, after the alignment moved the start
+        for (uint32_t j = 0; j < i; j++) {
+            gpt_entry_t prev;
+            memcpy(&prev, entries + (size_t) j * GPT_ENTRY_SIZE, sizeof(prev));
+            if (entry.first_lba <= prev.last_lba && prev.first_lba <= entry.last_lba) {
+                ESP_LOGE(TAG, "Partition %" PRIu32 " overlaps partition %" PRIu32, i, j);
+                return ESP_ERR_INVALID_STATE;
+            }
+        }
+        if (it->info.flags & ESP_EXT_PART_FLAG_ACTIVE) {
+            entry.attributes |= GPT_ATTR_LEGACY_BIOS_BOOTABLE;
+        }
+        if (it->info.label) {
+            gpt_name_from_utf8(entry.name, it->info.label);
+        }
+        memcpy(entries + (size_t) i * GPT_ENTRY_SIZE, &entry, sizeof(entry));
+        i++;
+    }
+
+    header->partition_entry_array_crc32 = esp_gpt_crc32(0, entries, (size_t) args.entry_count * GPT_ENTRY_SIZE);
+    header->header_crc32 = esp_gpt_crc32(0, header, GPT_HEADER_SIZE);
+    return ESP_OK;
+}
+
+esp_err_t esp_gpt_generate_backup(const void *gpt_buf,
+                                  size_t buf_size,
+                                  void *backup_buf,
+                                  size_t backup_buf_size,
+                                  esp_ext_part_sector_size_t sector_size,
+                                  uint64_t *out_lba)
+{
+    if (gpt_buf == NULL || backup_buf == NULL || sector_size == ESP_EXT_PART_SECTOR_SIZE_UNKNOWN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (buf_size < (size_t) sector_size + GPT_HEADER_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    const gpt_header_t *primary = (const gpt_header_t *)((const uint8_t *) gpt_buf + sector_size);
+    esp_err_t err = gpt_header_validate(primary, sector_size, buf_size - sector_size);
+    if (err != ESP_OK) {
+        return err == ESP_ERR_INVALID_CRC ? ESP_ERR_NOT_FOUND : err;
+    }
+
+    uint64_t entries_size = (uint64_t) primary->num_partition_entries * primary->partition_entry_size;
+    uint64_t entry_sectors = esp_ext_part_bytes_to_sector_count(entries_size, sector_size);
+    if (primary->partition_entry_lba > buf_size / sector_size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint64_t entries_offset = esp_ext_part_sector_count_to_bytes(primary->partition_entry_lba, sector_size);
+    if (entries_size > buf_size - entries_offset ||
+            esp_ext_part_sector_count_to_bytes(entry_sectors + 1, sector_size) > backup_buf_size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // Layout at the end of the disk: partition entry array, then the backup header in the very last sector
+    uint8_t *buf = (uint8_t *) backup_buf;
+    memset(buf, 0, (size_t) esp_ext_part_sector_count_to_bytes(entry_sectors + 1, sector_size));
+    memcpy(buf, (const uint8_t *) gpt_buf + entries_offset, (size_t) entries_size);
+
+    gpt_header_t *backup = (gpt_header_t *)(buf + esp_ext_part_sector_count_to_bytes(entry_sectors, sector_size));
+    memcpy(backup, primary, GPT_HEADER_SIZE);
+    backup->my_lba = primary->alternate_lba;
+    backup->alternate_lba = primary->my_lba;
+    backup->partition_entry_lba = primary->alternate_lba - entry_sectors;
+    backup->header_crc32 = 0;
+    backup->header_crc32 = esp_gpt_crc32(0, backup, GPT_HEADER_SIZE);
+
+    if (out_lba) {
+        *out_lba = backup->partition_entry_lba;
+    }
+    return ESP_OK;
+}
@@ -226,6 +226,10 @@ esp_err_t esp_mbr_generate(mbr_t *mbr,
 
     mbr->boot_signature = MBR_SIGNATURE;
     if (args.keep_signature) {
+        if (part_list->signature.type != ESP_EXT_PART_LIST_SIGNATURE_MBR) {
+            ESP_LOGE(TAG, "Partition list signature is not an MBR disk signature");
+            return ESP_ERR_INVALID_STATE;
+        }
         // Use the disk signature from the partition list
         err = esp_ext_part_list_signature_get(part_list, &mbr->disk_signature);
         if (err != ESP_OK) {
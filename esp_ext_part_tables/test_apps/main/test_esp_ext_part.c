@@ -12,6 +12,7 @@
 #include "esp_err.h"
 #include "esp_ext_part_tables.h"
 #include "esp_mbr.h"
+#include "esp_gpt.h"
 
 #include "unity.h"
 #include "unity_test_runner.h"
@@ -358,6 +359,181 @@ TEST_CASE("Test esp_mbr_partition_set and esp_mbr_remove_gaps_between_partiton_e
     TEST_ESP_OK(esp_ext_part_list_deinit(&part_list_from_mbr_correct));
 }
 
+TEST_CASE("Test esp_gpt_generate with esp_gpt_parse", "[esp_ext_part_table]")
+{
+    const uint64_t disk_sector_count = 64 * 2048; // 64 MiB disk
+    size_t gpt_size = esp_gpt_primary_size(ESP_EXT_PART_SECTOR_SIZE_512B, 0);
+    TEST_ASSERT_EQUAL(34 * 512, gpt_size); // Protective MBR + header + 32 sectors of entries
+
+    uint8_t *gpt = (uint8_t *) calloc(1, gpt_size);
+    TEST_ASSERT_NOT_NULL(gpt);
+
+    esp_ext_part_list_t part_list = {0};
+    esp_ext_part_list_item_t item1 = {
+        .info = {
+            .address = 8, // Should be round up to LBA 2048 (aligned to 1MiB)
+            .size = esp_ext_part_sector_count_to_bytes(8192, ESP_EXT_PART_SECTOR_SIZE_512B),
+            .type = ESP_EXT_PART_TYPE_FAT32,
+            .label = "boot",
+            .flags = ESP_EXT_PART_FLAG_ACTIVE,
+        }
+    };
+    esp_ext_part_list_item_t item2 = {
+        .info = {
+            .address = esp_ext_part_sector_count_to_bytes(16384, ESP_EXT_PART_SECTOR_SIZE_512B),
+            .size = esp_ext_part_sector_count_to_bytes(32768, ESP_EXT_PART_SECTOR_SIZE_512B),
+            .type = ESP_EXT_PART_TYPE_FAT16,
+            .label = "data",
+        }
+    };
+    TEST_ESP_OK(esp_ext_part_list_insert(&part_list, &item1));
+    TEST_ESP_OK(esp_ext_part_list_insert(&part_list, &item2));
+    TEST_ESP_OK(esp_gpt_generate(gpt, gpt_size, disk_sector_count, &part_list, NULL));
+    TEST_ESP_OK(esp_ext_part_list_deinit(&part_list));
+
+    // Protective MBR
+    mbr_t *mbr = (mbr_t *) gpt;
+    TEST_ASSERT_EQUAL(MBR_SIGNATURE, mbr->boot_signature);
+    TEST_ASSERT_EQUAL_HEX8(0xEE, mbr->partition_table[0].type);
+
+    TEST_ESP_OK(esp_gpt_parse(gpt, gpt_size, &part_list, NULL));
+    TEST_ASSERT_EQUAL(ESP_EXT_PART_LIST_SIGNATURE_GPT, part_list.signature.type);
+    gpt_header_t *header = (gpt_header_t *)(gpt + 512);
+    uint8_t disk_guid[GPT_GUID_SIZE];
+    TEST_ESP_OK(esp_ext_part_list_signature_get(&part_list, disk_guid));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(header->disk_guid, disk_guid, GPT_GUID_SIZE);
+
+    esp_ext_part_list_item_t *it = esp_ext_part_list_item_head(&part_list);
+    TEST_ASSERT_NOT_NULL(it);
+    print_esp_ext_part_list_items(it);
+    fflush(stdout);
+    TEST_ASSERT_EQUAL(esp_ext_part_sector_count_to_bytes(2048, ESP_EXT_PART_SECTOR_SIZE_512B), it->info.address);
+    TEST_ASSERT_EQUAL(item1.info.size, it->info.size);
+    TEST_ASSERT_EQUAL(ESP_EXT_PART_TYPE_FAT32, it->info.type);
+    TEST_ASSERT_EQUAL(ESP_EXT_PART_FLAG_ACTIVE, it->info.flags & ESP_EXT_PART_FLAG_ACTIVE);
+    TEST_ASSERT_EQUAL_STRING("boot", it->info.label);
+    it = esp_ext_part_list_item_next(it);
+    TEST_ASSERT_NOT_NULL(it);
+    TEST_ASSERT_EQUAL(item2.info.address, it->info.address);
+    TEST_ASSERT_EQUAL(item2.info.size, it->info.size);
+    TEST_ASSERT_EQUAL(ESP_EXT_PART_TYPE_FAT32, it->info.type); // FAT variants share the basic data GUID
+    TEST_ASSERT_EQUAL_STRING("data", it->info.label);
+    TEST_ASSERT_NULL(esp_ext_part_list_item_next(it));
+
+    // Regenerating with `keep_signature` preserves the disk GUID
+    esp_gpt_generate_extra_args_t gpt_args = {
+        .keep_signature = true,
+    };
+    TEST_ESP_OK(esp_gpt_generate(gpt, gpt_size, disk_sector_count, &part_list, &gpt_args));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(disk_guid, header->disk_guid, GPT_GUID_SIZE);
+    TEST_ESP_OK(esp_ext_part_list_deinit(&part_list));
+
+    // Backup GPT at the end of the disk
+    size_t backup_size = gpt_size - 512;
+    uint8_t *backup = (uint8_t *) calloc(1, backup_size);
+    TEST_ASSERT_NOT_NULL(backup);
+    uint64_t backup_lba = 0;
+    TEST_ESP_OK(esp_gpt_generate_backup(gpt, gpt_size, backup, backup_size, ESP_EXT_PART_SECTOR_SIZE_512B, &backup_lba));
+    TEST_ASSERT_EQUAL(disk_sector_count - 33, backup_lba);
+    gpt_header_t *backup_header = (gpt_header_t *)(backup + backup_size - 512);
+    TEST_ASSERT_EQUAL(disk_sector_count - 1, backup_header->my_lba);
+    TEST_ASSERT_EQUAL(1, backup_header->alternate_lba);
+    TEST_ASSERT_EQUAL(backup_lba, backup_header->partition_entry_lba);
+    TEST_ASSERT_EQUAL(header->partition_entry_array_crc32, backup_header->partition_entry_array_crc32);
+    free(backup);
+
+    // Corrupted partition entry array
+    gpt[2 * 512 + 32] ^= 0xFF;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_CRC, esp_gpt_parse(gpt, gpt_size, &part_list, NULL));
+    gpt[2 * 512 + 32] ^= 0xFF;
+    // Corrupted header
+    header->last_usable_lba++;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_CRC, esp_gpt_parse(gpt, gpt_size, &part_list, NULL));
+    header->last_usable_lba--;
+    // Truncated buffer
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_gpt_parse(gpt, 2 * 512, &part_list, NULL));
+    // Header size past the end of the buffer
+    header->header_size = 512;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_gpt_parse(gpt, 512 + 256, &part_list, NULL));
+    header->header_size = GPT_HEADER_SIZE;
+    // Partition entry array at an LBA whose byte offset overflows
+    uint64_t entry_lba = header->partition_entry_lba;
+    header->partition_entry_lba = UINT64_MAX / 256;
+    header->header_crc32 = 0;
+    header->header_crc32 = esp_gpt_crc32(0, header, GPT_HEADER_SIZE);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_gpt_parse(gpt, gpt_size, &part_list, NULL));
+    header->partition_entry_lba = entry_lba;
+    header->header_crc32 = 0;
+    header->header_crc32 = esp_gpt_crc32(0, header, GPT_HEADER_SIZE);
+    TEST_ESP_OK(esp_gpt_parse(gpt, gpt_size, &part_list, NULL));
+    TEST_ESP_OK(esp_ext_part_list_deinit(&part_list));
+    // Not a GPT
+    header->signature = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_gpt_parse(gpt, gpt_size, &part_list, NULL));
+
+    // Partitions overlapping once aligned to 1MiB
+    item1.info.address = esp_ext_part_sector_count_to_bytes(2048, ESP_EXT_PART_SECTOR_SIZE_512B);
+    item2.info.address = esp_ext_part_sector_count_to_bytes(3000, ESP_EXT_PART_SECTOR_SIZE_512B); // Aligned up to LBA 4096
+    TEST_ESP_OK(esp_ext_part_list_insert(&part_list, &item1));
+    TEST_ESP_OK(esp_ext_part_list_insert(&part_list, &item2));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_gpt_generate(gpt, gpt_size, disk_sector_count, &part_list, NULL));
+    TEST_ESP_OK(esp_ext_part_list_deinit(&part_list));
+    free(gpt);
+}
+
+TEST_CASE("Test esp_ext_part_index_build and esp_ext_part_index_find", "[esp_ext_part_table]")
+{
+    esp_ext_part_list_t part_list = {
+        .sector_size = ESP_EXT_PART_SECTOR_SIZE_512B,
+    };
+    // Inserted out of order on purpose, the index is sorted by start LBA
+    const uint64_t ranges[][2] = { {10000, 500}, {2048, 4096}, {20000, 1}, {6144, 100} }; // {start LBA, sector count}
+    for (int i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        esp_ext_part_list_item_t item = {
+            .info = {
+                .address = esp_ext_part_sector_count_to_bytes(ranges[i][0], ESP_EXT_PART_SECTOR_SIZE_512B),
+                .size = esp_ext_part_sector_count_to_bytes(ranges[i][1], ESP_EXT_PART_SECTOR_SIZE_512B),
+                .type = ESP_EXT_PART_TYPE_FAT32,
+            }
+        };
+        TEST_ESP_OK(esp_ext_part_list_insert(&part_list, &item));
+    }
+
+    esp_ext_part_index_t index;
+    TEST_ESP_OK(esp_ext_part_index_build(&index, &part_list));
+    TEST_ASSERT_EQUAL(4, index.count);
+
+    TEST_ASSERT_NULL(esp_ext_part_index_find(&index, 0));
+    TEST_ASSERT_NULL(esp_ext_part_index_find(&index, 2047));
+    esp_ext_part_list_item_t *item = esp_ext_part_index_find(&index, 2048);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL(esp_ext_part_sector_count_to_bytes(2048, ESP_EXT_PART_SECTOR_SIZE_512B), item->info.address);
+    TEST_ASSERT_EQUAL_PTR(item, esp_ext_part_index_find(&index, 6143));
+    item = esp_ext_part_index_find(&index, 6144);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL(esp_ext_part_sector_count_to_bytes(6144, ESP_EXT_PART_SECTOR_SIZE_512B), item->info.address);
+    TEST_ASSERT_NULL(esp_ext_part_index_find(&index, 6244));
+    TEST_ASSERT_NOT_NULL(esp_ext_part_index_find(&index, 10499));
+    TEST_ASSERT_NULL(esp_ext_part_index_find(&index, 10500));
+    TEST_ASSERT_NOT_NULL(esp_ext_part_index_find(&index, 20000));
+    TEST_ASSERT_NULL(esp_ext_part_index_find(&index, 20001));
+    TEST_ESP_OK(esp_ext_part_index_deinit(&index));
+
+    // Overlapping partitions cannot be indexed
+    esp_ext_part_list_item_t overlapping = {
+        .info = {
+            .address = esp_ext_part_sector_count_to_bytes(6000, ESP_EXT_PART_SECTOR_SIZE_512B),
+            .size = esp_ext_part_sector_count_to_bytes(200, ESP_EXT_PART_SECTOR_SIZE_512B),
+            .type = ESP_EXT_PART_TYPE_FAT32,
+        }
+    };
+    TEST_ESP_OK(esp_ext_part_list_insert(&part_list, &overlapping));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_ext_part_index_build(&index, &part_list));
+    TEST_ASSERT_NULL(index.entries);
+
+    TEST_ESP_OK(esp_ext_part_list_deinit(&part_list));
+}
+
 void app_main(void)
 {
     printf("Running esp_ext_part_tables component tests\n");
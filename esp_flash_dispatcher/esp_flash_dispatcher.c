@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -12,8 +13,10 @@
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 #include "esp_flash_spi_init.h"
+#include "spi_flash_mmap.h"
 #include "esp_private/startup_internal.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 #include "esp_flash_dispatcher.h"
 
 static const char *TAG = "flash_dispatcher";
@@ -31,8 +34,19 @@ typedef enum {
     FLASH_OP_WRITE_ENCRYPTED,
     FLASH_OP_ERASE_REGION,
     FLASH_OP_ERASE_CHIP,
+    FLASH_OP_STOP,              // Stop the dispatcher task, queued by esp_flash_dispatcher_deinit()
 } flash_operation_t;
 
+/**
+ * Completion of a synchronous request. Kept in internal RAM and reused, since the
+ * stack of the waiting task may be in PSRAM.
+ */
+typedef struct flash_dispatcher_waiter {
+    SemaphoreHandle_t done;                 // Given by the dispatcher task once the request is complete
+    esp_err_t result;                       // Result of the request
+    struct flash_dispatcher_waiter *next;   // Next free waiter
+} flash_dispatcher_waiter_t;
+
 // Structure to hold flash operation requests
 typedef struct {
     esp_flash_t *chip;
@@ -58,65 +72,453 @@ typedef struct {
             size_t size;
         } erase_region;                 // for FLASH_OP_ERASE_REGION
     } args;
+    esp_flash_dispatcher_done_cb_t done_cb; // Completion callback of an asynchronous request
+    void *user_ctx;                  // Argument of done_cb
+    flash_dispatcher_waiter_t *waiter; // Completion of a synchronous request, NULL for asynchronous ones
+    uint32_t progress;               // Bytes already written/erased by the previous slices
+    int64_t submit_time;             // esp_timer time the request was queued at, for the latency statistics
 } flash_operation_request_t;
 
 typedef struct {
     QueueHandle_t queue;
     TaskHandle_t task;
     bool dispatcher_initialized;
-    QueueHandle_t result_queue;
+    uint32_t erase_slice_size;
+    uint32_t write_slice_size;
+    flash_operation_request_t *pending; // Requests taken from the queue in submission order, only touched by the dispatcher task
+    size_t pending_size;
+    size_t pending_count;
+    uint32_t read_burst;                // Reads served since the last write/erase slice
+    uint8_t *merge_buf;                 // Bounce buffer for merged reads/writes, NULL if merging is disabled
+    uint32_t merge_buf_size;
+    esp_flash_dispatcher_stats_t stats; // Protected by s_stats_lock
 } flash_dispatcher_context_t;
 
+// Flash program page size, write slices keep the alignment needed by encrypted writes
+#define FLASH_DISPATCHER_PAGE_SIZE      256
+
+// Max number of reads served while a write/erase is waiting, so that a stream of reads can't starve it
+#define FLASH_DISPATCHER_MAX_READ_BURST 8
+
+// Max number of requests served by one merged read/write
+#define FLASH_DISPATCHER_MAX_MERGE      8
+
 // Configuration struct is declared in public header
 
 static flash_dispatcher_context_t s_flash_dispatcher_ctx;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static flash_dispatcher_waiter_t *s_free_waiters;
+static portMUX_TYPE s_waiters_lock = portMUX_INITIALIZER_UNLOCKED;
 
-static void flash_dispatcher_task(void *arg)
+/**
+ * Execute the next slice of a request. Writes and erases are split into slices of
+ * write_slice_size/erase_slice_size bytes, so that pending reads can be served in between.
+ * Returns true once the request is complete or has failed.
+ */
+static bool flash_dispatcher_run_slice(flash_operation_request_t *request, esp_err_t *result)
+{
+    uint32_t remaining;
+    uint32_t slice;
+    uint32_t address;
+
+    // Execute the actual flash operation based on the operation type and arguments
+    switch (request->op) {
+    case FLASH_OP_READ:
+        *result = __real_esp_flash_read(request->chip,
+                                        request->args.read.buffer,
+                                        request->args.read.address,
+                                        request->args.read.size);
+        return true;
+    case FLASH_OP_WRITE:
+        remaining = request->args.write.size - request->progress;
+        slice = s_flash_dispatcher_ctx.write_slice_size;
+        slice = (slice && slice < remaining) ? slice : remaining;
+        *result = __real_esp_flash_write(request->chip,
+                                         (const uint8_t *)request->args.write.buffer + request->progress,
+                                         request->args.write.address + request->progress,
+                                         slice);
+        break;
+    case FLASH_OP_WRITE_ENCRYPTED:
+        remaining = request->args.write_encrypted.size - request->progress;
+        slice = s_flash_dispatcher_ctx.write_slice_size;
+        slice = (slice && slice < remaining) ? slice : remaining;
+        *result = __real_esp_flash_write_encrypted(request->chip,
+                  request->args.write_encrypted.address + request->progress,
+                  (const uint8_t *)request->args.write_encrypted.buffer + request->progress,
+                  slice);
+        break;
+    case FLASH_OP_ERASE_REGION:
+        remaining = request->args.erase_region.size - request->progress;
+        address = request->args.erase_region.start_address + request->progress;
+        slice = remaining;
+        if (s_flash_dispatcher_ctx.erase_slice_size) {
+            // End the slice on an erase_slice_size boundary, so aligned slices are erased with block commands
+            uint32_t to_boundary = s_flash_dispatcher_ctx.erase_slice_size - (address % s_flash_dispatcher_ctx.erase_slice_size);
+            slice = to_boundary < remaining ? to_boundary : remaining;
+        }
+        *result = __real_esp_flash_erase_region(request->chip, address, slice);
+        break;
+    case FLASH_OP_ERASE_CHIP:
+        *result = __real_esp_flash_erase_chip(request->chip);
+        return true;
+    default:
+        ESP_EARLY_LOGE(TAG, "Unsupported flash operation type: %d", (int)request->op);
+        *result = ESP_FAIL;
+        return true;
+    }
+    request->progress += slice;
+    return *result != ESP_OK || slice == remaining;
+}
+
+static esp_err_t flash_dispatcher_run(flash_operation_request_t *request)
 {
-    flash_operation_request_t request;
     esp_err_t result;
+    while (!flash_dispatcher_run_slice(request, &result)) {
+    }
+    return result;
+}
 
-    while (true) {
-        if (xQueueReceive(s_flash_dispatcher_ctx.queue, &request, portMAX_DELAY) == pdTRUE) {
-            // Execute the actual flash operation based on the operation type and arguments
-            switch (request.op) {
-            case FLASH_OP_READ:
-                result = __real_esp_flash_read(request.chip,
-                                               request.args.read.buffer,
-                                               request.args.read.address,
-                                               request.args.read.size);
-                break;
-            case FLASH_OP_WRITE:
-                result = __real_esp_flash_write(request.chip,
-                                                request.args.write.buffer,
-                                                request.args.write.address,
-                                                request.args.write.size);
-                break;
-            case FLASH_OP_WRITE_ENCRYPTED:
-                result = __real_esp_flash_write_encrypted(request.chip,
-                         request.args.write_encrypted.address,
-                         request.args.write_encrypted.buffer,
-                         request.args.write_encrypted.size);
-                break;
-            case FLASH_OP_ERASE_REGION:
-                result = __real_esp_flash_erase_region(request.chip,
-                                                       request.args.erase_region.start_address,
-                                                       request.args.erase_region.size);
-                break;
-            case FLASH_OP_ERASE_CHIP:
-                result = __real_esp_flash_erase_chip(request.chip);
-                break;
-            default:
-                ESP_EARLY_LOGE(TAG, "Unsupported flash operation type: %d", (int)request.op);
-                result = ESP_FAIL;
-                break;
+// Check whether a read has to wait for a write/erase submitted before it
+static bool flash_dispatcher_conflicts(const flash_operation_request_t *read, const flash_operation_request_t *other)
+{
+    uint32_t start;
+    uint32_t size;
+
+    if (other->chip != read->chip) {
+        return false;
+    }
+    switch (other->op) {
+    case FLASH_OP_WRITE:
+        start = other->args.write.address;
+        size = other->args.write.size;
+        break;
+    case FLASH_OP_WRITE_ENCRYPTED:
+        start = other->args.write_encrypted.address;
+        size = other->args.write_encrypted.size;
+        break;
+    case FLASH_OP_ERASE_REGION:
+        start = other->args.erase_region.start_address;
+        size = other->args.erase_region.size;
+        break;
+    case FLASH_OP_ERASE_CHIP:
+        return true;
+    default:
+        return false;
+    }
+    return read->args.read.address < start + size && start < read->args.read.address + read->args.read.size;
+}
+
+/**
+ * Select the pending request to make progress on. Reads are latency sensitive and go
+ * first, unless they overlap a write/erase submitted before them. Writes and erases
+ * are executed in submission order.
+ */
+static bool flash_dispatcher_read_blocked(size_t index)
+{
+    const flash_operation_request_t *pending = s_flash_dispatcher_ctx.pending;
+    for (size_t j = 0; j < index; j++) {
+        if (pending[j].op != FLASH_OP_READ && flash_dispatcher_conflicts(&pending[index], &pending[j])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t flash_dispatcher_pick(void)
+{
+    const flash_operation_request_t *pending = s_flash_dispatcher_ctx.pending;
+    size_t first_normal = SIZE_MAX;
+
+    for (size_t i = 0; i < s_flash_dispatcher_ctx.pending_count; i++) {
+        if (pending[i].op != FLASH_OP_READ) {
+            if (first_normal == SIZE_MAX) {
+                first_normal = i;
+                if (s_flash_dispatcher_ctx.read_burst >= FLASH_DISPATCHER_MAX_READ_BURST) {
+                    break;
+                }
+            }
+            continue;
+        }
+        if (first_normal == SIZE_MAX || !flash_dispatcher_read_blocked(i)) {
+            return i;
+        }
+    }
+    return first_normal;
+}
+
+/**
+ * Collect the pending reads that can be served by one read together with pending[first]:
+ * same chip, contiguous addresses, not blocked by a write/erase and fitting the merge buffer.
+ */
+static size_t flash_dispatcher_collect_reads(size_t first, size_t *group)
+{
+    const flash_operation_request_t *pending = s_flash_dispatcher_ctx.pending;
+    uint32_t start = pending[first].args.read.address;
+    uint32_t end = start + pending[first].args.read.size;
+    size_t count = 1;
+    bool extended = true;
+
+    group[0] = first;
+    while (extended && count < FLASH_DISPATCHER_MAX_MERGE) {
+        extended = false;
+        for (size_t i = 0; i < s_flash_dispatcher_ctx.pending_count && !extended; i++) {
+            const flash_operation_request_t *request = &pending[i];
+            if (request->op != FLASH_OP_READ || request->chip != pending[first].chip ||
+                    end - start + request->args.read.size > s_flash_dispatcher_ctx.merge_buf_size) {
+                continue;
+            }
+            uint32_t address = request->args.read.address;
+            if (address != end && address + request->args.read.size != start) {
+                continue;
+            }
+            bool in_group = false;
+            for (size_t k = 0; k < count && !in_group; k++) {
+                in_group = group[k] == i;
+            }
+            if (in_group || flash_dispatcher_read_blocked(i)) {
+                continue;
+            }
+            group[count++] = i;
+            if (address == end) {
+                end += request->args.read.size;
+            } else {
+                start = address;
+            }
+            extended = true;
+        }
+    }
+    return count;
+}
+
+/**
+ * Collect the writes that directly follow pending[first] in submission order and continue
+ * where the previous one ends, so they can be programmed with one write from the merge buffer.
+ * A merged write is not longer than a write slice, so it doesn't hold the flash longer than a
+ * single write would.
+ */
+static size_t flash_dispatcher_collect_writes(size_t first, size_t *group)
+{
+    const flash_operation_request_t *pending = s_flash_dispatcher_ctx.pending;
+    uint32_t start = pending[first].args.write.address;
+    uint32_t end = start + pending[first].args.write.size;
+    uint32_t max_size = s_flash_dispatcher_ctx.merge_buf_size;
+    size_t count = 1;
+
+    if (s_flash_dispatcher_ctx.write_slice_size && s_flash_dispatcher_ctx.write_slice_size < max_size) {
+        max_size = s_flash_dispatcher_ctx.write_slice_size;
+    }
+    group[0] = first;
+    if (pending[first].progress != 0 || pending[first].args.write.size > max_size) {
+        return count;
+    }
+    for (size_t i = first + 1; i < s_flash_dispatcher_ctx.pending_count && count < FLASH_DISPATCHER_MAX_MERGE; i++) {
+        const flash_operation_request_t *request = &pending[i];
+        if (request->op != FLASH_OP_WRITE || request->chip != pending[first].chip || request->args.write.address != end ||
+                end - start + request->args.write.size > max_size) {
+            break;
+        }
+        group[count++] = i;
+        end += request->args.write.size;
+    }
+    return count;
+}
+
+static void flash_dispatcher_complete(const flash_operation_request_t *request, esp_err_t result)
+{
+    if (request->waiter) {
+        request->waiter->result = result;
+        xSemaphoreGive(request->waiter->done);
+    } else if (request->done_cb) {
+        request->done_cb(result, request->user_ctx);
+    }
+}
+
+static void flash_dispatcher_update_stats(const flash_operation_request_t *request)
+{
+    esp_flash_dispatcher_op_t op;
+    switch (request->op) {
+    case FLASH_OP_READ:
+        op = ESP_FLASH_DISPATCHER_OP_READ;
+        break;
+    case FLASH_OP_WRITE:
+    case FLASH_OP_WRITE_ENCRYPTED:
+        op = ESP_FLASH_DISPATCHER_OP_WRITE;
+        break;
+    default:
+        op = ESP_FLASH_DISPATCHER_OP_ERASE;
+        break;
+    }
+    int64_t latency = esp_timer_get_time() - request->submit_time;
+    int64_t bucket_limit = 100;
+    size_t bucket = 0;
+    while (bucket < ESP_FLASH_DISPATCHER_LATENCY_BUCKETS - 1 && latency >= bucket_limit) {
+        bucket_limit *= 10;
+        bucket++;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    s_flash_dispatcher_ctx.stats.completed[op]++;
+    s_flash_dispatcher_ctx.stats.latency_hist[op][bucket]++;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+// Complete pending[index] and remove it from the pending requests
+static void flash_dispatcher_finish(size_t index, esp_err_t result)
+{
+    flash_dispatcher_context_t *ctx = &s_flash_dispatcher_ctx;
+    flash_dispatcher_update_stats(&ctx->pending[index]);
+    flash_dispatcher_complete(&ctx->pending[index], result);
+    ctx->pending_count--;
+    memmove(&ctx->pending[index], &ctx->pending[index + 1], (ctx->pending_count - index) * sizeof(flash_operation_request_t));
+}
+
+// Complete a group of merged requests, the highest indexes are removed first so the others stay valid
+static void flash_dispatcher_finish_group(size_t *group, size_t count, esp_err_t result)
+{
+    for (size_t i = 1; i < count; i++) {
+        for (size_t k = i; k > 0 && group[k - 1] < group[k]; k--) {
+            size_t tmp = group[k];
+            group[k] = group[k - 1];
+            group[k - 1] = tmp;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        flash_dispatcher_finish(group[i], result);
+    }
+}
+
+/**
+ * Serve pending[index] together with the requests it can be merged with.
+ * Returns false if there is nothing to merge, the request is then executed on its own.
+ */
+static bool flash_dispatcher_run_merged(size_t index)
+{
+    flash_dispatcher_context_t *ctx = &s_flash_dispatcher_ctx;
+    flash_operation_request_t *pending = ctx->pending;
+    size_t group[FLASH_DISPATCHER_MAX_MERGE];
+    size_t count;
+    esp_err_t result;
+
+    if (pending[index].op == FLASH_OP_READ) {
+        count = flash_dispatcher_collect_reads(index, group);
+        if (count == 1) {
+            return false;
+        }
+        uint32_t start = UINT32_MAX;
+        uint32_t end = 0;
+        for (size_t i = 0; i < count; i++) {
+            const flash_operation_request_t *request = &pending[group[i]];
+            start = request->args.read.address < start ? request->args.read.address : start;
+            end = request->args.read.address + request->args.read.size > end ? request->args.read.address + request->args.read.size : end;
+        }
+        result = __real_esp_flash_read(pending[index].chip, ctx->merge_buf, start, end - start);
+        if (result == ESP_OK) {
+            for (size_t i = 0; i < count; i++) {
+                const flash_operation_request_t *request = &pending[group[i]];
+                memcpy(request->args.read.buffer, ctx->merge_buf + (request->args.read.address - start), request->args.read.size);
             }
-            // Publish result and signal completion to the waiting caller
-            if (xQueueSend(s_flash_dispatcher_ctx.result_queue, &result, portMAX_DELAY) != pdTRUE) {
-                ESP_EARLY_LOGE(TAG, "Failed to send result to queue");
+        }
+        portENTER_CRITICAL(&s_stats_lock);
+        ctx->stats.merged_reads += count - 1;
+        portEXIT_CRITICAL(&s_stats_lock);
+    } else if (pending[index].op == FLASH_OP_WRITE) {
+        count = flash_dispatcher_collect_writes(index, group);
+        if (count == 1) {
+            return false;
+        }
+        size_t size = 0;
+        for (size_t i = 0; i < count; i++) {
+            const flash_operation_request_t *request = &pending[group[i]];
+            memcpy(ctx->merge_buf + size, request->args.write.buffer, request->args.write.size);
+            size += request->args.write.size;
+        }
+        result = __real_esp_flash_write(pending[index].chip, ctx->merge_buf, pending[index].args.write.address, size);
+        portENTER_CRITICAL(&s_stats_lock);
+        ctx->stats.merged_writes += count - 1;
+        portEXIT_CRITICAL(&s_stats_lock);
+    } else {
+        return false;
+    }
+    flash_dispatcher_finish_group(group, count, result);
+    return true;
+}
+
+static void flash_dispatcher_task(void *arg)
+{
+    flash_dispatcher_context_t *ctx = &s_flash_dispatcher_ctx;
+
+    while (true) {
+        // Take whatever is queued, blocking only when there is nothing left to do
+        TickType_t wait = ctx->pending_count ? 0 : portMAX_DELAY;
+        while (ctx->pending_count < ctx->pending_size &&
+                xQueueReceive(ctx->queue, &ctx->pending[ctx->pending_count], wait) == pdTRUE) {
+            flash_operation_request_t *request = &ctx->pending[ctx->pending_count++];
+            if (request->chip == NULL) {
+                request->chip = esp_flash_default_chip;
             }
+            wait = 0;
+        }
+        if (ctx->pending_count == 0) {
+            continue;
+        }
+        uint32_t depth = ctx->pending_count + uxQueueMessagesWaiting(ctx->queue);
+        if (depth > ctx->stats.queue_depth_max) {
+            portENTER_CRITICAL(&s_stats_lock);
+            ctx->stats.queue_depth_max = depth;
+            portEXIT_CRITICAL(&s_stats_lock);
         }
+
+        size_t index = flash_dispatcher_pick();
+        if (ctx->pending[index].op == FLASH_OP_STOP) {
+            // All the requests submitted before are complete, wait to be deleted
+            flash_dispatcher_complete(&ctx->pending[index], ESP_OK);
+            vTaskSuspend(NULL);
+        }
+        if (ctx->pending[index].op == FLASH_OP_READ) {
+            ctx->read_burst++;
+        } else {
+            ctx->read_burst = 0;
+        }
+        if (ctx->merge_buf && flash_dispatcher_run_merged(index)) {
+            continue;
+        }
+        esp_err_t result;
+        if (flash_dispatcher_run_slice(&ctx->pending[index], &result)) {
+            flash_dispatcher_finish(index, result);
+        }
+    }
+}
+
+// Take a free waiter, or allocate a new one. Waiters are kept for reuse until deinit, there are as many as concurrent callers.
+static flash_dispatcher_waiter_t *flash_dispatcher_get_waiter(void)
+{
+    portENTER_CRITICAL(&s_waiters_lock);
+    flash_dispatcher_waiter_t *waiter = s_free_waiters;
+    if (waiter) {
+        s_free_waiters = waiter->next;
+    }
+    portEXIT_CRITICAL(&s_waiters_lock);
+    if (waiter) {
+        return waiter;
+    }
+
+    waiter = heap_caps_calloc(1, sizeof(flash_dispatcher_waiter_t), MALLOC_CAP_INTERNAL);
+    if (waiter == NULL) {
+        return NULL;
+    }
+    waiter->done = xSemaphoreCreateBinaryWithCaps(MALLOC_CAP_INTERNAL);
+    if (waiter->done == NULL) {
+        heap_caps_free(waiter);
+        return NULL;
     }
+    return waiter;
+}
+
+static void flash_dispatcher_put_waiter(flash_dispatcher_waiter_t *waiter)
+{
+    portENTER_CRITICAL(&s_waiters_lock);
+    waiter->next = s_free_waiters;
+    s_free_waiters = waiter;
+    portEXIT_CRITICAL(&s_waiters_lock);
 }
 
 esp_err_t esp_flash_dispatcher_init(const esp_flash_dispatcher_config_t *cfg)
@@ -126,15 +528,35 @@ esp_err_t esp_flash_dispatcher_init(const esp_flash_dispatcher_config_t *cfg)
         return ESP_ERR_INVALID_STATE;
     }
 
+    ESP_RETURN_ON_FALSE(cfg->erase_slice_size % SPI_FLASH_SEC_SIZE == 0, ESP_ERR_INVALID_ARG, TAG, "erase slice size must be a multiple of the sector size");
+    ESP_RETURN_ON_FALSE(cfg->write_slice_size % FLASH_DISPATCHER_PAGE_SIZE == 0, ESP_ERR_INVALID_ARG, TAG, "write slice size must be a multiple of the page size");
+
     s_flash_dispatcher_ctx.queue = xQueueCreateWithCaps(cfg->queue_size, sizeof(flash_operation_request_t), MALLOC_CAP_INTERNAL);
     ESP_RETURN_ON_FALSE(s_flash_dispatcher_ctx.queue, ESP_ERR_NO_MEM, TAG, "create flash operation queue failed");
 
-    s_flash_dispatcher_ctx.result_queue = xQueueCreateWithCaps(cfg->queue_size, sizeof(esp_err_t), MALLOC_CAP_INTERNAL);
-    if (s_flash_dispatcher_ctx.result_queue == NULL) {
+    s_flash_dispatcher_ctx.pending = heap_caps_calloc(cfg->queue_size, sizeof(flash_operation_request_t), MALLOC_CAP_INTERNAL);
+    if (s_flash_dispatcher_ctx.pending == NULL) {
         vQueueDeleteWithCaps(s_flash_dispatcher_ctx.queue);
-        ESP_EARLY_LOGE(TAG, "Failed to create completion semaphore");
+        s_flash_dispatcher_ctx.queue = NULL;
+        ESP_EARLY_LOGE(TAG, "Failed to allocate pending requests");
         return ESP_ERR_NO_MEM;
     }
+    s_flash_dispatcher_ctx.pending_size = cfg->queue_size;
+
+    if (cfg->merge_buf_size) {
+        s_flash_dispatcher_ctx.merge_buf = heap_caps_malloc(cfg->merge_buf_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (s_flash_dispatcher_ctx.merge_buf == NULL) {
+            vQueueDeleteWithCaps(s_flash_dispatcher_ctx.queue);
+            s_flash_dispatcher_ctx.queue = NULL;
+            heap_caps_free(s_flash_dispatcher_ctx.pending);
+            s_flash_dispatcher_ctx.pending = NULL;
+            ESP_EARLY_LOGE(TAG, "Failed to allocate merge buffer");
+            return ESP_ERR_NO_MEM;
+        }
+        s_flash_dispatcher_ctx.merge_buf_size = cfg->merge_buf_size;
+    }
+    s_flash_dispatcher_ctx.erase_slice_size = cfg->erase_slice_size;
+    s_flash_dispatcher_ctx.write_slice_size = cfg->write_slice_size;
 
     BaseType_t rc = xTaskCreatePinnedToCoreWithCaps(flash_dispatcher_task,
                     "flash_dispatcher",
@@ -149,8 +571,10 @@ esp_err_t esp_flash_dispatcher_init(const esp_flash_dispatcher_config_t *cfg)
         // Cleanup resources if task creation failed
         vQueueDeleteWithCaps(s_flash_dispatcher_ctx.queue);
         s_flash_dispatcher_ctx.queue = NULL;
-        vQueueDeleteWithCaps(s_flash_dispatcher_ctx.result_queue);
-        s_flash_dispatcher_ctx.result_queue = NULL;
+        heap_caps_free(s_flash_dispatcher_ctx.pending);
+        s_flash_dispatcher_ctx.pending = NULL;
+        heap_caps_free(s_flash_dispatcher_ctx.merge_buf);
+        s_flash_dispatcher_ctx.merge_buf = NULL;
         ESP_EARLY_LOGE(TAG, "create flash dispatcher task failed");
         return ESP_ERR_INVALID_STATE;
     }
@@ -160,107 +584,219 @@ esp_err_t esp_flash_dispatcher_init(const esp_flash_dispatcher_config_t *cfg)
     return ESP_OK;
 }
 
+esp_err_t esp_flash_dispatcher_deinit(void)
+{
+    flash_dispatcher_context_t *ctx = &s_flash_dispatcher_ctx;
+
+    ESP_RETURN_ON_FALSE(ctx->dispatcher_initialized, ESP_ERR_INVALID_STATE, TAG, "flash dispatcher is not initialized");
+    ESP_RETURN_ON_FALSE(xTaskGetCurrentTaskHandle() != ctx->task, ESP_ERR_INVALID_STATE, TAG, "can't deinit from a completion callback");
+
+    flash_dispatcher_waiter_t *waiter = flash_dispatcher_get_waiter();
+    ESP_RETURN_ON_FALSE(waiter, ESP_ERR_NO_MEM, TAG, "no memory to wait for the dispatcher task");
+
+    // The stop request is served after all the requests already queued
+    ctx->dispatcher_initialized = false;
+    flash_operation_request_t request = {
+        .op = FLASH_OP_STOP,
+        .waiter = waiter,
+    };
+    xQueueSend(ctx->queue, &request, portMAX_DELAY);
+    xSemaphoreTake(waiter->done, portMAX_DELAY);
+    flash_dispatcher_put_waiter(waiter);
+    while (eTaskGetState(ctx->task) != eSuspended) {
+        vTaskDelay(1);
+    }
+
+    vTaskDeleteWithCaps(ctx->task);
+    vQueueDeleteWithCaps(ctx->queue);
+    heap_caps_free(ctx->pending);
+    heap_caps_free(ctx->merge_buf);
+    memset(ctx, 0, sizeof(*ctx));
+
+    while (s_free_waiters) {
+        waiter = s_free_waiters;
+        s_free_waiters = waiter->next;
+        vSemaphoreDeleteWithCaps(waiter->done);
+        heap_caps_free(waiter);
+    }
+    return ESP_OK;
+}
+
 /**
- * Send a flash operation request to the dispatcher queue and wait for the result.
- * The meaning and order of arg1/arg2/arg3 must match what the dispatcher task expects
- * for the given operation type. This helper centralizes the common send/wait logic.
+ * Queue a flash operation request for the dispatcher task.
+ * A request submitted from the dispatcher task itself (i.e. from a completion callback)
+ * must not block on the queue the same task is supposed to drain.
  */
-static esp_err_t flash_dispatcher_execute(flash_operation_t op,
-        esp_flash_t *chip,
-        void *arg1,
-        void *arg2,
-        void *arg3,
-        const char *op_name)
+static esp_err_t flash_dispatcher_enqueue(flash_operation_request_t *request, const char *op_name)
 {
     ESP_RETURN_ON_FALSE(s_flash_dispatcher_ctx.dispatcher_initialized, ESP_ERR_INVALID_STATE, TAG, "flash dispatcher is not initialized");
 
-    esp_err_t operation_result = ESP_FAIL;
-    flash_operation_request_t request = { 0 };
-    request.chip = chip;
-    request.op = op;
-    switch (op) {
-    case FLASH_OP_READ:
-        request.args.read.buffer = arg1;
-        request.args.read.address = (uint32_t)(uintptr_t)arg2;
-        request.args.read.size = (size_t)(uintptr_t)arg3;
-        break;
-    case FLASH_OP_WRITE:
-        request.args.write.buffer = arg1;
-        request.args.write.address = (uint32_t)(uintptr_t)arg2;
-        request.args.write.size = (size_t)(uintptr_t)arg3;
-        break;
-    case FLASH_OP_WRITE_ENCRYPTED:
-        request.args.write_encrypted.address = (uint32_t)(uintptr_t)arg1;
-        request.args.write_encrypted.buffer = arg2;
-        request.args.write_encrypted.size = (size_t)(uintptr_t)arg3;
-        break;
-    case FLASH_OP_ERASE_REGION:
-        request.args.erase_region.start_address = (uint32_t)(uintptr_t)arg1;
-        request.args.erase_region.size = (size_t)(uintptr_t)arg2;
-        break;
-    case FLASH_OP_ERASE_CHIP:
-    default:
-        break;
-    }
-
-    if (xQueueSend(s_flash_dispatcher_ctx.queue, &request, portMAX_DELAY) != pdTRUE) {
+    request->submit_time = esp_timer_get_time();
+    TickType_t timeout = xTaskGetCurrentTaskHandle() == s_flash_dispatcher_ctx.task ? 0 : portMAX_DELAY;
+    if (xQueueSend(s_flash_dispatcher_ctx.queue, request, timeout) != pdTRUE) {
         ESP_EARLY_LOGE(TAG, "Failed to send %s request to queue", op_name ? op_name : "flash");
         return ESP_ERR_TIMEOUT;
     }
+    return ESP_OK;
+}
 
-    if (xQueueReceive(s_flash_dispatcher_ctx.result_queue, &operation_result, portMAX_DELAY) != pdTRUE) {
-        ESP_EARLY_LOGE(TAG, "Failed to receive %s result from queue", op_name ? op_name : "flash");
-        return ESP_ERR_TIMEOUT;
+/**
+ * Send a flash operation request to the dispatcher queue and wait for its own result.
+ * Every caller waits on a binary semaphore of its own, so any number of tasks can have
+ * requests in flight at the same time, and the task notifications of the callers are left alone.
+ */
+static esp_err_t flash_dispatcher_execute(flash_operation_request_t *request, const char *op_name)
+{
+    ESP_RETURN_ON_FALSE(s_flash_dispatcher_ctx.dispatcher_initialized, ESP_ERR_INVALID_STATE, TAG, "flash dispatcher is not initialized");
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if (self == s_flash_dispatcher_ctx.task) {
+        // Called from a completion callback, the stack is already in internal RAM
+        return flash_dispatcher_run(request);
+    }
+
+    flash_dispatcher_waiter_t *waiter = flash_dispatcher_get_waiter();
+    ESP_RETURN_ON_FALSE(waiter, ESP_ERR_NO_MEM, TAG, "no memory to wait for %s", op_name ? op_name : "flash");
+
+    request->waiter = waiter;
+    esp_err_t ret = flash_dispatcher_enqueue(request, op_name);
+    if (ret == ESP_OK) {
+        xSemaphoreTake(waiter->done, portMAX_DELAY);
+        ret = waiter->result;
     }
-    return operation_result;
+    flash_dispatcher_put_waiter(waiter);
+    return ret;
 }
 
 esp_err_t __wrap_esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t size)
 {
-    return flash_dispatcher_execute(FLASH_OP_READ,
-                                    chip,
-                                    (void *)buffer,
-                                    (void *)address,
-                                    (void *)size,
-                                    "flash read");
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_READ,
+        .args.read = { .buffer = buffer, .address = address, .size = size },
+    };
+    return flash_dispatcher_execute(&request, "flash read");
 }
 
 esp_err_t __wrap_esp_flash_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t size)
 {
-    return flash_dispatcher_execute(FLASH_OP_WRITE,
-                                    chip,
-                                    (void *)buffer,
-                                    (void *)address,
-                                    (void *)size,
-                                    "flash write");
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_WRITE,
+        .args.write = { .buffer = buffer, .address = address, .size = size },
+    };
+    return flash_dispatcher_execute(&request, "flash write");
 }
 
 esp_err_t __wrap_esp_flash_write_encrypted(esp_flash_t *chip, uint32_t address, const void *buffer, uint32_t size)
 {
-    return flash_dispatcher_execute(FLASH_OP_WRITE_ENCRYPTED,
-                                    chip,
-                                    (void *)address,
-                                    (void *)buffer,
-                                    (void *)size,
-                                    "flash write_encrypted");
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_WRITE_ENCRYPTED,
+        .args.write_encrypted = { .address = address, .buffer = buffer, .size = size },
+    };
+    return flash_dispatcher_execute(&request, "flash write_encrypted");
 }
 
 esp_err_t __wrap_esp_flash_erase_region(esp_flash_t *chip, uint32_t start_address, uint32_t size)
 {
-    return flash_dispatcher_execute(FLASH_OP_ERASE_REGION,
-                                    chip,
-                                    (void *)start_address,
-                                    (void *)size,
-                                    NULL,
-                                    "flash erase_region");
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_ERASE_REGION,
+        .args.erase_region = { .start_address = start_address, .size = size },
+    };
+    return flash_dispatcher_execute(&request, "flash erase_region");
 }
 
 esp_err_t __wrap_esp_flash_erase_chip(esp_flash_t *chip)
 {
-    return flash_dispatcher_execute(FLASH_OP_ERASE_CHIP,
-                                    chip,
-                                    NULL,
-                                    NULL,
-                                    NULL,
-                                    "flash erase_chip");
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_ERASE_CHIP,
+    };
+    return flash_dispatcher_execute(&request, "flash erase_chip");
+}
+
+esp_err_t esp_flash_dispatcher_submit_read(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx)
+{
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_READ,
+        .args.read = { .buffer = buffer, .address = address, .size = size },
+        .done_cb = done_cb,
+        .user_ctx = user_ctx,
+    };
+    return flash_dispatcher_enqueue(&request, "flash read");
+}
+
+esp_err_t esp_flash_dispatcher_submit_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx)
+{
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_WRITE,
+        .args.write = { .buffer = buffer, .address = address, .size = size },
+        .done_cb = done_cb,
+        .user_ctx = user_ctx,
+    };
+    return flash_dispatcher_enqueue(&request, "flash write");
+}
+
+esp_err_t esp_flash_dispatcher_submit_write_encrypted(esp_flash_t *chip, uint32_t address, const void *buffer, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx)
+{
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_WRITE_ENCRYPTED,
+        .args.write_encrypted = { .address = address, .buffer = buffer, .size = size },
+        .done_cb = done_cb,
+        .user_ctx = user_ctx,
+    };
+    return flash_dispatcher_enqueue(&request, "flash write_encrypted");
+}
+
+esp_err_t esp_flash_dispatcher_submit_erase_region(esp_flash_t *chip, uint32_t start_address, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx)
+{
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_ERASE_REGION,
+        .args.erase_region = { .start_address = start_address, .size = size },
+        .done_cb = done_cb,
+        .user_ctx = user_ctx,
+    };
+    return flash_dispatcher_enqueue(&request, "flash erase_region");
+}
+
+esp_err_t esp_flash_dispatcher_submit_erase_chip(esp_flash_t *chip, esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx)
+{
+    flash_operation_request_t request = {
+        .chip = chip,
+        .op = FLASH_OP_ERASE_CHIP,
+        .done_cb = done_cb,
+        .user_ctx = user_ctx,
+    };
+    return flash_dispatcher_enqueue(&request, "flash erase_chip");
+}
+
+esp_err_t esp_flash_dispatcher_get_stats(esp_flash_dispatcher_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "stats is NULL");
+    ESP_RETURN_ON_FALSE(s_flash_dispatcher_ctx.dispatcher_initialized, ESP_ERR_INVALID_STATE, TAG, "flash dispatcher is not initialized");
+
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_flash_dispatcher_ctx.stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_dispatcher_reset_stats(void)
+{
+    ESP_RETURN_ON_FALSE(s_flash_dispatcher_ctx.dispatcher_initialized, ESP_ERR_INVALID_STATE, TAG, "flash dispatcher is not initialized");
+
+    portENTER_CRITICAL(&s_stats_lock);
+    memset(&s_flash_dispatcher_ctx.stats, 0, sizeof(s_flash_dispatcher_ctx.stats));
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
 }
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include "freertos/FreeRTOS.h"
 #include "esp_err.h"
+#include "esp_flash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +22,9 @@ typedef struct {
     uint32_t task_priority;     // Priority for the dedicated flash task
     BaseType_t task_core_id;    // Core affinity (PRO_CPU_NUM, APP_CPU_NUM, or tskNO_AFFINITY)
     uint32_t queue_size;        // Length of the request queue
+    uint32_t erase_slice_size;  // Erases are split into slices of this size so pending reads can run in between, multiple of the sector size. 0 to not split
+    uint32_t write_slice_size;  // Writes are split into slices of this size so pending reads can run in between, multiple of 256 bytes. 0 to not split
+    uint32_t merge_buf_size;    // Size of the internal RAM buffer used to merge contiguous reads and sequential writes. 0 to not merge
 } esp_flash_dispatcher_config_t;
 
 /**
@@ -31,8 +35,53 @@ typedef struct {
     .task_priority = 10,                  \
     .task_core_id = tskNO_AFFINITY,                      \
     .queue_size = 1,                              \
+    .erase_slice_size = 0x10000,                  \
+    .write_slice_size = 0x1000,                   \
+    .merge_buf_size = 0,                          \
 }
 
+/**
+ * @brief Completion callback of an asynchronous flash operation
+ *
+ * Called from the dispatcher task once the operation is done. The callback should
+ * return quickly, since the following operations are not started before it returns.
+ * Flash functions called from the callback are executed in place.
+ *
+ * @param[in] result    Result of the flash operation
+ * @param[in] user_ctx  User context passed to the submit function
+ */
+typedef void (*esp_flash_dispatcher_done_cb_t)(esp_err_t result, void *user_ctx);
+
+/**
+ * @brief Operation classes of the dispatcher statistics
+ */
+typedef enum {
+    ESP_FLASH_DISPATCHER_OP_READ = 0,   /*!< esp_flash_read */
+    ESP_FLASH_DISPATCHER_OP_WRITE,      /*!< esp_flash_write and esp_flash_write_encrypted */
+    ESP_FLASH_DISPATCHER_OP_ERASE,      /*!< esp_flash_erase_region and esp_flash_erase_chip */
+    ESP_FLASH_DISPATCHER_OP_MAX,
+} esp_flash_dispatcher_op_t;
+
+/**
+ * @brief Number of latency histogram buckets
+ *
+ * Bucket 0 counts the operations completed within 100 us from their submission,
+ * each following bucket has a 10 times higher limit (1 ms, 10 ms, 100 ms, 1 s),
+ * the last one counts everything slower.
+ */
+#define ESP_FLASH_DISPATCHER_LATENCY_BUCKETS 6
+
+/**
+ * @brief Flash dispatcher statistics
+ */
+typedef struct {
+    uint32_t completed[ESP_FLASH_DISPATCHER_OP_MAX];    /*!< Number of completed operations */
+    uint32_t merged_reads;      /*!< Number of reads served by the flash read of another request */
+    uint32_t merged_writes;     /*!< Number of writes programmed together with the preceding write */
+    uint32_t queue_depth_max;   /*!< High-water mark of the requests waiting for the dispatcher */
+    uint32_t latency_hist[ESP_FLASH_DISPATCHER_OP_MAX][ESP_FLASH_DISPATCHER_LATENCY_BUCKETS]; /*!< Submission to completion latency histogram */
+} esp_flash_dispatcher_stats_t;
+
 /**
  * @brief Initialize flash dispatcher.
  *
@@ -45,6 +94,123 @@ typedef struct {
  */
 esp_err_t esp_flash_dispatcher_init(const esp_flash_dispatcher_config_t *cfg);
 
+/**
+ * @brief Deinitialize flash dispatcher.
+ *
+ * The operations already queued are completed first. No flash operation must be
+ * submitted while this function runs, and the wrapped esp_flash_* functions must
+ * not be called after it returns, until the dispatcher is initialized again.
+ *
+ * @return
+ *      - ESP_OK            on success
+ *      - ESP_ERR_NO_MEM    if there is no memory to wait for the dispatcher task
+ *      - ESP_ERR_INVALID_STATE    if the dispatcher is not initialized, or if called from a completion callback
+ */
+esp_err_t esp_flash_dispatcher_deinit(void);
+
+/**
+ * @brief Queue a flash read without waiting for it to complete
+ *
+ * The buffer must stay valid until done_cb is called. Operations are scheduled together
+ * with the ones from the wrapped esp_flash_* functions. The order of submission is only
+ * kept between overlapping operations: reads may overtake the writes and erases of other
+ * regions submitted before them, see the Scheduling section of the README.
+ *
+ * @param[in]  chip      Flash chip, NULL for the default one
+ * @param[out] buffer    Buffer to read the data into
+ * @param[in]  address   Flash address to read from
+ * @param[in]  size      Number of bytes to read
+ * @param[in]  done_cb   Completion callback, can be NULL
+ * @param[in]  user_ctx  User context passed to done_cb
+ *
+ * @return
+ *      - ESP_OK                 if the operation is queued
+ *      - ESP_ERR_INVALID_STATE  if the dispatcher is not initialized
+ *      - ESP_ERR_TIMEOUT        if called from a completion callback and the queue is full
+ */
+esp_err_t esp_flash_dispatcher_submit_read(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Queue a flash write without waiting for it to complete
+ *
+ * The buffer must stay valid until done_cb is called.
+ *
+ * @param[in]  chip      Flash chip, NULL for the default one
+ * @param[in]  buffer    Data to write
+ * @param[in]  address   Flash address to write to
+ * @param[in]  size      Number of bytes to write
+ * @param[in]  done_cb   Completion callback, can be NULL
+ * @param[in]  user_ctx  User context passed to done_cb
+ *
+ * @return see esp_flash_dispatcher_submit_read()
+ */
+esp_err_t esp_flash_dispatcher_submit_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Queue an encrypted flash write without waiting for it to complete
+ *
+ * The buffer must stay valid until done_cb is called.
+ *
+ * @param[in]  chip      Flash chip, NULL for the default one
+ * @param[in]  address   Flash address to write to
+ * @param[in]  buffer    Data to write
+ * @param[in]  size      Number of bytes to write
+ * @param[in]  done_cb   Completion callback, can be NULL
+ * @param[in]  user_ctx  User context passed to done_cb
+ *
+ * @return see esp_flash_dispatcher_submit_read()
+ */
+esp_err_t esp_flash_dispatcher_submit_write_encrypted(esp_flash_t *chip, uint32_t address, const void *buffer, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Queue a flash region erase without waiting for it to complete
+ *
+ * @param[in]  chip           Flash chip, NULL for the default one
+ * @param[in]  start_address  Start address of the region, sector aligned
+ * @param[in]  size           Size of the region, multiple of the sector size
+ * @param[in]  done_cb        Completion callback, can be NULL
+ * @param[in]  user_ctx       User context passed to done_cb
+ *
+ * @return see esp_flash_dispatcher_submit_read()
+ */
+esp_err_t esp_flash_dispatcher_submit_erase_region(esp_flash_t *chip, uint32_t start_address, uint32_t size,
+        esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Queue a full chip erase without waiting for it to complete
+ *
+ * @param[in]  chip      Flash chip, NULL for the default one
+ * @param[in]  done_cb   Completion callback, can be NULL
+ * @param[in]  user_ctx  User context passed to done_cb
+ *
+ * @return see esp_flash_dispatcher_submit_read()
+ */
+esp_err_t esp_flash_dispatcher_submit_erase_chip(esp_flash_t *chip, esp_flash_dispatcher_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Get the flash dispatcher statistics
+ *
+ * @param[out] stats  Statistics accumulated since the initialization or the last esp_flash_dispatcher_reset_stats()
+ *
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if stats is NULL
+ *      - ESP_ERR_INVALID_STATE  if the dispatcher is not initialized
+ */
+esp_err_t esp_flash_dispatcher_get_stats(esp_flash_dispatcher_stats_t *stats);
+
+/**
+ * @brief Reset the flash dispatcher statistics
+ *
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_STATE  if the dispatcher is not initialized
+ */
+esp_err_t esp_flash_dispatcher_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
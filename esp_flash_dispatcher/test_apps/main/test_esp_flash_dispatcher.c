@@ -85,7 +85,7 @@ TEST_CASE("Flash operations from PSRAM task", "[flash_dispatcher]")
 {
     // Use default configuration when cfg is NULL
     const esp_flash_dispatcher_config_t cfg = ESP_FLASH_DISPATCHER_DEFAULT_CONFIG;
-    esp_flash_dispatcher_init(&cfg);
+    TEST_ESP_OK(esp_flash_dispatcher_init(&cfg));
 
     ESP_LOGI("TEST", "Creating PSRAM task");
     s_psram_task_stack = (StackType_t *)heap_caps_malloc(TEST_PSRAM_TASK_STACK_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
@@ -110,4 +110,184 @@ TEST_CASE("Flash operations from PSRAM task", "[flash_dispatcher]")
 
     heap_caps_free(s_psram_task_stack);
     s_psram_task_stack = NULL;
+    TEST_ESP_OK(esp_flash_dispatcher_deinit());
+}
+
+typedef struct {
+    TaskHandle_t waiter;
+    esp_err_t result;
+} test_async_ctx_t;
+
+static void test_async_done_cb(esp_err_t result, void *user_ctx)
+{
+    test_async_ctx_t *ctx = (test_async_ctx_t *)user_ctx;
+    ctx->result = result;
+    xTaskNotifyGive(ctx->waiter);
+}
+
+TEST_CASE("Asynchronous flash operations complete in submission order", "[flash_dispatcher]")
+{
+    const esp_flash_dispatcher_config_t cfg = {
+        .task_stack_size = 2048,
+        .task_priority = 10,
+        .task_core_id = tskNO_AFFINITY,
+        .queue_size = 4,
+    };
+    TEST_ESP_OK(esp_flash_dispatcher_init(&cfg));
+
+    const esp_partition_t *test_part = get_test_data_partition();
+    uint8_t *write_buf = (uint8_t *)heap_caps_malloc(TEST_FLASH_SIZE, MALLOC_CAP_INTERNAL);
+    uint8_t *read_buf = (uint8_t *)heap_caps_calloc(1, TEST_FLASH_SIZE, MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(write_buf);
+    TEST_ASSERT_NOT_NULL(read_buf);
+    for (int i = 0; i < TEST_FLASH_SIZE; i++) {
+        write_buf[i] = (uint8_t)(255 - (i % 256));
+    }
+
+    test_async_ctx_t ctx[3];
+    for (int i = 0; i < 3; i++) {
+        ctx[i].waiter = xTaskGetCurrentTaskHandle();
+        ctx[i].result = ESP_FAIL;
+    }
+
+    // All three are queued before the first one completes
+    TEST_ESP_OK(esp_flash_dispatcher_submit_erase_region(NULL, test_part->address, TEST_FLASH_SIZE, test_async_done_cb, &ctx[0]));
+    TEST_ESP_OK(esp_flash_dispatcher_submit_write(NULL, write_buf, test_part->address, TEST_FLASH_SIZE, test_async_done_cb, &ctx[1]));
+    TEST_ESP_OK(esp_flash_dispatcher_submit_read(NULL, read_buf, test_part->address, TEST_FLASH_SIZE, test_async_done_cb, &ctx[2]));
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(5000)));
+    }
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, ctx[i].result);
+    }
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(write_buf, read_buf, TEST_FLASH_SIZE);
+
+    heap_caps_free(write_buf);
+    heap_caps_free(read_buf);
+    TEST_ESP_OK(esp_flash_dispatcher_deinit());
+}
+
+#define TEST_LARGE_ERASE_SIZE (256 * 1024)
+
+TEST_CASE("Reads are served while a large erase is in progress", "[flash_dispatcher]")
+{
+    const esp_flash_dispatcher_config_t cfg = ESP_FLASH_DISPATCHER_DEFAULT_CONFIG;
+    TEST_ESP_OK(esp_flash_dispatcher_init(&cfg));
+
+    const esp_partition_t *test_part = get_test_data_partition();
+    TEST_ASSERT_GREATER_THAN(TEST_LARGE_ERASE_SIZE + TEST_FLASH_SIZE, test_part->size);
+    uint8_t *read_buf = (uint8_t *)heap_caps_malloc(TEST_FLASH_SIZE, MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(read_buf);
+
+    test_async_ctx_t erase_ctx = {
+        .waiter = xTaskGetCurrentTaskHandle(),
+        .result = ESP_ERR_NOT_FINISHED,
+    };
+    TEST_ESP_OK(esp_flash_dispatcher_submit_erase_region(NULL, test_part->address, TEST_LARGE_ERASE_SIZE, test_async_done_cb, &erase_ctx));
+
+    // The read is outside of the erased region, it only has to wait for the erase slice in progress
+    TEST_ESP_OK(esp_flash_read(NULL, read_buf, test_part->address + TEST_LARGE_ERASE_SIZE, TEST_FLASH_SIZE));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, erase_ctx.result);
+
+    TEST_ASSERT_NOT_EQUAL(0, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10000)));
+    TEST_ASSERT_EQUAL(ESP_OK, erase_ctx.result);
+
+    // A read overlapping the erase must observe the erased content
+    TEST_ESP_OK(esp_flash_read(NULL, read_buf, test_part->address, TEST_FLASH_SIZE));
+    for (int i = 0; i < TEST_FLASH_SIZE; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xFF, read_buf[i]);
+    }
+
+    heap_caps_free(read_buf);
+    TEST_ESP_OK(esp_flash_dispatcher_deinit());
+}
+
+TEST_CASE("Flash dispatcher statistics", "[flash_dispatcher]")
+{
+    const esp_flash_dispatcher_config_t cfg = ESP_FLASH_DISPATCHER_DEFAULT_CONFIG;
+    TEST_ESP_OK(esp_flash_dispatcher_init(&cfg));
+
+    const esp_partition_t *test_part = get_test_data_partition();
+    uint8_t *buf = (uint8_t *)heap_caps_malloc(TEST_FLASH_SIZE, MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(buf);
+    memset(buf, 0xA5, TEST_FLASH_SIZE);
+
+    TEST_ESP_OK(esp_flash_dispatcher_reset_stats());
+    TEST_ESP_OK(esp_flash_erase_region(NULL, test_part->address, TEST_FLASH_SIZE));
+    TEST_ESP_OK(esp_flash_write(NULL, buf, test_part->address, TEST_FLASH_SIZE));
+    TEST_ESP_OK(esp_flash_read(NULL, buf, test_part->address, TEST_FLASH_SIZE));
+
+    esp_flash_dispatcher_stats_t stats;
+    TEST_ESP_OK(esp_flash_dispatcher_get_stats(&stats));
+    TEST_ASSERT_GREATER_OR_EQUAL(1, stats.queue_depth_max);
+    for (int op = 0; op < ESP_FLASH_DISPATCHER_OP_MAX; op++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(1, stats.completed[op]);
+        uint32_t hist_total = 0;
+        for (int bucket = 0; bucket < ESP_FLASH_DISPATCHER_LATENCY_BUCKETS; bucket++) {
+            hist_total += stats.latency_hist[op][bucket];
+        }
+        TEST_ASSERT_EQUAL(stats.completed[op], hist_total);
+    }
+
+    heap_caps_free(buf);
+    TEST_ESP_OK(esp_flash_dispatcher_deinit());
+}
+
+#define TEST_MERGE_WRITES       8
+#define TEST_MERGE_WRITE_SIZE   1024
+
+TEST_CASE("Merged writes are not longer than a write slice", "[flash_dispatcher]")
+{
+    const esp_flash_dispatcher_config_t cfg = {
+        .task_stack_size = 2048,
+        .task_priority = 10,
+        .task_core_id = tskNO_AFFINITY,
+        .queue_size = TEST_MERGE_WRITES + 1,
+        .erase_slice_size = 0x10000,
+        .write_slice_size = 0x1000,
+        .merge_buf_size = TEST_MERGE_WRITES * TEST_MERGE_WRITE_SIZE,
+    };
+    TEST_ESP_OK(esp_flash_dispatcher_init(&cfg));
+
+    const esp_partition_t *test_part = get_test_data_partition();
+    uint8_t *write_buf = (uint8_t *)heap_caps_malloc(TEST_MERGE_WRITES * TEST_MERGE_WRITE_SIZE, MALLOC_CAP_INTERNAL);
+    uint8_t *read_buf = (uint8_t *)heap_caps_calloc(1, TEST_MERGE_WRITES * TEST_MERGE_WRITE_SIZE, MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(write_buf);
+    TEST_ASSERT_NOT_NULL(read_buf);
+    for (int i = 0; i < TEST_MERGE_WRITES * TEST_MERGE_WRITE_SIZE; i++) {
+        write_buf[i] = (uint8_t)(i * 7);
+    }
+
+    TEST_ESP_OK(esp_flash_dispatcher_reset_stats());
+    test_async_ctx_t ctx[TEST_MERGE_WRITES + 1];
+    for (int i = 0; i <= TEST_MERGE_WRITES; i++) {
+        ctx[i].waiter = xTaskGetCurrentTaskHandle();
+        ctx[i].result = ESP_FAIL;
+    }
+
+    // The writes are all pending while the erase is in progress, and are merged in slices of 4 writes
+    TEST_ESP_OK(esp_flash_dispatcher_submit_erase_region(NULL, test_part->address, 0x10000, test_async_done_cb, &ctx[0]));
+    for (int i = 0; i < TEST_MERGE_WRITES; i++) {
+        TEST_ESP_OK(esp_flash_dispatcher_submit_write(NULL, write_buf + i * TEST_MERGE_WRITE_SIZE,
+                    test_part->address + i * TEST_MERGE_WRITE_SIZE, TEST_MERGE_WRITE_SIZE,
+                    test_async_done_cb, &ctx[i + 1]));
+    }
+    for (int i = 0; i <= TEST_MERGE_WRITES; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(5000)));
+    }
+    for (int i = 0; i <= TEST_MERGE_WRITES; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, ctx[i].result);
+    }
+
+    esp_flash_dispatcher_stats_t stats;
+    TEST_ESP_OK(esp_flash_dispatcher_get_stats(&stats));
+    TEST_ASSERT_EQUAL(TEST_MERGE_WRITES - TEST_MERGE_WRITES * TEST_MERGE_WRITE_SIZE / cfg.write_slice_size, stats.merged_writes);
+
+    TEST_ESP_OK(esp_flash_read(NULL, read_buf, test_part->address, TEST_MERGE_WRITES * TEST_MERGE_WRITE_SIZE));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(write_buf, read_buf, TEST_MERGE_WRITES * TEST_MERGE_WRITE_SIZE);
+
+    heap_caps_free(write_buf);
+    heap_caps_free(read_buf);
+    TEST_ESP_OK(esp_flash_dispatcher_deinit());
 }
@@ -6,7 +6,11 @@
 
 // This module implements runtime file I/O API for GCOV.
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
+#include <sys/param.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_app_trace.h"
@@ -129,51 +133,177 @@ void esp_gcov_dump(void)
     }
 }
 
+/*
+ * libgcov does a lot of small reads and writes (mostly 4 bytes words), each of them being a round trip with the host
+ * when forwarded as is to apptrace. So every stream has a buffer, which combines the writes until the next seek or
+ * close, and reads ahead when the data are read.
+ */
+typedef enum {
+    GCOV_STREAM_IDLE,   // buffer is empty
+    GCOV_STREAM_WRITE,  // buffer holds data not sent to the host yet
+    GCOV_STREAM_READ,   // buffer holds data read ahead from the host
+} gcov_stream_state_t;
+
+typedef struct {
+    void *file;                 // apptrace file handle
+    gcov_stream_state_t state;
+    size_t len;                 // number of valid bytes in the buffer
+    size_t pos;                 // read position in the buffer
+    bool eof;                   // end of file indicator, set by a short read and cleared by a seek
+    uint8_t buf[CONFIG_ESP_GCOV_STREAM_BUF_SIZE];
+} gcov_stream_t;
+
+static int gcov_stream_flush(gcov_stream_t *s)
+{
+    int ret = 0;
+
+    if (s->state == GCOV_STREAM_WRITE) {
+        if (esp_apptrace_fwrite(s->buf, 1, s->len, s->file) != s->len) {
+            ESP_EARLY_LOGE(TAG, "Failed to write %u bytes!", s->len);
+            ret = -1;
+        }
+    } else if (s->state == GCOV_STREAM_READ && s->pos < s->len) {
+        // move the host file position back to the first byte not consumed yet
+        ret = esp_apptrace_fseek(s->file, -(long)(s->len - s->pos), SEEK_CUR);
+    }
+    s->state = GCOV_STREAM_IDLE;
+    s->len = 0;
+    s->pos = 0;
+    return ret;
+}
+
 void *gcov_rtio_fopen(const char *path, const char *mode)
 {
     ESP_EARLY_LOGV(TAG, "%s '%s' '%s'", __FUNCTION__, path, mode);
-    void *f = esp_apptrace_fopen(path, mode);
-    ESP_EARLY_LOGV(TAG, "%s ret %p", __FUNCTION__, f);
-    return f;
+    gcov_stream_t *s = calloc(1, sizeof(gcov_stream_t));
+    if (s == NULL) {
+        ESP_EARLY_LOGE(TAG, "Could not allocate memory for the stream");
+        return NULL;
+    }
+    s->file = esp_apptrace_fopen(path, mode);
+    if (s->file == NULL) {
+        free(s);
+        s = NULL;
+    }
+    ESP_EARLY_LOGV(TAG, "%s ret %p", __FUNCTION__, s);
+    return s;
 }
 
 int gcov_rtio_fclose(void *stream)
 {
     ESP_EARLY_LOGV(TAG, "%s", __FUNCTION__);
-    return esp_apptrace_fclose(stream);
+    gcov_stream_t *s = (gcov_stream_t *)stream;
+    // read ahead data are just dropped, no need to seek back before closing
+    int ret = s->state == GCOV_STREAM_WRITE ? gcov_stream_flush(s) : 0;
+    if (esp_apptrace_fclose(s->file) != 0) {
+        ret = -1;
+    }
+    free(s);
+    return ret;
 }
 
 size_t gcov_rtio_fread(void *ptr, size_t size, size_t nmemb, void *stream)
 {
-    ESP_EARLY_LOGV(TAG, "%s read %u", __FUNCTION__, size * nmemb);
-    size_t sz = esp_apptrace_fread(ptr, size, nmemb, stream);
-    ESP_EARLY_LOGV(TAG, "%s actually read %u", __FUNCTION__, sz);
-    return sz;
+    gcov_stream_t *s = (gcov_stream_t *)stream;
+    uint8_t *dst = (uint8_t *)ptr;
+    size_t total = size * nmemb;
+    size_t done = 0;
+
+    ESP_EARLY_LOGV(TAG, "%s read %u", __FUNCTION__, total);
+    if (s->state == GCOV_STREAM_WRITE && gcov_stream_flush(s) != 0) {
+        return 0;
+    }
+    while (done < total) {
+        if (s->state == GCOV_STREAM_READ && s->pos < s->len) {
+            size_t n = MIN(s->len - s->pos, total - done);
+            memcpy(dst + done, s->buf + s->pos, n);
+            s->pos += n;
+            done += n;
+            continue;
+        }
+        s->state = GCOV_STREAM_IDLE;
+        s->len = 0;
+        s->pos = 0;
+        if (total - done >= sizeof(s->buf)) {
+            // large read, no need to go through the buffer
+            done += esp_apptrace_fread(dst + done, 1, total - done, s->file);
+            break;
+        }
+        size_t n = esp_apptrace_fread(s->buf, 1, sizeof(s->buf), s->file);
+        if (n == 0) {
+            break;
+        }
+        s->state = GCOV_STREAM_READ;
+        s->len = n;
+    }
+    s->eof = done < total;
+    ESP_EARLY_LOGV(TAG, "%s actually read %u", __FUNCTION__, done);
+    return size ? done / size : 0;
 }
 
 size_t gcov_rtio_fwrite(const void *ptr, size_t size, size_t nmemb, void *stream)
 {
     ESP_EARLY_LOGV(TAG, "%s", __FUNCTION__);
-    return esp_apptrace_fwrite(ptr, size, nmemb, stream);
+    gcov_stream_t *s = (gcov_stream_t *)stream;
+    size_t total = size * nmemb;
+
+    if (s->state == GCOV_STREAM_READ || s->len + total > sizeof(s->buf)) {
+        if (gcov_stream_flush(s) != 0) {
+            return 0;
+        }
+    }
+    if (total >= sizeof(s->buf)) {
+        // large write, no need to go through the buffer
+        return esp_apptrace_fwrite(ptr, size, nmemb, s->file);
+    }
+    memcpy(s->buf + s->len, ptr, total);
+    s->len += total;
+    s->state = GCOV_STREAM_WRITE;
+    return nmemb;
 }
 
 int gcov_rtio_fseek(void *stream, long offset, int whence)
 {
-    int ret = esp_apptrace_fseek(stream, offset, whence);
+    gcov_stream_t *s = (gcov_stream_t *)stream;
+    int ret = 0;
+    if (s->state == GCOV_STREAM_READ && whence == SEEK_CUR) {
+        // the relative seek is done from the host file position, which is ahead of the read position
+        offset -= s->len - s->pos;
+        s->state = GCOV_STREAM_IDLE;
+        s->len = 0;
+        s->pos = 0;
+    } else {
+        ret = gcov_stream_flush(s);
+    }
+    if (ret == 0) {
+        ret = esp_apptrace_fseek(s->file, offset, whence);
+    }
+    if (ret == 0) {
+        s->eof = false;
+    }
     ESP_EARLY_LOGV(TAG, "%s(%p %ld %d) = %d", __FUNCTION__, stream, offset, whence, ret);
     return ret;
 }
 
 long gcov_rtio_ftell(void *stream)
 {
-    long ret = esp_apptrace_ftell(stream);
+    gcov_stream_t *s = (gcov_stream_t *)stream;
+    long ret = esp_apptrace_ftell(s->file);
+    if (ret >= 0) {
+        if (s->state == GCOV_STREAM_WRITE) {
+            ret += s->len;
+        } else if (s->state == GCOV_STREAM_READ) {
+            ret -= s->len - s->pos;
+        }
+    }
     ESP_EARLY_LOGV(TAG, "%s(%p) = %ld", __FUNCTION__, stream, ret);
     return ret;
 }
 
 int gcov_rtio_feof(void *stream)
 {
-    int ret = esp_apptrace_feof(stream);
+    // the host file reaches its end while reading ahead, before the data have been consumed, so keep track of it here
+    int ret = ((gcov_stream_t *)stream)->eof;
     ESP_EARLY_LOGV(TAG, "%s(%p) = %d", __FUNCTION__, stream, ret);
     return ret;
 }
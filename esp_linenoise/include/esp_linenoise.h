@@ -121,6 +121,18 @@ typedef struct esp_linenoise_config {
     char **history; /*!< Pointer to the history buffer (used internally; typically initialized to NULL) */
 } esp_linenoise_config_t;
 
+/**
+ * @brief Output statistics of a linenoise instance
+ *
+ * Can be used to measure the amount of data sent to the terminal, e.g. on slow links.
+ */
+typedef struct esp_linenoise_stats {
+    size_t bytes_written; /*!< Number of bytes written to the output stream */
+    size_t write_calls; /*!< Number of calls to the write function */
+    size_t line_refreshes; /*!< Number of refreshes of the edited line */
+    size_t full_line_refreshes; /*!< Number of refreshes that redrew the whole line, prompt included */
+} esp_linenoise_stats_t;
+
 /**
  * @brief Opaque handle to a linenoise instance.
  */
@@ -375,6 +387,26 @@ esp_err_t esp_linenoise_get_read(esp_linenoise_handle_t handle, esp_linenoise_re
  */
 esp_err_t esp_linenoise_get_write(esp_linenoise_handle_t handle, esp_linenoise_write_bytes_t *write_func);
 
+/**
+ * @brief Get the output statistics of the instance
+ *
+ * @note Statistics are accumulated since the instance creation or the
+ * last call to esp_linenoise_reset_stats.
+ *
+ * @param handle The esp_linenoise handle from which to get the statistics
+ * @param stats Return value containing the statistics
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG otherwise
+ */
+esp_err_t esp_linenoise_get_stats(esp_linenoise_handle_t handle, esp_linenoise_stats_t *stats);
+
+/**
+ * @brief Reset the output statistics of the instance
+ *
+ * @param handle The esp_linenoise handle of which to reset the statistics
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG otherwise
+ */
+esp_err_t esp_linenoise_reset_stats(esp_linenoise_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,7 @@ extern "C" {
 
 #include <stdlib.h>
 #include <string.h>
+#include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "esp_linenoise.h"
@@ -22,6 +23,7 @@ extern "C" {
 #define ESP_LINENOISE_MINIMAL_MAX_LINE 64
 #define ESP_LINENOISE_COMMAND_MAX_LEN 32
 #define ESP_LINENOISE_PASTE_KEY_DELAY 30 /* Delay, in milliseconds, between two characters being pasted from clipboard */
+#define ESP_LINENOISE_OUT_BUFFER_SIZE CONFIG_ESP_LINENOISE_OUT_BUFFER_SIZE /* Size of the buffer used to group the bytes of a refresh in one write */
 
 enum KEY_ACTION {
     KEY_NULL = 0,       /* NULL */
@@ -59,6 +61,15 @@ typedef struct esp_linenoise_state {
     int history_length; /* The current length of the history*/
     SemaphoreHandle_t mux;
     int abort_read_fd;
+    size_t dirty_position; /* Lowest buffer position modified since the last refresh, SIZE_MAX if none. */
+    bool shown_valid; /* Whether the shown_* fields below describe what the terminal displays (single line mode). */
+    size_t shown_offset; /* Position in buffer of the first displayed character. */
+    size_t shown_length; /* Number of buffer characters displayed. */
+    size_t shown_end_column; /* Column right after the last displayed character, hint included. */
+    size_t shown_cursor_column; /* Column of the terminal cursor. */
+    esp_linenoise_stats_t stats; /* Output statistics. */
+    size_t out_length; /* Number of bytes pending in out_buffer. */
+    char out_buffer[ESP_LINENOISE_OUT_BUFFER_SIZE]; /* Output buffer, flushed when full or at the end of a refresh. */
 } esp_linenoise_state_t;
 
 typedef struct esp_linenoise_instance {
@@ -62,53 +62,76 @@ FILE *lndebug_fp = NULL;
 #define lndebug(fmt, ...)
 #endif
 
-/* We define a very simple "append buffer" structure, that is an heap
- * allocated string where we can append to. This is useful in order to
- * write all the escape sequences in a buffer and flush them to the standard
- * output in a single call, to avoid flickering effects. */
-typedef struct append_buffer {
-    char *b;
-    int len;
-} append_buffer_t;
-
-static void esp_linenoise_append_buffer_init(append_buffer_t *ab)
+/* Write to the output of the instance, keeping track of the amount of
+ * data written. All the output of an instance goes through this function. */
+static ssize_t esp_linenoise_write(esp_linenoise_instance_t *instance, const void *buf, size_t count)
 {
-    ab->b = NULL;
-    ab->len = 0;
+    esp_linenoise_state_t *state = &instance->state;
+
+    const ssize_t nwrite = instance->config.write_bytes_cb(instance->config.out_fd, buf, count);
+    state->stats.write_calls++;
+    if (nwrite > 0) {
+        state->stats.bytes_written += nwrite;
+    }
+    return nwrite;
 }
 
-static void esp_linenoise_append_buffer_append(append_buffer_t *ab, const char *s, int len)
+/* The escape sequences and characters of a refresh are gathered in the output
+ * buffer of the instance and flushed to the output in a single call, to avoid
+ * flickering effects and to limit the number of writes. The buffer has a fixed
+ * size, if a refresh does not fit, it is written in several chunks. */
+static void esp_linenoise_out_flush(esp_linenoise_instance_t *instance)
 {
-    char *new = realloc(ab->b, ab->len + len);
+    esp_linenoise_state_t *state = &instance->state;
 
-    if (new == NULL) {
-        return;
+    if (state->out_length != 0) {
+        if (esp_linenoise_write(instance, state->out_buffer, state->out_length) == -1) {} /* Can't recover from write error. */
+        state->out_length = 0;
     }
-    memcpy(new + ab->len, s, len);
-    ab->b = new;
-    ab->len += len;
 }
 
-static void esp_linenoise_append_buffer_free(append_buffer_t *ab)
+static void esp_linenoise_out_append(esp_linenoise_instance_t *instance, const char *s, size_t len)
 {
-    free(ab->b);
+    esp_linenoise_state_t *state = &instance->state;
+
+    while (len != 0) {
+        if (state->out_length == ESP_LINENOISE_OUT_BUFFER_SIZE) {
+            esp_linenoise_out_flush(instance);
+        }
+        const size_t room = ESP_LINENOISE_OUT_BUFFER_SIZE - state->out_length;
+        const size_t chunk = len < room ? len : room;
+        memcpy(state->out_buffer + state->out_length, s, chunk);
+        state->out_length += chunk;
+        s += chunk;
+        len -= chunk;
+    }
+}
+
+/* Record that the buffer content changed from the given position, so that
+ * the next refresh redraws the line from there. */
+static inline void esp_linenoise_mark_dirty(esp_linenoise_state_t *state, size_t position)
+{
+    if (position < state->dirty_position) {
+        state->dirty_position = position;
+    }
 }
 
 /* Helper of esp_linenoise_refresh_single_line() and esp_linenoise_refresh_multi_line() to show hints
- * to the right of the prompt. */
-static void esp_linenoise_refresh_show_hints(append_buffer_t *ab, esp_linenoise_instance_t *instance)
+ * to the right of the prompt. Returns the number of columns used by the hint. */
+static size_t esp_linenoise_refresh_show_hints(esp_linenoise_instance_t *instance)
 {
 
     esp_linenoise_state_t state = instance->state;
     esp_linenoise_config_t config = instance->config;
     char seq[64];
+    int hintlen = 0;
 
     if (config.hints_cb && state.prompt_length + state.len < state.columns) {
 
         int color = -1, bold = 0;
         char *hint = config.hints_cb(state.buffer, &color, &bold);
         if (hint) {
-            int hintlen = strlen(hint);
+            hintlen = strlen(hint);
             int hintmaxlen = state.columns - (state.prompt_length + state.len);
 
             if (hintlen > hintmaxlen) {
@@ -121,13 +144,13 @@ static void esp_linenoise_refresh_show_hints(append_buffer_t *ab, esp_linenoise_
 
             if (color != -1 || bold != 0) {
                 snprintf(seq, 64, "\033[%d;%d;49m", bold, color);
-                esp_linenoise_append_buffer_append(ab, seq, strlen(seq));
+                esp_linenoise_out_append(instance, seq, strlen(seq));
             }
 
-            esp_linenoise_append_buffer_append(ab, hint, hintlen);
+            esp_linenoise_out_append(instance, hint, hintlen);
 
             if (color != -1 || bold != 0) {
-                esp_linenoise_append_buffer_append(ab, "\033[0m", 4);
+                esp_linenoise_out_append(instance, "\033[0m", 4);
             }
 
             /* Call the function to free the hint returned. */
@@ -136,6 +159,51 @@ static void esp_linenoise_refresh_show_hints(append_buffer_t *ab, esp_linenoise_
             }
         }
     }
+    return hintlen;
+}
+
+/* Compute the part of the buffer displayed in single line mode: when the
+ * line does not fit in the terminal, it is scrolled so the cursor stays visible. */
+static void esp_linenoise_single_line_window(esp_linenoise_state_t *state, size_t *offset, size_t *length)
+{
+    size_t first = 0;
+    if (state->prompt_length + state->cur_cursor_position >= state->columns) {
+        first = state->prompt_length + state->cur_cursor_position - state->columns + 1;
+    }
+    size_t len = state->len - first;
+    if (state->prompt_length + len > state->columns) {
+        len = state->columns - state->prompt_length;
+    }
+    *offset = first;
+    *length = len;
+}
+
+/* Move the cursor of the terminal from column 'from' to column 'to' of the
+ * current row, with the shortest sequence. */
+static void esp_linenoise_move_cursor_column(esp_linenoise_instance_t *instance, size_t from, size_t to)
+{
+    char seq[ESP_LINENOISE_COMMAND_MAX_LEN];
+
+    if (from >= instance->state.columns) {
+        /* the cursor sits past the last column, waiting for a wrap,
+         * relative moves are not reliable there */
+        if (to) {
+            snprintf(seq, sizeof(seq), "\r\x1b[%dC", (int)to);
+        } else {
+            snprintf(seq, sizeof(seq), "\r");
+        }
+    } else if (to == from) {
+        return;
+    } else if (to == 0) {
+        snprintf(seq, sizeof(seq), "\r");
+    } else if (to + 1 == from) {
+        snprintf(seq, sizeof(seq), "\b");
+    } else if (to < from) {
+        snprintf(seq, sizeof(seq), "\x1b[%dD", (int)(from - to));
+    } else {
+        snprintf(seq, sizeof(seq), "\x1b[%dC", (int)(to - from));
+    }
+    esp_linenoise_out_append(instance, seq, strlen(seq));
 }
 
 /* Single line low level line refresh.
@@ -149,38 +217,96 @@ static void esp_linenoise_refresh_single_line(esp_linenoise_instance_t *instance
 
     char seq[64];
     size_t prompt_length = state->prompt_length;
-    int fd = instance->config.out_fd;
-    char *buf = state->buffer;
-    size_t len = state->len;
-    size_t cur_cursor_position = state->cur_cursor_position;
-    append_buffer_t ab;
+    size_t offset = 0;
+    size_t len = 0;
 
-    while ((prompt_length + cur_cursor_position) >= state->columns) {
-        buf++;
-        len--;
-        cur_cursor_position--;
-    }
-    while (prompt_length + len > state->columns) {
-        len--;
-    }
+    esp_linenoise_single_line_window(state, &offset, &len);
 
-    esp_linenoise_append_buffer_init(&ab);
     /* Cursor to left edge */
     snprintf(seq, 64, "\r");
-    esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+    esp_linenoise_out_append(instance, seq, strlen(seq));
     /* Write the prompt and the current buffer content */
-    esp_linenoise_append_buffer_append(&ab, config->prompt, strlen(config->prompt));
-    esp_linenoise_append_buffer_append(&ab, buf, len);
+    esp_linenoise_out_append(instance, config->prompt, strlen(config->prompt));
+    esp_linenoise_out_append(instance, state->buffer + offset, len);
     /* Show hits if any. */
-    esp_linenoise_refresh_show_hints(&ab, instance);
+    const size_t hint_length = esp_linenoise_refresh_show_hints(instance);
     /* Erase to right */
     snprintf(seq, 64, "\x1b[0K");
-    esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+    esp_linenoise_out_append(instance, seq, strlen(seq));
     /* Move cursor to original position. */
-    snprintf(seq, 64, "\r\x1b[%dC", (int)(cur_cursor_position + prompt_length));
-    esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
-    if (config->write_bytes_cb(fd, ab.b, ab.len) == -1) {} /* Can't recover from write error. */
-    esp_linenoise_append_buffer_free(&ab);
+    snprintf(seq, 64, "\r\x1b[%dC", (int)(state->cur_cursor_position - offset + prompt_length));
+    esp_linenoise_out_append(instance, seq, strlen(seq));
+    esp_linenoise_out_flush(instance);
+
+    /* Remember what is displayed for the next incremental refresh */
+    state->shown_valid = true;
+    state->shown_offset = offset;
+    state->shown_length = len;
+    state->shown_end_column = prompt_length + len + hint_length;
+    state->shown_cursor_column = prompt_length + state->cur_cursor_position - offset;
+    state->stats.full_line_refreshes++;
+}
+
+/* Single line incremental refresh.
+ *
+ * Only rewrite the part of the line that changed since the last refresh,
+ * from the first modified position to the end of the line, and move the
+ * cursor. On slow links, this avoids sending the prompt and the whole line
+ * for each key pressed. Falls back to the full refresh when the displayed
+ * part of the line scrolled. */
+static void esp_linenoise_refresh_single_line_incremental(esp_linenoise_instance_t *instance)
+{
+    esp_linenoise_config_t *config = &instance->config;
+    esp_linenoise_state_t *state = &instance->state;
+
+    const size_t prompt_length = state->prompt_length;
+    size_t offset = 0;
+    size_t len = 0;
+
+    esp_linenoise_single_line_window(state, &offset, &len);
+    if (!state->shown_valid || offset != state->shown_offset) {
+        esp_linenoise_refresh_single_line(instance);
+        return;
+    }
+
+    const size_t text_end_column = prompt_length + len;
+    size_t start = state->dirty_position;
+    if (start == SIZE_MAX && !config->hints_cb && state->shown_end_column > text_end_column) {
+        /* the content did not change but a hint is displayed and has to be removed */
+        start = offset + len;
+    }
+
+    if (start != SIZE_MAX) {
+        /* the characters displayed before the shown length are up to date
+         * up to the first modified position */
+        if (start > offset + state->shown_length) {
+            start = offset + state->shown_length;
+        }
+        if (start > offset + len) {
+            start = offset + len;
+        }
+        if (start < offset) {
+            start = offset;
+        }
+
+        esp_linenoise_move_cursor_column(instance, state->shown_cursor_column, prompt_length + start - offset);
+        esp_linenoise_out_append(instance, state->buffer + start, offset + len - start);
+
+        size_t end_column = text_end_column + esp_linenoise_refresh_show_hints(instance);
+        if (end_column < state->shown_end_column) {
+            /* Erase to right what remains of the previous content */
+            esp_linenoise_out_append(instance, "\x1b[0K", 4);
+        }
+        state->shown_length = len;
+        state->shown_end_column = end_column;
+        state->shown_cursor_column = end_column;
+    }
+
+    /* Move cursor to its position. */
+    const size_t cursor_column = prompt_length + state->cur_cursor_position - offset;
+    esp_linenoise_move_cursor_column(instance, state->shown_cursor_column, cursor_column);
+    state->shown_cursor_column = cursor_column;
+    esp_linenoise_out_flush(instance);
 }
 
 /* Multi line low level line refresh.
@@ -200,8 +326,6 @@ static void esp_linenoise_refresh_multi_line(esp_linenoise_instance_t *instance)
     int col; /* column position, zero-based. */
     int old_rows = state->max_rows_used;
     int j;
-    int fd = instance->config.out_fd;
-    append_buffer_t ab;
 
     /* Update max_rows_used if needed. */
     if (rows > (int)state->max_rows_used) {
@@ -210,31 +334,30 @@ static void esp_linenoise_refresh_multi_line(esp_linenoise_instance_t *instance)
 
     /* First step: clear all the lines used before. To do so start by
      * going to the last row. */
-    esp_linenoise_append_buffer_init(&ab);
     if (old_rows - rpos > 0) {
         lndebug("go down %d", old_rows - rpos);
         snprintf(seq, 64, "\x1b[%dB", old_rows - rpos);
-        esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+        esp_linenoise_out_append(instance, seq, strlen(seq));
     }
 
     /* Now for every row clear it, go up. */
     for (j = 0; j < old_rows - 1; j++) {
         lndebug("clear+up");
         snprintf(seq, 64, "\r\x1b[0K\x1b[1A");
-        esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+        esp_linenoise_out_append(instance, seq, strlen(seq));
     }
 
     /* Clean the top line. */
     lndebug("clear");
     snprintf(seq, 64, "\r\x1b[0K");
-    esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+    esp_linenoise_out_append(instance, seq, strlen(seq));
 
     /* Write the prompt and the current buffer content */
-    esp_linenoise_append_buffer_append(&ab, config->prompt, strlen(config->prompt));
-    esp_linenoise_append_buffer_append(&ab, state->buffer, state->len);
+    esp_linenoise_out_append(instance, config->prompt, strlen(config->prompt));
+    esp_linenoise_out_append(instance, state->buffer, state->len);
 
     /* Show hits if any. */
-    esp_linenoise_refresh_show_hints(&ab, instance);
+    (void)esp_linenoise_refresh_show_hints(instance);
 
     /* If we are at the very end of the screen with our prompt, we need to
      * emit a newline and move the prompt to the first column. */
@@ -242,9 +365,9 @@ static void esp_linenoise_refresh_multi_line(esp_linenoise_instance_t *instance)
             state->cur_cursor_position == state->len &&
             (state->cur_cursor_position + prompt_length) % state->columns == 0) {
         lndebug("<newline>");
-        esp_linenoise_append_buffer_append(&ab, "\n", 1);
+        esp_linenoise_out_append(instance, "\n", 1);
         snprintf(seq, 64, "\r");
-        esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+        esp_linenoise_out_append(instance, seq, strlen(seq));
         rows++;
         if (rows > (int)state->max_rows_used) {
             state->max_rows_used = rows;
@@ -259,7 +382,7 @@ static void esp_linenoise_refresh_multi_line(esp_linenoise_instance_t *instance)
     if (rows - rpos2 > 0) {
         lndebug("go-up %d", rows - rpos2);
         snprintf(seq, 64, "\x1b[%dA", rows - rpos2);
-        esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+        esp_linenoise_out_append(instance, seq, strlen(seq));
     }
 
     /* Set column. */
@@ -270,24 +393,29 @@ static void esp_linenoise_refresh_multi_line(esp_linenoise_instance_t *instance)
     } else {
         snprintf(seq, 64, "\r");
     }
-    esp_linenoise_append_buffer_append(&ab, seq, strlen(seq));
+    esp_linenoise_out_append(instance, seq, strlen(seq));
 
     lndebug("\n");
     state->old_cursor_position = state->cur_cursor_position;
 
-    if (config->write_bytes_cb(fd, ab.b, ab.len) == -1) {} /* Can't recover from write error. */
-    esp_linenoise_append_buffer_free(&ab);
+    esp_linenoise_out_flush(instance);
+
+    /* the single line incremental refresh cannot rely on what multi line mode displayed */
+    state->shown_valid = false;
+    state->stats.full_line_refreshes++;
 }
 
-/* Calls the two low level functions esp_linenoise_refresh_single_line() or
+/* Calls the two low level functions esp_linenoise_refresh_single_line_incremental() or
  * esp_linenoise_refresh_multi_line() according to the selected mode. */
 static void esp_linenoise_refresh_line(esp_linenoise_instance_t *instance)
 {
     if (instance->config.allow_multi_line) {
         esp_linenoise_refresh_multi_line(instance);
     } else {
-        esp_linenoise_refresh_single_line(instance);
+        esp_linenoise_refresh_single_line_incremental(instance);
     }
+    instance->state.dirty_position = SIZE_MAX;
+    instance->state.stats.line_refreshes++;
 }
 
 /* Use the ESC [6n escape sequence to query the horizontal cursor position
@@ -301,7 +429,6 @@ static int esp_linenoise_get_cursor_position(esp_linenoise_instance_t *instance)
     int columns = 0;
     int rows = 0;
     int i = 0;
-    const int out_fd = instance->config.out_fd;
     const int in_fd = instance->config.in_fd;
     /* The following ANSI escape sequence is used to get from the TTY the
      * cursor position. */
@@ -310,7 +437,7 @@ static int esp_linenoise_get_cursor_position(esp_linenoise_instance_t *instance)
     /* Send the command to the TTY on the other end of the UART.
      * Let's use unistd's write function. Thus, data sent through it are raw
      * reducing the overhead compared to using fputs, fprintf, etc... */
-    const int num_written = config->write_bytes_cb(out_fd, get_cursor_cmd, sizeof(get_cursor_cmd));
+    const int num_written = esp_linenoise_write(instance, get_cursor_cmd, sizeof(get_cursor_cmd));
     if (num_written != sizeof(get_cursor_cmd)) {
         return -1;
     }
@@ -352,13 +479,11 @@ static int esp_linenoise_get_cursor_position(esp_linenoise_instance_t *instance)
  * if it fails. */
 static int esp_linenoise_get_columns(esp_linenoise_instance_t *instance)
 {
-    esp_linenoise_config_t *config = &instance->config;
 
     int start = 0;
     int columns = 0;
     int written = 0;
     char seq[ESP_LINENOISE_COMMAND_MAX_LEN] = { 0 };
-    const int fd = instance->config.out_fd;
 
     /* The following ANSI escape sequence is used to tell the TTY to move
      * the cursor to the most-right position. */
@@ -376,7 +501,7 @@ static int esp_linenoise_get_columns(esp_linenoise_instance_t *instance)
 
     /* Send the command to go to right margin. Use `write` function instead of
      * `fwrite` for the same reasons explained in `esp_linenoise_get_cursor_position()` */
-    if (config->write_bytes_cb(fd, move_cursor_right, cmd_len) != cmd_len) {
+    if (esp_linenoise_write(instance, move_cursor_right, cmd_len) != cmd_len) {
         goto failed;
     }
 
@@ -398,7 +523,7 @@ static int esp_linenoise_get_columns(esp_linenoise_instance_t *instance)
         assert (written < ESP_LINENOISE_COMMAND_MAX_LEN);
 
         /* Send the command with `write`, which is not buffered. */
-        if (config->write_bytes_cb(fd, seq, written) == -1) {
+        if (esp_linenoise_write(instance, seq, written) == -1) {
             /* Can't recover... */
         }
     }
@@ -412,10 +537,8 @@ failed:
  * the choices were already shown. */
 static void esp_linenoise_make_beep_sound(esp_linenoise_instance_t *instance)
 {
-    esp_linenoise_config_t *config = &instance->config;
-
     char bip_screen_str[] = "\x7";
-    (void)config->write_bytes_cb(instance->config.out_fd, bip_screen_str, sizeof(bip_screen_str));
+    (void)esp_linenoise_write(instance, bip_screen_str, sizeof(bip_screen_str));
 }
 
 /* Free a list of completion option populated by linenoiseAddCompletion(). */
@@ -459,11 +582,13 @@ static int esp_linenoise_complete_line(esp_linenoise_instance_t *instance)
 
                 state->len = state->cur_cursor_position = strlen(lc.cvec[i]);
                 state->buffer = lc.cvec[i];
+                esp_linenoise_mark_dirty(state, 0);
                 esp_linenoise_refresh_line(instance);
                 state->len = saved.len;
                 state->cur_cursor_position = saved.cur_cursor_position;
                 state->buffer = saved.buffer;
             } else {
+                esp_linenoise_mark_dirty(state, 0);
                 esp_linenoise_refresh_line(instance);
             }
 
@@ -483,6 +608,7 @@ static int esp_linenoise_complete_line(esp_linenoise_instance_t *instance)
             case ESC: /* escape */
                 /* Re-show original buffer */
                 if (i < lc.len) {
+                    esp_linenoise_mark_dirty(state, 0);
                     esp_linenoise_refresh_line(instance);
                 }
                 stop = 1;
@@ -492,6 +618,9 @@ static int esp_linenoise_complete_line(esp_linenoise_instance_t *instance)
                 if (i < lc.len) {
                     nwritten = snprintf(state->buffer, state->buffer_length, "%s", lc.cvec[i]);
                     state->len = state->cur_cursor_position = nwritten;
+                    /* the terminal already displays the completion, unless it
+                     * was truncated to fit in the buffer */
+                    esp_linenoise_mark_dirty(state, nwritten);
                 }
                 stop = 1;
                 break;
@@ -505,6 +634,25 @@ static int esp_linenoise_complete_line(esp_linenoise_instance_t *instance)
 
 /* =========================== Line editing ================================= */
 
+/* Update what the single line incremental refresh knows is displayed after
+ * the last character of the line was echoed directly, without refresh. */
+static void esp_linenoise_shown_append_char(esp_linenoise_instance_t *instance)
+{
+    esp_linenoise_state_t *state = &instance->state;
+
+    if (!state->shown_valid || instance->config.allow_multi_line ||
+            state->prompt_length + state->len >= state->columns) {
+        /* the terminal may have wrapped the line, redraw it all next time */
+        state->shown_valid = false;
+        return;
+    }
+    state->shown_length = state->len - state->shown_offset;
+    state->shown_cursor_column++;
+    if (state->shown_cursor_column > state->shown_end_column) {
+        state->shown_end_column = state->shown_cursor_column;
+    }
+}
+
 /* Insert the character 'c' at cursor current position.
  *
  * On error writing to the terminal -1 is returned, otherwise 0. */
@@ -513,7 +661,6 @@ static int esp_linenoise_edit_insert(esp_linenoise_instance_t *instance, char c)
     esp_linenoise_config_t *config = &instance->config;
     esp_linenoise_state_t *state = &instance->state;
 
-    int fd = instance->config.out_fd;
     if (state->len < state->buffer_length) {
         if (state->len == state->cur_cursor_position) {
             state->buffer[state->cur_cursor_position] = c;
@@ -523,15 +670,18 @@ static int esp_linenoise_edit_insert(esp_linenoise_instance_t *instance, char c)
             if ((!config->allow_multi_line && state->prompt_length + state->len < state->columns && !config->hints_cb)) {
                 /* Avoid a full update of the line in the
                  * trivial case. */
-                if (config->write_bytes_cb(fd, &c, 1) == -1) {
+                if (esp_linenoise_write(instance, &c, 1) == -1) {
                     return -1;
                 }
+                esp_linenoise_shown_append_char(instance);
             } else {
+                esp_linenoise_mark_dirty(state, state->cur_cursor_position - 1);
                 esp_linenoise_refresh_line(instance);
             }
         } else {
             memmove(state->buffer + state->cur_cursor_position + 1, state->buffer + state->cur_cursor_position, state->len - state->cur_cursor_position);
             state->buffer[state->cur_cursor_position] = c;
+            esp_linenoise_mark_dirty(state, state->cur_cursor_position);
             state->len++;
             state->cur_cursor_position++;
             state->buffer[state->len] = '\0';
@@ -543,18 +693,17 @@ static int esp_linenoise_edit_insert(esp_linenoise_instance_t *instance, char c)
 
 static int esp_linenoise_insert_pasted_char(esp_linenoise_instance_t *instance, char c)
 {
-    esp_linenoise_config_t *config = &instance->config;
     esp_linenoise_state_t *state = &instance->state;
-    int fd = instance->config.out_fd;
 
     if (state->len < state->buffer_length && state->len == state->cur_cursor_position) {
         state->buffer[state->cur_cursor_position] = c;
         state->cur_cursor_position++;
         state->len++;
         state->buffer[state->len] = '\0';
-        if (config->write_bytes_cb(fd, &c, 1) == -1) {
+        if (esp_linenoise_write(instance, &c, 1) == -1) {
             return -1;
         }
+        esp_linenoise_shown_append_char(instance);
     }
     return 0;
 }
@@ -629,6 +778,12 @@ static void esp_linenoise_edit_history_next(esp_linenoise_instance_t *instance,
         strncpy(state->buffer, config->history[state->history_index], state->buffer_length);
         state->buffer[state->buffer_length - 1] = '\0';
         state->len = state->cur_cursor_position = strlen(state->buffer);
+        /* the entries often share a prefix, only the rest has to be redrawn */
+        size_t common_length = 0;
+        while (buffer_copy[common_length] != '\0' && buffer_copy[common_length] == state->buffer[common_length]) {
+            common_length++;
+        }
+        esp_linenoise_mark_dirty(state, common_length);
         esp_linenoise_refresh_line(instance);
     }
 }
@@ -641,6 +796,7 @@ static void esp_linenoise_edit_delete(esp_linenoise_instance_t *instance)
 
     if (state->len > 0 && state->cur_cursor_position < state->len) {
         memmove(state->buffer + state->cur_cursor_position, state->buffer + state->cur_cursor_position + 1, state->len - state->cur_cursor_position - 1);
+        esp_linenoise_mark_dirty(state, state->cur_cursor_position);
         state->len--;
         state->buffer[state->len] = '\0';
         esp_linenoise_refresh_line(instance);
@@ -655,6 +811,7 @@ static void esp_linenoise_edit_backspace(esp_linenoise_instance_t *instance)
     if (state->cur_cursor_position > 0 && state->len > 0) {
         memmove(state->buffer + state->cur_cursor_position - 1, state->buffer + state->cur_cursor_position, state->len - state->cur_cursor_position);
         state->cur_cursor_position--;
+        esp_linenoise_mark_dirty(state, state->cur_cursor_position);
         state->len--;
         state->buffer[state->len] = '\0';
         esp_linenoise_refresh_line(instance);
@@ -678,6 +835,7 @@ static void esp_linenoise_edit_delete_prev_word(esp_linenoise_instance_t *instan
     }
     diff = old_pos - state->cur_cursor_position;
     memmove(state->buffer + state->cur_cursor_position, state->buffer + old_pos, state->len - old_pos + 1);
+    esp_linenoise_mark_dirty(state, state->cur_cursor_position);
     state->len -= diff;
     esp_linenoise_refresh_line(instance);
 }
@@ -721,7 +879,6 @@ static int esp_linenoise_edit(esp_linenoise_instance_t *instance, char *buffer,
     esp_linenoise_state_t *state = &instance->state;
 
     uint32_t t1 = 0;
-    int out_fd = instance->config.out_fd;
     int in_fd = instance->config.in_fd;
 
     /* Populate the linenoise state that we pass to functions implementing
@@ -746,7 +903,7 @@ static int esp_linenoise_edit(esp_linenoise_instance_t *instance, char *buffer,
         return -1;
     }
 
-    if (config->write_bytes_cb(out_fd, config->prompt, state->prompt_length) == -1) {
+    if (esp_linenoise_write(instance, config->prompt, state->prompt_length) == -1) {
         return -1;
     }
 
@@ -755,6 +912,15 @@ static int esp_linenoise_edit(esp_linenoise_instance_t *instance, char *buffer,
      * calculation. */
     state->prompt_length = esp_linenoise_prompt_len_ignore_escape_seq(config->prompt);
 
+    /* The terminal displays the prompt only, with the cursor right after it */
+    state->dirty_position = SIZE_MAX;
+    state->out_length = 0;
+    state->shown_valid = true;
+    state->shown_offset = 0;
+    state->shown_length = 0;
+    state->shown_end_column = state->prompt_length;
+    state->shown_cursor_column = state->prompt_length;
+
     while (1) {
         char c;
 
@@ -837,6 +1003,7 @@ static int esp_linenoise_edit(esp_linenoise_instance_t *instance, char *buffer,
                 int aux = state->buffer[state->cur_cursor_position - 1];
                 state->buffer[state->cur_cursor_position - 1] = state->buffer[state->cur_cursor_position];
                 state->buffer[state->cur_cursor_position] = aux;
+                esp_linenoise_mark_dirty(state, state->cur_cursor_position - 1);
                 if (state->cur_cursor_position != state->len - 1) {
                     state->cur_cursor_position++;
                 }
@@ -858,11 +1025,13 @@ static int esp_linenoise_edit(esp_linenoise_instance_t *instance, char *buffer,
         case CTRL_U: /* Ctrl+u, delete the whole line. */
             state->buffer[0] = '\0';
             state->cur_cursor_position = state->len = 0;
+            esp_linenoise_mark_dirty(state, 0);
             esp_linenoise_refresh_line(instance);
             break;
         case CTRL_K: /* Ctrl+k, delete from current to end of line. */
             state->buffer[state->cur_cursor_position] = '\0';
             state->len = state->cur_cursor_position;
+            esp_linenoise_mark_dirty(state, state->cur_cursor_position);
             esp_linenoise_refresh_line(instance);
             break;
         case CTRL_A: /* Ctrl+a, go to the start of the line */
@@ -873,6 +1042,8 @@ static int esp_linenoise_edit(esp_linenoise_instance_t *instance, char *buffer,
             break;
         case CTRL_L: /* ctrl+l, clear screen */
             (void)esp_linenoise_clear_screen(instance);
+            /* nothing is displayed anymore, redraw the whole line */
+            state->shown_valid = false;
             esp_linenoise_refresh_line(instance);
             break;
         case CTRL_W: /* ctrl+w, delete previous word */
@@ -956,7 +1127,6 @@ static int esp_linenoise_edit(esp_linenoise_instance_t *instance, char *buffer,
 
 static int esp_linenoise_raw(esp_linenoise_instance_t *instance, char *buffer, size_t buffer_length)
 {
-    esp_linenoise_config_t *config = &instance->config;
 
     int count;
 
@@ -966,7 +1136,7 @@ static int esp_linenoise_raw(esp_linenoise_instance_t *instance, char *buffer, s
     }
 
     count = esp_linenoise_edit(instance, buffer, buffer_length);
-    config->write_bytes_cb(config->out_fd, "\n", 1);
+    esp_linenoise_write(instance, "\n", 1);
     return count;
 }
 
@@ -974,7 +1144,7 @@ static int esp_linenoise_dumb(esp_linenoise_instance_t *instance, char *buffer,
 {
     esp_linenoise_config_t *config = &instance->config;
 
-    config->write_bytes_cb(instance->config.out_fd, config->prompt, strlen(config->prompt));
+    esp_linenoise_write(instance, config->prompt, strlen(config->prompt));
 
     size_t count = 0;
     const int in_fd = instance->config.in_fd;
@@ -1005,7 +1175,7 @@ static int esp_linenoise_dumb(esp_linenoise_instance_t *instance, char *buffer,
 
                 /* Only erase symbol echoed from in_fd. */
                 char erase_symbol_str[] = "\x08";
-                config->write_bytes_cb(instance->config.out_fd, erase_symbol_str, sizeof(erase_symbol_str)); /* Windows CMD: erase symbol under cursor */
+                esp_linenoise_write(instance, erase_symbol_str, sizeof(erase_symbol_str)); /* Windows CMD: erase symbol under cursor */
             } else {
                 /* Consume backspace if the command line is empty to avoid erasing the prompt */
                 continue;
@@ -1019,9 +1189,9 @@ static int esp_linenoise_dumb(esp_linenoise_instance_t *instance, char *buffer,
             buffer[count] = c;
             ++count;
         }
-        config->write_bytes_cb(instance->config.out_fd, &c, 1); /* echo */
+        esp_linenoise_write(instance, &c, 1); /* echo */
     }
-    config->write_bytes_cb(instance->config.out_fd, "\n", 1);
+    esp_linenoise_write(instance, "\n", 1);
 
     // null terminate the string
     buffer[count + 1] = '\0';
@@ -1047,7 +1217,6 @@ int esp_linenoise_probe(esp_linenoise_handle_t handle)
 
     /* Make sure we are in non blocking mode before performing the terminal probing */
     int fd_in = instance->config.in_fd;
-    int out_fd = instance->config.out_fd;
     int old_flags = fcntl(fd_in, F_GETFL);
     int new_flags = old_flags | O_NONBLOCK;
     int res = fcntl(fd_in, F_SETFL, new_flags);
@@ -1057,7 +1226,7 @@ int esp_linenoise_probe(esp_linenoise_handle_t handle)
 
     /* Device status request */
     char status_request_str[] = "\x1b[5n";
-    instance->config.write_bytes_cb(out_fd, status_request_str, sizeof(status_request_str));
+    esp_linenoise_write(instance, status_request_str, sizeof(status_request_str));
 
     /* Try to read response */
     int timeout_ms = 500;
@@ -1192,7 +1361,7 @@ esp_err_t esp_linenoise_create_instance(const esp_linenoise_config_t *config, es
                            "Line editing and history features are disabled.\n\n"
                            "On Windows, try using Windows Terminal or Putty instead.\r\n");
 
-        instance->config.write_bytes_cb(instance->config.out_fd, buf, len);
+        esp_linenoise_write(instance, buf, len);
     }
 
     *out_handle =  (esp_linenoise_handle_t)instance;
@@ -1488,11 +1657,10 @@ esp_err_t esp_linenoise_clear_screen(esp_linenoise_handle_t handle)
 {
     ESP_LINENOISE_CHECK_INSTANCE(handle);
     esp_linenoise_instance_t *instance = (esp_linenoise_instance_t *)handle;
-    esp_linenoise_config_t *config = &instance->config;
 
     char erase_screen_str[] = "\x1b[H\x1b[2J";
     size_t msg_size = sizeof(erase_screen_str);
-    ssize_t nb_bytes = config->write_bytes_cb(config->out_fd, erase_screen_str, msg_size);
+    ssize_t nb_bytes = esp_linenoise_write(instance, erase_screen_str, msg_size);
     if (nb_bytes < 0 || nb_bytes != msg_size) {
         return ESP_FAIL;
     }
@@ -1651,3 +1819,23 @@ esp_err_t esp_linenoise_get_write(esp_linenoise_handle_t handle, esp_linenoise_w
     *write_func = handle->config.write_bytes_cb;
     return ESP_OK;
 }
+
+esp_err_t esp_linenoise_get_stats(esp_linenoise_handle_t handle, esp_linenoise_stats_t *stats)
+{
+    ESP_LINENOISE_CHECK_INSTANCE(handle);
+
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *stats = handle->state.stats;
+    return ESP_OK;
+}
+
+esp_err_t esp_linenoise_reset_stats(esp_linenoise_handle_t handle)
+{
+    ESP_LINENOISE_CHECK_INSTANCE(handle);
+
+    memset(&handle->state.stats, 0x00, sizeof(esp_linenoise_stats_t));
+    return ESP_OK;
+}
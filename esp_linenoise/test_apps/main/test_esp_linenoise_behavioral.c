@@ -1142,3 +1142,122 @@ TEST_CASE("tests that esp_linenoise_abort actually forces esp_linenoise_get_line
     test_instance_teardown(s_socket_fd_a, linenoise_handle_a, &lock_a);
     test_instance_teardown(s_socket_fd_b, linenoise_handle_b, &lock_b);
 }
+
+/* Replay the output of esp_linenoise on a single line terminal model
+ * supporting the sequences used by the single line mode, and return the
+ * content of the line as displayed. */
+static void test_replay_single_line_output(const char *out, size_t out_len, char *line, size_t line_size)
+{
+    size_t col = 0;
+    memset(line, ' ', line_size - 1);
+    line[line_size - 1] = '\0';
+
+    for (size_t i = 0; i < out_len; i++) {
+        if (out[i] == ESC && i + 1 < out_len && out[i + 1] == '[') {
+            int n = 0;
+            i += 2;
+            while (i < out_len && out[i] >= '0' && out[i] <= '9') {
+                n = n * 10 + out[i] - '0';
+                i++;
+            }
+            if (i >= out_len) {
+                break;
+            }
+            if (out[i] == 'C') {
+                col += (n == 0) ? 1 : n;
+            } else if (out[i] == 'D') {
+                col -= (n == 0) ? 1 : n;
+            } else if (out[i] == 'K') {
+                memset(line + col, ' ', line_size - 1 - col);
+            }
+        } else if (out[i] == '\r') {
+            col = 0;
+        } else if (out[i] == '\b') {
+            col--;
+        } else if (out[i] >= ' ' && col < line_size - 1) {
+            line[col++] = out[i];
+        }
+    }
+
+    /* remove the trailing spaces */
+    size_t end = line_size - 1;
+    while (end > 0 && line[end - 1] == ' ') {
+        end--;
+    }
+    line[end] = '\0';
+}
+
+TEST_CASE("line refresh only writes the modified part of the line", "[esp_linenoise]")
+{
+    esp_linenoise_config_t config;
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+    test_instance_setup(s_socket_fd_a, &lock, &config);
+
+    esp_linenoise_handle_t handle;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_linenoise_create_instance(&config, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    char buffer[CMD_LINE_LENGTH] = {0};
+    get_line_task_args_t args = {
+        .handle = handle,
+        .parent_task = xTaskGetCurrentTaskHandle(),
+        .lock = &lock,
+        .ret_val = ESP_FAIL,
+        .buf = buffer,
+        .buf_size = CMD_LINE_LENGTH
+    };
+    xTaskCreate(get_line_task_w_args, "freertos_task", 2048, &args, 5, NULL);
+    pthread_mutex_lock(&lock);
+
+    test_send_characters(s_socket_fd_a[1], "abcdefghij");
+    wait_ms(100);
+
+    /* moving the cursor only sends the cursor move */
+    esp_linenoise_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_linenoise_reset_stats(handle));
+    test_send_characters(s_socket_fd_a[1], COMPOUND_LITERAL(CTRL_A));
+    wait_ms(100);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_linenoise_get_stats(handle, &stats));
+    TEST_ASSERT_EQUAL(1, stats.line_refreshes);
+    TEST_ASSERT_EQUAL(0, stats.full_line_refreshes);
+    TEST_ASSERT_EQUAL(1, stats.write_calls);
+    TEST_ASSERT_EQUAL(strlen("\x1b[10D"), stats.bytes_written);
+
+    /* inserting a character at the start of the line rewrites the line
+     * but not the prompt, in a single write */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_linenoise_reset_stats(handle));
+    test_send_characters(s_socket_fd_a[1], "z");
+    wait_ms(100);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_linenoise_get_stats(handle, &stats));
+    TEST_ASSERT_EQUAL(0, stats.full_line_refreshes);
+    TEST_ASSERT_EQUAL(1, stats.write_calls);
+    TEST_ASSERT_EQUAL(strlen("zabcdefghij\x1b[10D"), stats.bytes_written);
+
+    /* deleting the last character erases it without rewriting the line */
+    test_send_characters(s_socket_fd_a[1], COMPOUND_LITERAL(CTRL_E));
+    wait_ms(100);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_linenoise_reset_stats(handle));
+    test_send_characters(s_socket_fd_a[1], COMPOUND_LITERAL(BACKSPACE));
+    wait_ms(100);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_linenoise_get_stats(handle, &stats));
+    TEST_ASSERT_EQUAL(0, stats.full_line_refreshes);
+    TEST_ASSERT_EQUAL(strlen("\b\x1b[0K"), stats.bytes_written);
+
+    test_send_characters(s_socket_fd_a[1], COMPOUND_LITERAL(CTRL_B));
+    test_send_characters(s_socket_fd_a[1], COMPOUND_LITERAL(CTRL_T));
+    test_send_characters(s_socket_fd_a[1], "\n");
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    TEST_ASSERT_EQUAL(ESP_OK, args.ret_val);
+    TEST_ASSERT_EQUAL_STRING("zabcdefgih", buffer);
+
+    /* what the terminal displays matches the returned line */
+    char output[512];
+    const ssize_t nread = read(s_socket_fd_a[1], output, sizeof(output));
+    TEST_ASSERT_GREATER_THAN(0, nread);
+    char displayed[64];
+    test_replay_single_line_output(output, nread, displayed, sizeof(displayed));
+    TEST_ASSERT_EQUAL_STRING(">zabcdefgih", displayed);
+
+    test_instance_teardown(s_socket_fd_a, handle, &lock);
+}
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
@@ -25,6 +26,8 @@ typedef void *esp_schedule_handle_t;
 /** Callback for schedule trigger
  *
  * This callback is called when the schedule is triggered.
+ * All the schedules share a single timer, so the callbacks of the schedules due at the same time are called one after
+ * the other from the timer service task. The callback should return quickly. The esp_schedule APIs can be called from it.
  *
  * @param[in] handle Schedule handle.
  * @param[in] priv_data Pointer to the private data passed while creating/editing the schedule.
@@ -252,6 +255,61 @@ esp_err_t esp_schedule_disable(esp_schedule_handle_t handle);
  */
 esp_err_t esp_schedule_get(esp_schedule_handle_t handle, esp_schedule_config_t *schedule_config);
 
+/** Begin a batch of schedule changes
+ *
+ * Until esp_schedule_batch_commit() is called, the changes done by esp_schedule_create(), esp_schedule_edit()
+ * and esp_schedule_delete() are only kept in memory. They are then written to NVS at once, with a single commit.
+ * This is useful when many schedules are changed together, e.g. while syncing them from the cloud.
+ * Batches can be nested, the changes are written when the outermost batch is committed.
+ *
+ * Note: Changes done in a batch are lost if the device restarts before the batch is committed.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t esp_schedule_batch_begin(void);
+
+/** Commit a batch of schedule changes
+ *
+ * This writes to NVS all the changes done since esp_schedule_batch_begin() was called.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if no batch has been started.
+ * @return error in case of NVS failure.
+ */
+esp_err_t esp_schedule_batch_commit(void);
+
+/** Import Schedules
+ *
+ * This API can be used to create or edit many schedules at once. A schedule is edited if a schedule with the same
+ * name already exists, else it is created. All the changes are written to NVS with a single commit.
+ * The schedules still need to be enabled using esp_schedule_enable().
+ *
+ * @param[in] schedule_configs Configurations of the schedules.
+ * @param[in] count Number of configurations.
+ * @param[out] handles (Optional) Array of count handles, populated with the handles of the schedules,
+ * or NULL for the schedules which could not be imported.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_FAIL if some schedules could not be imported.
+ * @return error in case of failure.
+ */
+esp_err_t esp_schedule_import(esp_schedule_config_t *schedule_configs, size_t count, esp_schedule_handle_t *handles);
+
+/** Export Schedules
+ *
+ * This API can be used to get the details of all the existing schedules at once.
+ * If schedule_configs is NULL, only the number of schedules is returned.
+ *
+ * @param[out] schedule_configs Array populated with the details of the schedules. Can be NULL.
+ * @param[inout] count Size of the schedule_configs array as input, number of schedules as output.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_SIZE if the array is too small. count is set to the required size.
+ * @return error in case of failure.
+ */
+esp_err_t esp_schedule_export(esp_schedule_config_t *schedule_configs, size_t *count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,7 @@
 #include <inttypes.h>
 #include "esp_log.h"
 #include "esp_sntp.h"
+#include "freertos/semphr.h"
 #include "esp_daylight.h"
 #include "esp_schedule_internal.h"
 
@@ -14,9 +15,52 @@ static const char *TAG = "esp_schedule";
 
 #define SECONDS_TILL_2020 ((2020 - 1970) * 365 * 24 * 3600)
 #define SECONDS_IN_DAY (60 * 60 * 24)
+/* Upper bound of the dispatcher timer period. Keeps the period within the tick counter range and
+ * lets the dispatcher catch up with time updates (SNTP, timezone change) at least once a day. */
+#define DISPATCHER_MAX_WAIT_SECONDS SECONDS_IN_DAY
+#define DISPATCHER_HEAP_MIN_CAPACITY 8
+#define SCHEDULE_TABLE_MIN_SIZE 8
+
+/* Current time, converted once and shared by all the schedules computed at the same time */
+typedef struct {
+    time_t timestamp;
+    struct tm local;
+} esp_schedule_now_t;
+
+typedef struct {
+    time_t fire_time;
+    esp_schedule_t *schedule;
+} esp_schedule_heap_entry_t;
 
 static bool init_done = false;
 
+/* All the enabled schedules share a single timer, armed for the earliest one of a min-heap
+ * ordered by trigger time. The lock is recursive so that the APIs can be called from the callbacks. */
+static SemaphoreHandle_t s_lock;
+static TimerHandle_t s_dispatcher_timer;
+static esp_schedule_heap_entry_t *s_heap;
+static size_t s_heap_len;
+static size_t s_heap_capacity;
+/* Time at which the dispatcher timer has been armed to expire, 0 if it is not armed */
+static time_t s_armed_time;
+static bool s_dispatching;
+/* A task is sending a command to the timer service, the others only leave a request for it */
+static bool s_arming;
+static bool s_arm_requested;
+/* Incremented by every dispatch, tells whether the timer expired while a command was being sent */
+static uint32_t s_dispatch_count;
+/* Schedule whose callback is being called, reset if it is disabled or deleted from the callback */
+static esp_schedule_t *s_current;
+/* All the schedules, indexed by slot. The slot is also the index of the schedule record in NVS. */
+static esp_schedule_t **s_table;
+static size_t s_table_size;
+
+static void esp_schedule_get_now(esp_schedule_now_t *now)
+{
+    time(&now->timestamp);
+    localtime_r(&now->timestamp, &now->local);
+}
+
 static int esp_schedule_get_no_of_days(esp_schedule_trigger_t *trigger, struct tm *current_time, struct tm *schedule_time)
 {
     /* for day, monday = 0, sunday = 6. */
@@ -213,15 +257,14 @@ static int32_t esp_schedule_finalize_solar_time(time_t solar_time, time_t now,
 }
 #endif /* CONFIG_ESP_SCHEDULE_ENABLE_DAYLIGHT */
 
-static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_name, esp_schedule_trigger_t *trigger)
+static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_name, esp_schedule_trigger_t *trigger,
+        const esp_schedule_now_t *current)
 {
     struct tm current_time, schedule_time;
-    time_t now;
+    time_t now = current->timestamp;
     char time_str[64];
     int32_t time_diff;
 
-    /* Get current time */
-    time(&now);
     /* Handling ESP_SCHEDULE_TYPE_RELATIVE first since it doesn't require any
      * computation based on days, hours, minutes, etc.
      */
@@ -238,7 +281,7 @@ static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_na
             time_diff = trigger->relative_seconds;
         }
         localtime_r(&target, &schedule_time);
-        trigger->next_scheduled_time_utc = mktime(&schedule_time);
+        trigger->next_scheduled_time_utc = target;
         /* Print schedule time */
         memset(time_str, 0, sizeof(time_str));
         strftime(time_str, sizeof(time_str), "%c %z[%Z]", &schedule_time);
@@ -252,7 +295,7 @@ static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_na
         time_t solar_time = 0;
 
         /* Start with current local time for day calculations */
-        localtime_r(&now, &current_time);
+        current_time = current->local;
 
         /* Determine schedule pattern using unified approach */
         if (trigger->date.day != 0) {
@@ -367,8 +410,7 @@ static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_na
 
             /* If time has passed today, calculate for tomorrow (like regular schedules) */
             if (solar_time > 0 && solar_time <= now) {
-                struct tm tomorrow_time;
-                localtime_r(&now, &tomorrow_time);  // Use fresh local time
+                struct tm tomorrow_time = current->local;
                 tomorrow_time.tm_mday += 1;
                 mktime(&tomorrow_time);
 
@@ -413,10 +455,10 @@ static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_na
     }
 #endif /* CONFIG_ESP_SCHEDULE_ENABLE_DAYLIGHT */
 
-    localtime_r(&now, &current_time);
+    current_time = current->local;
 
     /* Get schedule time */
-    localtime_r(&now, &schedule_time);
+    schedule_time = current->local;
     schedule_time.tm_sec = 0;
     schedule_time.tm_min = trigger->minutes;
     schedule_time.tm_hour = trigger->hours;
@@ -452,7 +494,7 @@ static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_na
     }
     ESP_LOGD(TAG, "DST adjust seconds: %lld", (long long) dst_adjust);
     schedule_time.tm_sec += dst_adjust;
-    mktime(&schedule_time);
+    time_t schedule_timestamp = mktime(&schedule_time);
 
     /* Print schedule time */
     memset(time_str, 0, sizeof(time_str));
@@ -460,20 +502,17 @@ static uint32_t esp_schedule_get_next_schedule_time_diff(const char *schedule_na
     ESP_LOGI(TAG, "Schedule %s will be active on: %s. DST: %s", schedule_name, time_str, schedule_time.tm_isdst ? "Yes" : "No");
 
     /* Calculate difference */
-    time_diff = difftime((mktime(&schedule_time)), mktime(&current_time));
+    time_diff = difftime(schedule_timestamp, now);
 
     /* For one time schedules to check for expiry after a reboot. If NVS is enabled, this should be stored in NVS. */
-    trigger->next_scheduled_time_utc = mktime(&schedule_time);
+    trigger->next_scheduled_time_utc = schedule_timestamp;
 
     return time_diff;
 }
 
-static bool esp_schedule_is_expired(esp_schedule_trigger_t *trigger)
+static bool esp_schedule_is_expired(esp_schedule_trigger_t *trigger, const esp_schedule_now_t *current)
 {
-    time_t current_timestamp = 0;
-    struct tm current_time = {0};
-    time(&current_timestamp);
-    localtime_r(&current_timestamp, &current_time);
+    time_t current_timestamp = current->timestamp;
 
     if (trigger->type == ESP_SCHEDULE_TYPE_RELATIVE) {
         if (trigger->next_scheduled_time_utc > 0 && trigger->next_scheduled_time_utc <= current_timestamp) {
@@ -520,8 +559,7 @@ static bool esp_schedule_is_expired(esp_schedule_trigger_t *trigger)
             return false;
         }
 
-        struct tm schedule_time = {0};
-        localtime_r(&current_timestamp, &schedule_time);
+        struct tm schedule_time = current->local;
         schedule_time.tm_sec = 0;
         schedule_time.tm_min = trigger->minutes;
         schedule_time.tm_hour = trigger->hours;
@@ -543,21 +581,170 @@ static bool esp_schedule_is_expired(esp_schedule_trigger_t *trigger)
     return false;
 }
 
+static bool esp_schedule_heap_before(size_t a, size_t b)
+{
+    return s_heap[a].fire_time < s_heap[b].fire_time;
+}
+
+static void esp_schedule_heap_place(size_t index, esp_schedule_heap_entry_t entry)
+{
+    s_heap[index] = entry;
+    entry.schedule->heap_index = (int32_t)index;
+}
+
+static void esp_schedule_heap_swap(size_t a, size_t b)
+{
+    esp_schedule_heap_entry_t entry = s_heap[a];
+    esp_schedule_heap_place(a, s_heap[b]);
+    esp_schedule_heap_place(b, entry);
+}
+
+static void esp_schedule_heap_sift_up(size_t index)
+{
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!esp_schedule_heap_before(index, parent)) {
+            break;
+        }
+        esp_schedule_heap_swap(index, parent);
+        index = parent;
+    }
+}
+
+static void esp_schedule_heap_sift_down(size_t index)
+{
+    while (true) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < s_heap_len && esp_schedule_heap_before(left, smallest)) {
+            smallest = left;
+        }
+        if (right < s_heap_len && esp_schedule_heap_before(right, smallest)) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            break;
+        }
+        esp_schedule_heap_swap(index, smallest);
+        index = smallest;
+    }
+}
+
+static esp_err_t esp_schedule_heap_push(esp_schedule_t *schedule, time_t fire_time)
+{
+    if (s_heap_len == s_heap_capacity) {
+        size_t capacity = s_heap_capacity ? s_heap_capacity * 2 : DISPATCHER_HEAP_MIN_CAPACITY;
+        esp_schedule_heap_entry_t *heap = (esp_schedule_heap_entry_t *)MEM_REALLOC_EXTRAM(s_heap, capacity * sizeof(esp_schedule_heap_entry_t));
+        if (heap == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        s_heap = heap;
+        s_heap_capacity = capacity;
+    }
+    esp_schedule_heap_entry_t entry = {
+        .fire_time = fire_time,
+        .schedule = schedule,
+    };
+    esp_schedule_heap_place(s_heap_len, entry);
+    s_heap_len++;
+    esp_schedule_heap_sift_up(s_heap_len - 1);
+    return ESP_OK;
+}
+
+static void esp_schedule_heap_remove(esp_schedule_t *schedule)
+{
+    if (schedule->heap_index < 0) {
+        return;
+    }
+    size_t index = (size_t)schedule->heap_index;
+    schedule->heap_index = -1;
+    s_heap_len--;
+    if (index == s_heap_len) {
+        return;
+    }
+    esp_schedule_heap_place(index, s_heap[s_heap_len]);
+    if (index > 0 && esp_schedule_heap_before(index, (index - 1) / 2)) {
+        esp_schedule_heap_sift_up(index);
+    } else {
+        esp_schedule_heap_sift_down(index);
+    }
+}
+
+/* Arm the dispatcher timer for the earliest schedule. The timer is left as is if it will already
+ * expire before that, which keeps the timer service queue free when many schedules are enabled.
+ *
+ * Must be called without the lock held. The command is sent with the lock released, since the
+ * timer service task needs the lock to dispatch and would otherwise never drain a full queue.
+ * Only one task sends at a time, a request made meanwhile is handled by that task before it returns. */
+static void esp_schedule_arm_dispatcher(TickType_t block_time)
+{
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    s_arm_requested = true;
+    if (s_arming) {
+        xSemaphoreGiveRecursive(s_lock);
+        return;
+    }
+    s_arming = true;
+    /* Re-armed at the end of the dispatch */
+    while (s_arm_requested && !s_dispatching) {
+        s_arm_requested = false;
+        if (s_heap_len == 0) {
+            break;
+        }
+        time_t now = time(NULL);
+        time_t fire_time = s_heap[0].fire_time;
+        if (fire_time > now + DISPATCHER_MAX_WAIT_SECONDS) {
+            fire_time = now + DISPATCHER_MAX_WAIT_SECONDS;
+        }
+        if (s_armed_time != 0 && s_armed_time <= fire_time) {
+            continue;
+        }
+        TickType_t ticks = 1;
+        if (fire_time > now) {
+            ticks = (TickType_t)((uint64_t)(fire_time - now) * configTICK_RATE_HZ);
+        }
+        uint32_t dispatch_count = s_dispatch_count;
+        xSemaphoreGiveRecursive(s_lock);
+        BaseType_t ret = xTimerChangePeriod(s_dispatcher_timer, ticks, block_time);
+        xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+        if (ret != pdPASS) {
+            ESP_LOGE(TAG, "Could not arm the schedule dispatcher");
+            break;
+        }
+        if (dispatch_count == s_dispatch_count) {
+            s_armed_time = fire_time;
+        } else {
+            /* The timer expired in the meantime, check again what it is armed for */
+            s_armed_time = 0;
+            s_arm_requested = true;
+        }
+    }
+    s_arm_requested = false;
+    s_arming = false;
+    xSemaphoreGiveRecursive(s_lock);
+}
+
 static void esp_schedule_stop_timer(esp_schedule_t *schedule)
 {
-    xTimerStop(schedule->timer, portMAX_DELAY);
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    esp_schedule_heap_remove(schedule);
+    if (s_current == schedule) {
+        s_current = NULL;
+    }
+    xSemaphoreGiveRecursive(s_lock);
 }
 
-static void esp_schedule_start_timer(esp_schedule_t *schedule)
+/* Must be called with the lock held. The dispatcher has to be armed once the lock is released. */
+static void esp_schedule_queue(esp_schedule_t *schedule, const esp_schedule_now_t *now)
 {
-    time_t current_time = 0;
-    time(&current_time);
-    if (current_time < SECONDS_TILL_2020) {
+    esp_schedule_heap_remove(schedule);
+    if (now->timestamp < SECONDS_TILL_2020) {
         ESP_LOGE(TAG, "Time is not updated");
         return;
     }
 
-    schedule->next_scheduled_time_diff = esp_schedule_get_next_schedule_time_diff(schedule->name, &schedule->trigger);
+    schedule->next_scheduled_time_diff = esp_schedule_get_next_schedule_time_diff(schedule->name, &schedule->trigger, now);
 
     /* Check if schedule calculation failed (returns 0) */
     if (schedule->next_scheduled_time_diff == 0) {
@@ -573,19 +760,24 @@ static void esp_schedule_start_timer(esp_schedule_t *schedule)
         schedule->timestamp_cb((esp_schedule_handle_t)schedule, schedule->trigger.next_scheduled_time_utc, schedule->priv_data);
     }
 
-    xTimerStop(schedule->timer, portMAX_DELAY);
-    xTimerChangePeriod(schedule->timer, (schedule->next_scheduled_time_diff * 1000) / portTICK_PERIOD_MS, portMAX_DELAY);
+    if (esp_schedule_heap_push(schedule, now->timestamp + schedule->next_scheduled_time_diff) != ESP_OK) {
+        ESP_LOGE(TAG, "Could not queue schedule %s", schedule->name);
+    }
 }
 
-static void esp_schedule_common_timer_cb(TimerHandle_t timer)
+static void esp_schedule_start_timer(esp_schedule_t *schedule)
+{
+    esp_schedule_now_t now;
+    esp_schedule_get_now(&now);
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    esp_schedule_queue(schedule, &now);
+    xSemaphoreGiveRecursive(s_lock);
+    esp_schedule_arm_dispatcher(portMAX_DELAY);
+}
+
+/* Returns false if the schedule must not be started again */
+static bool esp_schedule_trigger(esp_schedule_t *schedule, time_t now)
 {
-    void *priv_data = pvTimerGetTimerID(timer);
-    if (priv_data == NULL) {
-        return;
-    }
-    esp_schedule_t *schedule = (esp_schedule_t *)priv_data;
-    time_t now;
-    time(&now);
     struct tm validity_time;
     char time_str[64] = {0};
     if (schedule->validity.start_time != 0) {
@@ -597,7 +789,7 @@ static void esp_schedule_common_timer_cb(TimerHandle_t timer)
             /* TODO: Start the timer such that the next time it triggers, it will be within the valid window.
              * Currently, it will just keep triggering and then get skipped if not in valid range.
              */
-            goto restart_schedule;
+            return true;
         }
     }
     if (schedule->validity.end_time != 0) {
@@ -605,38 +797,131 @@ static void esp_schedule_common_timer_cb(TimerHandle_t timer)
             localtime_r(&schedule->validity.end_time, &validity_time);
             strftime(time_str, sizeof(time_str), "%c %z[%Z]", &validity_time);
             ESP_LOGW(TAG, "Schedule %s skipped. It can't be active after: %s. DST: %s.", schedule->name, time_str, validity_time.tm_isdst ? "Yes" : "No");
-            /* Return from here will ensure that the timer does not start again for this schedule */
-            return;
+            return false;
         }
     }
     ESP_LOGI(TAG, "Schedule %s triggered", schedule->name);
     if (schedule->trigger_cb) {
         schedule->trigger_cb((esp_schedule_handle_t)schedule, schedule->priv_data);
     }
+    return true;
+}
 
-restart_schedule:
+static void esp_schedule_dispatcher_cb(TimerHandle_t timer)
+{
+    esp_schedule_now_t now;
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    esp_schedule_get_now(&now);
+    s_armed_time = 0;
+    s_dispatching = true;
+    s_dispatch_count++;
+    /* All the schedules due at the same time are handled in one go, with the broken-down current time
+     * computed only once for all of them. */
+    while (s_heap_len > 0 && s_heap[0].fire_time <= now.timestamp) {
+        esp_schedule_t *schedule = s_heap[0].schedule;
+        esp_schedule_heap_remove(schedule);
+        s_current = schedule;
+        bool restart = esp_schedule_trigger(schedule, now.timestamp);
+        if (s_current == NULL || schedule->heap_index >= 0) {
+            /* Disabled, deleted or enabled again by the callback */
+            continue;
+        }
+        if (!restart || esp_schedule_is_expired(&schedule->trigger, &now)) {
+            /* Not deleting the schedule here. Just not starting it again. */
+            continue;
+        }
+        esp_schedule_queue(schedule, &now);
+    }
+    s_current = NULL;
+    s_dispatching = false;
+    xSemaphoreGiveRecursive(s_lock);
+    /* The timer service task must not block on its own queue */
+    esp_schedule_arm_dispatcher(0);
+}
 
-    if (esp_schedule_is_expired(&schedule->trigger)) {
-        /* Not deleting the schedule here. Just not starting it again. */
-        return;
+static esp_err_t esp_schedule_dispatcher_init(void)
+{
+    if (s_dispatcher_timer) {
+        return ESP_OK;
     }
-    esp_schedule_start_timer(schedule);
+    s_lock = xSemaphoreCreateRecursiveMutex();
+    if (s_lock == NULL) {
+        ESP_LOGE(TAG, "Could not create the schedule lock");
+        return ESP_ERR_NO_MEM;
+    }
+    /* Temporarily setting the timer for 1 (anything greater than 0) tick. This will get changed when xTimerChangePeriod() is called. */
+    s_dispatcher_timer = xTimerCreate("schedule", 1, pdFALSE, NULL, esp_schedule_dispatcher_cb);
+    if (s_dispatcher_timer == NULL) {
+        ESP_LOGE(TAG, "Could not create the schedule dispatcher");
+        vSemaphoreDelete(s_lock);
+        s_lock = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_schedule_t *esp_schedule_get_by_slot(size_t slot)
+{
+    return slot < s_table_size ? s_table[slot] : NULL;
+}
+
+/* Must be called with the lock held. The slot of the schedule is kept if it is free, else the first free one is used. */
+static esp_err_t esp_schedule_register(esp_schedule_t *schedule)
+{
+    size_t slot = 0;
+    if (schedule->slot >= 0 && esp_schedule_get_by_slot(schedule->slot) == NULL) {
+        slot = schedule->slot;
+    } else {
+        while (slot < s_table_size && s_table[slot] != NULL) {
+            slot++;
+        }
+    }
+    if (slot > INT16_MAX) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (slot >= s_table_size) {
+        size_t size = s_table_size ? s_table_size : SCHEDULE_TABLE_MIN_SIZE;
+        while (size <= slot) {
+            size *= 2;
+        }
+        esp_schedule_t **table = (esp_schedule_t **)MEM_REALLOC_EXTRAM(s_table, size * sizeof(esp_schedule_t *));
+        if (table == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        memset(&table[s_table_size], 0, (size - s_table_size) * sizeof(esp_schedule_t *));
+        s_table = table;
+        s_table_size = size;
+    }
+    s_table[slot] = schedule;
+    schedule->slot = (int16_t)slot;
+    return ESP_OK;
 }
 
-static void esp_schedule_delete_timer(esp_schedule_t *schedule)
+/* Must be called with the lock held. The slot is left in the schedule for removing it from NVS. */
+static void esp_schedule_unregister(esp_schedule_t *schedule)
 {
-    xTimerDelete(schedule->timer, portMAX_DELAY);
+    if (esp_schedule_get_by_slot(schedule->slot) == schedule) {
+        s_table[schedule->slot] = NULL;
+    }
+}
+
+static esp_schedule_t *esp_schedule_find(const char *name)
+{
+    for (size_t slot = 0; slot < s_table_size; slot++) {
+        if (s_table[slot] && strncmp(s_table[slot]->name, name, sizeof(s_table[slot]->name)) == 0) {
+            return s_table[slot];
+        }
+    }
+    return NULL;
 }
 
-static void esp_schedule_create_timer(esp_schedule_t *schedule)
+static void esp_schedule_create_timer(esp_schedule_t *schedule, const esp_schedule_now_t *now)
 {
+    schedule->heap_index = -1;
     if (esp_schedule_nvs_is_enabled()) {
         /* This is just used for calculating next_scheduled_time_utc for ESP_SCHEDULE_DAY_ONCE (in case of ESP_SCHEDULE_TYPE_DAYS_OF_WEEK) or for ESP_SCHEDULE_MONTH_ONCE (in case of ESP_SCHEDULE_TYPE_DATE), and only used when NVS is enabled. And if NVS is enabled, time will already be synced and the time will be correctly calculated. */
-        schedule->next_scheduled_time_diff = esp_schedule_get_next_schedule_time_diff(schedule->name, &schedule->trigger);
+        schedule->next_scheduled_time_diff = esp_schedule_get_next_schedule_time_diff(schedule->name, &schedule->trigger, now);
     }
-
-    /* Temporarily setting the timer for 1 (anything greater than 0) tick. This will get changed when xTimerChangePeriod() is called. */
-    schedule->timer = xTimerCreate("schedule", 1, pdFALSE, (void *)schedule, esp_schedule_common_timer_cb);
 }
 
 esp_err_t esp_schedule_get(esp_schedule_handle_t handle, esp_schedule_config_t *schedule_config)
@@ -745,11 +1030,13 @@ esp_err_t esp_schedule_edit(esp_schedule_handle_t handle, esp_schedule_config_t
         return ESP_FAIL;
     }
 
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
     /* Editing a schedule with relative time should also reset it. */
     if (schedule->trigger.type == ESP_SCHEDULE_TYPE_RELATIVE) {
         schedule->trigger.next_scheduled_time_utc = 0;
     }
     esp_schedule_set(schedule, schedule_config);
+    xSemaphoreGiveRecursive(s_lock);
     ESP_LOGD(TAG, "Schedule %s edited", schedule->name);
     return ESP_OK;
 }
@@ -761,11 +1048,11 @@ esp_err_t esp_schedule_delete(esp_schedule_handle_t handle)
     }
     esp_schedule_t *schedule = (esp_schedule_t *)handle;
     ESP_LOGI(TAG, "Deleting schedule %s", schedule->name);
-    if (schedule->timer) {
-        esp_schedule_stop_timer(schedule);
-        esp_schedule_delete_timer(schedule);
-    }
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    esp_schedule_stop_timer(schedule);
+    esp_schedule_unregister(schedule);
     esp_schedule_nvs_remove(schedule);
+    xSemaphoreGiveRecursive(s_lock);
     free(schedule);
     return ESP_OK;
 }
@@ -785,22 +1072,41 @@ esp_schedule_handle_t esp_schedule_create(esp_schedule_config_t *schedule_config
         return NULL;
     }
 
+    if (esp_schedule_dispatcher_init() != ESP_OK) {
+        return NULL;
+    }
+
     esp_schedule_t *schedule = (esp_schedule_t *)MEM_CALLOC_EXTRAM(1, sizeof(esp_schedule_t));
     if (schedule == NULL) {
         ESP_LOGE(TAG, "Could not allocate handle");
         return NULL;
     }
     strlcpy(schedule->name, schedule_config->name, sizeof(schedule->name));
+    schedule->slot = -1;
 
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    if (esp_schedule_register(schedule) != ESP_OK) {
+        xSemaphoreGiveRecursive(s_lock);
+        ESP_LOGE(TAG, "Could not add schedule %s to the schedule table", schedule->name);
+        free(schedule);
+        return NULL;
+    }
     esp_schedule_set(schedule, schedule_config);
 
-    esp_schedule_create_timer(schedule);
+    esp_schedule_now_t now;
+    esp_schedule_get_now(&now);
+    esp_schedule_create_timer(schedule, &now);
+    xSemaphoreGiveRecursive(s_lock);
     ESP_LOGD(TAG, "Schedule %s created", schedule->name);
     return (esp_schedule_handle_t)schedule;
 }
 
 esp_schedule_handle_t *esp_schedule_init(bool enable_nvs, char *nvs_partition, uint8_t *schedule_count)
 {
+    if (esp_schedule_dispatcher_init() != ESP_OK) {
+        return NULL;
+    }
+
     if (!esp_sntp_enabled()) {
         ESP_LOGI(TAG, "Initializing SNTP");
         esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
@@ -826,14 +1132,28 @@ esp_schedule_handle_t *esp_schedule_init(bool enable_nvs, char *nvs_partition, u
         return NULL;
     }
     ESP_LOGI(TAG, "Schedules found in NVS: %"PRIu8, *schedule_count);
-    /* Start/Delete the schedules */
+    /* Start/Delete the schedules. The current time is converted only once for all of them. */
     esp_schedule_t *schedule = NULL;
+    esp_schedule_now_t now;
+    esp_schedule_get_now(&now);
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    /* Changes (expired schedules, schedules moved from the previous format) are written to NVS at once */
+    esp_schedule_nvs_batch_begin();
     for (size_t handle_count = 0; handle_count < *schedule_count; handle_count++) {
         schedule = (esp_schedule_t *)handle_list[handle_count];
         schedule->trigger_cb = NULL;
-        schedule->timer = NULL;
+        schedule->heap_index = -1;
+        bool legacy = (schedule->slot < 0);
+        if (esp_schedule_register(schedule) != ESP_OK) {
+            ESP_LOGE(TAG, "Could not add schedule %s to the schedule table", schedule->name);
+            free(schedule);
+            handle_list[handle_count] = handle_list[*schedule_count - 1];
+            (*schedule_count)--;
+            handle_count--;
+            continue;
+        }
         /* Check for ONCE and expired schedules and delete them. */
-        if (esp_schedule_is_expired(&schedule->trigger)) {
+        if (esp_schedule_is_expired(&schedule->trigger, &now)) {
             /* This schedule has already expired. */
             ESP_LOGI(TAG, "Schedule %s does not repeat and has already expired. Deleting it.", schedule->name);
             esp_schedule_delete((esp_schedule_handle_t)schedule);
@@ -843,9 +1163,111 @@ esp_schedule_handle_t *esp_schedule_init(bool enable_nvs, char *nvs_partition, u
             handle_count--;
             continue;
         }
-        esp_schedule_create_timer(schedule);
-        esp_schedule_start_timer(schedule);
+        if (legacy) {
+            esp_schedule_nvs_add(schedule);
+        }
+        esp_schedule_create_timer(schedule, &now);
+        esp_schedule_queue(schedule, &now);
     }
+    esp_schedule_nvs_batch_commit();
+    xSemaphoreGiveRecursive(s_lock);
+    esp_schedule_arm_dispatcher(portMAX_DELAY);
     init_done = true;
     return handle_list;
 }
+
+esp_err_t esp_schedule_batch_begin(void)
+{
+    if (esp_schedule_dispatcher_init() != ESP_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    esp_err_t err = esp_schedule_nvs_batch_begin();
+    xSemaphoreGiveRecursive(s_lock);
+    return err;
+}
+
+esp_err_t esp_schedule_batch_commit(void)
+{
+    if (s_lock == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    esp_err_t err = esp_schedule_nvs_batch_commit();
+    xSemaphoreGiveRecursive(s_lock);
+    return err;
+}
+
+esp_err_t esp_schedule_import(esp_schedule_config_t *schedule_configs, size_t count, esp_schedule_handle_t *handles)
+{
+    if (schedule_configs == NULL && count > 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = esp_schedule_batch_begin();
+    if (err != ESP_OK) {
+        return err;
+    }
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    for (size_t i = 0; i < count; i++) {
+        esp_schedule_t *schedule = esp_schedule_find(schedule_configs[i].name);
+        if (schedule) {
+            if (esp_schedule_edit((esp_schedule_handle_t)schedule, &schedule_configs[i]) != ESP_OK) {
+                schedule = NULL;
+            }
+        } else {
+            schedule = (esp_schedule_t *)esp_schedule_create(&schedule_configs[i]);
+        }
+        if (schedule == NULL) {
+            ESP_LOGE(TAG, "Could not import schedule %s", schedule_configs[i].name);
+            ret = ESP_FAIL;
+        }
+        if (handles) {
+            handles[i] = (esp_schedule_handle_t)schedule;
+        }
+    }
+    xSemaphoreGiveRecursive(s_lock);
+    err = esp_schedule_batch_commit();
+    return ret != ESP_OK ? ret : err;
+}
+
+esp_err_t esp_schedule_export(esp_schedule_config_t *schedule_configs, size_t *count)
+{
+    if (count == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_lock == NULL) {
+        *count = 0;
+        return ESP_OK;
+    }
+    xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    size_t schedule_count = 0;
+    for (size_t slot = 0; slot < s_table_size; slot++) {
+        if (s_table[slot]) {
+            schedule_count++;
+        }
+    }
+    if (schedule_configs == NULL || *count < schedule_count) {
+        xSemaphoreGiveRecursive(s_lock);
+        esp_err_t err = (schedule_configs == NULL) ? ESP_OK : ESP_ERR_INVALID_SIZE;
+        *count = schedule_count;
+        return err;
+    }
+    size_t index = 0;
+    for (size_t slot = 0; slot < s_table_size; slot++) {
+        esp_schedule_t *schedule = s_table[slot];
+        if (schedule == NULL) {
+            continue;
+        }
+        esp_schedule_config_t *schedule_config = &schedule_configs[index++];
+        strlcpy(schedule_config->name, schedule->name, sizeof(schedule_config->name));
+        schedule_config->trigger = schedule->trigger;
+        schedule_config->trigger_cb = schedule->trigger_cb;
+        schedule_config->timestamp_cb = schedule->timestamp_cb;
+        schedule_config->priv_data = schedule->priv_data;
+        schedule_config->validity = schedule->validity;
+    }
+    xSemaphoreGiveRecursive(s_lock);
+    *count = schedule_count;
+    return ESP_OK;
+}
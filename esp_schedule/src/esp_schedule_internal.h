@@ -27,15 +27,29 @@ typedef struct esp_schedule {
     char name[MAX_SCHEDULE_NAME_LEN + 1];
     esp_schedule_trigger_t trigger;
     uint32_t next_scheduled_time_diff;
-    TimerHandle_t timer;
+    /* Position of the schedule in the dispatcher heap, -1 if it is not queued.
+     * Takes the place of the former per schedule timer handle so that the layout of the
+     * schedules stored in NVS does not change. */
+    int32_t heap_index;
     esp_schedule_trigger_cb_t trigger_cb;
     esp_schedule_timestamp_cb_t timestamp_cb;
     void *priv_data;
     esp_schedule_validity_t validity;
+    /* Index of the schedule in the schedule table, which is also its record in NVS, -1 if not assigned yet.
+     * Kept last, so that schedules stored by previous versions can still be read. */
+    int16_t slot;
 } esp_schedule_t;
 
+/* Maximum number of schedules which can be stored in NVS. Limited by the count returned by esp_schedule_init(). */
+#define ESP_SCHEDULE_NVS_MAX_SCHEDULES 255
+
 esp_err_t esp_schedule_nvs_add(esp_schedule_t *schedule);
 esp_err_t esp_schedule_nvs_remove(esp_schedule_t *schedule);
 esp_schedule_handle_t *esp_schedule_nvs_get_all(uint8_t *schedule_count);
 bool esp_schedule_nvs_is_enabled(void);
 esp_err_t esp_schedule_nvs_init(char *nvs_partition);
+esp_err_t esp_schedule_nvs_batch_begin(void);
+esp_err_t esp_schedule_nvs_batch_commit(void);
+
+/* Schedule table, implemented in esp_schedule.c. Must be called with the schedule lock held. */
+esp_schedule_t *esp_schedule_get_by_slot(size_t slot);
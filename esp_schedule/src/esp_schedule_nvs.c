@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include "esp_log.h"
@@ -20,136 +21,263 @@
 
 static const char *TAG = "esp_schedule_nvs";
 
+/* Schedules stored by previous versions, one blob per schedule with the raw esp_schedule_t */
 #define ESP_SCHEDULE_NVS_NAMESPACE "schd"
 #define ESP_SCHEDULE_COUNT_KEY "schd_count"
 
+/* Schedule table: the records of the schedules, grouped by chunks of ESP_SCHEDULE_NVS_CHUNK_RECORDS, one blob per chunk */
+#define ESP_SCHEDULE_NVS_TABLE_NAMESPACE "schd_tbl"
+#define ESP_SCHEDULE_NVS_CHUNK_KEY_FMT "chunk%u"
+#define ESP_SCHEDULE_NVS_CHUNK_RECORDS 8
+#define ESP_SCHEDULE_NVS_CHUNKS ((ESP_SCHEDULE_NVS_MAX_SCHEDULES + ESP_SCHEDULE_NVS_CHUNK_RECORDS - 1) / ESP_SCHEDULE_NVS_CHUNK_RECORDS)
+
+/* Record of a schedule in the table. Only the persistent fields are stored, with fixed sizes so that the
+ * format does not depend on the configuration. A record with an empty name is a free slot. */
+typedef struct __attribute__((packed)) {
+    char name[MAX_SCHEDULE_NAME_LEN + 1];
+    uint8_t type;
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t repeat_days;
+    uint8_t day;
+    uint16_t repeat_months;
+    uint16_t year;
+    uint8_t repeat_every_year;
+    int32_t relative_seconds;
+    int64_t next_scheduled_time_utc;
+    int64_t validity_start_time;
+    int64_t validity_end_time;
+    double latitude;
+    double longitude;
+    int16_t offset_minutes;
+} esp_schedule_nvs_record_t;
+
 static char *esp_schedule_nvs_partition = NULL;
 static bool nvs_enabled = false;
+/* Chunks of the table modified since they have been written */
+static uint32_t dirty_chunks = 0;
+static int batch_depth = 0;
+/* Schedules of the previous format have been loaded, and are to be removed once written to the table */
+static bool legacy_pending = false;
 
-esp_err_t esp_schedule_nvs_add(esp_schedule_t *schedule)
+_Static_assert(ESP_SCHEDULE_NVS_CHUNKS <= 32, "dirty_chunks is too small");
+
+static void esp_schedule_nvs_to_record(const esp_schedule_t *schedule, esp_schedule_nvs_record_t *record)
+{
+    memset(record, 0, sizeof(*record));
+    strlcpy(record->name, schedule->name, sizeof(record->name));
+    record->type = schedule->trigger.type;
+    record->hours = schedule->trigger.hours;
+    record->minutes = schedule->trigger.minutes;
+    record->repeat_days = schedule->trigger.day.repeat_days;
+    record->day = schedule->trigger.date.day;
+    record->repeat_months = schedule->trigger.date.repeat_months;
+    record->year = schedule->trigger.date.year;
+    record->repeat_every_year = schedule->trigger.date.repeat_every_year;
+    record->relative_seconds = schedule->trigger.relative_seconds;
+    record->next_scheduled_time_utc = schedule->trigger.next_scheduled_time_utc;
+    record->validity_start_time = schedule->validity.start_time;
+    record->validity_end_time = schedule->validity.end_time;
+#if CONFIG_ESP_SCHEDULE_ENABLE_DAYLIGHT
+    record->latitude = schedule->trigger.solar.latitude;
+    record->longitude = schedule->trigger.solar.longitude;
+    record->offset_minutes = schedule->trigger.solar.offset_minutes;
+#endif
+}
+
+static void esp_schedule_nvs_from_record(const esp_schedule_nvs_record_t *record, esp_schedule_t *schedule)
+{
+    memcpy(schedule->name, record->name, sizeof(schedule->name) - 1);
+    schedule->name[sizeof(schedule->name) - 1] = '\0';
+    schedule->trigger.type = record->type;
+    schedule->trigger.hours = record->hours;
+    schedule->trigger.minutes = record->minutes;
+    schedule->trigger.day.repeat_days = record->repeat_days;
+    schedule->trigger.date.day = record->day;
+    schedule->trigger.date.repeat_months = record->repeat_months;
+    schedule->trigger.date.year = record->year;
+    schedule->trigger.date.repeat_every_year = record->repeat_every_year;
+    schedule->trigger.relative_seconds = record->relative_seconds;
+    schedule->trigger.next_scheduled_time_utc = record->next_scheduled_time_utc;
+    schedule->validity.start_time = record->validity_start_time;
+    schedule->validity.end_time = record->validity_end_time;
+#if CONFIG_ESP_SCHEDULE_ENABLE_DAYLIGHT
+    schedule->trigger.solar.latitude = record->latitude;
+    schedule->trigger.solar.longitude = record->longitude;
+    schedule->trigger.solar.offset_minutes = record->offset_minutes;
+#endif
+}
+
+static esp_err_t esp_schedule_nvs_erase_namespace(const char *namespace)
 {
-    if (!nvs_enabled) {
-        ESP_LOGD(TAG, "NVS not enabled. Not adding to NVS.");
-        return ESP_ERR_INVALID_STATE;
-    }
     nvs_handle_t nvs_handle;
-    esp_err_t err = nvs_open_from_partition(esp_schedule_nvs_partition, ESP_SCHEDULE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    esp_err_t err = nvs_open_from_partition(esp_schedule_nvs_partition, namespace, NVS_READWRITE, &nvs_handle);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "NVS open failed with error %d", err);
         return err;
     }
-
-    /* Check if this is new schedule or editing an existing schedule */
-    size_t buf_size;
-    bool editing_schedule = true;
-    err = nvs_get_blob(nvs_handle, schedule->name, NULL, &buf_size);
+    err = nvs_erase_all(nvs_handle);
     if (err != ESP_OK) {
-        if (err == ESP_ERR_NVS_NOT_FOUND) {
-            editing_schedule = false;
+        ESP_LOGE(TAG, "NVS erase all keys failed with error %d", err);
+        nvs_close(nvs_handle);
+        return err;
+    }
+    err = nvs_commit(nvs_handle);
+    nvs_close(nvs_handle);
+    return err;
+}
+
+/* `records` is a scratch buffer of ESP_SCHEDULE_NVS_CHUNK_RECORDS records, too large for the stack of the callers */
+static esp_err_t esp_schedule_nvs_write_chunk(nvs_handle_t nvs_handle, unsigned int chunk, esp_schedule_nvs_record_t *records)
+{
+    size_t record_count = 0;
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    snprintf(key, sizeof(key), ESP_SCHEDULE_NVS_CHUNK_KEY_FMT, chunk);
+
+    /* Trailing free slots are not stored */
+    for (size_t i = 0; i < ESP_SCHEDULE_NVS_CHUNK_RECORDS; i++) {
+        size_t slot = chunk * ESP_SCHEDULE_NVS_CHUNK_RECORDS + i;
+        esp_schedule_t *schedule = slot < ESP_SCHEDULE_NVS_MAX_SCHEDULES ? esp_schedule_get_by_slot(slot) : NULL;
+        if (schedule) {
+            esp_schedule_nvs_to_record(schedule, &records[i]);
+            record_count = i + 1;
         } else {
-            ESP_LOGE(TAG, "NVS get failed with error %d", err);
-            nvs_close(nvs_handle);
-            return err;
+            memset(&records[i], 0, sizeof(records[i]));
         }
-    } else {
-        ESP_LOGI(TAG, "Updating the existing schedule %s", schedule->name);
     }
+    if (record_count == 0) {
+        esp_err_t err = nvs_erase_key(nvs_handle, key);
+        return err == ESP_ERR_NVS_NOT_FOUND ? ESP_OK : err;
+    }
+    return nvs_set_blob(nvs_handle, key, records, record_count * sizeof(esp_schedule_nvs_record_t));
+}
 
-    err = nvs_set_blob(nvs_handle, schedule->name, schedule, sizeof(esp_schedule_t));
+/* Write all the modified chunks of the table, with a single commit */
+static esp_err_t esp_schedule_nvs_flush(void)
+{
+    if (dirty_chunks == 0) {
+        return ESP_OK;
+    }
+    esp_schedule_nvs_record_t *records = (esp_schedule_nvs_record_t *)MEM_ALLOC_EXTRAM(sizeof(esp_schedule_nvs_record_t) * ESP_SCHEDULE_NVS_CHUNK_RECORDS);
+    if (records == NULL) {
+        ESP_LOGE(TAG, "Could not allocate schedule records");
+        return ESP_ERR_NO_MEM;
+    }
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open_from_partition(esp_schedule_nvs_partition, ESP_SCHEDULE_NVS_TABLE_NAMESPACE, NVS_READWRITE, &nvs_handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS set failed with error %d", err);
-        nvs_close(nvs_handle);
+        ESP_LOGE(TAG, "NVS open failed with error %d", err);
+        free(records);
         return err;
     }
-    if (editing_schedule == false) {
-        uint8_t schedule_count;
-        err = nvs_get_u8(nvs_handle, ESP_SCHEDULE_COUNT_KEY, &schedule_count);
-        if (err != ESP_OK) {
-            if (err == ESP_ERR_NVS_NOT_FOUND) {
-                schedule_count = 0;
-            } else {
-                ESP_LOGE(TAG, "NVS get failed with error %d", err);
-                nvs_close(nvs_handle);
-                return err;
-            }
+    unsigned int chunk_count = 0;
+    for (unsigned int chunk = 0; chunk < ESP_SCHEDULE_NVS_CHUNKS; chunk++) {
+        if (!(dirty_chunks & (1UL << chunk))) {
+            continue;
         }
-        schedule_count++;
-        err = nvs_set_u8(nvs_handle, ESP_SCHEDULE_COUNT_KEY, schedule_count);
+        err = esp_schedule_nvs_write_chunk(nvs_handle, chunk, records);
         if (err != ESP_OK) {
-            ESP_LOGE(TAG, "NVS set failed for schedule count with error %d", err);
+            ESP_LOGE(TAG, "NVS set failed for schedule table chunk %u with error %d", chunk, err);
             nvs_close(nvs_handle);
+            free(records);
             return err;
         }
+        dirty_chunks &= ~(1UL << chunk);
+        chunk_count++;
     }
-    nvs_commit(nvs_handle);
+    free(records);
+    err = nvs_commit(nvs_handle);
     nvs_close(nvs_handle);
-    ESP_LOGI(TAG, "Schedule %s added in NVS", schedule->name);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "NVS commit failed with error %d", err);
+        return err;
+    }
+    ESP_LOGD(TAG, "%u schedule table chunks written in NVS", chunk_count);
+
+    if (legacy_pending) {
+        /* The schedules of the previous format are now all in the table */
+        if (esp_schedule_nvs_erase_namespace(ESP_SCHEDULE_NVS_NAMESPACE) == ESP_OK) {
+            ESP_LOGI(TAG, "Schedules moved to the schedule table");
+            legacy_pending = false;
+        }
+    }
     return ESP_OK;
 }
 
-esp_err_t esp_schedule_nvs_remove_all(void)
+static esp_err_t esp_schedule_nvs_mark_dirty(esp_schedule_t *schedule)
 {
     if (!nvs_enabled) {
-        ESP_LOGD(TAG, "NVS not enabled. Not removing from NVS.");
+        ESP_LOGD(TAG, "NVS not enabled. Not updating NVS.");
         return ESP_ERR_INVALID_STATE;
     }
-    nvs_handle_t nvs_handle;
-    esp_err_t err = nvs_open_from_partition(esp_schedule_nvs_partition, ESP_SCHEDULE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS open failed with error %d", err);
-        return err;
+    if (schedule->slot < 0 || schedule->slot >= ESP_SCHEDULE_NVS_MAX_SCHEDULES) {
+        ESP_LOGE(TAG, "Schedule %s can't be stored in NVS. Only %d schedules can be stored.", schedule->name, ESP_SCHEDULE_NVS_MAX_SCHEDULES);
+        return ESP_ERR_NO_MEM;
     }
-    err = nvs_erase_all(nvs_handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS erase all keys failed with error %d", err);
-        nvs_close(nvs_handle);
-        return err;
+    dirty_chunks |= 1UL << (schedule->slot / ESP_SCHEDULE_NVS_CHUNK_RECORDS);
+    if (batch_depth > 0) {
+        /* Written when the batch is committed */
+        return ESP_OK;
     }
-    nvs_commit(nvs_handle);
-    nvs_close(nvs_handle);
-    ESP_LOGI(TAG, "All schedules removed from NVS");
-    return ESP_OK;
+    return esp_schedule_nvs_flush();
+}
+
+esp_err_t esp_schedule_nvs_add(esp_schedule_t *schedule)
+{
+    esp_err_t err = esp_schedule_nvs_mark_dirty(schedule);
+    if (err == ESP_OK) {
+        ESP_LOGD(TAG, "Schedule %s added in NVS", schedule->name);
+    }
+    return err;
 }
 
 esp_err_t esp_schedule_nvs_remove(esp_schedule_t *schedule)
 {
-    if (!nvs_enabled) {
-        ESP_LOGD(TAG, "NVS not enabled. Not removing from NVS.");
+    esp_err_t err = esp_schedule_nvs_mark_dirty(schedule);
+    if (err == ESP_OK) {
+        ESP_LOGD(TAG, "Schedule %s removed from NVS", schedule->name);
+    }
+    return err;
+}
+
+esp_err_t esp_schedule_nvs_batch_begin(void)
+{
+    batch_depth++;
+    return ESP_OK;
+}
+
+esp_err_t esp_schedule_nvs_batch_commit(void)
+{
+    if (batch_depth == 0) {
         return ESP_ERR_INVALID_STATE;
     }
-    nvs_handle_t nvs_handle;
-    esp_err_t err = nvs_open_from_partition(esp_schedule_nvs_partition, ESP_SCHEDULE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS open failed with error %d", err);
-        return err;
+    if (--batch_depth > 0 || !nvs_enabled) {
+        return ESP_OK;
     }
-    err = nvs_erase_key(nvs_handle, schedule->name);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS erase key failed with error %d", err);
-        nvs_close(nvs_handle);
-        return err;
+    return esp_schedule_nvs_flush();
+}
+
+esp_err_t esp_schedule_nvs_remove_all(void)
+{
+    if (!nvs_enabled) {
+        ESP_LOGD(TAG, "NVS not enabled. Not removing from NVS.");
+        return ESP_ERR_INVALID_STATE;
     }
-    uint8_t schedule_count;
-    err = nvs_get_u8(nvs_handle, ESP_SCHEDULE_COUNT_KEY, &schedule_count);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS get failed for schedule count with error %d", err);
-        nvs_close(nvs_handle);
-        return err;
+    esp_err_t err = esp_schedule_nvs_erase_namespace(ESP_SCHEDULE_NVS_TABLE_NAMESPACE);
+    if (err == ESP_OK) {
+        err = esp_schedule_nvs_erase_namespace(ESP_SCHEDULE_NVS_NAMESPACE);
     }
-    schedule_count--;
-    err = nvs_set_u8(nvs_handle, ESP_SCHEDULE_COUNT_KEY, schedule_count);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS set failed for schedule count with error %d", err);
-        nvs_close(nvs_handle);
         return err;
     }
-    nvs_commit(nvs_handle);
-    nvs_close(nvs_handle);
-    ESP_LOGI(TAG, "Schedule %s removed from NVS", schedule->name);
+    dirty_chunks = 0;
+    legacy_pending = false;
+    ESP_LOGI(TAG, "All schedules removed from NVS");
     return ESP_OK;
 }
 
-static uint8_t esp_schedule_nvs_get_count(void)
+
+static uint8_t esp_schedule_nvs_legacy_get_count(void)
 {
     if (!nvs_enabled) {
         ESP_LOGD(TAG, "NVS not enabled. Not getting count from NVS.");
@@ -173,7 +301,7 @@ static uint8_t esp_schedule_nvs_get_count(void)
     return schedule_count;
 }
 
-static esp_schedule_handle_t esp_schedule_nvs_get(char *nvs_key)
+static esp_schedule_handle_t esp_schedule_nvs_legacy_get(char *nvs_key)
 {
     if (!nvs_enabled) {
         ESP_LOGD(TAG, "NVS not enabled. Not getting from NVS.");
@@ -192,7 +320,12 @@ static esp_schedule_handle_t esp_schedule_nvs_get(char *nvs_key)
         nvs_close(nvs_handle);
         return NULL;
     }
-    esp_schedule_t *schedule = (esp_schedule_t *)malloc(buf_size);
+    if (buf_size > sizeof(esp_schedule_t)) {
+        ESP_LOGE(TAG, "Invalid size %d of schedule %s", (int)buf_size, nvs_key);
+        nvs_close(nvs_handle);
+        return NULL;
+    }
+    esp_schedule_t *schedule = (esp_schedule_t *)MEM_CALLOC_EXTRAM(1, sizeof(esp_schedule_t));
     if (schedule == NULL) {
         ESP_LOGE(TAG, "Could not allocate handle");
         nvs_close(nvs_handle);
@@ -206,18 +339,17 @@ static esp_schedule_handle_t esp_schedule_nvs_get(char *nvs_key)
         return NULL;
     }
     nvs_close(nvs_handle);
+    /* The callbacks and the private data stored by previous versions are not valid anymore */
+    schedule->timestamp_cb = NULL;
+    schedule->priv_data = NULL;
+    schedule->slot = -1;
     ESP_LOGI(TAG, "Schedule %s found in NVS", schedule->name);
     return (esp_schedule_handle_t) schedule;
 }
 
-esp_schedule_handle_t *esp_schedule_nvs_get_all(uint8_t *schedule_count)
+static esp_schedule_handle_t *esp_schedule_nvs_legacy_get_all(uint8_t *schedule_count)
 {
-    if (!nvs_enabled) {
-        ESP_LOGD(TAG, "NVS not enabled. Not Initialising NVS.");
-        return NULL;
-    }
-
-    *schedule_count = esp_schedule_nvs_get_count();
+    *schedule_count = esp_schedule_nvs_legacy_get_count();
     if (*schedule_count == 0) {
         ESP_LOGI(TAG, "No Entries found in NVS");
         return NULL;
@@ -241,7 +373,7 @@ esp_schedule_handle_t *esp_schedule_nvs_get_all(uint8_t *schedule_count)
     while (err == ESP_OK) {
         nvs_entry_info(nvs_iterator, &nvs_entry);
         ESP_LOGI(TAG, "Found schedule in NVS with key: %s", nvs_entry.key);
-        handle_list[handle_count] = esp_schedule_nvs_get(nvs_entry.key);
+        handle_list[handle_count] = esp_schedule_nvs_legacy_get(nvs_entry.key);
         if (handle_list[handle_count] != NULL) {
             /* Increase count only if nvs_get was successful */
             handle_count++;
@@ -254,6 +386,96 @@ esp_schedule_handle_t *esp_schedule_nvs_get_all(uint8_t *schedule_count)
     return handle_list;
 }
 
+/* Read a chunk of the table and append its schedules to the list. `records` is a scratch buffer of ESP_SCHEDULE_NVS_CHUNK_RECORDS records. */
+static esp_err_t esp_schedule_nvs_read_chunk(nvs_handle_t nvs_handle, const char *key, esp_schedule_nvs_record_t *records,
+        esp_schedule_handle_t *handle_list, uint8_t *schedule_count)
+{
+    unsigned int chunk;
+    if (sscanf(key, ESP_SCHEDULE_NVS_CHUNK_KEY_FMT, &chunk) != 1 || chunk >= ESP_SCHEDULE_NVS_CHUNKS) {
+        ESP_LOGW(TAG, "Unknown key %s in the schedule table", key);
+        return ESP_OK;
+    }
+    size_t buf_size = sizeof(esp_schedule_nvs_record_t) * ESP_SCHEDULE_NVS_CHUNK_RECORDS;
+    esp_err_t err = nvs_get_blob(nvs_handle, key, records, &buf_size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "NVS get failed for %s with error %d", key, err);
+        return err;
+    }
+    for (size_t i = 0; i < buf_size / sizeof(esp_schedule_nvs_record_t); i++) {
+        size_t slot = chunk * ESP_SCHEDULE_NVS_CHUNK_RECORDS + i;
+        if (records[i].name[0] == '\0' || slot >= ESP_SCHEDULE_NVS_MAX_SCHEDULES) {
+            continue;
+        }
+        esp_schedule_t *schedule = (esp_schedule_t *)MEM_CALLOC_EXTRAM(1, sizeof(esp_schedule_t));
+        if (schedule == NULL) {
+            ESP_LOGE(TAG, "Could not allocate handle");
+            return ESP_ERR_NO_MEM;
+        }
+        esp_schedule_nvs_from_record(&records[i], schedule);
+        schedule->slot = slot;
+        schedule->heap_index = -1;
+        handle_list[(*schedule_count)++] = (esp_schedule_handle_t)schedule;
+    }
+    return ESP_OK;
+}
+
+esp_schedule_handle_t *esp_schedule_nvs_get_all(uint8_t *schedule_count)
+{
+    *schedule_count = 0;
+    if (!nvs_enabled) {
+        ESP_LOGD(TAG, "NVS not enabled. Not Initialising NVS.");
+        return NULL;
+    }
+
+    nvs_iterator_t nvs_iterator = NULL;
+    esp_err_t err = nvs_entry_find(esp_schedule_nvs_partition, ESP_SCHEDULE_NVS_TABLE_NAMESPACE, NVS_TYPE_BLOB, &nvs_iterator);
+    if (err != ESP_OK) {
+        /* No schedule table yet. Get the schedules stored by previous versions, if any. */
+        esp_schedule_handle_t *handle_list = esp_schedule_nvs_legacy_get_all(schedule_count);
+        legacy_pending = (handle_list != NULL);
+        return handle_list;
+    }
+
+    /* The whole table is read with the namespace opened once */
+    esp_schedule_handle_t *handle_list = (esp_schedule_handle_t *)MEM_ALLOC_EXTRAM(sizeof(esp_schedule_handle_t) * ESP_SCHEDULE_NVS_MAX_SCHEDULES);
+    esp_schedule_nvs_record_t *records = (esp_schedule_nvs_record_t *)MEM_ALLOC_EXTRAM(sizeof(esp_schedule_nvs_record_t) * ESP_SCHEDULE_NVS_CHUNK_RECORDS);
+    nvs_handle_t nvs_handle;
+    if (handle_list == NULL || records == NULL) {
+        ESP_LOGE(TAG, "Could not allocate schedule list");
+        nvs_release_iterator(nvs_iterator);
+        free(handle_list);
+        free(records);
+        return NULL;
+    }
+    err = nvs_open_from_partition(esp_schedule_nvs_partition, ESP_SCHEDULE_NVS_TABLE_NAMESPACE, NVS_READONLY, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "NVS open failed with error %d", err);
+        nvs_release_iterator(nvs_iterator);
+        free(handle_list);
+        free(records);
+        return NULL;
+    }
+    while (err == ESP_OK) {
+        nvs_entry_info_t nvs_entry;
+        nvs_entry_info(nvs_iterator, &nvs_entry);
+        if (esp_schedule_nvs_read_chunk(nvs_handle, nvs_entry.key, records, handle_list, schedule_count) == ESP_ERR_NO_MEM) {
+            break;
+        }
+        err = nvs_entry_next(&nvs_iterator);
+    }
+    nvs_release_iterator(nvs_iterator);
+    nvs_close(nvs_handle);
+    free(records);
+
+    if (*schedule_count == 0) {
+        ESP_LOGI(TAG, "No Entries found in NVS");
+        free(handle_list);
+        return NULL;
+    }
+    ESP_LOGI(TAG, "Found %d schedules in NVS", *schedule_count);
+    return handle_list;
+}
+
 bool esp_schedule_nvs_is_enabled(void)
 {
     return nvs_enabled;
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/time.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "esp_heap_caps.h"
+#include "esp_newlib.h"
+#include "unity_test_utils_memory.h"
+#include "esp_netif.h"
+#include "esp_schedule.h"
+#include "test_esp_schedule.h"
+
+void setUp(void)
+{
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    esp_reent_cleanup();    /* clean up some of the newlib's lazy allocations */
+    unity_utils_evaluate_leaks_direct(50);
+}
+
+void app_main(void)
+{
+    /* The dispatcher timer, its lock, the schedule table, the heap and SNTP are allocated once for good,
+     * create them before the memory leak checks */
+    struct timeval tv = { .tv_sec = TEST_START_TIME };
+    settimeofday(&tv, NULL);
+    uint8_t count = 0;
+    ESP_ERROR_CHECK(esp_netif_init());
+    esp_schedule_init(false, NULL, &count);
+    esp_schedule_config_t config = {
+        .name = "init",
+        .trigger = {
+            .type = ESP_SCHEDULE_TYPE_RELATIVE,
+            .relative_seconds = 1,
+        },
+    };
+    esp_schedule_handle_t handle = esp_schedule_create(&config);
+    esp_schedule_enable(handle);
+    esp_schedule_delete(handle);
+
+    printf("Running esp_schedule component tests\n");
+    unity_run_menu();
+}
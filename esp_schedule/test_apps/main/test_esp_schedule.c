@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_schedule.h"
+#include "test_esp_schedule.h"
+
+#define TEST_SCHEDULE_COUNT 6
+
+static esp_schedule_handle_t s_handles[TEST_SCHEDULE_COUNT];
+static time_t s_fire_time[TEST_SCHEDULE_COUNT];
+static int s_order[TEST_SCHEDULE_COUNT * 2];
+static volatile int s_fired;
+
+static void test_reset(void)
+{
+    struct timeval tv = { .tv_sec = TEST_START_TIME };
+    settimeofday(&tv, NULL);
+    memset(s_handles, 0, sizeof(s_handles));
+    memset(s_fire_time, 0, sizeof(s_fire_time));
+    s_fired = 0;
+}
+
+static void test_record(void *priv_data)
+{
+    int index = (int)(intptr_t)priv_data;
+    s_fire_time[index] = time(NULL);
+    s_order[s_fired] = index;
+    s_fired++;
+}
+
+static void test_record_cb(esp_schedule_handle_t handle, void *priv_data)
+{
+    test_record(priv_data);
+}
+
+/* The first schedule to trigger deletes itself and the schedules of odd index, and disables the others */
+static void test_remove_all_cb(esp_schedule_handle_t handle, void *priv_data)
+{
+    test_record(priv_data);
+    if (s_fired > 1) {
+        return;
+    }
+    for (int i = 0; i < TEST_SCHEDULE_COUNT; i++) {
+        if (s_handles[i] == handle || i % 2) {
+            esp_schedule_delete(s_handles[i]);
+            s_handles[i] = NULL;
+        } else {
+            esp_schedule_disable(s_handles[i]);
+        }
+    }
+}
+
+static void test_create(int index, int relative_seconds, esp_schedule_trigger_cb_t trigger_cb)
+{
+    esp_schedule_config_t config = {
+        .trigger = {
+            .type = ESP_SCHEDULE_TYPE_RELATIVE,
+            .relative_seconds = relative_seconds,
+        },
+        .trigger_cb = trigger_cb,
+        .priv_data = (void *)(intptr_t)index,
+    };
+    snprintf(config.name, sizeof(config.name), "test%d", index);
+    s_handles[index] = esp_schedule_create(&config);
+    TEST_ASSERT_NOT_NULL(s_handles[index]);
+}
+
+static void test_delete_all(void)
+{
+    for (int i = 0; i < TEST_SCHEDULE_COUNT; i++) {
+        if (s_handles[i]) {
+            TEST_ESP_OK(esp_schedule_delete(s_handles[i]));
+            s_handles[i] = NULL;
+        }
+    }
+}
+
+TEST_CASE("Schedules trigger in the order of their time", "[esp_schedule]")
+{
+    const int relative_seconds[] = {3, 1, 2};
+    const int expected_order[] = {1, 2, 0};
+
+    test_reset();
+    for (int i = 0; i < 3; i++) {
+        test_create(i, relative_seconds[i], test_record_cb);
+        TEST_ESP_OK(esp_schedule_enable(s_handles[i]));
+    }
+    vTaskDelay(pdMS_TO_TICKS(4500));
+    TEST_ASSERT_EQUAL(3, s_fired);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected_order, s_order, 3);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_INT_WITHIN(1, TEST_START_TIME + relative_seconds[i], s_fire_time[i]);
+    }
+    test_delete_all();
+}
+
+TEST_CASE("Schedules due in the same second all trigger once", "[esp_schedule]")
+{
+    test_reset();
+    for (int i = 0; i < TEST_SCHEDULE_COUNT; i++) {
+        test_create(i, 1, test_record_cb);
+        TEST_ESP_OK(esp_schedule_enable(s_handles[i]));
+    }
+    vTaskDelay(pdMS_TO_TICKS(3000));
+    TEST_ASSERT_EQUAL(TEST_SCHEDULE_COUNT, s_fired);
+    for (int i = 1; i < TEST_SCHEDULE_COUNT; i++) {
+        TEST_ASSERT_EQUAL(s_fire_time[0], s_fire_time[i]);
+    }
+    test_delete_all();
+}
+
+TEST_CASE("Schedules can be disabled and deleted from a callback", "[esp_schedule]")
+{
+    test_reset();
+    for (int i = 0; i < TEST_SCHEDULE_COUNT; i++) {
+        test_create(i, 1, test_remove_all_cb);
+        TEST_ESP_OK(esp_schedule_enable(s_handles[i]));
+    }
+    vTaskDelay(pdMS_TO_TICKS(2500));
+    /* All the others were due in the same second, but have been removed before their turn */
+    TEST_ASSERT_EQUAL(1, s_fired);
+    TEST_ASSERT_NULL(s_handles[s_order[0]]);
+
+    /* The dispatcher keeps running for the disabled schedules enabled again */
+    int disabled = 0;
+    for (int i = 0; i < TEST_SCHEDULE_COUNT; i++) {
+        if (s_handles[i]) {
+            TEST_ESP_OK(esp_schedule_enable(s_handles[i]));
+            disabled++;
+        }
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(TEST_SCHEDULE_COUNT / 2 - 1, disabled);
+    vTaskDelay(pdMS_TO_TICKS(2500));
+    TEST_ASSERT_EQUAL(1 + disabled, s_fired);
+    test_delete_all();
+}
@@ -0,0 +1,10 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/* 2026-01-01 00:00:00 UTC, the schedules are only started once the time is set */
+#define TEST_START_TIME 1767225600
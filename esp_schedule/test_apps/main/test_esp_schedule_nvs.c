@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include "unity.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "esp_schedule.h"
+#include "test_esp_schedule.h"
+
+#define TEST_LEGACY_COUNT 3
+
+/* Layout of the schedules stored by the versions before the schedule table, one blob per schedule */
+typedef struct {
+    char name[MAX_SCHEDULE_NAME_LEN + 1];
+    esp_schedule_trigger_t trigger;
+    uint32_t next_scheduled_time_diff;
+    void *timer;
+    esp_schedule_trigger_cb_t trigger_cb;
+    esp_schedule_timestamp_cb_t timestamp_cb;
+    void *priv_data;
+    esp_schedule_validity_t validity;
+} test_legacy_schedule_t;
+
+static void test_write_legacy_schedules(void)
+{
+    nvs_handle_t nvs_handle;
+    TEST_ESP_OK(nvs_open("schd", NVS_READWRITE, &nvs_handle));
+    for (int i = 0; i < TEST_LEGACY_COUNT; i++) {
+        /* The handles and the pointers saved with the schedules are stale */
+        test_legacy_schedule_t schedule = {
+            .trigger = {
+                .type = ESP_SCHEDULE_TYPE_DAYS_OF_WEEK,
+                .hours = 7 + i,
+                .minutes = 30,
+                .day.repeat_days = ESP_SCHEDULE_DAY_EVERYDAY,
+            },
+            .timer = (void *)0x3fc01234,
+            .timestamp_cb = (esp_schedule_timestamp_cb_t)0x42001234,
+            .priv_data = (void *)0x3fc05678,
+        };
+        snprintf(schedule.name, sizeof(schedule.name), "legacy%d", i);
+        TEST_ESP_OK(nvs_set_blob(nvs_handle, schedule.name, &schedule, sizeof(schedule)));
+    }
+    /* One time schedule which has already expired, deleted when loaded */
+    test_legacy_schedule_t expired = {
+        .name = "expired",
+        .trigger = {
+            .type = ESP_SCHEDULE_TYPE_RELATIVE,
+            .relative_seconds = 60,
+            .next_scheduled_time_utc = TEST_START_TIME - 60,
+        },
+    };
+    TEST_ESP_OK(nvs_set_blob(nvs_handle, expired.name, &expired, sizeof(expired)));
+    TEST_ESP_OK(nvs_set_u8(nvs_handle, "schd_count", TEST_LEGACY_COUNT + 1));
+    TEST_ESP_OK(nvs_commit(nvs_handle));
+    nvs_close(nvs_handle);
+}
+
+/* Size of the first chunk of the schedule table, which holds the records up to the last used slot */
+static size_t test_get_chunk_size(void)
+{
+    nvs_handle_t nvs_handle;
+    size_t size = 0;
+    TEST_ESP_OK(nvs_open("schd_tbl", NVS_READONLY, &nvs_handle));
+    TEST_ESP_OK(nvs_get_blob(nvs_handle, "chunk0", NULL, &size));
+    nvs_close(nvs_handle);
+    return size;
+}
+
+static esp_schedule_handle_t test_create(const char *name)
+{
+    esp_schedule_config_t config = {
+        .trigger = {
+            .type = ESP_SCHEDULE_TYPE_RELATIVE,
+            .relative_seconds = 3600,
+        },
+    };
+    strlcpy(config.name, name, sizeof(config.name));
+    esp_schedule_handle_t handle = esp_schedule_create(&config);
+    TEST_ASSERT_NOT_NULL(handle);
+    return handle;
+}
+
+TEST_CASE("Schedules of the previous NVS format are moved to the schedule table", "[esp_schedule][nvs]")
+{
+    struct timeval tv = { .tv_sec = TEST_START_TIME };
+    settimeofday(&tv, NULL);
+    TEST_ESP_OK(nvs_flash_erase());
+    TEST_ESP_OK(nvs_flash_init());
+    test_write_legacy_schedules();
+
+    uint8_t count = 0;
+    esp_schedule_handle_t *loaded = esp_schedule_init(true, NULL, &count);
+    TEST_ASSERT_NOT_NULL(loaded);
+    TEST_ASSERT_EQUAL(TEST_LEGACY_COUNT, count);
+    esp_schedule_handle_t handles[TEST_LEGACY_COUNT + 4] = {0};
+    for (int i = 0; i < count; i++) {
+        esp_schedule_config_t config;
+        TEST_ESP_OK(esp_schedule_get(loaded[i], &config));
+        int index = config.name[strlen("legacy")] - '0';
+        TEST_ASSERT_EQUAL_STRING_LEN("legacy", config.name, strlen("legacy"));
+        TEST_ASSERT_TRUE(index >= 0 && index < TEST_LEGACY_COUNT);
+        TEST_ASSERT_EQUAL(ESP_SCHEDULE_TYPE_DAYS_OF_WEEK, config.trigger.type);
+        TEST_ASSERT_EQUAL(7 + index, config.trigger.hours);
+        TEST_ASSERT_EQUAL(30, config.trigger.minutes);
+        TEST_ASSERT_EQUAL(ESP_SCHEDULE_DAY_EVERYDAY, config.trigger.day.repeat_days);
+        TEST_ASSERT_NULL(config.timestamp_cb);
+        TEST_ASSERT_NULL(config.priv_data);
+        handles[i] = loaded[i];
+    }
+    free(loaded);
+
+    /* The schedules of the previous format are erased once the table is written */
+    nvs_handle_t nvs_handle;
+    uint8_t legacy_count;
+    size_t legacy_size;
+    TEST_ESP_OK(nvs_open("schd", NVS_READONLY, &nvs_handle));
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, nvs_get_u8(nvs_handle, "schd_count", &legacy_count));
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, nvs_get_blob(nvs_handle, "legacy0", NULL, &legacy_size));
+    nvs_close(nvs_handle);
+    /* The slot of the expired schedule, loaded last, is free and not stored */
+    size_t record_size = test_get_chunk_size() / TEST_LEGACY_COUNT;
+    TEST_ASSERT_NOT_EQUAL(0, record_size);
+    TEST_ASSERT_EQUAL(TEST_LEGACY_COUNT * record_size, test_get_chunk_size());
+
+    /* The slot of a deleted schedule is given to the next schedule created */
+    esp_schedule_config_t configs[TEST_LEGACY_COUNT + 4];
+    size_t export_count = TEST_LEGACY_COUNT + 4;
+    TEST_ESP_OK(esp_schedule_export(configs, &export_count));
+    TEST_ASSERT_EQUAL(TEST_LEGACY_COUNT, export_count);
+    for (int i = 0; i < TEST_LEGACY_COUNT; i++) {
+        esp_schedule_config_t config;
+        TEST_ESP_OK(esp_schedule_get(handles[i], &config));
+        if (strcmp(config.name, configs[1].name) == 0) {
+            TEST_ESP_OK(esp_schedule_delete(handles[i]));
+            handles[i] = test_create("reused");
+        }
+    }
+    export_count = TEST_LEGACY_COUNT + 4;
+    TEST_ESP_OK(esp_schedule_export(configs, &export_count));
+    TEST_ASSERT_EQUAL(TEST_LEGACY_COUNT, export_count);
+    TEST_ASSERT_EQUAL_STRING("reused", configs[1].name);
+    TEST_ASSERT_EQUAL(TEST_LEGACY_COUNT * record_size, test_get_chunk_size());
+
+    /* Nothing is written to NVS before the batch is committed, then the table is written at once */
+    nvs_stats_t stats_before;
+    nvs_stats_t stats;
+    TEST_ESP_OK(nvs_get_stats(NULL, &stats_before));
+    TEST_ESP_OK(esp_schedule_batch_begin());
+    for (int i = 0; i < 3; i++) {
+        char name[MAX_SCHEDULE_NAME_LEN + 1];
+        snprintf(name, sizeof(name), "batch%d", i);
+        handles[TEST_LEGACY_COUNT + i] = test_create(name);
+    }
+    TEST_ESP_OK(nvs_get_stats(NULL, &stats));
+    TEST_ASSERT_EQUAL(stats_before.used_entries, stats.used_entries);
+    TEST_ASSERT_EQUAL(TEST_LEGACY_COUNT * record_size, test_get_chunk_size());
+    TEST_ESP_OK(esp_schedule_batch_commit());
+    TEST_ASSERT_EQUAL((TEST_LEGACY_COUNT + 3) * record_size, test_get_chunk_size());
+
+    for (int i = 0; i < TEST_LEGACY_COUNT + 3; i++) {
+        TEST_ESP_OK(esp_schedule_delete(handles[i]));
+    }
+    TEST_ESP_OK(nvs_flash_deinit());
+}
@@ -0,0 +1,13 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+from pytest_embedded import Dut
+
+
+@pytest.mark.generic
+def test_esp_schedule(dut: Dut) -> None:
+    """
+    Test esp_schedule component functionality
+    """
+    dut.run_all_single_board_cases(timeout=60)
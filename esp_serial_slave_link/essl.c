@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -139,6 +140,146 @@ esp_err_t essl_get_packet(essl_handle_t handle, void *out_data, size_t size, siz
     return ESP_OK;
 }
 
+esp_err_t essl_stream_send(essl_handle_t handle, const essl_stream_packet_t *packets, size_t count, size_t *out_sent, uint32_t wait_ms)
+{
+    if (out_sent) {
+        *out_sent = 0;
+    }
+    if (handle == NULL || packets == NULL || count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->send_packet == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    esp_err_t err = ESP_OK;
+    const uint32_t timeout_ticks = pdMS_TO_TICKS(wait_ms);
+
+    uint32_t pre = xTaskGetTickCount();
+    uint32_t remain_wait_ms = wait_ms;
+    size_t sent = 0;
+
+    while (sent < count) {
+        const essl_stream_packet_t *packet = &packets[sent];
+        if (packet->data == NULL || packet->length == 0) {
+            err = ESP_ERR_INVALID_ARG;
+            break;
+        }
+        // The lower layer only reads the TX buffer num from the slave when the buffers it knows to be free are not enough
+        err = handle->send_packet(handle->args, packet->data, packet->length, remain_wait_ms);
+        if (err == ESP_OK) {
+            handle->stream_stats.packets_sent++;
+            handle->stream_stats.bytes_sent += packet->length;
+            sent++;
+            continue;
+        } else if (err != ESP_ERR_NOT_FOUND) {
+            break;
+        } // else ESP_ERR_NOT_FOUND
+        //the slave has not loaded enough buffers yet, retry until timeout
+        handle->stream_stats.tx_stalls++;
+        remain_wait_ms = pdTICKS_TO_MS(TIME_REMAIN(pre, xTaskGetTickCount(), timeout_ticks));
+        if (remain_wait_ms == 0) {
+            err = ESP_ERR_TIMEOUT;
+            break;
+        }
+    }
+
+    if (out_sent) {
+        *out_sent = sent;
+    }
+    return err;
+}
+
+esp_err_t essl_stream_recv(essl_handle_t handle, void *out_data, size_t size, size_t *out_length, uint32_t wait_ms)
+{
+    if (handle == NULL || out_data == NULL || size == 0 || out_length == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->get_packet == NULL || handle->update_rx_data_size == NULL || handle->get_rx_data_size == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    esp_err_t err;
+    const uint32_t timeout_ticks = pdMS_TO_TICKS(wait_ms);
+
+    uint32_t pre = xTaskGetTickCount();
+    uint32_t wait_remain_ms = wait_ms;
+    *out_length = 0;
+
+    // Data the host already knows about is read without querying the slave again
+    uint32_t data_available = handle->get_rx_data_size(handle->args);
+    while (data_available == 0) {
+        err = handle->update_rx_data_size(handle->args, wait_remain_ms);
+        if (err != ESP_OK) {
+            return err;
+        }
+        handle->stream_stats.rx_size_refreshes++;
+        data_available = handle->get_rx_data_size(handle->args);
+        if (data_available > 0) {
+            break;
+        }
+
+        wait_remain_ms = pdTICKS_TO_MS(TIME_REMAIN(pre, xTaskGetTickCount(), timeout_ticks));
+        if (wait_remain_ms == 0) {
+            break;
+        }
+        // Sleep on the interrupt line rather than polling the slave over the bus, if the device has one
+        if (handle->wait_int) {
+            err = handle->wait_int(handle->args, wait_remain_ms);
+            if (err == ESP_ERR_TIMEOUT) {
+                break;
+            } else if (err != ESP_OK && err != ESP_ERR_NOT_SUPPORTED) {
+                return err;
+            }
+            // The interrupt stays raised until cleared. Clear it before reading the RX data size, so that data
+            // arriving after the read raises it again instead of being missed.
+            if (err == ESP_OK && handle->new_packet_intr_mask && handle->clear_intr) {
+                wait_remain_ms = pdTICKS_TO_MS(TIME_REMAIN(pre, xTaskGetTickCount(), timeout_ticks));
+                err = handle->clear_intr(handle->args, handle->new_packet_intr_mask, wait_remain_ms);
+                if (err != ESP_OK) {
+                    return err;
+                }
+            }
+        }
+    }
+
+    if (data_available == 0) {
+        //the slave has no data to send
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    size_t len = ESSL_MIN(data_available, size);
+    wait_remain_ms = pdTICKS_TO_MS(TIME_REMAIN(pre, xTaskGetTickCount(), timeout_ticks));
+    err = handle->get_packet(handle->args, out_data, len, wait_remain_ms);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    handle->stream_stats.reads++;
+    handle->stream_stats.bytes_received += len;
+    *out_length = len;
+    if (len < data_available) {
+        return ESP_ERR_NOT_FINISHED;
+    }
+    return ESP_OK;
+}
+
+esp_err_t essl_stream_get_stats(essl_handle_t handle, essl_stream_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_stats = handle->stream_stats;
+    return ESP_OK;
+}
+
+esp_err_t essl_stream_reset_stats(essl_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(&handle->stream_stats, 0, sizeof(essl_stream_stats_t));
+    return ESP_OK;
+}
+
 esp_err_t essl_get_tx_buffer_num(essl_handle_t handle, uint32_t *out_tx_num, uint32_t wait_ms)
 {
     if (handle == NULL || out_tx_num == NULL) {
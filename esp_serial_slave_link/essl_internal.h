@@ -9,6 +9,8 @@
 #include <esp_types.h>
 #include <esp_err.h>
 
+#include "essl.h"
+
 /** Context used by the ``esp_serial_slave_link`` component.
  */
 struct essl_dev_t {
@@ -33,6 +35,9 @@ struct essl_dev_t {
     uint32_t (*get_tx_buffer_num)(void *ctx);
     uint32_t (*get_rx_data_size)(void *ctx);
     void (*reset_cnt)(void *ctx);
+
+    uint32_t new_packet_intr_mask;      ///< Interrupt the slave raises when it has new data to send, cleared by ``essl_stream_recv`` after waiting on it. 0 if unknown.
+    essl_stream_stats_t stream_stats;   ///< Statistics of the streaming API, zeroed with the context
 };
 
 typedef struct essl_dev_t essl_dev_t;
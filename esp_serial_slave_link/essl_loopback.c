@@ -0,0 +1,353 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "essl_internal.h"
+#include "essl_loopback.h"
+
+static const char TAG[] = "essl_loopback";
+
+// Same counter widths as the SDIO slave, so that the wrap-around is exercised the same way
+#define TX_BUFFER_MAX   0x1000
+#define TX_BUFFER_MASK  0xFFF
+#define RX_BYTE_MAX     0x100000
+#define RX_BYTE_MASK    0xFFFFF
+
+#define REG_NUM         64
+
+#define LOOPBACK_MIN(a, b)   ((a) < (b) ? (a) : (b))
+
+typedef struct {
+    size_t remain;      ///< Bytes of the packet not read back by the host yet
+    size_t buffers;     ///< Receiving buffers used by the packet, loaded again once it's fully read back
+} loopback_packet_t;
+
+typedef struct {
+    essl_loopback_config_t config;
+
+    // Slave side
+    uint8_t        *fifo;               ///< Looped back data, ``buffer_size * buffer_num`` bytes
+    size_t          fifo_size;
+    size_t          fifo_head;          ///< Offset of the first byte not read back by the host yet
+    size_t          fifo_len;           ///< Bytes not read back by the host yet
+    loopback_packet_t *packets;         ///< Packets not read back by the host yet (at most ``buffer_num``)
+    size_t          packet_head;
+    size_t          packet_num;
+    size_t          slave_tx_loaded;    ///< Accumulated buffers loaded by the slave (TX buffer num counter)
+    size_t          slave_rx_prepared;  ///< Accumulated bytes prepared by the slave (RX data size counter)
+    uint8_t         regs[REG_NUM];
+    uint32_t        intr_raw;
+    uint32_t        intr_ena;
+    uint32_t        slave_intr;         ///< Interrupts sent by the host to the slave
+
+    // Host side, same bookkeeping as ``essl_sdio``
+    size_t          tx_sent_buffers;
+    size_t          tx_sent_buffers_latest;
+    size_t          rx_got_bytes;
+    size_t          rx_got_bytes_latest;
+
+    uint32_t        transactions;
+} essl_loopback_context_t;
+
+static void loopback_transaction(essl_loopback_context_t *ctx)
+{
+    ctx->transactions++;
+    if (ctx->config.transaction_delay_us) {
+        usleep(ctx->config.transaction_delay_us);
+    }
+}
+
+static esp_err_t essl_loopback_init(void *arg, uint32_t wait_ms)
+{
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_wait_for_ready(void *arg, uint32_t wait_ms)
+{
+    return ESP_OK;
+}
+
+static uint32_t essl_loopback_get_tx_buffer_num(void *arg)
+{
+    essl_loopback_context_t *ctx = arg;
+    return (ctx->tx_sent_buffers_latest + TX_BUFFER_MAX - ctx->tx_sent_buffers) % TX_BUFFER_MAX;
+}
+
+static esp_err_t essl_loopback_update_tx_buffer_num(void *arg, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    loopback_transaction(ctx);
+    ctx->tx_sent_buffers_latest = ctx->slave_tx_loaded & TX_BUFFER_MASK;
+    ESP_LOGV(TAG, "update_tx_buffer_num: %d", (int) ctx->tx_sent_buffers_latest);
+    return ESP_OK;
+}
+
+static uint32_t essl_loopback_get_rx_data_size(void *arg)
+{
+    essl_loopback_context_t *ctx = arg;
+    return (ctx->rx_got_bytes_latest + RX_BYTE_MAX - ctx->rx_got_bytes) % RX_BYTE_MAX;
+}
+
+static esp_err_t essl_loopback_update_rx_data_size(void *arg, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    loopback_transaction(ctx);
+    ctx->rx_got_bytes_latest = ctx->slave_rx_prepared & RX_BYTE_MASK;
+    ESP_LOGV(TAG, "update_rx_data_size: %d", (int) ctx->rx_got_bytes_latest);
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_send_packet(void *arg, const void *start, size_t length, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    size_t buffer_used = (length + ctx->config.buffer_size - 1) / ctx->config.buffer_size;
+
+    if (buffer_used > ctx->config.buffer_num) {
+        ESP_LOGE(TAG, "packet of %d bytes exceeds the buffers of the slave", (int) length);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (essl_loopback_get_tx_buffer_num(arg) < buffer_used) {
+        //slave has no enough buffer, try update for once
+        essl_loopback_update_tx_buffer_num(arg, wait_ms);
+        if (essl_loopback_get_tx_buffer_num(arg) < buffer_used) {
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    loopback_transaction(ctx);
+    // The packet fits: the pending data never exceeds the loaded buffers, which never exceed the FIFO
+    const uint8_t *data = start;
+    size_t tail = (ctx->fifo_head + ctx->fifo_len) % ctx->fifo_size;
+    size_t first = LOOPBACK_MIN(length, ctx->fifo_size - tail);
+    memcpy(ctx->fifo + tail, data, first);
+    memcpy(ctx->fifo, data + first, length - first);
+    ctx->fifo_len += length;
+
+    ctx->packets[(ctx->packet_head + ctx->packet_num) % ctx->config.buffer_num] = (loopback_packet_t) {
+        .remain = length,
+        .buffers = buffer_used,
+    };
+    ctx->packet_num++;
+
+    ctx->tx_sent_buffers += buffer_used;
+    ctx->slave_rx_prepared += length;
+    ctx->intr_raw |= ESSL_LOOPBACK_NEW_PACKET_INTR_MASK;
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_get_packet(void *arg, void *out_data, size_t size, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+
+    if (essl_loopback_get_rx_data_size(arg) < size) {
+        essl_loopback_update_rx_data_size(arg, wait_ms);
+        if (essl_loopback_get_rx_data_size(arg) < size) {
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    loopback_transaction(ctx);
+    uint8_t *out = out_data;
+    size_t first = LOOPBACK_MIN(size, ctx->fifo_size - ctx->fifo_head);
+    memcpy(out, ctx->fifo + ctx->fifo_head, first);
+    memcpy(out + first, ctx->fifo, size - first);
+    ctx->fifo_head = (ctx->fifo_head + size) % ctx->fifo_size;
+    ctx->fifo_len -= size;
+    ctx->rx_got_bytes += size;
+
+    // Load the buffers of the packets fully read back again
+    size_t consumed = size;
+    while (consumed > 0 && ctx->packet_num > 0) {
+        loopback_packet_t *packet = &ctx->packets[ctx->packet_head];
+        size_t take = LOOPBACK_MIN(consumed, packet->remain);
+        packet->remain -= take;
+        consumed -= take;
+        if (packet->remain == 0) {
+            ctx->slave_tx_loaded += packet->buffers;
+            ctx->packet_head = (ctx->packet_head + 1) % ctx->config.buffer_num;
+            ctx->packet_num--;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_write_reg(void *arg, uint8_t addr, uint8_t value, uint8_t *value_o, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    if (addr >= REG_NUM) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    loopback_transaction(ctx);
+    ctx->regs[addr] = value;
+    if (value_o) {
+        *value_o = value;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_read_reg(void *arg, uint8_t add, uint8_t *value_o, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    if (add >= REG_NUM) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    loopback_transaction(ctx);
+    *value_o = ctx->regs[add];
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_wait_int(void *arg, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    if (ctx->intr_raw & ctx->intr_ena) {
+        return ESP_OK;
+    }
+    // Nothing runs on the simulated slave side, the interrupt can't be raised while waiting
+    vTaskDelay(pdMS_TO_TICKS(wait_ms));
+    return ESP_ERR_TIMEOUT;
+}
+
+static esp_err_t essl_loopback_clear_intr(void *arg, uint32_t intr_mask, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    loopback_transaction(ctx);
+    ctx->intr_raw &= ~intr_mask;
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_get_intr(void *arg, uint32_t *intr_raw, uint32_t *intr_st, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    loopback_transaction(ctx);
+    if (intr_raw) {
+        *intr_raw = ctx->intr_raw;
+    }
+    if (intr_st) {
+        *intr_st = ctx->intr_raw & ctx->intr_ena;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_set_intr_ena(void *arg, uint32_t ena_mask, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    loopback_transaction(ctx);
+    ctx->intr_ena = ena_mask;
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_get_intr_ena(void *arg, uint32_t *ena_mask_o, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    loopback_transaction(ctx);
+    *ena_mask_o = ctx->intr_ena;
+    return ESP_OK;
+}
+
+static esp_err_t essl_loopback_send_slave_intr(void *arg, uint32_t intr_mask, uint32_t wait_ms)
+{
+    essl_loopback_context_t *ctx = arg;
+    loopback_transaction(ctx);
+    ctx->slave_intr |= intr_mask;
+    return ESP_OK;
+}
+
+static void essl_loopback_reset_cnt(void *arg)
+{
+    essl_loopback_context_t *ctx = arg;
+    ctx->rx_got_bytes = 0;
+    ctx->tx_sent_buffers = 0;
+}
+
+/**
+ * Initialize ``essl_dev_t`` of the loopback device by this macro.
+ */
+#define ESSL_LOOPBACK_DEFAULT_CONTEXT() (essl_dev_t){\
+    .init = essl_loopback_init, \
+    .wait_for_ready = essl_loopback_wait_for_ready, \
+    .get_tx_buffer_num = essl_loopback_get_tx_buffer_num,\
+    .update_tx_buffer_num = essl_loopback_update_tx_buffer_num,\
+    .get_rx_data_size = essl_loopback_get_rx_data_size,\
+    .update_rx_data_size = essl_loopback_update_rx_data_size,\
+    .send_packet = essl_loopback_send_packet,\
+    .get_packet = essl_loopback_get_packet,\
+    .write_reg = essl_loopback_write_reg,\
+    .read_reg = essl_loopback_read_reg,\
+    .wait_int = essl_loopback_wait_int,\
+    .send_slave_intr = essl_loopback_send_slave_intr, \
+    .get_intr = essl_loopback_get_intr, \
+    .clear_intr = essl_loopback_clear_intr, \
+    .set_intr_ena = essl_loopback_set_intr_ena, \
+    .get_intr_ena = essl_loopback_get_intr_ena, \
+    .reset_cnt = essl_loopback_reset_cnt, \
+    }
+
+esp_err_t essl_loopback_init_dev(essl_handle_t *out_handle, const essl_loopback_config_t *config)
+{
+    if (out_handle == NULL || config == NULL || config->buffer_size == 0 || config->buffer_num == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = ESP_OK;
+    essl_loopback_context_t *ctx = calloc(1, sizeof(essl_loopback_context_t));
+    essl_dev_t *dev = calloc(1, sizeof(essl_dev_t));
+    if (ctx == NULL || dev == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+
+    ctx->config = *config;
+    ctx->fifo_size = (size_t) config->buffer_size * config->buffer_num;
+    ctx->fifo = malloc(ctx->fifo_size);
+    ctx->packets = calloc(config->buffer_num, sizeof(loopback_packet_t));
+    if (ctx->fifo == NULL || ctx->packets == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+    ctx->slave_tx_loaded = config->buffer_num; // All the buffers are loaded at start
+
+    *dev = ESSL_LOOPBACK_DEFAULT_CONTEXT();
+    dev->args = ctx;
+    dev->new_packet_intr_mask = ESSL_LOOPBACK_NEW_PACKET_INTR_MASK;
+    *out_handle = dev;
+    return ESP_OK;
+
+cleanup:
+    if (ctx) {
+        free(ctx->fifo);
+        free(ctx->packets);
+    }
+    free(ctx);
+    free(dev);
+    return ret;
+}
+
+esp_err_t essl_loopback_deinit_dev(essl_handle_t handle)
+{
+    if (handle) {
+        essl_loopback_context_t *ctx = handle->args;
+        if (ctx) {
+            free(ctx->fifo);
+            free(ctx->packets);
+        }
+        free(ctx);
+    }
+    free(handle);
+    return ESP_OK;
+}
+
+uint32_t essl_loopback_get_transaction_count(essl_handle_t handle)
+{
+    if (handle == NULL || handle->args == NULL) {
+        return 0;
+    }
+    return ((essl_loopback_context_t *) handle->args)->transactions;
+}
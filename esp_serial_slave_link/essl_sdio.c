@@ -119,6 +119,8 @@ esp_err_t essl_sdio_init_dev(essl_handle_t *out_handle, const essl_sdio_config_t
 
     *dev = ESSL_SDIO_DEFAULT_CONTEXT();
     dev->args = arg;
+    // Same bit on all the supported SDIO slaves
+    dev->new_packet_intr_mask = ESSL_SDIO_DEF_ESP32.new_packet_intr_mask;
 
     *arg = (essl_sdio_context_t) {
         .card = config->card,
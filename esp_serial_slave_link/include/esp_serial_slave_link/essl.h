@@ -6,7 +6,8 @@
 
 #pragma once
 
-
+#include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -120,6 +121,92 @@ esp_err_t essl_send_packet(essl_handle_t handle, const void *start, size_t lengt
  */
 esp_err_t essl_get_packet(essl_handle_t handle, void *out_data, size_t size, size_t *out_length, uint32_t wait_ms);
 
+/// A packet to send with ``essl_stream_send``
+typedef struct {
+    const void *data;   ///< Start address of the packet
+    size_t length;      ///< Length of the packet, in bytes
+} essl_stream_packet_t;
+
+/// Statistics of the streaming API of an ESSL device
+typedef struct {
+    uint32_t packets_sent;      ///< Packets sent by ``essl_stream_send``
+    uint64_t bytes_sent;        ///< Bytes sent by ``essl_stream_send``
+    uint32_t tx_stalls;         ///< Times ``essl_stream_send`` found the slave out of receiving buffers and had to retry
+    uint32_t reads;             ///< Successful reads done by ``essl_stream_recv``
+    uint64_t bytes_received;    ///< Bytes received by ``essl_stream_recv``
+    uint32_t rx_size_refreshes; ///< Times ``essl_stream_recv`` had to read the RX data size from the slave
+} essl_stream_stats_t;
+
+/**
+ * @brief Send a batch of packets to the ESSL slave back to back.
+ *
+ * This is ``essl_send_packet`` called for each packet in turn, with one ``wait_ms`` budget shared by the whole batch
+ * instead of one per packet, and the transfers counted in the stream statistics. It does not save any bus
+ * transaction over the loop: ``essl_send_packet`` already reads the TX buffer num from the slave only when the
+ * buffers known to be free are not enough for the next packet.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param packets Array of packets to send, in order.
+ * @param count Number of packets in ``packets``.
+ * @param[out] out_sent Output of the number of packets sent, can be NULL. Valid also when an error is returned.
+ * @param wait_ms Millisecond to wait before timeout, will not wait at all if set to 0-9.
+ *
+ * @return
+ *      - ESP_OK:                All the packets were sent.
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument, handle is not init or a packet is empty.
+ *      - ESP_ERR_TIMEOUT:       The slave had not enough buffers for the remaining packets before timeout.
+ *      - ESP_ERR_NOT_SUPPORTED: This API is not supported in this mode
+ *      - One of the error codes from SDMMC/SPI host controller.
+ */
+esp_err_t essl_stream_send(essl_handle_t handle, const essl_stream_packet_t *packets, size_t count, size_t *out_sent, uint32_t wait_ms);
+
+/**
+ * @brief Receive data from the ESSL slave as a stream.
+ *
+ * Unlike ``essl_get_packet``, which reads the RX data size from the slave whenever the data known to be available is
+ * shorter than ``size``, the slave is only queried when the known data is used up. While the slave has nothing to
+ * send, the device interrupt line is waited on (when the device supports it) instead of polling the RX data size over
+ * the bus, and the new packet interrupt is cleared before the RX data size is read again.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param[out] out_data Data output address
+ * @param size The size of the output buffer.
+ * @param[out] out_length Output of length of the data actually received from slave.
+ * @param wait_ms Millisecond to wait before timeout, will not wait at all if set to 0-9.
+ *
+ * @return
+ *     - ESP_OK:                All the data known to be available has been read.
+ *     - ESP_ERR_INVALID_ARG:   Invalid argument, The handle is not initialized or the other arguments are invalid.
+ *     - ESP_ERR_NOT_FINISHED:  Read was successful, but there is still data remaining.
+ *     - ESP_ERR_NOT_FOUND:     Slave had no data to send before timeout.
+ *     - ESP_ERR_NOT_SUPPORTED: This API is not supported in this mode
+ *     - One of the error codes from SDMMC/SPI host controller.
+ */
+esp_err_t essl_stream_recv(essl_handle_t handle, void *out_data, size_t size, size_t *out_length, uint32_t wait_ms);
+
+/**
+ * @brief Get the statistics of the streaming API.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param[out] out_stats Output of the statistics.
+ *
+ * @return
+ *      - ESP_OK:              Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument, handle is not init or ``out_stats`` is NULL.
+ */
+esp_err_t essl_stream_get_stats(essl_handle_t handle, essl_stream_stats_t *out_stats);
+
+/**
+ * @brief Reset the statistics of the streaming API.
+ *
+ * @param handle Handle of an ESSL device.
+ *
+ * @return
+ *      - ESP_OK:              Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument, handle is not init.
+ */
+esp_err_t essl_stream_reset_stats(essl_handle_t handle);
+
 /**
  * @brief Write general purpose R/W registers (8-bit) of ESSL slave.
  *
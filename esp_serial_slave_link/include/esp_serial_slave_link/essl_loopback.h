@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Software loopback ESSL device: a simulated slave sending back to the host everything it receives.
+// It needs no bus driver, so it also builds for the linux target and can be used to test and benchmark
+// code written against the ``essl_`` API without hardware.
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#include "esp_serial_slave_link/essl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Interrupt bit raised by the loopback slave when it has new data to send, same as the ESP32 SDIO slave. It stays raised until the host clears it.
+#define ESSL_LOOPBACK_NEW_PACKET_INTR_MASK  (1UL << 23)
+
+/// Configuration for the ESSL loopback device
+typedef struct {
+    uint16_t buffer_size;           ///< Size of each receiving buffer of the simulated slave, like ``recv_buffer_size`` of SDIO.
+    uint16_t buffer_num;            ///< Number of receiving buffers loaded by the simulated slave. A buffer is loaded again once the host has read back its data.
+    uint32_t transaction_delay_us;  ///< Simulated bus latency added to each bus transaction, in us. 0 for no delay.
+} essl_loopback_config_t;
+
+/**
+ * @brief Initialize the ESSL loopback device and get its handle.
+ *
+ * @param out_handle Output of the handle.
+ * @param config    Configuration for the ESSL loopback device.
+ * @return
+ *  - ESP_OK: on success
+ *  - ESP_ERR_INVALID_ARG: ``buffer_size`` or ``buffer_num`` is 0.
+ *  - ESP_ERR_NO_MEM: memory exhausted.
+ */
+esp_err_t essl_loopback_init_dev(essl_handle_t *out_handle, const essl_loopback_config_t *config);
+
+/**
+ * @brief Deinitialize and free the space used by the ESSL loopback device.
+ *
+ * @param handle Handle of the ESSL loopback device to deinit.
+ * @return
+ *  - ESP_OK: on success
+ */
+esp_err_t essl_loopback_deinit_dev(essl_handle_t handle);
+
+/**
+ * @brief Get the number of bus transactions the ESSL loopback device has simulated so far.
+ *
+ * Every operation that would access the bus on a real device (packet transfer, register or counter read/write)
+ * counts as one transaction.
+ *
+ * @param handle Handle of the ESSL loopback device.
+ * @return Number of transactions, 0 if the handle is NULL.
+ */
+uint32_t essl_loopback_get_transaction_count(essl_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
 #include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "esp_serial_slave_link/essl.h"
+#include "esp_serial_slave_link/essl_loopback.h"
 
-void app_main(void)
+#define TEST_BUFFER_SIZE    512
+#define TEST_BUFFER_NUM     16
+
+static essl_handle_t s_handle;
+
+void setUp(void)
+{
+    essl_loopback_config_t config = {
+        .buffer_size = TEST_BUFFER_SIZE,
+        .buffer_num = TEST_BUFFER_NUM,
+    };
+    TEST_ESP_OK(essl_loopback_init_dev(&s_handle, &config));
+    TEST_ESP_OK(essl_init(s_handle, 0));
+}
+
+void tearDown(void)
+{
+    TEST_ESP_OK(essl_loopback_deinit_dev(s_handle));
+    s_handle = NULL;
+}
+
+static int64_t test_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void fill_pattern(uint8_t *buf, size_t len, uint32_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(seed + i * 7);
+    }
+}
+
+TEST_CASE("essl loopback: packet API round trip", "[essl]")
+{
+    uint8_t tx[1000];
+    uint8_t rx[1000];
+    size_t len = 0;
+    fill_pattern(tx, sizeof(tx), 1);
+
+    TEST_ESP_OK(essl_send_packet(s_handle, tx, sizeof(tx), 0));
+    TEST_ESP_OK(essl_get_packet(s_handle, rx, sizeof(rx), &len, 0));
+    TEST_ASSERT_EQUAL(sizeof(tx), len);
+    TEST_ASSERT_EQUAL_MEMORY(tx, rx, sizeof(tx));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, essl_get_packet(s_handle, rx, sizeof(rx), &len, 0));
+}
+
+TEST_CASE("essl loopback: stream send and recv round trip", "[essl]")
+{
+    static uint8_t tx[TEST_BUFFER_NUM][TEST_BUFFER_SIZE];
+    static uint8_t rx[TEST_BUFFER_NUM * TEST_BUFFER_SIZE];
+    essl_stream_packet_t packets[TEST_BUFFER_NUM];
+    for (int i = 0; i < TEST_BUFFER_NUM; i++) {
+        fill_pattern(tx[i], TEST_BUFFER_SIZE, i);
+        packets[i] = (essl_stream_packet_t) {
+            .data = tx[i],
+            .length = TEST_BUFFER_SIZE,
+        };
+    }
+
+    // One credit refresh for the whole batch, then one transaction per packet
+    size_t sent = 0;
+    TEST_ESP_OK(essl_stream_send(s_handle, packets, TEST_BUFFER_NUM, &sent, 0));
+    TEST_ASSERT_EQUAL(TEST_BUFFER_NUM, sent);
+    TEST_ASSERT_EQUAL(1 + TEST_BUFFER_NUM, essl_loopback_get_transaction_count(s_handle));
+
+    // The slave is out of buffers until the data is read back
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, essl_stream_send(s_handle, packets, 1, &sent, 0));
+    TEST_ASSERT_EQUAL(0, sent);
+
+    // All the pending data is read in one transfer after one RX data size refresh
+    size_t len = 0;
+    uint32_t transactions = essl_loopback_get_transaction_count(s_handle);
+    TEST_ESP_OK(essl_stream_recv(s_handle, rx, sizeof(rx), &len, 0));
+    TEST_ASSERT_EQUAL(sizeof(rx), len);
+    TEST_ASSERT_EQUAL(transactions + 2, essl_loopback_get_transaction_count(s_handle));
+    for (int i = 0; i < TEST_BUFFER_NUM; i++) {
+        TEST_ASSERT_EQUAL_MEMORY(tx[i], rx + i * TEST_BUFFER_SIZE, TEST_BUFFER_SIZE);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, essl_stream_recv(s_handle, rx, sizeof(rx), &len, 0));
+
+    essl_stream_stats_t stats;
+    TEST_ESP_OK(essl_stream_get_stats(s_handle, &stats));
+    TEST_ASSERT_EQUAL(TEST_BUFFER_NUM, stats.packets_sent);
+    TEST_ASSERT_EQUAL(sizeof(rx), stats.bytes_sent);
+    TEST_ASSERT_EQUAL(1, stats.tx_stalls);
+    TEST_ASSERT_EQUAL(1, stats.reads);
+    TEST_ASSERT_EQUAL(sizeof(rx), stats.bytes_received);
+    TEST_ASSERT_EQUAL(2, stats.rx_size_refreshes);
+    TEST_ESP_OK(essl_stream_reset_stats(s_handle));
+    TEST_ESP_OK(essl_stream_get_stats(s_handle, &stats));
+    TEST_ASSERT_EQUAL(0, stats.packets_sent);
+}
+
+TEST_CASE("essl loopback: stream recv reads known data without querying the slave", "[essl]")
+{
+    uint8_t tx[3000];
+    uint8_t rx[3000];
+    size_t len = 0;
+    fill_pattern(tx, sizeof(tx), 3);
+    TEST_ESP_OK(essl_send_packet(s_handle, tx, sizeof(tx), 0));
+
+    // First read learns about all the 3000 bytes, the following ones use the cached size
+    size_t got = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, essl_stream_recv(s_handle, rx, 1000, &len, 0));
+    got += len;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, essl_stream_recv(s_handle, rx + got, 1000, &len, 0));
+    got += len;
+    TEST_ESP_OK(essl_stream_recv(s_handle, rx + got, 1000, &len, 0));
+    got += len;
+    TEST_ASSERT_EQUAL(sizeof(tx), got);
+    TEST_ASSERT_EQUAL_MEMORY(tx, rx, sizeof(tx));
+
+    essl_stream_stats_t stats;
+    TEST_ESP_OK(essl_stream_get_stats(s_handle, &stats));
+    TEST_ASSERT_EQUAL(1, stats.rx_size_refreshes);
+    TEST_ASSERT_EQUAL(3, stats.reads);
+}
+
+TEST_CASE("essl loopback: stream recv waits on the new packet interrupt and clears it", "[essl]")
+{
+    uint8_t tx[100];
+    uint8_t rx[100];
+    size_t len = 0;
+    uint32_t intr_raw = 0;
+    fill_pattern(tx, sizeof(tx), 4);
+    TEST_ESP_OK(essl_set_intr_ena(s_handle, ESSL_LOOPBACK_NEW_PACKET_INTR_MASK, 0));
+
+    // Nothing to read: one RX data size read, then the whole timeout is spent waiting on the interrupt
+    TickType_t start = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, essl_stream_recv(s_handle, rx, sizeof(rx), &len, 50));
+    TEST_ASSERT_GREATER_OR_EQUAL(pdMS_TO_TICKS(50) - 1, xTaskGetTickCount() - start);
+
+    // The packet raises the interrupt, which stays raised after the data has been read
+    TEST_ESP_OK(essl_send_packet(s_handle, tx, sizeof(tx), 0));
+    TEST_ESP_OK(essl_stream_recv(s_handle, rx, sizeof(rx), &len, 0));
+    TEST_ASSERT_EQUAL(sizeof(tx), len);
+    TEST_ESP_OK(essl_get_intr(s_handle, &intr_raw, NULL, 0));
+    TEST_ASSERT_EQUAL(ESSL_LOOPBACK_NEW_PACKET_INTR_MASK, intr_raw);
+
+    // The stale interrupt is cleared once, then waited on again instead of polling the slave until timeout
+    essl_stream_stats_t stats;
+    TEST_ESP_OK(essl_stream_reset_stats(s_handle));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, essl_stream_recv(s_handle, rx, sizeof(rx), &len, 50));
+    TEST_ESP_OK(essl_stream_get_stats(s_handle, &stats));
+    TEST_ASSERT_EQUAL(2, stats.rx_size_refreshes);
+    TEST_ESP_OK(essl_get_intr(s_handle, &intr_raw, NULL, 0));
+    TEST_ASSERT_EQUAL(0, intr_raw);
+}
+
+typedef struct {
+    int64_t elapsed_us;
+    uint32_t transactions;
+} benchmark_result_t;
+
+// Loop back ``rounds`` batches of packets, read back through a buffer of one and a half packet
+static benchmark_result_t benchmark_run(bool stream, int rounds)
+{
+    static uint8_t tx[TEST_BUFFER_SIZE * 4];
+    static uint8_t rx[TEST_BUFFER_SIZE * 6];
+    const int batch = TEST_BUFFER_NUM / 4;
+    essl_stream_packet_t packets[TEST_BUFFER_NUM / 4];
+    fill_pattern(tx, sizeof(tx), 5);
+    for (int i = 0; i < batch; i++) {
+        packets[i] = (essl_stream_packet_t) {
+            .data = tx,
+            .length = sizeof(tx),
+        };
+    }
+
+    essl_loopback_config_t config = {
+        .buffer_size = TEST_BUFFER_SIZE,
+        .buffer_num = TEST_BUFFER_NUM,
+        .transaction_delay_us = 20,
+    };
+    essl_handle_t handle;
+    TEST_ESP_OK(essl_loopback_init_dev(&handle, &config));
+
+    int64_t start = test_time_us();
+    for (int i = 0; i < rounds; i++) {
+        if (stream) {
+            size_t sent = 0;
+            TEST_ESP_OK(essl_stream_send(handle, packets, batch, &sent, 0));
+        } else {
+            for (int j = 0; j < batch; j++) {
+                TEST_ESP_OK(essl_send_packet(handle, packets[j].data, packets[j].length, 0));
+            }
+        }
+        size_t got = 0;
+        esp_err_t err;
+        do {
+            size_t len = 0;
+            if (stream) {
+                err = essl_stream_recv(handle, rx, sizeof(rx), &len, 0);
+            } else {
+                err = essl_get_packet(handle, rx, sizeof(rx), &len, 0);
+            }
+            got += len;
+        } while (err == ESP_ERR_NOT_FINISHED);
+        TEST_ESP_OK(err);
+        TEST_ASSERT_EQUAL(batch * sizeof(tx), got);
+    }
+    benchmark_result_t result = {
+        .elapsed_us = test_time_us() - start,
+        .transactions = essl_loopback_get_transaction_count(handle),
+    };
+    TEST_ESP_OK(essl_loopback_deinit_dev(handle));
+    return result;
+}
+
+TEST_CASE("essl loopback: stream throughput", "[essl][benchmark]")
 {
+    const int rounds = 200;
+    benchmark_result_t baseline = benchmark_run(false, rounds);
+    benchmark_result_t stream = benchmark_run(true, rounds);
+
+    printf("essl_send_packet/essl_get_packet: %" PRId64 " us, %" PRIu32 " bus transactions\n",
+           baseline.elapsed_us, baseline.transactions);
+    printf("essl_stream_send/essl_stream_recv: %" PRId64 " us, %" PRIu32 " bus transactions\n",
+           stream.elapsed_us, stream.transactions);
+    // Sending costs the same, the last read of each batch skips the RX data size read of essl_get_packet
+    TEST_ASSERT_EQUAL(baseline.transactions - rounds, stream.transactions);
+}
 
+void app_main(void)
+{
+    unity_run_menu();
 }
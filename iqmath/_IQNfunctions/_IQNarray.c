@@ -0,0 +1,2934 @@
+/*!****************************************************************************
+ *  @file       _IQNarray.c
+ *  @brief      Functions processing arrays of IQN values.
+ *
+ *  <hr>
+ ******************************************************************************/
+/*
+ * The array functions apply the IQN operations to whole blocks of samples.
+ * Each of them is specialized for its IQ format at compile time, and the
+ * operation is inlined in the loop, which removes the call overhead of the
+ * scalar functions.
+ *
+ * The targets have no SIMD lanes producing the 64-bit products the IQN
+ * multiplications need, so the loops are written for the scalar 32x32->64
+ * multiplier: the inner loops are unrolled and the products of the sums are
+ * accumulated with 64 bits, and shifted to the IQ format once.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../support/support.h"
+#include "_IQNmpy.h"
+#include "_IQNsin_cos.h"
+#include "_IQNsqrt.h"
+#include "../include/IQmathLib.h"
+
+/**
+ * @brief Multiply the elements of two arrays of IQN type.
+ *
+ * @param a               IQN type array to be multiplied.
+ * @param b               IQN type array to be multiplied.
+ * @param res             IQN type array of the results, can be a or b.
+ * @param len             Number of elements.
+ * @param q_value         IQ format.
+ */
+__STATIC_INLINE void __IQNmpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len, const int8_t q_value)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= len; i += 4) {
+        res[i] = __IQNmpy(a[i], b[i], q_value);
+        res[i + 1] = __IQNmpy(a[i + 1], b[i + 1], q_value);
+        res[i + 2] = __IQNmpy(a[i + 2], b[i + 2], q_value);
+        res[i + 3] = __IQNmpy(a[i + 3], b[i + 3], q_value);
+    }
+    for (; i < len; i++) {
+        res[i] = __IQNmpy(a[i], b[i], q_value);
+    }
+}
+
+/**
+ * @brief Multiply the elements of two arrays of IQN type and accumulate the products.
+ *
+ * @param a               IQN type array to be multiplied.
+ * @param b               IQN type array to be multiplied.
+ * @param acc             IQN type array the products are added to.
+ * @param len             Number of elements.
+ * @param q_value         IQ format.
+ */
+__STATIC_INLINE void __IQNmacArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len, const int8_t q_value)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= len; i += 4) {
+        acc[i] += __IQNmpy(a[i], b[i], q_value);
+        acc[i + 1] += __IQNmpy(a[i + 1], b[i + 1], q_value);
+        acc[i + 2] += __IQNmpy(a[i + 2], b[i + 2], q_value);
+        acc[i + 3] += __IQNmpy(a[i + 3], b[i + 3], q_value);
+    }
+    for (; i < len; i++) {
+        acc[i] += __IQNmpy(a[i], b[i], q_value);
+    }
+}
+
+/**
+ * @brief Multiply the elements of an array of IQN type by a value.
+ *
+ * @param a               IQN type array to be multiplied.
+ * @param scale           IQN type value to multiply by.
+ * @param res             IQN type array of the results, can be a.
+ * @param len             Number of elements.
+ * @param q_value         IQ format.
+ */
+__STATIC_INLINE void __IQNscaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len, const int8_t q_value)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= len; i += 4) {
+        res[i] = __IQNmpy(a[i], scale, q_value);
+        res[i + 1] = __IQNmpy(a[i + 1], scale, q_value);
+        res[i + 2] = __IQNmpy(a[i + 2], scale, q_value);
+        res[i + 3] = __IQNmpy(a[i + 3], scale, q_value);
+    }
+    for (; i < len; i++) {
+        res[i] = __IQNmpy(a[i], scale, q_value);
+    }
+}
+
+/**
+ * @brief Compute the dot product of two arrays of IQN type.
+ *
+ * @param a               IQN type array.
+ * @param b               IQN type array.
+ * @param len             Number of elements.
+ * @param q_value         IQ format.
+ *
+ * @return                IQN type dot product.
+ */
+__STATIC_INLINE int32_t __IQNdot(const int32_t *a, const int32_t *b, size_t len, const int8_t q_value)
+{
+    /* Two accumulators, so that consecutive multiply-adds do not depend on each other. */
+    int_fast64_t acc0 = 0;
+    int_fast64_t acc1 = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= len; i += 4) {
+        acc0 += (int_fast64_t)a[i] * b[i];
+        acc1 += (int_fast64_t)a[i + 1] * b[i + 1];
+        acc0 += (int_fast64_t)a[i + 2] * b[i + 2];
+        acc1 += (int_fast64_t)a[i + 3] * b[i + 3];
+    }
+    for (; i < len; i++) {
+        acc0 += (int_fast64_t)a[i] * b[i];
+    }
+    return (int32_t)((acc0 + acc1) >> q_value);
+}
+
+/**
+ * @brief Filter an array of IQN type with a FIR filter.
+ *
+ * @param coeffs          IQN type coefficients of the filter.
+ * @param state           IQN type taps - 1 last input samples of the previous block, oldest first.
+ * @param taps            Number of coefficients.
+ * @param input           IQN type input samples.
+ * @param output          IQN type output samples.
+ * @param len             Number of samples.
+ * @param q_value         IQ format.
+ */
+__STATIC_INLINE void __IQNfir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input,
+                              int32_t *output, size_t len, const int8_t q_value)
+{
+    size_t history = taps - 1;
+
+    if (taps == 0) {
+        memset(output, 0, len * sizeof(int32_t));
+        return;
+    }
+
+    for (size_t n = 0; n < len; n++) {
+        int_fast64_t acc = 0;
+        size_t k = 0;
+        /* Taps applied to the samples of this block: y[n] += c[k] * x[n - k] */
+        size_t block_taps = (n < history) ? n + 1 : taps;
+        const int32_t *x = &input[n];
+
+        for (; k + 2 <= block_taps; k += 2) {
+            acc += (int_fast64_t)coeffs[k] * x[-(ptrdiff_t)k];
+            acc += (int_fast64_t)coeffs[k + 1] * x[-(ptrdiff_t)k - 1];
+        }
+        for (; k < block_taps; k++) {
+            acc += (int_fast64_t)coeffs[k] * x[-(ptrdiff_t)k];
+        }
+        /* Taps applied to the samples of the previous blocks, x[n - k] = state[history + n - k] */
+        for (; k < taps; k++) {
+            acc += (int_fast64_t)coeffs[k] * state[history + n - k];
+        }
+        output[n] = (int32_t)(acc >> q_value);
+    }
+
+    /* Keep the last input samples for the next block */
+    if (len >= history) {
+        memcpy(state, &input[len - history], history * sizeof(int32_t));
+    } else {
+        memmove(state, &state[len], (history - len) * sizeof(int32_t));
+        memcpy(&state[history - len], input, len * sizeof(int32_t));
+    }
+}
+
+#if ((!defined (__IQMATH_USE_MATHACL__)) || (!defined (__MSPM0_HAS_MATHACL__)))
+/**
+ * @brief Computes both the sine and cosine of an IQN input.
+ *
+ * The range reduction is shared by both results, which are the same as the
+ * ones of __IQNsin_cos.
+ *
+ * @param iqNInput        IQN type input.
+ * @param q_value         IQ format.
+ * @param format          Specifies radians or per-unit operation.
+ * @param sinRes          IQN type result of sine operation.
+ * @param cosRes          IQN type result of cosine operation.
+ */
+__STATIC_INLINE void __IQNsinCos(int_fast32_t iqNInput, const int8_t q_value, const int8_t format,
+                                 int32_t *sinRes, int32_t *cosRes)
+{
+    uint8_t ui8SinSign = 0;
+    uint8_t ui8CosSign = 0;
+    uint_fast32_t uiq29Input;
+    uint_fast32_t uiq30Input;
+    uint_fast32_t uiq31Input;
+    uint_fast32_t uiq32Input;
+    uint_fast32_t uiq31Sin;
+    uint_fast32_t uiq31Cos;
+
+    /* Remove sign from input, which only flips the sign of sin */
+    if (iqNInput < 0) {
+        iqNInput = -iqNInput;
+        ui8SinSign = 1;
+    }
+
+    /* Per unit API */
+    if (format == TYPE_PU) {
+        uiq32Input = (uint_fast32_t)iqNInput << (32 - q_value);
+
+        /* Reduce the input to the first two quadrants. */
+        if (uiq32Input >= 0x80000000) {
+            uiq32Input -= 0x80000000;
+            ui8SinSign ^= 1;
+            ui8CosSign ^= 1;
+        }
+
+        uiq30Input = __mpyf_ul(uiq32Input, iq30_pi);
+    }
+    /* Radians API */
+    else {
+        int_fast16_t exp = 29 - q_value;
+
+        uiq29Input = (uint_fast32_t)iqNInput;
+
+        /* Reduce the input exponent to zero by scaling by 2*pi. */
+        while (exp) {
+            if (uiq29Input >= iq29_pi) {
+                uiq29Input -= iq29_pi;
+            }
+            uiq29Input <<= 1;
+            exp--;
+        }
+
+        /* Reduce the range to the first two quadrants. */
+        if (uiq29Input >= iq29_pi) {
+            uiq29Input -= iq29_pi;
+            ui8SinSign ^= 1;
+            ui8CosSign ^= 1;
+        }
+
+        uiq30Input = uiq29Input << 1;
+    }
+
+    /* Reduce the iq30 input range to the first quadrant, which only flips the sign of cos. */
+    if (uiq30Input >= iq30_halfPi) {
+        uiq30Input = iq30_pi - uiq30Input;
+        ui8CosSign ^= 1;
+    }
+
+    uiq31Input = uiq30Input << 1;
+
+    /* If input is greater than pi/4 swap sin and cos for calculations */
+    if (uiq31Input > iq31_quarterPi) {
+        uiq31Input = iq31_halfPi - uiq31Input;
+        uiq31Sin = __IQNcalcCos(uiq31Input);
+        uiq31Cos = __IQNcalcSin(uiq31Input);
+    } else {
+        uiq31Sin = __IQNcalcSin(uiq31Input);
+        uiq31Cos = __IQNcalcCos(uiq31Input);
+    }
+
+    /* Shift to Q type */
+    uiq31Sin >>= (31 - q_value);
+    uiq31Cos >>= (31 - q_value);
+
+    *sinRes = ui8SinSign ? -uiq31Sin : uiq31Sin;
+    *cosRes = ui8CosSign ? -uiq31Cos : uiq31Cos;
+}
+#else
+__STATIC_INLINE void __IQNsinCos(int_fast32_t iqNInput, const int8_t q_value, const int8_t format,
+                                 int32_t *sinRes, int32_t *cosRes)
+{
+    *sinRes = __IQNsin_cos(iqNInput, q_value, TYPE_SIN, format);
+    *cosRes = __IQNsin_cos(iqNInput, q_value, TYPE_COS, format);
+}
+#endif
+
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQN type.
+ *
+ * @param a               IQN type input array.
+ * @param sinRes          IQN type array of the results of sine operation.
+ * @param cosRes          IQN type array of the results of cosine operation.
+ * @param len             Number of elements.
+ * @param q_value         IQ format.
+ * @param format          Specifies radians or per-unit operation.
+ */
+__STATIC_INLINE void __IQNsinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len,
+                                      const int8_t q_value, const int8_t format)
+{
+    for (size_t i = 0; i < len; i++) {
+        __IQNsinCos(a[i], q_value, format, &sinRes[i], &cosRes[i]);
+    }
+}
+
+/**
+ * @brief Computes the magnitude of the elements of two arrays of IQ type.
+ *
+ * @param a               IQ type array of the first components.
+ * @param b               IQ type array of the second components.
+ * @param res             IQ type array of the results, can be a or b.
+ * @param len             Number of elements.
+ */
+void _IQmagArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        res[i] = __IQNsqrt(a[i], b[i], 31, TYPE_MAG);
+    }
+}
+
+/* IQ mpyArray functions */
+
+/**
+ * @brief Multiplies the elements of two arrays of IQ30 type.
+ *
+ * @param a               IQ30 type array to be multiplied.
+ * @param b               IQ30 type array to be multiplied.
+ * @param res             IQ30 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ30mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 30);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ29 type.
+ *
+ * @param a               IQ29 type array to be multiplied.
+ * @param b               IQ29 type array to be multiplied.
+ * @param res             IQ29 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ29mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 29);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ28 type.
+ *
+ * @param a               IQ28 type array to be multiplied.
+ * @param b               IQ28 type array to be multiplied.
+ * @param res             IQ28 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ28mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 28);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ27 type.
+ *
+ * @param a               IQ27 type array to be multiplied.
+ * @param b               IQ27 type array to be multiplied.
+ * @param res             IQ27 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ27mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 27);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ26 type.
+ *
+ * @param a               IQ26 type array to be multiplied.
+ * @param b               IQ26 type array to be multiplied.
+ * @param res             IQ26 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ26mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 26);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ25 type.
+ *
+ * @param a               IQ25 type array to be multiplied.
+ * @param b               IQ25 type array to be multiplied.
+ * @param res             IQ25 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ25mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 25);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ24 type.
+ *
+ * @param a               IQ24 type array to be multiplied.
+ * @param b               IQ24 type array to be multiplied.
+ * @param res             IQ24 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ24mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 24);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ23 type.
+ *
+ * @param a               IQ23 type array to be multiplied.
+ * @param b               IQ23 type array to be multiplied.
+ * @param res             IQ23 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ23mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 23);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ22 type.
+ *
+ * @param a               IQ22 type array to be multiplied.
+ * @param b               IQ22 type array to be multiplied.
+ * @param res             IQ22 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ22mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 22);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ21 type.
+ *
+ * @param a               IQ21 type array to be multiplied.
+ * @param b               IQ21 type array to be multiplied.
+ * @param res             IQ21 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ21mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 21);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ20 type.
+ *
+ * @param a               IQ20 type array to be multiplied.
+ * @param b               IQ20 type array to be multiplied.
+ * @param res             IQ20 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ20mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 20);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ19 type.
+ *
+ * @param a               IQ19 type array to be multiplied.
+ * @param b               IQ19 type array to be multiplied.
+ * @param res             IQ19 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ19mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 19);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ18 type.
+ *
+ * @param a               IQ18 type array to be multiplied.
+ * @param b               IQ18 type array to be multiplied.
+ * @param res             IQ18 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ18mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 18);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ17 type.
+ *
+ * @param a               IQ17 type array to be multiplied.
+ * @param b               IQ17 type array to be multiplied.
+ * @param res             IQ17 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ17mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 17);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ16 type.
+ *
+ * @param a               IQ16 type array to be multiplied.
+ * @param b               IQ16 type array to be multiplied.
+ * @param res             IQ16 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ16mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 16);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ15 type.
+ *
+ * @param a               IQ15 type array to be multiplied.
+ * @param b               IQ15 type array to be multiplied.
+ * @param res             IQ15 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ15mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 15);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ14 type.
+ *
+ * @param a               IQ14 type array to be multiplied.
+ * @param b               IQ14 type array to be multiplied.
+ * @param res             IQ14 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ14mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 14);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ13 type.
+ *
+ * @param a               IQ13 type array to be multiplied.
+ * @param b               IQ13 type array to be multiplied.
+ * @param res             IQ13 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ13mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 13);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ12 type.
+ *
+ * @param a               IQ12 type array to be multiplied.
+ * @param b               IQ12 type array to be multiplied.
+ * @param res             IQ12 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ12mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 12);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ11 type.
+ *
+ * @param a               IQ11 type array to be multiplied.
+ * @param b               IQ11 type array to be multiplied.
+ * @param res             IQ11 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ11mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 11);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ10 type.
+ *
+ * @param a               IQ10 type array to be multiplied.
+ * @param b               IQ10 type array to be multiplied.
+ * @param res             IQ10 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ10mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 10);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ9 type.
+ *
+ * @param a               IQ9 type array to be multiplied.
+ * @param b               IQ9 type array to be multiplied.
+ * @param res             IQ9 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ9mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 9);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ8 type.
+ *
+ * @param a               IQ8 type array to be multiplied.
+ * @param b               IQ8 type array to be multiplied.
+ * @param res             IQ8 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ8mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 8);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ7 type.
+ *
+ * @param a               IQ7 type array to be multiplied.
+ * @param b               IQ7 type array to be multiplied.
+ * @param res             IQ7 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ7mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 7);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ6 type.
+ *
+ * @param a               IQ6 type array to be multiplied.
+ * @param b               IQ6 type array to be multiplied.
+ * @param res             IQ6 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ6mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 6);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ5 type.
+ *
+ * @param a               IQ5 type array to be multiplied.
+ * @param b               IQ5 type array to be multiplied.
+ * @param res             IQ5 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ5mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 5);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ4 type.
+ *
+ * @param a               IQ4 type array to be multiplied.
+ * @param b               IQ4 type array to be multiplied.
+ * @param res             IQ4 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ4mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 4);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ3 type.
+ *
+ * @param a               IQ3 type array to be multiplied.
+ * @param b               IQ3 type array to be multiplied.
+ * @param res             IQ3 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ3mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 3);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ2 type.
+ *
+ * @param a               IQ2 type array to be multiplied.
+ * @param b               IQ2 type array to be multiplied.
+ * @param res             IQ2 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ2mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 2);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ1 type.
+ *
+ * @param a               IQ1 type array to be multiplied.
+ * @param b               IQ1 type array to be multiplied.
+ * @param res             IQ1 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ1mpyArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len)
+{
+    __IQNmpyArray(a, b, res, len, 1);
+}
+
+/* IQ macArray functions */
+
+/**
+ * @brief Multiplies the elements of two arrays of IQ30 type and accumulates the products.
+ *
+ * @param a               IQ30 type array to be multiplied.
+ * @param b               IQ30 type array to be multiplied.
+ * @param acc             IQ30 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ30macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 30);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ29 type and accumulates the products.
+ *
+ * @param a               IQ29 type array to be multiplied.
+ * @param b               IQ29 type array to be multiplied.
+ * @param acc             IQ29 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ29macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 29);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ28 type and accumulates the products.
+ *
+ * @param a               IQ28 type array to be multiplied.
+ * @param b               IQ28 type array to be multiplied.
+ * @param acc             IQ28 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ28macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 28);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ27 type and accumulates the products.
+ *
+ * @param a               IQ27 type array to be multiplied.
+ * @param b               IQ27 type array to be multiplied.
+ * @param acc             IQ27 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ27macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 27);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ26 type and accumulates the products.
+ *
+ * @param a               IQ26 type array to be multiplied.
+ * @param b               IQ26 type array to be multiplied.
+ * @param acc             IQ26 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ26macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 26);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ25 type and accumulates the products.
+ *
+ * @param a               IQ25 type array to be multiplied.
+ * @param b               IQ25 type array to be multiplied.
+ * @param acc             IQ25 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ25macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 25);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ24 type and accumulates the products.
+ *
+ * @param a               IQ24 type array to be multiplied.
+ * @param b               IQ24 type array to be multiplied.
+ * @param acc             IQ24 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ24macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 24);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ23 type and accumulates the products.
+ *
+ * @param a               IQ23 type array to be multiplied.
+ * @param b               IQ23 type array to be multiplied.
+ * @param acc             IQ23 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ23macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 23);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ22 type and accumulates the products.
+ *
+ * @param a               IQ22 type array to be multiplied.
+ * @param b               IQ22 type array to be multiplied.
+ * @param acc             IQ22 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ22macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 22);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ21 type and accumulates the products.
+ *
+ * @param a               IQ21 type array to be multiplied.
+ * @param b               IQ21 type array to be multiplied.
+ * @param acc             IQ21 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ21macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 21);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ20 type and accumulates the products.
+ *
+ * @param a               IQ20 type array to be multiplied.
+ * @param b               IQ20 type array to be multiplied.
+ * @param acc             IQ20 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ20macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 20);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ19 type and accumulates the products.
+ *
+ * @param a               IQ19 type array to be multiplied.
+ * @param b               IQ19 type array to be multiplied.
+ * @param acc             IQ19 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ19macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 19);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ18 type and accumulates the products.
+ *
+ * @param a               IQ18 type array to be multiplied.
+ * @param b               IQ18 type array to be multiplied.
+ * @param acc             IQ18 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ18macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 18);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ17 type and accumulates the products.
+ *
+ * @param a               IQ17 type array to be multiplied.
+ * @param b               IQ17 type array to be multiplied.
+ * @param acc             IQ17 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ17macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 17);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ16 type and accumulates the products.
+ *
+ * @param a               IQ16 type array to be multiplied.
+ * @param b               IQ16 type array to be multiplied.
+ * @param acc             IQ16 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ16macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 16);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ15 type and accumulates the products.
+ *
+ * @param a               IQ15 type array to be multiplied.
+ * @param b               IQ15 type array to be multiplied.
+ * @param acc             IQ15 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ15macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 15);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ14 type and accumulates the products.
+ *
+ * @param a               IQ14 type array to be multiplied.
+ * @param b               IQ14 type array to be multiplied.
+ * @param acc             IQ14 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ14macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 14);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ13 type and accumulates the products.
+ *
+ * @param a               IQ13 type array to be multiplied.
+ * @param b               IQ13 type array to be multiplied.
+ * @param acc             IQ13 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ13macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 13);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ12 type and accumulates the products.
+ *
+ * @param a               IQ12 type array to be multiplied.
+ * @param b               IQ12 type array to be multiplied.
+ * @param acc             IQ12 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ12macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 12);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ11 type and accumulates the products.
+ *
+ * @param a               IQ11 type array to be multiplied.
+ * @param b               IQ11 type array to be multiplied.
+ * @param acc             IQ11 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ11macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 11);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ10 type and accumulates the products.
+ *
+ * @param a               IQ10 type array to be multiplied.
+ * @param b               IQ10 type array to be multiplied.
+ * @param acc             IQ10 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ10macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 10);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ9 type and accumulates the products.
+ *
+ * @param a               IQ9 type array to be multiplied.
+ * @param b               IQ9 type array to be multiplied.
+ * @param acc             IQ9 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ9macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 9);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ8 type and accumulates the products.
+ *
+ * @param a               IQ8 type array to be multiplied.
+ * @param b               IQ8 type array to be multiplied.
+ * @param acc             IQ8 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ8macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 8);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ7 type and accumulates the products.
+ *
+ * @param a               IQ7 type array to be multiplied.
+ * @param b               IQ7 type array to be multiplied.
+ * @param acc             IQ7 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ7macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 7);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ6 type and accumulates the products.
+ *
+ * @param a               IQ6 type array to be multiplied.
+ * @param b               IQ6 type array to be multiplied.
+ * @param acc             IQ6 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ6macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 6);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ5 type and accumulates the products.
+ *
+ * @param a               IQ5 type array to be multiplied.
+ * @param b               IQ5 type array to be multiplied.
+ * @param acc             IQ5 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ5macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 5);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ4 type and accumulates the products.
+ *
+ * @param a               IQ4 type array to be multiplied.
+ * @param b               IQ4 type array to be multiplied.
+ * @param acc             IQ4 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ4macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 4);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ3 type and accumulates the products.
+ *
+ * @param a               IQ3 type array to be multiplied.
+ * @param b               IQ3 type array to be multiplied.
+ * @param acc             IQ3 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ3macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 3);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ2 type and accumulates the products.
+ *
+ * @param a               IQ2 type array to be multiplied.
+ * @param b               IQ2 type array to be multiplied.
+ * @param acc             IQ2 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ2macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 2);
+}
+/**
+ * @brief Multiplies the elements of two arrays of IQ1 type and accumulates the products.
+ *
+ * @param a               IQ1 type array to be multiplied.
+ * @param b               IQ1 type array to be multiplied.
+ * @param acc             IQ1 type array the products are added to.
+ * @param len             Number of elements.
+ */
+void _IQ1macArray(const int32_t *a, const int32_t *b, int32_t *acc, size_t len)
+{
+    __IQNmacArray(a, b, acc, len, 1);
+}
+
+/* IQ scaleArray functions */
+
+/**
+ * @brief Multiplies the elements of an array of IQ30 type by a value.
+ *
+ * @param a               IQ30 type array to be multiplied.
+ * @param scale           IQ30 type value to multiply by.
+ * @param res             IQ30 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ30scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 30);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ29 type by a value.
+ *
+ * @param a               IQ29 type array to be multiplied.
+ * @param scale           IQ29 type value to multiply by.
+ * @param res             IQ29 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ29scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 29);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ28 type by a value.
+ *
+ * @param a               IQ28 type array to be multiplied.
+ * @param scale           IQ28 type value to multiply by.
+ * @param res             IQ28 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ28scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 28);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ27 type by a value.
+ *
+ * @param a               IQ27 type array to be multiplied.
+ * @param scale           IQ27 type value to multiply by.
+ * @param res             IQ27 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ27scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 27);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ26 type by a value.
+ *
+ * @param a               IQ26 type array to be multiplied.
+ * @param scale           IQ26 type value to multiply by.
+ * @param res             IQ26 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ26scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 26);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ25 type by a value.
+ *
+ * @param a               IQ25 type array to be multiplied.
+ * @param scale           IQ25 type value to multiply by.
+ * @param res             IQ25 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ25scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 25);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ24 type by a value.
+ *
+ * @param a               IQ24 type array to be multiplied.
+ * @param scale           IQ24 type value to multiply by.
+ * @param res             IQ24 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ24scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 24);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ23 type by a value.
+ *
+ * @param a               IQ23 type array to be multiplied.
+ * @param scale           IQ23 type value to multiply by.
+ * @param res             IQ23 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ23scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 23);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ22 type by a value.
+ *
+ * @param a               IQ22 type array to be multiplied.
+ * @param scale           IQ22 type value to multiply by.
+ * @param res             IQ22 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ22scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 22);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ21 type by a value.
+ *
+ * @param a               IQ21 type array to be multiplied.
+ * @param scale           IQ21 type value to multiply by.
+ * @param res             IQ21 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ21scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 21);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ20 type by a value.
+ *
+ * @param a               IQ20 type array to be multiplied.
+ * @param scale           IQ20 type value to multiply by.
+ * @param res             IQ20 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ20scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 20);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ19 type by a value.
+ *
+ * @param a               IQ19 type array to be multiplied.
+ * @param scale           IQ19 type value to multiply by.
+ * @param res             IQ19 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ19scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 19);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ18 type by a value.
+ *
+ * @param a               IQ18 type array to be multiplied.
+ * @param scale           IQ18 type value to multiply by.
+ * @param res             IQ18 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ18scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 18);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ17 type by a value.
+ *
+ * @param a               IQ17 type array to be multiplied.
+ * @param scale           IQ17 type value to multiply by.
+ * @param res             IQ17 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ17scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 17);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ16 type by a value.
+ *
+ * @param a               IQ16 type array to be multiplied.
+ * @param scale           IQ16 type value to multiply by.
+ * @param res             IQ16 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ16scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 16);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ15 type by a value.
+ *
+ * @param a               IQ15 type array to be multiplied.
+ * @param scale           IQ15 type value to multiply by.
+ * @param res             IQ15 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ15scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 15);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ14 type by a value.
+ *
+ * @param a               IQ14 type array to be multiplied.
+ * @param scale           IQ14 type value to multiply by.
+ * @param res             IQ14 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ14scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 14);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ13 type by a value.
+ *
+ * @param a               IQ13 type array to be multiplied.
+ * @param scale           IQ13 type value to multiply by.
+ * @param res             IQ13 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ13scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 13);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ12 type by a value.
+ *
+ * @param a               IQ12 type array to be multiplied.
+ * @param scale           IQ12 type value to multiply by.
+ * @param res             IQ12 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ12scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 12);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ11 type by a value.
+ *
+ * @param a               IQ11 type array to be multiplied.
+ * @param scale           IQ11 type value to multiply by.
+ * @param res             IQ11 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ11scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 11);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ10 type by a value.
+ *
+ * @param a               IQ10 type array to be multiplied.
+ * @param scale           IQ10 type value to multiply by.
+ * @param res             IQ10 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ10scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 10);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ9 type by a value.
+ *
+ * @param a               IQ9 type array to be multiplied.
+ * @param scale           IQ9 type value to multiply by.
+ * @param res             IQ9 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ9scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 9);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ8 type by a value.
+ *
+ * @param a               IQ8 type array to be multiplied.
+ * @param scale           IQ8 type value to multiply by.
+ * @param res             IQ8 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ8scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 8);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ7 type by a value.
+ *
+ * @param a               IQ7 type array to be multiplied.
+ * @param scale           IQ7 type value to multiply by.
+ * @param res             IQ7 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ7scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 7);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ6 type by a value.
+ *
+ * @param a               IQ6 type array to be multiplied.
+ * @param scale           IQ6 type value to multiply by.
+ * @param res             IQ6 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ6scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 6);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ5 type by a value.
+ *
+ * @param a               IQ5 type array to be multiplied.
+ * @param scale           IQ5 type value to multiply by.
+ * @param res             IQ5 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ5scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 5);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ4 type by a value.
+ *
+ * @param a               IQ4 type array to be multiplied.
+ * @param scale           IQ4 type value to multiply by.
+ * @param res             IQ4 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ4scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 4);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ3 type by a value.
+ *
+ * @param a               IQ3 type array to be multiplied.
+ * @param scale           IQ3 type value to multiply by.
+ * @param res             IQ3 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ3scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 3);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ2 type by a value.
+ *
+ * @param a               IQ2 type array to be multiplied.
+ * @param scale           IQ2 type value to multiply by.
+ * @param res             IQ2 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ2scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 2);
+}
+/**
+ * @brief Multiplies the elements of an array of IQ1 type by a value.
+ *
+ * @param a               IQ1 type array to be multiplied.
+ * @param scale           IQ1 type value to multiply by.
+ * @param res             IQ1 type array of the results.
+ * @param len             Number of elements.
+ */
+void _IQ1scaleArray(const int32_t *a, int32_t scale, int32_t *res, size_t len)
+{
+    __IQNscaleArray(a, scale, res, len, 1);
+}
+
+/* IQ dot functions */
+
+/**
+ * @brief Computes the dot product of two arrays of IQ30 type.
+ *
+ * @param a               IQ30 type array.
+ * @param b               IQ30 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ30 type dot product.
+ */
+int32_t _IQ30dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 30);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ29 type.
+ *
+ * @param a               IQ29 type array.
+ * @param b               IQ29 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ29 type dot product.
+ */
+int32_t _IQ29dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 29);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ28 type.
+ *
+ * @param a               IQ28 type array.
+ * @param b               IQ28 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ28 type dot product.
+ */
+int32_t _IQ28dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 28);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ27 type.
+ *
+ * @param a               IQ27 type array.
+ * @param b               IQ27 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ27 type dot product.
+ */
+int32_t _IQ27dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 27);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ26 type.
+ *
+ * @param a               IQ26 type array.
+ * @param b               IQ26 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ26 type dot product.
+ */
+int32_t _IQ26dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 26);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ25 type.
+ *
+ * @param a               IQ25 type array.
+ * @param b               IQ25 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ25 type dot product.
+ */
+int32_t _IQ25dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 25);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ24 type.
+ *
+ * @param a               IQ24 type array.
+ * @param b               IQ24 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ24 type dot product.
+ */
+int32_t _IQ24dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 24);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ23 type.
+ *
+ * @param a               IQ23 type array.
+ * @param b               IQ23 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ23 type dot product.
+ */
+int32_t _IQ23dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 23);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ22 type.
+ *
+ * @param a               IQ22 type array.
+ * @param b               IQ22 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ22 type dot product.
+ */
+int32_t _IQ22dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 22);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ21 type.
+ *
+ * @param a               IQ21 type array.
+ * @param b               IQ21 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ21 type dot product.
+ */
+int32_t _IQ21dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 21);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ20 type.
+ *
+ * @param a               IQ20 type array.
+ * @param b               IQ20 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ20 type dot product.
+ */
+int32_t _IQ20dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 20);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ19 type.
+ *
+ * @param a               IQ19 type array.
+ * @param b               IQ19 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ19 type dot product.
+ */
+int32_t _IQ19dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 19);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ18 type.
+ *
+ * @param a               IQ18 type array.
+ * @param b               IQ18 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ18 type dot product.
+ */
+int32_t _IQ18dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 18);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ17 type.
+ *
+ * @param a               IQ17 type array.
+ * @param b               IQ17 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ17 type dot product.
+ */
+int32_t _IQ17dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 17);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ16 type.
+ *
+ * @param a               IQ16 type array.
+ * @param b               IQ16 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ16 type dot product.
+ */
+int32_t _IQ16dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 16);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ15 type.
+ *
+ * @param a               IQ15 type array.
+ * @param b               IQ15 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ15 type dot product.
+ */
+int32_t _IQ15dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 15);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ14 type.
+ *
+ * @param a               IQ14 type array.
+ * @param b               IQ14 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ14 type dot product.
+ */
+int32_t _IQ14dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 14);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ13 type.
+ *
+ * @param a               IQ13 type array.
+ * @param b               IQ13 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ13 type dot product.
+ */
+int32_t _IQ13dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 13);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ12 type.
+ *
+ * @param a               IQ12 type array.
+ * @param b               IQ12 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ12 type dot product.
+ */
+int32_t _IQ12dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 12);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ11 type.
+ *
+ * @param a               IQ11 type array.
+ * @param b               IQ11 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ11 type dot product.
+ */
+int32_t _IQ11dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 11);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ10 type.
+ *
+ * @param a               IQ10 type array.
+ * @param b               IQ10 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ10 type dot product.
+ */
+int32_t _IQ10dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 10);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ9 type.
+ *
+ * @param a               IQ9 type array.
+ * @param b               IQ9 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ9 type dot product.
+ */
+int32_t _IQ9dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 9);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ8 type.
+ *
+ * @param a               IQ8 type array.
+ * @param b               IQ8 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ8 type dot product.
+ */
+int32_t _IQ8dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 8);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ7 type.
+ *
+ * @param a               IQ7 type array.
+ * @param b               IQ7 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ7 type dot product.
+ */
+int32_t _IQ7dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 7);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ6 type.
+ *
+ * @param a               IQ6 type array.
+ * @param b               IQ6 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ6 type dot product.
+ */
+int32_t _IQ6dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 6);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ5 type.
+ *
+ * @param a               IQ5 type array.
+ * @param b               IQ5 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ5 type dot product.
+ */
+int32_t _IQ5dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 5);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ4 type.
+ *
+ * @param a               IQ4 type array.
+ * @param b               IQ4 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ4 type dot product.
+ */
+int32_t _IQ4dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 4);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ3 type.
+ *
+ * @param a               IQ3 type array.
+ * @param b               IQ3 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ3 type dot product.
+ */
+int32_t _IQ3dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 3);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ2 type.
+ *
+ * @param a               IQ2 type array.
+ * @param b               IQ2 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ2 type dot product.
+ */
+int32_t _IQ2dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 2);
+}
+/**
+ * @brief Computes the dot product of two arrays of IQ1 type.
+ *
+ * @param a               IQ1 type array.
+ * @param b               IQ1 type array.
+ * @param len             Number of elements.
+ *
+ * @return                IQ1 type dot product.
+ */
+int32_t _IQ1dot(const int32_t *a, const int32_t *b, size_t len)
+{
+    return __IQNdot(a, b, len, 1);
+}
+
+/* IQ fir functions */
+
+/**
+ * @brief Filters an array of IQ30 type with a FIR filter.
+ *
+ * @param coeffs          IQ30 type coefficients of the filter.
+ * @param state           IQ30 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ30 type input samples.
+ * @param output          IQ30 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ30fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 30);
+}
+/**
+ * @brief Filters an array of IQ29 type with a FIR filter.
+ *
+ * @param coeffs          IQ29 type coefficients of the filter.
+ * @param state           IQ29 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ29 type input samples.
+ * @param output          IQ29 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ29fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 29);
+}
+/**
+ * @brief Filters an array of IQ28 type with a FIR filter.
+ *
+ * @param coeffs          IQ28 type coefficients of the filter.
+ * @param state           IQ28 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ28 type input samples.
+ * @param output          IQ28 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ28fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 28);
+}
+/**
+ * @brief Filters an array of IQ27 type with a FIR filter.
+ *
+ * @param coeffs          IQ27 type coefficients of the filter.
+ * @param state           IQ27 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ27 type input samples.
+ * @param output          IQ27 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ27fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 27);
+}
+/**
+ * @brief Filters an array of IQ26 type with a FIR filter.
+ *
+ * @param coeffs          IQ26 type coefficients of the filter.
+ * @param state           IQ26 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ26 type input samples.
+ * @param output          IQ26 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ26fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 26);
+}
+/**
+ * @brief Filters an array of IQ25 type with a FIR filter.
+ *
+ * @param coeffs          IQ25 type coefficients of the filter.
+ * @param state           IQ25 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ25 type input samples.
+ * @param output          IQ25 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ25fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 25);
+}
+/**
+ * @brief Filters an array of IQ24 type with a FIR filter.
+ *
+ * @param coeffs          IQ24 type coefficients of the filter.
+ * @param state           IQ24 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ24 type input samples.
+ * @param output          IQ24 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ24fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 24);
+}
+/**
+ * @brief Filters an array of IQ23 type with a FIR filter.
+ *
+ * @param coeffs          IQ23 type coefficients of the filter.
+ * @param state           IQ23 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ23 type input samples.
+ * @param output          IQ23 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ23fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 23);
+}
+/**
+ * @brief Filters an array of IQ22 type with a FIR filter.
+ *
+ * @param coeffs          IQ22 type coefficients of the filter.
+ * @param state           IQ22 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ22 type input samples.
+ * @param output          IQ22 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ22fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 22);
+}
+/**
+ * @brief Filters an array of IQ21 type with a FIR filter.
+ *
+ * @param coeffs          IQ21 type coefficients of the filter.
+ * @param state           IQ21 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ21 type input samples.
+ * @param output          IQ21 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ21fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 21);
+}
+/**
+ * @brief Filters an array of IQ20 type with a FIR filter.
+ *
+ * @param coeffs          IQ20 type coefficients of the filter.
+ * @param state           IQ20 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ20 type input samples.
+ * @param output          IQ20 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ20fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 20);
+}
+/**
+ * @brief Filters an array of IQ19 type with a FIR filter.
+ *
+ * @param coeffs          IQ19 type coefficients of the filter.
+ * @param state           IQ19 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ19 type input samples.
+ * @param output          IQ19 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ19fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 19);
+}
+/**
+ * @brief Filters an array of IQ18 type with a FIR filter.
+ *
+ * @param coeffs          IQ18 type coefficients of the filter.
+ * @param state           IQ18 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ18 type input samples.
+ * @param output          IQ18 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ18fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 18);
+}
+/**
+ * @brief Filters an array of IQ17 type with a FIR filter.
+ *
+ * @param coeffs          IQ17 type coefficients of the filter.
+ * @param state           IQ17 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ17 type input samples.
+ * @param output          IQ17 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ17fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 17);
+}
+/**
+ * @brief Filters an array of IQ16 type with a FIR filter.
+ *
+ * @param coeffs          IQ16 type coefficients of the filter.
+ * @param state           IQ16 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ16 type input samples.
+ * @param output          IQ16 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ16fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 16);
+}
+/**
+ * @brief Filters an array of IQ15 type with a FIR filter.
+ *
+ * @param coeffs          IQ15 type coefficients of the filter.
+ * @param state           IQ15 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ15 type input samples.
+ * @param output          IQ15 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ15fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 15);
+}
+/**
+ * @brief Filters an array of IQ14 type with a FIR filter.
+ *
+ * @param coeffs          IQ14 type coefficients of the filter.
+ * @param state           IQ14 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ14 type input samples.
+ * @param output          IQ14 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ14fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 14);
+}
+/**
+ * @brief Filters an array of IQ13 type with a FIR filter.
+ *
+ * @param coeffs          IQ13 type coefficients of the filter.
+ * @param state           IQ13 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ13 type input samples.
+ * @param output          IQ13 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ13fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 13);
+}
+/**
+ * @brief Filters an array of IQ12 type with a FIR filter.
+ *
+ * @param coeffs          IQ12 type coefficients of the filter.
+ * @param state           IQ12 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ12 type input samples.
+ * @param output          IQ12 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ12fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 12);
+}
+/**
+ * @brief Filters an array of IQ11 type with a FIR filter.
+ *
+ * @param coeffs          IQ11 type coefficients of the filter.
+ * @param state           IQ11 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ11 type input samples.
+ * @param output          IQ11 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ11fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 11);
+}
+/**
+ * @brief Filters an array of IQ10 type with a FIR filter.
+ *
+ * @param coeffs          IQ10 type coefficients of the filter.
+ * @param state           IQ10 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ10 type input samples.
+ * @param output          IQ10 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ10fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 10);
+}
+/**
+ * @brief Filters an array of IQ9 type with a FIR filter.
+ *
+ * @param coeffs          IQ9 type coefficients of the filter.
+ * @param state           IQ9 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ9 type input samples.
+ * @param output          IQ9 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ9fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 9);
+}
+/**
+ * @brief Filters an array of IQ8 type with a FIR filter.
+ *
+ * @param coeffs          IQ8 type coefficients of the filter.
+ * @param state           IQ8 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ8 type input samples.
+ * @param output          IQ8 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ8fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 8);
+}
+/**
+ * @brief Filters an array of IQ7 type with a FIR filter.
+ *
+ * @param coeffs          IQ7 type coefficients of the filter.
+ * @param state           IQ7 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ7 type input samples.
+ * @param output          IQ7 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ7fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 7);
+}
+/**
+ * @brief Filters an array of IQ6 type with a FIR filter.
+ *
+ * @param coeffs          IQ6 type coefficients of the filter.
+ * @param state           IQ6 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ6 type input samples.
+ * @param output          IQ6 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ6fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 6);
+}
+/**
+ * @brief Filters an array of IQ5 type with a FIR filter.
+ *
+ * @param coeffs          IQ5 type coefficients of the filter.
+ * @param state           IQ5 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ5 type input samples.
+ * @param output          IQ5 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ5fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 5);
+}
+/**
+ * @brief Filters an array of IQ4 type with a FIR filter.
+ *
+ * @param coeffs          IQ4 type coefficients of the filter.
+ * @param state           IQ4 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ4 type input samples.
+ * @param output          IQ4 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ4fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 4);
+}
+/**
+ * @brief Filters an array of IQ3 type with a FIR filter.
+ *
+ * @param coeffs          IQ3 type coefficients of the filter.
+ * @param state           IQ3 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ3 type input samples.
+ * @param output          IQ3 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ3fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 3);
+}
+/**
+ * @brief Filters an array of IQ2 type with a FIR filter.
+ *
+ * @param coeffs          IQ2 type coefficients of the filter.
+ * @param state           IQ2 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ2 type input samples.
+ * @param output          IQ2 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ2fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 2);
+}
+/**
+ * @brief Filters an array of IQ1 type with a FIR filter.
+ *
+ * @param coeffs          IQ1 type coefficients of the filter.
+ * @param state           IQ1 type taps - 1 last input samples of the previous block.
+ * @param taps            Number of coefficients.
+ * @param input           IQ1 type input samples.
+ * @param output          IQ1 type output samples.
+ * @param len             Number of samples.
+ */
+void _IQ1fir(const int32_t *coeffs, int32_t *state, size_t taps, const int32_t *input, int32_t *output, size_t len)
+{
+    __IQNfir(coeffs, state, taps, input, output, len, 1);
+}
+
+/* IQ sinCosArray functions */
+
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ29 type, in radians.
+ *
+ * @param a               IQ29 type input array.
+ * @param sinRes          IQ29 type array of the results of sine operation.
+ * @param cosRes          IQ29 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ29sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 29, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ28 type, in radians.
+ *
+ * @param a               IQ28 type input array.
+ * @param sinRes          IQ28 type array of the results of sine operation.
+ * @param cosRes          IQ28 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ28sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 28, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ27 type, in radians.
+ *
+ * @param a               IQ27 type input array.
+ * @param sinRes          IQ27 type array of the results of sine operation.
+ * @param cosRes          IQ27 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ27sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 27, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ26 type, in radians.
+ *
+ * @param a               IQ26 type input array.
+ * @param sinRes          IQ26 type array of the results of sine operation.
+ * @param cosRes          IQ26 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ26sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 26, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ25 type, in radians.
+ *
+ * @param a               IQ25 type input array.
+ * @param sinRes          IQ25 type array of the results of sine operation.
+ * @param cosRes          IQ25 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ25sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 25, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ24 type, in radians.
+ *
+ * @param a               IQ24 type input array.
+ * @param sinRes          IQ24 type array of the results of sine operation.
+ * @param cosRes          IQ24 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ24sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 24, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ23 type, in radians.
+ *
+ * @param a               IQ23 type input array.
+ * @param sinRes          IQ23 type array of the results of sine operation.
+ * @param cosRes          IQ23 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ23sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 23, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ22 type, in radians.
+ *
+ * @param a               IQ22 type input array.
+ * @param sinRes          IQ22 type array of the results of sine operation.
+ * @param cosRes          IQ22 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ22sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 22, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ21 type, in radians.
+ *
+ * @param a               IQ21 type input array.
+ * @param sinRes          IQ21 type array of the results of sine operation.
+ * @param cosRes          IQ21 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ21sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 21, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ20 type, in radians.
+ *
+ * @param a               IQ20 type input array.
+ * @param sinRes          IQ20 type array of the results of sine operation.
+ * @param cosRes          IQ20 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ20sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 20, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ19 type, in radians.
+ *
+ * @param a               IQ19 type input array.
+ * @param sinRes          IQ19 type array of the results of sine operation.
+ * @param cosRes          IQ19 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ19sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 19, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ18 type, in radians.
+ *
+ * @param a               IQ18 type input array.
+ * @param sinRes          IQ18 type array of the results of sine operation.
+ * @param cosRes          IQ18 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ18sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 18, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ17 type, in radians.
+ *
+ * @param a               IQ17 type input array.
+ * @param sinRes          IQ17 type array of the results of sine operation.
+ * @param cosRes          IQ17 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ17sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 17, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ16 type, in radians.
+ *
+ * @param a               IQ16 type input array.
+ * @param sinRes          IQ16 type array of the results of sine operation.
+ * @param cosRes          IQ16 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ16sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 16, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ15 type, in radians.
+ *
+ * @param a               IQ15 type input array.
+ * @param sinRes          IQ15 type array of the results of sine operation.
+ * @param cosRes          IQ15 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ15sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 15, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ14 type, in radians.
+ *
+ * @param a               IQ14 type input array.
+ * @param sinRes          IQ14 type array of the results of sine operation.
+ * @param cosRes          IQ14 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ14sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 14, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ13 type, in radians.
+ *
+ * @param a               IQ13 type input array.
+ * @param sinRes          IQ13 type array of the results of sine operation.
+ * @param cosRes          IQ13 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ13sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 13, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ12 type, in radians.
+ *
+ * @param a               IQ12 type input array.
+ * @param sinRes          IQ12 type array of the results of sine operation.
+ * @param cosRes          IQ12 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ12sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 12, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ11 type, in radians.
+ *
+ * @param a               IQ11 type input array.
+ * @param sinRes          IQ11 type array of the results of sine operation.
+ * @param cosRes          IQ11 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ11sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 11, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ10 type, in radians.
+ *
+ * @param a               IQ10 type input array.
+ * @param sinRes          IQ10 type array of the results of sine operation.
+ * @param cosRes          IQ10 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ10sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 10, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ9 type, in radians.
+ *
+ * @param a               IQ9 type input array.
+ * @param sinRes          IQ9 type array of the results of sine operation.
+ * @param cosRes          IQ9 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ9sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 9, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ8 type, in radians.
+ *
+ * @param a               IQ8 type input array.
+ * @param sinRes          IQ8 type array of the results of sine operation.
+ * @param cosRes          IQ8 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ8sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 8, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ7 type, in radians.
+ *
+ * @param a               IQ7 type input array.
+ * @param sinRes          IQ7 type array of the results of sine operation.
+ * @param cosRes          IQ7 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ7sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 7, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ6 type, in radians.
+ *
+ * @param a               IQ6 type input array.
+ * @param sinRes          IQ6 type array of the results of sine operation.
+ * @param cosRes          IQ6 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ6sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 6, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ5 type, in radians.
+ *
+ * @param a               IQ5 type input array.
+ * @param sinRes          IQ5 type array of the results of sine operation.
+ * @param cosRes          IQ5 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ5sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 5, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ4 type, in radians.
+ *
+ * @param a               IQ4 type input array.
+ * @param sinRes          IQ4 type array of the results of sine operation.
+ * @param cosRes          IQ4 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ4sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 4, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ3 type, in radians.
+ *
+ * @param a               IQ3 type input array.
+ * @param sinRes          IQ3 type array of the results of sine operation.
+ * @param cosRes          IQ3 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ3sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 3, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ2 type, in radians.
+ *
+ * @param a               IQ2 type input array.
+ * @param sinRes          IQ2 type array of the results of sine operation.
+ * @param cosRes          IQ2 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ2sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 2, TYPE_RAD);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ1 type, in radians.
+ *
+ * @param a               IQ1 type input array.
+ * @param sinRes          IQ1 type array of the results of sine operation.
+ * @param cosRes          IQ1 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ1sinCosArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 1, TYPE_RAD);
+}
+
+/* IQ sinCosPUArray functions */
+
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ30 type, in cycles per unit.
+ *
+ * @param a               IQ30 type input array.
+ * @param sinRes          IQ30 type array of the results of sine operation.
+ * @param cosRes          IQ30 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ30sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 30, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ29 type, in cycles per unit.
+ *
+ * @param a               IQ29 type input array.
+ * @param sinRes          IQ29 type array of the results of sine operation.
+ * @param cosRes          IQ29 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ29sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 29, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ28 type, in cycles per unit.
+ *
+ * @param a               IQ28 type input array.
+ * @param sinRes          IQ28 type array of the results of sine operation.
+ * @param cosRes          IQ28 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ28sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 28, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ27 type, in cycles per unit.
+ *
+ * @param a               IQ27 type input array.
+ * @param sinRes          IQ27 type array of the results of sine operation.
+ * @param cosRes          IQ27 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ27sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 27, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ26 type, in cycles per unit.
+ *
+ * @param a               IQ26 type input array.
+ * @param sinRes          IQ26 type array of the results of sine operation.
+ * @param cosRes          IQ26 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ26sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 26, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ25 type, in cycles per unit.
+ *
+ * @param a               IQ25 type input array.
+ * @param sinRes          IQ25 type array of the results of sine operation.
+ * @param cosRes          IQ25 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ25sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 25, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ24 type, in cycles per unit.
+ *
+ * @param a               IQ24 type input array.
+ * @param sinRes          IQ24 type array of the results of sine operation.
+ * @param cosRes          IQ24 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ24sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 24, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ23 type, in cycles per unit.
+ *
+ * @param a               IQ23 type input array.
+ * @param sinRes          IQ23 type array of the results of sine operation.
+ * @param cosRes          IQ23 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ23sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 23, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ22 type, in cycles per unit.
+ *
+ * @param a               IQ22 type input array.
+ * @param sinRes          IQ22 type array of the results of sine operation.
+ * @param cosRes          IQ22 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ22sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 22, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ21 type, in cycles per unit.
+ *
+ * @param a               IQ21 type input array.
+ * @param sinRes          IQ21 type array of the results of sine operation.
+ * @param cosRes          IQ21 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ21sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 21, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ20 type, in cycles per unit.
+ *
+ * @param a               IQ20 type input array.
+ * @param sinRes          IQ20 type array of the results of sine operation.
+ * @param cosRes          IQ20 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ20sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 20, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ19 type, in cycles per unit.
+ *
+ * @param a               IQ19 type input array.
+ * @param sinRes          IQ19 type array of the results of sine operation.
+ * @param cosRes          IQ19 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ19sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 19, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ18 type, in cycles per unit.
+ *
+ * @param a               IQ18 type input array.
+ * @param sinRes          IQ18 type array of the results of sine operation.
+ * @param cosRes          IQ18 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ18sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 18, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ17 type, in cycles per unit.
+ *
+ * @param a               IQ17 type input array.
+ * @param sinRes          IQ17 type array of the results of sine operation.
+ * @param cosRes          IQ17 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ17sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 17, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ16 type, in cycles per unit.
+ *
+ * @param a               IQ16 type input array.
+ * @param sinRes          IQ16 type array of the results of sine operation.
+ * @param cosRes          IQ16 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ16sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 16, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ15 type, in cycles per unit.
+ *
+ * @param a               IQ15 type input array.
+ * @param sinRes          IQ15 type array of the results of sine operation.
+ * @param cosRes          IQ15 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ15sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 15, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ14 type, in cycles per unit.
+ *
+ * @param a               IQ14 type input array.
+ * @param sinRes          IQ14 type array of the results of sine operation.
+ * @param cosRes          IQ14 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ14sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 14, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ13 type, in cycles per unit.
+ *
+ * @param a               IQ13 type input array.
+ * @param sinRes          IQ13 type array of the results of sine operation.
+ * @param cosRes          IQ13 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ13sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 13, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ12 type, in cycles per unit.
+ *
+ * @param a               IQ12 type input array.
+ * @param sinRes          IQ12 type array of the results of sine operation.
+ * @param cosRes          IQ12 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ12sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 12, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ11 type, in cycles per unit.
+ *
+ * @param a               IQ11 type input array.
+ * @param sinRes          IQ11 type array of the results of sine operation.
+ * @param cosRes          IQ11 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ11sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 11, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ10 type, in cycles per unit.
+ *
+ * @param a               IQ10 type input array.
+ * @param sinRes          IQ10 type array of the results of sine operation.
+ * @param cosRes          IQ10 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ10sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 10, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ9 type, in cycles per unit.
+ *
+ * @param a               IQ9 type input array.
+ * @param sinRes          IQ9 type array of the results of sine operation.
+ * @param cosRes          IQ9 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ9sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 9, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ8 type, in cycles per unit.
+ *
+ * @param a               IQ8 type input array.
+ * @param sinRes          IQ8 type array of the results of sine operation.
+ * @param cosRes          IQ8 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ8sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 8, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ7 type, in cycles per unit.
+ *
+ * @param a               IQ7 type input array.
+ * @param sinRes          IQ7 type array of the results of sine operation.
+ * @param cosRes          IQ7 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ7sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 7, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ6 type, in cycles per unit.
+ *
+ * @param a               IQ6 type input array.
+ * @param sinRes          IQ6 type array of the results of sine operation.
+ * @param cosRes          IQ6 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ6sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 6, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ5 type, in cycles per unit.
+ *
+ * @param a               IQ5 type input array.
+ * @param sinRes          IQ5 type array of the results of sine operation.
+ * @param cosRes          IQ5 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ5sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 5, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ4 type, in cycles per unit.
+ *
+ * @param a               IQ4 type input array.
+ * @param sinRes          IQ4 type array of the results of sine operation.
+ * @param cosRes          IQ4 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ4sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 4, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ3 type, in cycles per unit.
+ *
+ * @param a               IQ3 type input array.
+ * @param sinRes          IQ3 type array of the results of sine operation.
+ * @param cosRes          IQ3 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ3sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 3, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ2 type, in cycles per unit.
+ *
+ * @param a               IQ2 type input array.
+ * @param sinRes          IQ2 type array of the results of sine operation.
+ * @param cosRes          IQ2 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ2sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 2, TYPE_PU);
+}
+/**
+ * @brief Computes the sine and cosine of the elements of an array of IQ1 type, in cycles per unit.
+ *
+ * @param a               IQ1 type input array.
+ * @param sinRes          IQ1 type array of the results of sine operation.
+ * @param cosRes          IQ1 type array of the results of cosine operation.
+ * @param len             Number of elements.
+ */
+void _IQ1sinCosPUArray(const int32_t *a, int32_t *sinRes, int32_t *cosRes, size_t len)
+{
+    __IQNsinCosArray(a, sinRes, cosRes, len, 1, TYPE_PU);
+}
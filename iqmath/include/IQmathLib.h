@@ -6516,6 +6516,1004 @@ extern int16_t _IQ1toa(char *string, const char *format, _iq1 input);
  */
 #define _IQabs(A)               (((A) < 0) ? - (A) : (A))
 
+//*****************************************************************************
+//
+// Array functions, applying the operations to whole blocks of IQ numbers.
+// The result arrays can be the same as the input arrays, unless stated
+// otherwise. The products are not saturated.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Multiplies the elements of two arrays of IQ numbers.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern void _IQ30mpyArray(const _iq30 *a, const _iq30 *b, _iq30 *res, size_t len);
+extern void _IQ29mpyArray(const _iq29 *a, const _iq29 *b, _iq29 *res, size_t len);
+extern void _IQ28mpyArray(const _iq28 *a, const _iq28 *b, _iq28 *res, size_t len);
+extern void _IQ27mpyArray(const _iq27 *a, const _iq27 *b, _iq27 *res, size_t len);
+extern void _IQ26mpyArray(const _iq26 *a, const _iq26 *b, _iq26 *res, size_t len);
+extern void _IQ25mpyArray(const _iq25 *a, const _iq25 *b, _iq25 *res, size_t len);
+extern void _IQ24mpyArray(const _iq24 *a, const _iq24 *b, _iq24 *res, size_t len);
+extern void _IQ23mpyArray(const _iq23 *a, const _iq23 *b, _iq23 *res, size_t len);
+extern void _IQ22mpyArray(const _iq22 *a, const _iq22 *b, _iq22 *res, size_t len);
+extern void _IQ21mpyArray(const _iq21 *a, const _iq21 *b, _iq21 *res, size_t len);
+extern void _IQ20mpyArray(const _iq20 *a, const _iq20 *b, _iq20 *res, size_t len);
+extern void _IQ19mpyArray(const _iq19 *a, const _iq19 *b, _iq19 *res, size_t len);
+extern void _IQ18mpyArray(const _iq18 *a, const _iq18 *b, _iq18 *res, size_t len);
+extern void _IQ17mpyArray(const _iq17 *a, const _iq17 *b, _iq17 *res, size_t len);
+extern void _IQ16mpyArray(const _iq16 *a, const _iq16 *b, _iq16 *res, size_t len);
+extern void _IQ15mpyArray(const _iq15 *a, const _iq15 *b, _iq15 *res, size_t len);
+extern void _IQ14mpyArray(const _iq14 *a, const _iq14 *b, _iq14 *res, size_t len);
+extern void _IQ13mpyArray(const _iq13 *a, const _iq13 *b, _iq13 *res, size_t len);
+extern void _IQ12mpyArray(const _iq12 *a, const _iq12 *b, _iq12 *res, size_t len);
+extern void _IQ11mpyArray(const _iq11 *a, const _iq11 *b, _iq11 *res, size_t len);
+extern void _IQ10mpyArray(const _iq10 *a, const _iq10 *b, _iq10 *res, size_t len);
+extern void _IQ9mpyArray(const _iq9 *a, const _iq9 *b, _iq9 *res, size_t len);
+extern void _IQ8mpyArray(const _iq8 *a, const _iq8 *b, _iq8 *res, size_t len);
+extern void _IQ7mpyArray(const _iq7 *a, const _iq7 *b, _iq7 *res, size_t len);
+extern void _IQ6mpyArray(const _iq6 *a, const _iq6 *b, _iq6 *res, size_t len);
+extern void _IQ5mpyArray(const _iq5 *a, const _iq5 *b, _iq5 *res, size_t len);
+extern void _IQ4mpyArray(const _iq4 *a, const _iq4 *b, _iq4 *res, size_t len);
+extern void _IQ3mpyArray(const _iq3 *a, const _iq3 *b, _iq3 *res, size_t len);
+extern void _IQ2mpyArray(const _iq2 *a, const _iq2 *b, _iq2 *res, size_t len);
+extern void _IQ1mpyArray(const _iq1 *a, const _iq1 *b, _iq1 *res, size_t len);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Multiplies the elements of two arrays of global IQ format numbers.
+ *
+ * @param A               Global IQ format array to be multiplied.
+ * @param B               Global IQ format array to be multiplied.
+ * @param RES             Global IQ format array of the results.
+ * @param LEN             Number of elements.
+ */
+#if GLOBAL_IQ == 30
+#define _IQmpyArray(A, B, RES, LEN) _IQ30mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQmpyArray(A, B, RES, LEN) _IQ29mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQmpyArray(A, B, RES, LEN) _IQ28mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQmpyArray(A, B, RES, LEN) _IQ27mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQmpyArray(A, B, RES, LEN) _IQ26mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQmpyArray(A, B, RES, LEN) _IQ25mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQmpyArray(A, B, RES, LEN) _IQ24mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQmpyArray(A, B, RES, LEN) _IQ23mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQmpyArray(A, B, RES, LEN) _IQ22mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQmpyArray(A, B, RES, LEN) _IQ21mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQmpyArray(A, B, RES, LEN) _IQ20mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQmpyArray(A, B, RES, LEN) _IQ19mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQmpyArray(A, B, RES, LEN) _IQ18mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQmpyArray(A, B, RES, LEN) _IQ17mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQmpyArray(A, B, RES, LEN) _IQ16mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQmpyArray(A, B, RES, LEN) _IQ15mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQmpyArray(A, B, RES, LEN) _IQ14mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQmpyArray(A, B, RES, LEN) _IQ13mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQmpyArray(A, B, RES, LEN) _IQ12mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQmpyArray(A, B, RES, LEN) _IQ11mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQmpyArray(A, B, RES, LEN) _IQ10mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQmpyArray(A, B, RES, LEN) _IQ9mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQmpyArray(A, B, RES, LEN) _IQ8mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQmpyArray(A, B, RES, LEN) _IQ7mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQmpyArray(A, B, RES, LEN) _IQ6mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQmpyArray(A, B, RES, LEN) _IQ5mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQmpyArray(A, B, RES, LEN) _IQ4mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQmpyArray(A, B, RES, LEN) _IQ3mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQmpyArray(A, B, RES, LEN) _IQ2mpyArray(A, B, RES, LEN)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQmpyArray(A, B, RES, LEN) _IQ1mpyArray(A, B, RES, LEN)
+#endif
+
+//*****************************************************************************
+//
+// Multiplies the elements of two arrays of IQ numbers and accumulates the products.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern void _IQ30macArray(const _iq30 *a, const _iq30 *b, _iq30 *acc, size_t len);
+extern void _IQ29macArray(const _iq29 *a, const _iq29 *b, _iq29 *acc, size_t len);
+extern void _IQ28macArray(const _iq28 *a, const _iq28 *b, _iq28 *acc, size_t len);
+extern void _IQ27macArray(const _iq27 *a, const _iq27 *b, _iq27 *acc, size_t len);
+extern void _IQ26macArray(const _iq26 *a, const _iq26 *b, _iq26 *acc, size_t len);
+extern void _IQ25macArray(const _iq25 *a, const _iq25 *b, _iq25 *acc, size_t len);
+extern void _IQ24macArray(const _iq24 *a, const _iq24 *b, _iq24 *acc, size_t len);
+extern void _IQ23macArray(const _iq23 *a, const _iq23 *b, _iq23 *acc, size_t len);
+extern void _IQ22macArray(const _iq22 *a, const _iq22 *b, _iq22 *acc, size_t len);
+extern void _IQ21macArray(const _iq21 *a, const _iq21 *b, _iq21 *acc, size_t len);
+extern void _IQ20macArray(const _iq20 *a, const _iq20 *b, _iq20 *acc, size_t len);
+extern void _IQ19macArray(const _iq19 *a, const _iq19 *b, _iq19 *acc, size_t len);
+extern void _IQ18macArray(const _iq18 *a, const _iq18 *b, _iq18 *acc, size_t len);
+extern void _IQ17macArray(const _iq17 *a, const _iq17 *b, _iq17 *acc, size_t len);
+extern void _IQ16macArray(const _iq16 *a, const _iq16 *b, _iq16 *acc, size_t len);
+extern void _IQ15macArray(const _iq15 *a, const _iq15 *b, _iq15 *acc, size_t len);
+extern void _IQ14macArray(const _iq14 *a, const _iq14 *b, _iq14 *acc, size_t len);
+extern void _IQ13macArray(const _iq13 *a, const _iq13 *b, _iq13 *acc, size_t len);
+extern void _IQ12macArray(const _iq12 *a, const _iq12 *b, _iq12 *acc, size_t len);
+extern void _IQ11macArray(const _iq11 *a, const _iq11 *b, _iq11 *acc, size_t len);
+extern void _IQ10macArray(const _iq10 *a, const _iq10 *b, _iq10 *acc, size_t len);
+extern void _IQ9macArray(const _iq9 *a, const _iq9 *b, _iq9 *acc, size_t len);
+extern void _IQ8macArray(const _iq8 *a, const _iq8 *b, _iq8 *acc, size_t len);
+extern void _IQ7macArray(const _iq7 *a, const _iq7 *b, _iq7 *acc, size_t len);
+extern void _IQ6macArray(const _iq6 *a, const _iq6 *b, _iq6 *acc, size_t len);
+extern void _IQ5macArray(const _iq5 *a, const _iq5 *b, _iq5 *acc, size_t len);
+extern void _IQ4macArray(const _iq4 *a, const _iq4 *b, _iq4 *acc, size_t len);
+extern void _IQ3macArray(const _iq3 *a, const _iq3 *b, _iq3 *acc, size_t len);
+extern void _IQ2macArray(const _iq2 *a, const _iq2 *b, _iq2 *acc, size_t len);
+extern void _IQ1macArray(const _iq1 *a, const _iq1 *b, _iq1 *acc, size_t len);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Multiplies the elements of two arrays of global IQ format numbers and
+ * adds the products to the elements of an accumulator array: ACC[i] += A[i] * B[i].
+ *
+ * @param A               Global IQ format array to be multiplied.
+ * @param B               Global IQ format array to be multiplied.
+ * @param ACC             Global IQ format array the products are added to.
+ * @param LEN             Number of elements.
+ */
+#if GLOBAL_IQ == 30
+#define _IQmacArray(A, B, ACC, LEN) _IQ30macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQmacArray(A, B, ACC, LEN) _IQ29macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQmacArray(A, B, ACC, LEN) _IQ28macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQmacArray(A, B, ACC, LEN) _IQ27macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQmacArray(A, B, ACC, LEN) _IQ26macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQmacArray(A, B, ACC, LEN) _IQ25macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQmacArray(A, B, ACC, LEN) _IQ24macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQmacArray(A, B, ACC, LEN) _IQ23macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQmacArray(A, B, ACC, LEN) _IQ22macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQmacArray(A, B, ACC, LEN) _IQ21macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQmacArray(A, B, ACC, LEN) _IQ20macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQmacArray(A, B, ACC, LEN) _IQ19macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQmacArray(A, B, ACC, LEN) _IQ18macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQmacArray(A, B, ACC, LEN) _IQ17macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQmacArray(A, B, ACC, LEN) _IQ16macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQmacArray(A, B, ACC, LEN) _IQ15macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQmacArray(A, B, ACC, LEN) _IQ14macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQmacArray(A, B, ACC, LEN) _IQ13macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQmacArray(A, B, ACC, LEN) _IQ12macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQmacArray(A, B, ACC, LEN) _IQ11macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQmacArray(A, B, ACC, LEN) _IQ10macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQmacArray(A, B, ACC, LEN) _IQ9macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQmacArray(A, B, ACC, LEN) _IQ8macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQmacArray(A, B, ACC, LEN) _IQ7macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQmacArray(A, B, ACC, LEN) _IQ6macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQmacArray(A, B, ACC, LEN) _IQ5macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQmacArray(A, B, ACC, LEN) _IQ4macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQmacArray(A, B, ACC, LEN) _IQ3macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQmacArray(A, B, ACC, LEN) _IQ2macArray(A, B, ACC, LEN)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQmacArray(A, B, ACC, LEN) _IQ1macArray(A, B, ACC, LEN)
+#endif
+
+//*****************************************************************************
+//
+// Multiplies the elements of an array of IQ numbers by a value.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern void _IQ30scaleArray(const _iq30 *a, _iq30 scale, _iq30 *res, size_t len);
+extern void _IQ29scaleArray(const _iq29 *a, _iq29 scale, _iq29 *res, size_t len);
+extern void _IQ28scaleArray(const _iq28 *a, _iq28 scale, _iq28 *res, size_t len);
+extern void _IQ27scaleArray(const _iq27 *a, _iq27 scale, _iq27 *res, size_t len);
+extern void _IQ26scaleArray(const _iq26 *a, _iq26 scale, _iq26 *res, size_t len);
+extern void _IQ25scaleArray(const _iq25 *a, _iq25 scale, _iq25 *res, size_t len);
+extern void _IQ24scaleArray(const _iq24 *a, _iq24 scale, _iq24 *res, size_t len);
+extern void _IQ23scaleArray(const _iq23 *a, _iq23 scale, _iq23 *res, size_t len);
+extern void _IQ22scaleArray(const _iq22 *a, _iq22 scale, _iq22 *res, size_t len);
+extern void _IQ21scaleArray(const _iq21 *a, _iq21 scale, _iq21 *res, size_t len);
+extern void _IQ20scaleArray(const _iq20 *a, _iq20 scale, _iq20 *res, size_t len);
+extern void _IQ19scaleArray(const _iq19 *a, _iq19 scale, _iq19 *res, size_t len);
+extern void _IQ18scaleArray(const _iq18 *a, _iq18 scale, _iq18 *res, size_t len);
+extern void _IQ17scaleArray(const _iq17 *a, _iq17 scale, _iq17 *res, size_t len);
+extern void _IQ16scaleArray(const _iq16 *a, _iq16 scale, _iq16 *res, size_t len);
+extern void _IQ15scaleArray(const _iq15 *a, _iq15 scale, _iq15 *res, size_t len);
+extern void _IQ14scaleArray(const _iq14 *a, _iq14 scale, _iq14 *res, size_t len);
+extern void _IQ13scaleArray(const _iq13 *a, _iq13 scale, _iq13 *res, size_t len);
+extern void _IQ12scaleArray(const _iq12 *a, _iq12 scale, _iq12 *res, size_t len);
+extern void _IQ11scaleArray(const _iq11 *a, _iq11 scale, _iq11 *res, size_t len);
+extern void _IQ10scaleArray(const _iq10 *a, _iq10 scale, _iq10 *res, size_t len);
+extern void _IQ9scaleArray(const _iq9 *a, _iq9 scale, _iq9 *res, size_t len);
+extern void _IQ8scaleArray(const _iq8 *a, _iq8 scale, _iq8 *res, size_t len);
+extern void _IQ7scaleArray(const _iq7 *a, _iq7 scale, _iq7 *res, size_t len);
+extern void _IQ6scaleArray(const _iq6 *a, _iq6 scale, _iq6 *res, size_t len);
+extern void _IQ5scaleArray(const _iq5 *a, _iq5 scale, _iq5 *res, size_t len);
+extern void _IQ4scaleArray(const _iq4 *a, _iq4 scale, _iq4 *res, size_t len);
+extern void _IQ3scaleArray(const _iq3 *a, _iq3 scale, _iq3 *res, size_t len);
+extern void _IQ2scaleArray(const _iq2 *a, _iq2 scale, _iq2 *res, size_t len);
+extern void _IQ1scaleArray(const _iq1 *a, _iq1 scale, _iq1 *res, size_t len);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Multiplies the elements of an array of global IQ format numbers by a value.
+ *
+ * @param A               Global IQ format array to be multiplied.
+ * @param SCALE           Global IQ format value to multiply by.
+ * @param RES             Global IQ format array of the results.
+ * @param LEN             Number of elements.
+ */
+#if GLOBAL_IQ == 30
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ30scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ29scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ28scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ27scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ26scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ25scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ24scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ23scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ22scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ21scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ20scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ19scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ18scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ17scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ16scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ15scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ14scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ13scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ12scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ11scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ10scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ9scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ8scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ7scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ6scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ5scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ4scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ3scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ2scaleArray(A, SCALE, RES, LEN)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQscaleArray(A, SCALE, RES, LEN) _IQ1scaleArray(A, SCALE, RES, LEN)
+#endif
+
+//*****************************************************************************
+//
+// Computes the dot product of two arrays of IQ numbers.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern _iq30 _IQ30dot(const _iq30 *a, const _iq30 *b, size_t len);
+extern _iq29 _IQ29dot(const _iq29 *a, const _iq29 *b, size_t len);
+extern _iq28 _IQ28dot(const _iq28 *a, const _iq28 *b, size_t len);
+extern _iq27 _IQ27dot(const _iq27 *a, const _iq27 *b, size_t len);
+extern _iq26 _IQ26dot(const _iq26 *a, const _iq26 *b, size_t len);
+extern _iq25 _IQ25dot(const _iq25 *a, const _iq25 *b, size_t len);
+extern _iq24 _IQ24dot(const _iq24 *a, const _iq24 *b, size_t len);
+extern _iq23 _IQ23dot(const _iq23 *a, const _iq23 *b, size_t len);
+extern _iq22 _IQ22dot(const _iq22 *a, const _iq22 *b, size_t len);
+extern _iq21 _IQ21dot(const _iq21 *a, const _iq21 *b, size_t len);
+extern _iq20 _IQ20dot(const _iq20 *a, const _iq20 *b, size_t len);
+extern _iq19 _IQ19dot(const _iq19 *a, const _iq19 *b, size_t len);
+extern _iq18 _IQ18dot(const _iq18 *a, const _iq18 *b, size_t len);
+extern _iq17 _IQ17dot(const _iq17 *a, const _iq17 *b, size_t len);
+extern _iq16 _IQ16dot(const _iq16 *a, const _iq16 *b, size_t len);
+extern _iq15 _IQ15dot(const _iq15 *a, const _iq15 *b, size_t len);
+extern _iq14 _IQ14dot(const _iq14 *a, const _iq14 *b, size_t len);
+extern _iq13 _IQ13dot(const _iq13 *a, const _iq13 *b, size_t len);
+extern _iq12 _IQ12dot(const _iq12 *a, const _iq12 *b, size_t len);
+extern _iq11 _IQ11dot(const _iq11 *a, const _iq11 *b, size_t len);
+extern _iq10 _IQ10dot(const _iq10 *a, const _iq10 *b, size_t len);
+extern _iq9 _IQ9dot(const _iq9 *a, const _iq9 *b, size_t len);
+extern _iq8 _IQ8dot(const _iq8 *a, const _iq8 *b, size_t len);
+extern _iq7 _IQ7dot(const _iq7 *a, const _iq7 *b, size_t len);
+extern _iq6 _IQ6dot(const _iq6 *a, const _iq6 *b, size_t len);
+extern _iq5 _IQ5dot(const _iq5 *a, const _iq5 *b, size_t len);
+extern _iq4 _IQ4dot(const _iq4 *a, const _iq4 *b, size_t len);
+extern _iq3 _IQ3dot(const _iq3 *a, const _iq3 *b, size_t len);
+extern _iq2 _IQ2dot(const _iq2 *a, const _iq2 *b, size_t len);
+extern _iq1 _IQ1dot(const _iq1 *a, const _iq1 *b, size_t len);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Computes the dot product of two arrays of global IQ format numbers.
+ *
+ * The products are summed with 64 bits and the sum is converted to the IQ
+ * format once, so the result is more accurate than the sum of _IQmpy().
+ * The sum must fit in the IQ format.
+ *
+ * @param A               Global IQ format array.
+ * @param B               Global IQ format array.
+ * @param LEN             Number of elements.
+ *
+ * @return                Global IQ format dot product.
+ */
+#if GLOBAL_IQ == 30
+#define _IQdot(A, B, LEN)       _IQ30dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQdot(A, B, LEN)       _IQ29dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQdot(A, B, LEN)       _IQ28dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQdot(A, B, LEN)       _IQ27dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQdot(A, B, LEN)       _IQ26dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQdot(A, B, LEN)       _IQ25dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQdot(A, B, LEN)       _IQ24dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQdot(A, B, LEN)       _IQ23dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQdot(A, B, LEN)       _IQ22dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQdot(A, B, LEN)       _IQ21dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQdot(A, B, LEN)       _IQ20dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQdot(A, B, LEN)       _IQ19dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQdot(A, B, LEN)       _IQ18dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQdot(A, B, LEN)       _IQ17dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQdot(A, B, LEN)       _IQ16dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQdot(A, B, LEN)       _IQ15dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQdot(A, B, LEN)       _IQ14dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQdot(A, B, LEN)       _IQ13dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQdot(A, B, LEN)       _IQ12dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQdot(A, B, LEN)       _IQ11dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQdot(A, B, LEN)       _IQ10dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQdot(A, B, LEN)       _IQ9dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQdot(A, B, LEN)       _IQ8dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQdot(A, B, LEN)       _IQ7dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQdot(A, B, LEN)       _IQ6dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQdot(A, B, LEN)       _IQ5dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQdot(A, B, LEN)       _IQ4dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQdot(A, B, LEN)       _IQ3dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQdot(A, B, LEN)       _IQ2dot(A, B, LEN)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQdot(A, B, LEN)       _IQ1dot(A, B, LEN)
+#endif
+
+//*****************************************************************************
+//
+// Filters an array of IQ numbers with a FIR filter.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern void _IQ30fir(const _iq30 *coeffs, _iq30 *state, size_t taps, const _iq30 *input, _iq30 *output, size_t len);
+extern void _IQ29fir(const _iq29 *coeffs, _iq29 *state, size_t taps, const _iq29 *input, _iq29 *output, size_t len);
+extern void _IQ28fir(const _iq28 *coeffs, _iq28 *state, size_t taps, const _iq28 *input, _iq28 *output, size_t len);
+extern void _IQ27fir(const _iq27 *coeffs, _iq27 *state, size_t taps, const _iq27 *input, _iq27 *output, size_t len);
+extern void _IQ26fir(const _iq26 *coeffs, _iq26 *state, size_t taps, const _iq26 *input, _iq26 *output, size_t len);
+extern void _IQ25fir(const _iq25 *coeffs, _iq25 *state, size_t taps, const _iq25 *input, _iq25 *output, size_t len);
+extern void _IQ24fir(const _iq24 *coeffs, _iq24 *state, size_t taps, const _iq24 *input, _iq24 *output, size_t len);
+extern void _IQ23fir(const _iq23 *coeffs, _iq23 *state, size_t taps, const _iq23 *input, _iq23 *output, size_t len);
+extern void _IQ22fir(const _iq22 *coeffs, _iq22 *state, size_t taps, const _iq22 *input, _iq22 *output, size_t len);
+extern void _IQ21fir(const _iq21 *coeffs, _iq21 *state, size_t taps, const _iq21 *input, _iq21 *output, size_t len);
+extern void _IQ20fir(const _iq20 *coeffs, _iq20 *state, size_t taps, const _iq20 *input, _iq20 *output, size_t len);
+extern void _IQ19fir(const _iq19 *coeffs, _iq19 *state, size_t taps, const _iq19 *input, _iq19 *output, size_t len);
+extern void _IQ18fir(const _iq18 *coeffs, _iq18 *state, size_t taps, const _iq18 *input, _iq18 *output, size_t len);
+extern void _IQ17fir(const _iq17 *coeffs, _iq17 *state, size_t taps, const _iq17 *input, _iq17 *output, size_t len);
+extern void _IQ16fir(const _iq16 *coeffs, _iq16 *state, size_t taps, const _iq16 *input, _iq16 *output, size_t len);
+extern void _IQ15fir(const _iq15 *coeffs, _iq15 *state, size_t taps, const _iq15 *input, _iq15 *output, size_t len);
+extern void _IQ14fir(const _iq14 *coeffs, _iq14 *state, size_t taps, const _iq14 *input, _iq14 *output, size_t len);
+extern void _IQ13fir(const _iq13 *coeffs, _iq13 *state, size_t taps, const _iq13 *input, _iq13 *output, size_t len);
+extern void _IQ12fir(const _iq12 *coeffs, _iq12 *state, size_t taps, const _iq12 *input, _iq12 *output, size_t len);
+extern void _IQ11fir(const _iq11 *coeffs, _iq11 *state, size_t taps, const _iq11 *input, _iq11 *output, size_t len);
+extern void _IQ10fir(const _iq10 *coeffs, _iq10 *state, size_t taps, const _iq10 *input, _iq10 *output, size_t len);
+extern void _IQ9fir(const _iq9 *coeffs, _iq9 *state, size_t taps, const _iq9 *input, _iq9 *output, size_t len);
+extern void _IQ8fir(const _iq8 *coeffs, _iq8 *state, size_t taps, const _iq8 *input, _iq8 *output, size_t len);
+extern void _IQ7fir(const _iq7 *coeffs, _iq7 *state, size_t taps, const _iq7 *input, _iq7 *output, size_t len);
+extern void _IQ6fir(const _iq6 *coeffs, _iq6 *state, size_t taps, const _iq6 *input, _iq6 *output, size_t len);
+extern void _IQ5fir(const _iq5 *coeffs, _iq5 *state, size_t taps, const _iq5 *input, _iq5 *output, size_t len);
+extern void _IQ4fir(const _iq4 *coeffs, _iq4 *state, size_t taps, const _iq4 *input, _iq4 *output, size_t len);
+extern void _IQ3fir(const _iq3 *coeffs, _iq3 *state, size_t taps, const _iq3 *input, _iq3 *output, size_t len);
+extern void _IQ2fir(const _iq2 *coeffs, _iq2 *state, size_t taps, const _iq2 *input, _iq2 *output, size_t len);
+extern void _IQ1fir(const _iq1 *coeffs, _iq1 *state, size_t taps, const _iq1 *input, _iq1 *output, size_t len);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Filters an array of global IQ format numbers with a FIR filter:
+ * OUTPUT[n] = COEFFS[0] * INPUT[n] + ... + COEFFS[TAPS - 1] * INPUT[n - TAPS + 1].
+ *
+ * The input samples preceding the block are taken from STATE, which is then
+ * updated with the last input samples of the block, so that a signal can be
+ * filtered block by block. STATE must be zeroed before the first block.
+ * The products are summed with 64 bits and the sum is converted to the IQ
+ * format once. OUTPUT must not overlap INPUT.
+ *
+ * @param COEFFS          Global IQ format array of TAPS coefficients.
+ * @param STATE           Global IQ format array of TAPS - 1 samples.
+ * @param TAPS            Number of coefficients.
+ * @param INPUT           Global IQ format input samples.
+ * @param OUTPUT          Global IQ format output samples.
+ * @param LEN             Number of samples.
+ */
+#if GLOBAL_IQ == 30
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ30fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ29fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ28fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ27fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ26fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ25fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ24fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ23fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ22fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ21fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ20fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ19fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ18fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ17fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ16fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ15fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ14fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ13fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ12fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ11fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ10fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ9fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ8fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ7fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ6fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ5fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ4fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ3fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ2fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQfir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN) _IQ1fir(COEFFS, STATE, TAPS, INPUT, OUTPUT, LEN)
+#endif
+
+//*****************************************************************************
+//
+// Computes the sine and cosine of the elements of an array of IQ numbers.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern void _IQ29sinCosArray(const _iq29 *a, _iq29 *sinRes, _iq29 *cosRes, size_t len);
+extern void _IQ28sinCosArray(const _iq28 *a, _iq28 *sinRes, _iq28 *cosRes, size_t len);
+extern void _IQ27sinCosArray(const _iq27 *a, _iq27 *sinRes, _iq27 *cosRes, size_t len);
+extern void _IQ26sinCosArray(const _iq26 *a, _iq26 *sinRes, _iq26 *cosRes, size_t len);
+extern void _IQ25sinCosArray(const _iq25 *a, _iq25 *sinRes, _iq25 *cosRes, size_t len);
+extern void _IQ24sinCosArray(const _iq24 *a, _iq24 *sinRes, _iq24 *cosRes, size_t len);
+extern void _IQ23sinCosArray(const _iq23 *a, _iq23 *sinRes, _iq23 *cosRes, size_t len);
+extern void _IQ22sinCosArray(const _iq22 *a, _iq22 *sinRes, _iq22 *cosRes, size_t len);
+extern void _IQ21sinCosArray(const _iq21 *a, _iq21 *sinRes, _iq21 *cosRes, size_t len);
+extern void _IQ20sinCosArray(const _iq20 *a, _iq20 *sinRes, _iq20 *cosRes, size_t len);
+extern void _IQ19sinCosArray(const _iq19 *a, _iq19 *sinRes, _iq19 *cosRes, size_t len);
+extern void _IQ18sinCosArray(const _iq18 *a, _iq18 *sinRes, _iq18 *cosRes, size_t len);
+extern void _IQ17sinCosArray(const _iq17 *a, _iq17 *sinRes, _iq17 *cosRes, size_t len);
+extern void _IQ16sinCosArray(const _iq16 *a, _iq16 *sinRes, _iq16 *cosRes, size_t len);
+extern void _IQ15sinCosArray(const _iq15 *a, _iq15 *sinRes, _iq15 *cosRes, size_t len);
+extern void _IQ14sinCosArray(const _iq14 *a, _iq14 *sinRes, _iq14 *cosRes, size_t len);
+extern void _IQ13sinCosArray(const _iq13 *a, _iq13 *sinRes, _iq13 *cosRes, size_t len);
+extern void _IQ12sinCosArray(const _iq12 *a, _iq12 *sinRes, _iq12 *cosRes, size_t len);
+extern void _IQ11sinCosArray(const _iq11 *a, _iq11 *sinRes, _iq11 *cosRes, size_t len);
+extern void _IQ10sinCosArray(const _iq10 *a, _iq10 *sinRes, _iq10 *cosRes, size_t len);
+extern void _IQ9sinCosArray(const _iq9 *a, _iq9 *sinRes, _iq9 *cosRes, size_t len);
+extern void _IQ8sinCosArray(const _iq8 *a, _iq8 *sinRes, _iq8 *cosRes, size_t len);
+extern void _IQ7sinCosArray(const _iq7 *a, _iq7 *sinRes, _iq7 *cosRes, size_t len);
+extern void _IQ6sinCosArray(const _iq6 *a, _iq6 *sinRes, _iq6 *cosRes, size_t len);
+extern void _IQ5sinCosArray(const _iq5 *a, _iq5 *sinRes, _iq5 *cosRes, size_t len);
+extern void _IQ4sinCosArray(const _iq4 *a, _iq4 *sinRes, _iq4 *cosRes, size_t len);
+extern void _IQ3sinCosArray(const _iq3 *a, _iq3 *sinRes, _iq3 *cosRes, size_t len);
+extern void _IQ2sinCosArray(const _iq2 *a, _iq2 *sinRes, _iq2 *cosRes, size_t len);
+extern void _IQ1sinCosArray(const _iq1 *a, _iq1 *sinRes, _iq1 *cosRes, size_t len);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Computes the sine and cosine of the elements of an array of global IQ
+ * format numbers, in radians. The results are the same as _IQsin() and _IQcos().
+ *
+ * @param A               Global IQ format input array.
+ * @param SIN             Global IQ format array of the results of sine operation.
+ * @param COS             Global IQ format array of the results of cosine operation.
+ * @param LEN             Number of elements.
+ */
+#if GLOBAL_IQ == 29
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ29sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ28sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ27sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ26sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ25sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ24sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ23sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ22sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ21sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ20sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ19sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ18sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ17sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ16sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ15sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ14sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ13sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ12sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ11sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ10sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ9sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ8sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ7sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ6sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ5sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ4sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ3sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ2sinCosArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQsinCosArray(A, SIN, COS, LEN) _IQ1sinCosArray(A, SIN, COS, LEN)
+#endif
+
+//*****************************************************************************
+//
+// Computes the sine and cosine of the elements of an array of IQ numbers, using cycles per unit instead of radians.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern void _IQ30sinCosPUArray(const _iq30 *a, _iq30 *sinRes, _iq30 *cosRes, size_t len);
+extern void _IQ29sinCosPUArray(const _iq29 *a, _iq29 *sinRes, _iq29 *cosRes, size_t len);
+extern void _IQ28sinCosPUArray(const _iq28 *a, _iq28 *sinRes, _iq28 *cosRes, size_t len);
+extern void _IQ27sinCosPUArray(const _iq27 *a, _iq27 *sinRes, _iq27 *cosRes, size_t len);
+extern void _IQ26sinCosPUArray(const _iq26 *a, _iq26 *sinRes, _iq26 *cosRes, size_t len);
+extern void _IQ25sinCosPUArray(const _iq25 *a, _iq25 *sinRes, _iq25 *cosRes, size_t len);
+extern void _IQ24sinCosPUArray(const _iq24 *a, _iq24 *sinRes, _iq24 *cosRes, size_t len);
+extern void _IQ23sinCosPUArray(const _iq23 *a, _iq23 *sinRes, _iq23 *cosRes, size_t len);
+extern void _IQ22sinCosPUArray(const _iq22 *a, _iq22 *sinRes, _iq22 *cosRes, size_t len);
+extern void _IQ21sinCosPUArray(const _iq21 *a, _iq21 *sinRes, _iq21 *cosRes, size_t len);
+extern void _IQ20sinCosPUArray(const _iq20 *a, _iq20 *sinRes, _iq20 *cosRes, size_t len);
+extern void _IQ19sinCosPUArray(const _iq19 *a, _iq19 *sinRes, _iq19 *cosRes, size_t len);
+extern void _IQ18sinCosPUArray(const _iq18 *a, _iq18 *sinRes, _iq18 *cosRes, size_t len);
+extern void _IQ17sinCosPUArray(const _iq17 *a, _iq17 *sinRes, _iq17 *cosRes, size_t len);
+extern void _IQ16sinCosPUArray(const _iq16 *a, _iq16 *sinRes, _iq16 *cosRes, size_t len);
+extern void _IQ15sinCosPUArray(const _iq15 *a, _iq15 *sinRes, _iq15 *cosRes, size_t len);
+extern void _IQ14sinCosPUArray(const _iq14 *a, _iq14 *sinRes, _iq14 *cosRes, size_t len);
+extern void _IQ13sinCosPUArray(const _iq13 *a, _iq13 *sinRes, _iq13 *cosRes, size_t len);
+extern void _IQ12sinCosPUArray(const _iq12 *a, _iq12 *sinRes, _iq12 *cosRes, size_t len);
+extern void _IQ11sinCosPUArray(const _iq11 *a, _iq11 *sinRes, _iq11 *cosRes, size_t len);
+extern void _IQ10sinCosPUArray(const _iq10 *a, _iq10 *sinRes, _iq10 *cosRes, size_t len);
+extern void _IQ9sinCosPUArray(const _iq9 *a, _iq9 *sinRes, _iq9 *cosRes, size_t len);
+extern void _IQ8sinCosPUArray(const _iq8 *a, _iq8 *sinRes, _iq8 *cosRes, size_t len);
+extern void _IQ7sinCosPUArray(const _iq7 *a, _iq7 *sinRes, _iq7 *cosRes, size_t len);
+extern void _IQ6sinCosPUArray(const _iq6 *a, _iq6 *sinRes, _iq6 *cosRes, size_t len);
+extern void _IQ5sinCosPUArray(const _iq5 *a, _iq5 *sinRes, _iq5 *cosRes, size_t len);
+extern void _IQ4sinCosPUArray(const _iq4 *a, _iq4 *sinRes, _iq4 *cosRes, size_t len);
+extern void _IQ3sinCosPUArray(const _iq3 *a, _iq3 *sinRes, _iq3 *cosRes, size_t len);
+extern void _IQ2sinCosPUArray(const _iq2 *a, _iq2 *sinRes, _iq2 *cosRes, size_t len);
+extern void _IQ1sinCosPUArray(const _iq1 *a, _iq1 *sinRes, _iq1 *cosRes, size_t len);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Computes the sine and cosine of the elements of an array of global IQ
+ * format numbers, in cycles per unit. The results are the same as _IQsinPU()
+ * and _IQcosPU().
+ *
+ * @param A               Global IQ format input array.
+ * @param SIN             Global IQ format array of the results of sine operation.
+ * @param COS             Global IQ format array of the results of cosine operation.
+ * @param LEN             Number of elements.
+ */
+#if GLOBAL_IQ == 30
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ30sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ29sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ28sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ27sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ26sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ25sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ24sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ23sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ22sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ21sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ20sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ19sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ18sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ17sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ16sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ15sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ14sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ13sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ12sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ11sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ10sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ9sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ8sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ7sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ6sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ5sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ4sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ3sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ2sinCosPUArray(A, SIN, COS, LEN)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQsinCosPUArray(A, SIN, COS, LEN) _IQ1sinCosPUArray(A, SIN, COS, LEN)
+#endif
+
+//*****************************************************************************
+//
+// Computes the magnitude of the elements of two arrays of IQ numbers.
+//
+//*****************************************************************************
+/**
+ * @brief Computes the square root of A[i]^2 + B[i]^2 for the elements of two
+ * arrays of IQ numbers. As for _IQmag(), the result does not depend on the
+ * IQ format.
+ *
+ * @param a               IQ type array of the first components.
+ * @param b               IQ type array of the second components.
+ * @param res             IQ type array of the results.
+ * @param len             Number of elements.
+ */
+extern void _IQmagArray(const int32_t *a, const int32_t *b, int32_t *res, size_t len);
+
 //*****************************************************************************
 //
 // Mark the end of the C bindings section for C++ compilers.
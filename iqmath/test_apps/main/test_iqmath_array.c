@@ -0,0 +1,185 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_cpu.h"
+#include "IQmathLib.h"
+
+#define TEST_ARRAY_LEN  256
+#define TEST_FIR_TAPS   16
+
+static const char *TAG = "iqmath_array_test";
+
+static _iq24 s_a[TEST_ARRAY_LEN];
+static _iq24 s_b[TEST_ARRAY_LEN];
+static _iq24 s_res[TEST_ARRAY_LEN];
+static _iq24 s_res2[TEST_ARRAY_LEN];
+
+/* Fill an array with pseudo-random IQ24 values in [-range, range) */
+static void fill_array(_iq24 *array, size_t len, uint32_t seed, int range_shift)
+{
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1664525 + 1013904223;
+        array[i] = (int32_t)seed >> range_shift;
+    }
+}
+
+TEST_CASE("Test IQ array arithmetic functions", "[iqmath]")
+{
+    fill_array(s_a, TEST_ARRAY_LEN, 1, 4);
+    fill_array(s_b, TEST_ARRAY_LEN, 2, 4);
+
+    _IQ24mpyArray(s_a, s_b, s_res, TEST_ARRAY_LEN);
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(_IQ24mpy(s_a[i], s_b[i]), s_res[i]);
+    }
+
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        s_res[i] = _IQ24(1.0);
+    }
+    _IQ24macArray(s_a, s_b, s_res, TEST_ARRAY_LEN);
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(_IQ24(1.0) + _IQ24mpy(s_a[i], s_b[i]), s_res[i]);
+    }
+
+    _IQ24scaleArray(s_a, _IQ24(-0.75), s_res, TEST_ARRAY_LEN);
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(_IQ24mpy(s_a[i], _IQ24(-0.75)), s_res[i]);
+    }
+
+    /* In place operation */
+    memcpy(s_res, s_a, sizeof(s_res));
+    _IQ24mpyArray(s_res, s_b, s_res, TEST_ARRAY_LEN);
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(_IQ24mpy(s_a[i], s_b[i]), s_res[i]);
+    }
+
+    /* Keep the sum of the products in range */
+    fill_array(s_a, TEST_ARRAY_LEN, 3, 12);
+    fill_array(s_b, TEST_ARRAY_LEN, 4, 12);
+    int64_t dot = 0;
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        dot += (int64_t)s_a[i] * s_b[i];
+    }
+    ESP_LOGI(TAG, "Dot product: %f", _IQ24toF(_IQ24dot(s_a, s_b, TEST_ARRAY_LEN)));
+    TEST_ASSERT_EQUAL_INT32((int32_t)(dot >> 24), _IQ24dot(s_a, s_b, TEST_ARRAY_LEN));
+}
+
+TEST_CASE("Test IQ array FIR filter", "[iqmath]")
+{
+    _iq24 coeffs[TEST_FIR_TAPS];
+    _iq24 state[TEST_FIR_TAPS - 1] = {0};
+    const size_t blocks[] = {1, 5, 20, 100, 130};
+
+    fill_array(coeffs, TEST_FIR_TAPS, 5, 8);
+    fill_array(s_a, TEST_ARRAY_LEN, 6, 8);
+
+    /* The filter applied block by block must match the filter applied to the whole signal */
+    size_t pos = 0;
+    for (size_t i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++) {
+        _IQ24fir(coeffs, state, TEST_FIR_TAPS, &s_a[pos], &s_res[pos], blocks[i]);
+        pos += blocks[i];
+    }
+    TEST_ASSERT_EQUAL(TEST_ARRAY_LEN, pos);
+
+    for (size_t n = 0; n < TEST_ARRAY_LEN; n++) {
+        int64_t acc = 0;
+        for (size_t k = 0; k < TEST_FIR_TAPS && k <= n; k++) {
+            acc += (int64_t)coeffs[k] * s_a[n - k];
+        }
+        TEST_ASSERT_EQUAL_INT32((int32_t)(acc >> 24), s_res[n]);
+    }
+}
+
+TEST_CASE("Test IQ array trigonometric and magnitude functions", "[iqmath]")
+{
+    fill_array(s_a, TEST_ARRAY_LEN, 7, 0);
+    fill_array(s_b, TEST_ARRAY_LEN, 8, 0);
+
+    /* The results must be the same as the ones of the scalar functions */
+    _IQ24sinCosArray(s_a, s_res, s_res2, TEST_ARRAY_LEN);
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(_IQ24sin(s_a[i]), s_res[i]);
+        TEST_ASSERT_EQUAL_INT32(_IQ24cos(s_a[i]), s_res2[i]);
+    }
+
+    _IQ24sinCosPUArray(s_a, s_res, s_res2, TEST_ARRAY_LEN);
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(_IQ24sinPU(s_a[i]), s_res[i]);
+        TEST_ASSERT_EQUAL_INT32(_IQ24cosPU(s_a[i]), s_res2[i]);
+    }
+
+    _IQmagArray(s_a, s_b, s_res, TEST_ARRAY_LEN);
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        TEST_ASSERT_EQUAL_INT32(_IQmag(s_a[i], s_b[i]), s_res[i]);
+    }
+}
+
+TEST_CASE("Test IQ array functions throughput", "[iqmath]")
+{
+    uint32_t start;
+    uint32_t scalar_cycles;
+    uint32_t array_cycles;
+
+    fill_array(s_a, TEST_ARRAY_LEN, 9, 4);
+    fill_array(s_b, TEST_ARRAY_LEN, 10, 4);
+
+    start = esp_cpu_get_cycle_count();
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        s_res[i] = _IQ24mpy(s_a[i], s_b[i]);
+    }
+    scalar_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    _IQ24mpyArray(s_a, s_b, s_res2, TEST_ARRAY_LEN);
+    array_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "mpy: %.1f cycles/sample scalar, %.1f cycles/sample array",
+             (float)scalar_cycles / TEST_ARRAY_LEN, (float)array_cycles / TEST_ARRAY_LEN);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(s_res, s_res2, TEST_ARRAY_LEN);
+
+    start = esp_cpu_get_cycle_count();
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        s_res[i] = _IQ24sin(s_a[i]);
+        s_res2[i] = _IQ24cos(s_a[i]);
+    }
+    scalar_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    _IQ24sinCosArray(s_a, s_b, s_res2, TEST_ARRAY_LEN);
+    array_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "sin+cos: %.1f cycles/sample scalar, %.1f cycles/sample array",
+             (float)scalar_cycles / TEST_ARRAY_LEN, (float)array_cycles / TEST_ARRAY_LEN);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(s_res, s_b, TEST_ARRAY_LEN);
+
+    fill_array(s_b, TEST_ARRAY_LEN, 10, 4);
+    start = esp_cpu_get_cycle_count();
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        s_res[i] = _IQmag(s_a[i], s_b[i]);
+    }
+    scalar_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    _IQmagArray(s_a, s_b, s_res2, TEST_ARRAY_LEN);
+    array_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "mag: %.1f cycles/sample scalar, %.1f cycles/sample array",
+             (float)scalar_cycles / TEST_ARRAY_LEN, (float)array_cycles / TEST_ARRAY_LEN);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(s_res, s_res2, TEST_ARRAY_LEN);
+
+    fill_array(s_a, TEST_ARRAY_LEN, 11, 12);
+    fill_array(s_b, TEST_ARRAY_LEN, 12, 12);
+    start = esp_cpu_get_cycle_count();
+    _iq24 sum = 0;
+    for (size_t i = 0; i < TEST_ARRAY_LEN; i++) {
+        sum += _IQ24mpy(s_a[i], s_b[i]);
+    }
+    scalar_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    _iq24 dot = _IQ24dot(s_a, s_b, TEST_ARRAY_LEN);
+    array_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "dot: %.1f cycles/sample scalar, %.1f cycles/sample array (%f, %f)",
+             (float)scalar_cycles / TEST_ARRAY_LEN, (float)array_cycles / TEST_ARRAY_LEN,
+             _IQ24toF(sum), _IQ24toF(dot));
+}
@@ -9,6 +9,7 @@
 #include "esp_err.h"
 #include "led_strip_rmt.h"
 #include "led_strip_spi.h"
+#include "led_strip_group.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -66,6 +67,59 @@ esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uin
  */
 esp_err_t led_strip_set_pixel_hsv(led_strip_handle_t strip, uint32_t index, uint16_t hue, uint8_t saturation, uint8_t value);
 
+/**
+ * @brief Set RGB for a range of pixels
+ *
+ * @note This is much faster than calling `led_strip_set_pixel` in a loop, because the color component order
+ *       and the backend specific encoding are resolved once for the whole range.
+ * @note For the strips with a white component, the white part is set to zero.
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param rgb: packed colors, 3 bytes per pixel in R-G-B order, regardless of the strip's color component format
+ *
+ * @return
+ *      - ESP_OK: Set RGB for the pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Set RGB for the pixels failed because of invalid parameters, e.g. the range is out of the strip
+ *      - ESP_FAIL: Set RGB for the pixels failed because other error occurred
+ */
+esp_err_t led_strip_set_pixels(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *rgb);
+
+/**
+ * @brief Set RGB for a range of pixels, with each color component mapped through a lookup table
+ *
+ * @note The lookup table is usually a gamma correction table, optionally with a global brightness scaling baked in.
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param rgb: packed colors, 3 bytes per pixel in R-G-B order
+ * @param gamma_table: 256-entry table that maps the input component value to the output value
+ *
+ * @return
+ *      - ESP_OK: Set RGB for the pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Set RGB for the pixels failed because of invalid parameters
+ *      - ESP_FAIL: Set RGB for the pixels failed because other error occurred
+ */
+esp_err_t led_strip_set_pixels_gamma(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *rgb, const uint8_t gamma_table[256]);
+
+/**
+ * @brief Set HSV for a range of pixels
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param hsv: array of `count` HSV colors
+ * @param gamma_table: optional 256-entry table applied to the converted R-G-B components, NULL to skip the mapping
+ *
+ * @return
+ *      - ESP_OK: Set HSV for the pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Set HSV for the pixels failed because of invalid parameters
+ *      - ESP_FAIL: Set HSV for the pixels failed because other error occurred
+ */
+esp_err_t led_strip_set_pixels_hsv(led_strip_handle_t strip, uint32_t start, uint32_t count, const led_color_hsv_t *hsv, const uint8_t gamma_table[256]);
+
 /**
  * @brief Refresh memory colors to LEDs
  *
@@ -80,6 +134,55 @@ esp_err_t led_strip_set_pixel_hsv(led_strip_handle_t strip, uint32_t index, uint
  */
 esp_err_t led_strip_refresh(led_strip_handle_t strip);
 
+/**
+ * @brief Start flushing memory colors to LEDs, return without waiting for the transmission to finish
+ *
+ * @note If the strip is created with `flags.double_buffer` set, the application can continue drawing the next frame
+ *       right after this function returns. The new draw buffer starts as a copy of the frame being transmitted.
+ * @note Without double buffering, the pixel buffer must not be modified until `led_strip_refresh_wait_done` returns
+ *       or the `on_refresh_done` callback is invoked.
+ * @note If a previous asynchronous refresh is still in progress, this function waits for it to finish first.
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh started successfully
+ *      - ESP_ERR_INVALID_ARG: Refresh failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Refresh failed because the backend doesn't support asynchronous refresh
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ */
+esp_err_t led_strip_refresh_async(led_strip_handle_t strip);
+
+/**
+ * @brief Wait for the refresh started by `led_strip_refresh_async` to finish
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh finished, or there was no refresh in progress
+ *      - ESP_ERR_INVALID_ARG: Wait failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Wait failed because the backend doesn't support asynchronous refresh
+ *      - ESP_FAIL: Wait failed because some other error occurred
+ */
+esp_err_t led_strip_refresh_wait_done(led_strip_handle_t strip);
+
+/**
+ * @brief Register LED strip event callbacks
+ *
+ * @note The callbacks are invoked from ISR context, so they must not call blocking functions
+ *
+ * @param strip: LED strip
+ * @param cbs: Group of callback functions, pass NULL to unregister all callbacks
+ * @param user_data: User data, which will be passed to the callback functions directly
+ *
+ * @return
+ *      - ESP_OK: Register callbacks successfully
+ *      - ESP_ERR_INVALID_ARG: Register callbacks failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Register callbacks failed because a refresh is in progress
+ *      - ESP_ERR_NOT_SUPPORTED: Register callbacks failed because the backend doesn't support it
+ */
+esp_err_t led_strip_register_event_callbacks(led_strip_handle_t strip, const led_strip_event_callbacks_t *cbs, void *user_data);
+
 /**
  * @brief Clear LED strip (turn off all LEDs)
  *
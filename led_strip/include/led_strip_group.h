@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "led_strip_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Type of LED strip group handle
+ */
+typedef struct led_strip_group_t *led_strip_group_handle_t;
+
+/**
+ * @brief Create a group of LED strips that are refreshed together
+ *
+ * @note The strips in a group are transmitted by their own peripheral channels in parallel,
+ *       so refreshing a group takes about the time of refreshing the longest strip.
+ * @note The group only references the strips, it doesn't take the ownership.
+ *       Delete the group before deleting any of the strips in it.
+ *
+ * @param strips: Array of LED strip handles
+ * @param num_strips: Number of LED strips in the array
+ * @param ret_group: Returned LED strip group handle
+ *
+ * @return
+ *      - ESP_OK: Create LED strip group successfully
+ *      - ESP_ERR_INVALID_ARG: Create LED strip group failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Create LED strip group failed because some strip doesn't support asynchronous refresh
+ *      - ESP_ERR_NO_MEM: Create LED strip group failed because of out of memory
+ */
+esp_err_t led_strip_new_group(const led_strip_handle_t *strips, size_t num_strips, led_strip_group_handle_t *ret_group);
+
+/**
+ * @brief Start refreshing all the strips in the group, return without waiting for the transmissions to finish
+ *
+ * @note Same as `led_strip_refresh_async`, the pixel buffers must not be modified until the refresh is done,
+ *       unless the strips are created with double buffering.
+ *
+ * @param group: LED strip group
+ *
+ * @return
+ *      - ESP_OK: Refresh started successfully
+ *      - ESP_ERR_INVALID_ARG: Refresh failed because of invalid argument
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ */
+esp_err_t led_strip_group_refresh_async(led_strip_group_handle_t group);
+
+/**
+ * @brief Wait for all the strips in the group to finish the refresh
+ *
+ * @param group: LED strip group
+ *
+ * @return
+ *      - ESP_OK: All strips finished the refresh
+ *      - ESP_ERR_INVALID_ARG: Wait failed because of invalid argument
+ *      - ESP_FAIL: Wait failed because some other error occurred
+ */
+esp_err_t led_strip_group_refresh_wait_done(led_strip_group_handle_t group);
+
+/**
+ * @brief Refresh all the strips in the group in parallel, and wait for them to finish
+ *
+ * @param group: LED strip group
+ *
+ * @return
+ *      - ESP_OK: Refresh successfully
+ *      - ESP_ERR_INVALID_ARG: Refresh failed because of invalid argument
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ */
+esp_err_t led_strip_group_refresh(led_strip_group_handle_t group);
+
+/**
+ * @brief Delete the LED strip group
+ *
+ * @note The strips in the group are not deleted
+ *
+ * @param group: LED strip group
+ *
+ * @return
+ *      - ESP_OK: Delete the group successfully
+ *      - ESP_ERR_INVALID_ARG: Delete the group failed because of invalid argument
+ */
+esp_err_t led_strip_del_group(led_strip_group_handle_t group);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,6 +17,24 @@ extern "C" {
  */
 typedef struct led_strip_t *led_strip_handle_t;
 
+/**
+ * @brief Type of LED strip refresh done callback
+ *
+ * @note The callback is invoked from ISR context, it must not block
+ *
+ * @param strip LED strip handle
+ * @param user_data User registered context, passed from `led_strip_register_event_callbacks`
+ * @return Whether a high priority task has been waken up by this callback function
+ */
+typedef bool (*led_strip_refresh_done_cb_t)(led_strip_handle_t strip, void *user_data);
+
+/**
+ * @brief Group of supported LED strip event callbacks
+ */
+typedef struct {
+    led_strip_refresh_done_cb_t on_refresh_done; /*!< Invoked when a refresh transaction has been clocked out completely */
+} led_strip_event_callbacks_t;
+
 /**
  * @brief LED strip model
  * @note Different led model may have different timing parameters, so we need to distinguish them.
@@ -49,6 +68,15 @@ typedef union {
 #define LED_STRIP_COLOR_COMPONENT_FMT_RGB (led_color_component_format_t){.format = {.r_pos = 0, .g_pos = 1, .b_pos = 2, .w_pos = 3, .reserved = 0, .num_components = 3}}
 #define LED_STRIP_COLOR_COMPONENT_FMT_RGBW (led_color_component_format_t){.format = {.r_pos = 0, .g_pos = 1, .b_pos = 2, .w_pos = 3, .reserved = 0, .num_components = 4}}
 
+/**
+ * @brief HSV color, used by the bulk pixel APIs
+ */
+typedef struct {
+    uint16_t hue;       /*!< Hue part of color (0 - 360) */
+    uint8_t saturation; /*!< Saturation part of color (0 - 255) */
+    uint8_t value;      /*!< Value part of color (0 - 255) */
+} led_color_hsv_t;
+
 /**
  * @brief LED Strip common configurations
  *        The common configurations are not specific to any backend peripheral.
@@ -61,7 +89,9 @@ typedef struct {
                                                               Use helper macros like `LED_STRIP_COLOR_COMPONENT_FMT_GRB` to set the format */
     /*!< LED strip extra driver flags */
     struct led_strip_extra_flags {
-        uint32_t invert_out: 1; /*!< Invert output signal */
+        uint32_t invert_out: 1;    /*!< Invert output signal */
+        uint32_t double_buffer: 1; /*!< Allocate a second pixel buffer, so the application can draw the next frame
+                                        while the previous one is still being transmitted by `led_strip_refresh_async` */
     } flags; /*!< Extra driver flags */
 } led_strip_config_t;
 
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include "esp_err.h"
+#include "led_strip_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,6 +52,23 @@ struct led_strip_t {
      */
     esp_err_t (*set_pixel_rgbw)(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white);
 
+    /**
+     * @brief Set RGB for a range of pixels
+     *
+     * @note Optional, the generic layer falls back to calling `set_pixel` for each pixel if it's not implemented
+     *
+     * @param strip: LED strip
+     * @param start: index of the first pixel to set
+     * @param count: number of pixels to set
+     * @param rgb: packed R-G-B bytes, 3 bytes per pixel
+     *
+     * @return
+     *      - ESP_OK: Set RGB for the pixels successfully
+     *      - ESP_ERR_INVALID_ARG: Set RGB for the pixels failed because of invalid parameters
+     *      - ESP_FAIL: Set RGB for the pixels failed because other error occurred
+     */
+    esp_err_t (*set_pixels)(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *rgb);
+
     /**
      * @brief Refresh memory colors to LEDs
      *
@@ -66,6 +84,41 @@ struct led_strip_t {
      */
     esp_err_t (*refresh)(led_strip_t *strip);
 
+    /**
+     * @brief Start refreshing memory colors to LEDs without waiting for the transmission to finish
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Refresh started successfully
+     *      - ESP_FAIL: Refresh failed because some other error occurred
+     */
+    esp_err_t (*refresh_async)(led_strip_t *strip);
+
+    /**
+     * @brief Wait for the pending asynchronous refresh to finish
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Pending refresh finished (or there was nothing pending)
+     *      - ESP_FAIL: Wait failed because some other error occurred
+     */
+    esp_err_t (*refresh_wait_done)(led_strip_t *strip);
+
+    /**
+     * @brief Register event callbacks
+     *
+     * @param strip: LED strip
+     * @param cbs: Group of callback functions
+     * @param user_data: User data, will be passed to the callback functions directly
+     *
+     * @return
+     *      - ESP_OK: Register callbacks successfully
+     *      - ESP_ERR_INVALID_STATE: Register callbacks failed because a refresh is in progress
+     */
+    esp_err_t (*register_event_callbacks)(led_strip_t *strip, const led_strip_event_callbacks_t *cbs, void *user_data);
+
     /**
      * @brief Clear LED strip (turn off all LEDs)
      *
@@ -3,11 +3,15 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <inttypes.h>
 #include "esp_log.h"
 #include "esp_check.h"
 #include "led_strip.h"
 #include "led_strip_interface.h"
 
+// number of pixels converted on the stack at a time by the HSV and gamma mapped bulk APIs
+#define LED_STRIP_BULK_CHUNK_PIXELS 32
+
 static const char *TAG = "led_strip";
 
 esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
@@ -16,14 +20,8 @@ esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t
     return strip->set_pixel(strip, index, red, green, blue);
 }
 
-esp_err_t led_strip_set_pixel_hsv(led_strip_handle_t strip, uint32_t index, uint16_t hue, uint8_t saturation, uint8_t value)
+static void led_strip_hsv2rgb(uint16_t hue, uint8_t saturation, uint8_t value, uint32_t *red, uint32_t *green, uint32_t *blue)
 {
-    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
-
-    uint32_t red = 0;
-    uint32_t green = 0;
-    uint32_t blue = 0;
-
     uint32_t rgb_max = value;
     uint32_t rgb_min = rgb_max * (255 - saturation) / 255.0f;
 
@@ -35,40 +33,108 @@ esp_err_t led_strip_set_pixel_hsv(led_strip_handle_t strip, uint32_t index, uint
 
     switch (i) {
     case 0:
-        red = rgb_max;
-        green = rgb_min + rgb_adj;
-        blue = rgb_min;
+        *red = rgb_max;
+        *green = rgb_min + rgb_adj;
+        *blue = rgb_min;
         break;
     case 1:
-        red = rgb_max - rgb_adj;
-        green = rgb_max;
-        blue = rgb_min;
+        *red = rgb_max - rgb_adj;
+        *green = rgb_max;
+        *blue = rgb_min;
         break;
     case 2:
-        red = rgb_min;
-        green = rgb_max;
-        blue = rgb_min + rgb_adj;
+        *red = rgb_min;
+        *green = rgb_max;
+        *blue = rgb_min + rgb_adj;
         break;
     case 3:
-        red = rgb_min;
-        green = rgb_max - rgb_adj;
-        blue = rgb_max;
+        *red = rgb_min;
+        *green = rgb_max - rgb_adj;
+        *blue = rgb_max;
         break;
     case 4:
-        red = rgb_min + rgb_adj;
-        green = rgb_min;
-        blue = rgb_max;
+        *red = rgb_min + rgb_adj;
+        *green = rgb_min;
+        *blue = rgb_max;
         break;
     default:
-        red = rgb_max;
-        green = rgb_min;
-        blue = rgb_max - rgb_adj;
+        *red = rgb_max;
+        *green = rgb_min;
+        *blue = rgb_max - rgb_adj;
         break;
     }
+}
+
+esp_err_t led_strip_set_pixel_hsv(led_strip_handle_t strip, uint32_t index, uint16_t hue, uint8_t saturation, uint8_t value)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    uint32_t red = 0;
+    uint32_t green = 0;
+    uint32_t blue = 0;
+    led_strip_hsv2rgb(hue, saturation, value, &red, &green, &blue);
 
     return strip->set_pixel(strip, index, red, green, blue);
 }
 
+esp_err_t led_strip_set_pixels(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *rgb)
+{
+    ESP_RETURN_ON_FALSE(strip && rgb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (strip->set_pixels) {
+        return strip->set_pixels(strip, start, count, rgb);
+    }
+    // fallback for the backends that don't support bulk upload
+    for (uint32_t i = 0; i < count; i++, rgb += 3) {
+        ESP_RETURN_ON_ERROR(strip->set_pixel(strip, start + i, rgb[0], rgb[1], rgb[2]), TAG, "set pixel %"PRIu32" failed", start + i);
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_strip_set_pixels_gamma(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *rgb, const uint8_t gamma_table[256])
+{
+    ESP_RETURN_ON_FALSE(strip && rgb && gamma_table, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    uint8_t chunk[LED_STRIP_BULK_CHUNK_PIXELS * 3];
+    while (count) {
+        uint32_t n = count < LED_STRIP_BULK_CHUNK_PIXELS ? count : LED_STRIP_BULK_CHUNK_PIXELS;
+        for (uint32_t i = 0; i < n * 3; i++) {
+            chunk[i] = gamma_table[rgb[i]];
+        }
+        ESP_RETURN_ON_ERROR(led_strip_set_pixels(strip, start, n, chunk), TAG, "set pixels failed");
+        start += n;
+        count -= n;
+        rgb += n * 3;
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_strip_set_pixels_hsv(led_strip_handle_t strip, uint32_t start, uint32_t count, const led_color_hsv_t *hsv, const uint8_t gamma_table[256])
+{
+    ESP_RETURN_ON_FALSE(strip && hsv, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    uint8_t chunk[LED_STRIP_BULK_CHUNK_PIXELS * 3];
+    uint32_t red = 0;
+    uint32_t green = 0;
+    uint32_t blue = 0;
+    while (count) {
+        uint32_t n = count < LED_STRIP_BULK_CHUNK_PIXELS ? count : LED_STRIP_BULK_CHUNK_PIXELS;
+        for (uint32_t i = 0; i < n; i++) {
+            led_strip_hsv2rgb(hsv[i].hue, hsv[i].saturation, hsv[i].value, &red, &green, &blue);
+            if (gamma_table) {
+                red = gamma_table[red & 0xFF];
+                green = gamma_table[green & 0xFF];
+                blue = gamma_table[blue & 0xFF];
+            }
+            chunk[i * 3 + 0] = red;
+            chunk[i * 3 + 1] = green;
+            chunk[i * 3 + 2] = blue;
+        }
+        ESP_RETURN_ON_ERROR(led_strip_set_pixels(strip, start, n, chunk), TAG, "set pixels failed");
+        start += n;
+        count -= n;
+        hsv += n;
+    }
+    return ESP_OK;
+}
+
 esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white)
 {
     ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -81,6 +147,27 @@ esp_err_t led_strip_refresh(led_strip_handle_t strip)
     return strip->refresh(strip);
 }
 
+esp_err_t led_strip_refresh_async(led_strip_handle_t strip)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(strip->refresh_async, ESP_ERR_NOT_SUPPORTED, TAG, "async refresh not supported");
+    return strip->refresh_async(strip);
+}
+
+esp_err_t led_strip_refresh_wait_done(led_strip_handle_t strip)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(strip->refresh_wait_done, ESP_ERR_NOT_SUPPORTED, TAG, "async refresh not supported");
+    return strip->refresh_wait_done(strip);
+}
+
+esp_err_t led_strip_register_event_callbacks(led_strip_handle_t strip, const led_strip_event_callbacks_t *cbs, void *user_data)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(strip->register_event_callbacks, ESP_ERR_NOT_SUPPORTED, TAG, "event callbacks not supported");
+    return strip->register_event_callbacks(strip, cbs, user_data);
+}
+
 esp_err_t led_strip_clear(led_strip_handle_t strip)
 {
     ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "led_strip.h"
+#include "led_strip_group.h"
+#include "led_strip_interface.h"
+
+static const char *TAG = "led_strip_group";
+
+typedef struct led_strip_group_t {
+    size_t num_strips;
+    led_strip_handle_t strips[];
+} led_strip_group_t;
+
+esp_err_t led_strip_new_group(const led_strip_handle_t *strips, size_t num_strips, led_strip_group_handle_t *ret_group)
+{
+    ESP_RETURN_ON_FALSE(strips && num_strips && ret_group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    for (size_t i = 0; i < num_strips; i++) {
+        ESP_RETURN_ON_FALSE(strips[i], ESP_ERR_INVALID_ARG, TAG, "invalid strip handle at %zu", i);
+        ESP_RETURN_ON_FALSE(strips[i]->refresh_async && strips[i]->refresh_wait_done, ESP_ERR_NOT_SUPPORTED, TAG,
+                            "strip %zu doesn't support async refresh", i);
+    }
+    led_strip_group_t *group = calloc(1, sizeof(led_strip_group_t) + num_strips * sizeof(led_strip_handle_t));
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_NO_MEM, TAG, "no mem for strip group");
+    for (size_t i = 0; i < num_strips; i++) {
+        group->strips[i] = strips[i];
+    }
+    group->num_strips = num_strips;
+    *ret_group = group;
+    return ESP_OK;
+}
+
+esp_err_t led_strip_group_refresh_async(led_strip_group_handle_t group)
+{
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    for (size_t i = 0; i < group->num_strips; i++) {
+        led_strip_handle_t strip = group->strips[i];
+        esp_err_t ret = strip->refresh_async(strip);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "start refresh of strip %zu failed", i);
+            // don't leave the strips that have been started in an unknown state
+            led_strip_group_refresh_wait_done(group);
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_strip_group_refresh_wait_done(led_strip_group_handle_t group)
+{
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_err_t first_err = ESP_OK;
+    // the strips are transmitted in parallel, so the total wait time is bounded by the longest strip
+    for (size_t i = 0; i < group->num_strips; i++) {
+        led_strip_handle_t strip = group->strips[i];
+        esp_err_t ret = strip->refresh_wait_done(strip);
+        if (ret != ESP_OK && first_err == ESP_OK) {
+            ESP_LOGE(TAG, "wait refresh of strip %zu failed", i);
+            first_err = ret;
+        }
+    }
+    return first_err;
+}
+
+esp_err_t led_strip_group_refresh(led_strip_group_handle_t group)
+{
+    ESP_RETURN_ON_ERROR(led_strip_group_refresh_async(group), TAG, "start group refresh failed");
+    return led_strip_group_refresh_wait_done(group);
+}
+
+esp_err_t led_strip_del_group(led_strip_group_handle_t group)
+{
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(group);
+    return ESP_OK;
+}
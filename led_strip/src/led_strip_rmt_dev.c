@@ -31,9 +31,23 @@ typedef struct {
     uint32_t strip_len;
     uint8_t bytes_per_pixel;
     led_color_component_format_t component_fmt;
-    uint8_t pixel_buf[];
+    bool tx_in_progress;           // an asynchronous refresh has been started and not waited yet
+    led_strip_refresh_done_cb_t on_refresh_done;
+    void *user_data;
+    uint8_t *pixel_buf;            // buffer that the application draws into
+    uint8_t *tx_buf;               // buffer handed to the RMT channel, only differs from pixel_buf when double buffered
+    uint8_t pixel_buf_mem[];
 } led_strip_rmt_obj;
 
+static bool led_strip_rmt_trans_done_cb(rmt_channel_handle_t tx_chan, const rmt_tx_done_event_data_t *edata, void *user_ctx)
+{
+    led_strip_rmt_obj *rmt_strip = (led_strip_rmt_obj *)user_ctx;
+    if (rmt_strip->on_refresh_done) {
+        return rmt_strip->on_refresh_done(&rmt_strip->base, rmt_strip->user_data);
+    }
+    return false;
+}
+
 static esp_err_t led_strip_rmt_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
 {
     led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
@@ -71,18 +85,90 @@ static esp_err_t led_strip_rmt_set_pixel_rgbw(led_strip_t *strip, uint32_t index
     return ESP_OK;
 }
 
-static esp_err_t led_strip_rmt_refresh(led_strip_t *strip)
+static esp_err_t led_strip_rmt_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *rgb)
 {
     led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(start <= rmt_strip->strip_len && count <= rmt_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG,
+                        "pixel range out of maximum number of LEDs");
+
+    // resolve the color component order once for the whole range
+    led_color_component_format_t component_fmt = rmt_strip->component_fmt;
+    uint8_t bytes_per_pixel = rmt_strip->bytes_per_pixel;
+    uint8_t r_pos = component_fmt.format.r_pos;
+    uint8_t g_pos = component_fmt.format.g_pos;
+    uint8_t b_pos = component_fmt.format.b_pos;
+    uint8_t *pixel = rmt_strip->pixel_buf + start * bytes_per_pixel;
+
+    if (bytes_per_pixel > 3) {
+        uint8_t w_pos = component_fmt.format.w_pos;
+        for (uint32_t i = 0; i < count; i++, rgb += 3, pixel += 4) {
+            pixel[r_pos] = rgb[0];
+            pixel[g_pos] = rgb[1];
+            pixel[b_pos] = rgb[2];
+            pixel[w_pos] = 0;
+        }
+    } else {
+        for (uint32_t i = 0; i < count; i++, rgb += 3, pixel += 3) {
+            pixel[r_pos] = rgb[0];
+            pixel[g_pos] = rgb[1];
+            pixel[b_pos] = rgb[2];
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh_wait_done(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    if (!rmt_strip->tx_in_progress) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
+    ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+    rmt_strip->tx_in_progress = false;
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh_async(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    size_t frame_size = rmt_strip->strip_len * rmt_strip->bytes_per_pixel;
     rmt_transmit_config_t tx_conf = {
         .loop_count = 0,
     };
 
-    ESP_RETURN_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), TAG, "enable RMT channel failed");
-    ESP_RETURN_ON_ERROR(rmt_transmit(rmt_strip->rmt_chan, rmt_strip->strip_encoder, rmt_strip->pixel_buf,
-                                     rmt_strip->strip_len * rmt_strip->bytes_per_pixel, &tx_conf), TAG, "transmit pixels by RMT failed");
-    ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
-    ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+    if (rmt_strip->tx_in_progress) {
+        // the previous frame still owns the transmit buffer, wait for it but keep the channel enabled
+        ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
+    } else {
+        ESP_RETURN_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), TAG, "enable RMT channel failed");
+        rmt_strip->tx_in_progress = true;
+    }
+
+    if (rmt_strip->tx_buf != rmt_strip->pixel_buf) {
+        // swap the buffers, and let the application continue drawing based on the frame being transmitted
+        uint8_t *draw_buf = rmt_strip->tx_buf;
+        rmt_strip->tx_buf = rmt_strip->pixel_buf;
+        rmt_strip->pixel_buf = draw_buf;
+        memcpy(draw_buf, rmt_strip->tx_buf, frame_size);
+    }
+    ESP_RETURN_ON_ERROR(rmt_transmit(rmt_strip->rmt_chan, rmt_strip->strip_encoder, rmt_strip->tx_buf, frame_size, &tx_conf),
+                        TAG, "transmit pixels by RMT failed");
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh(led_strip_t *strip)
+{
+    ESP_RETURN_ON_ERROR(led_strip_rmt_refresh_async(strip), TAG, "start refresh failed");
+    return led_strip_rmt_refresh_wait_done(strip);
+}
+
+static esp_err_t led_strip_rmt_register_event_callbacks(led_strip_t *strip, const led_strip_event_callbacks_t *cbs, void *user_data)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(!rmt_strip->tx_in_progress, ESP_ERR_INVALID_STATE, TAG, "refresh in progress");
+    rmt_strip->on_refresh_done = cbs ? cbs->on_refresh_done : NULL;
+    rmt_strip->user_data = user_data;
     return ESP_OK;
 }
 
@@ -97,6 +183,7 @@ static esp_err_t led_strip_rmt_clear(led_strip_t *strip)
 static esp_err_t led_strip_rmt_del(led_strip_t *strip)
 {
     led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_ERROR(led_strip_rmt_refresh_wait_done(strip), TAG, "wait pending refresh failed");
     ESP_RETURN_ON_ERROR(rmt_del_channel(rmt_strip->rmt_chan), TAG, "delete RMT channel failed");
     ESP_RETURN_ON_ERROR(rmt_del_encoder(rmt_strip->strip_encoder), TAG, "delete strip encoder failed");
     free(rmt_strip);
@@ -128,8 +215,12 @@ esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const l
     }
     // TODO: we assume each color component is 8 bits, may need to support other configurations in the future, e.g. 10bits per color component?
     uint8_t bytes_per_pixel = component_fmt.format.num_components;
-    rmt_strip = calloc(1, sizeof(led_strip_rmt_obj) + led_config->max_leds * bytes_per_pixel);
+    size_t frame_size = led_config->max_leds * bytes_per_pixel;
+    size_t num_bufs = led_config->flags.double_buffer ? 2 : 1;
+    rmt_strip = calloc(1, sizeof(led_strip_rmt_obj) + frame_size * num_bufs);
     ESP_GOTO_ON_FALSE(rmt_strip, ESP_ERR_NO_MEM, err, TAG, "no mem for rmt strip");
+    rmt_strip->pixel_buf = rmt_strip->pixel_buf_mem;
+    rmt_strip->tx_buf = rmt_strip->pixel_buf_mem + frame_size * (num_bufs - 1);
     uint32_t resolution = rmt_config->resolution_hz ? rmt_config->resolution_hz : LED_STRIP_RMT_DEFAULT_RESOLUTION;
 
     // for backward compatibility, if the user does not set the clk_src, use the default value
@@ -152,6 +243,10 @@ esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const l
         .flags.invert_out = led_config->flags.invert_out,
     };
     ESP_GOTO_ON_ERROR(rmt_new_tx_channel(&rmt_chan_config, &rmt_strip->rmt_chan), err, TAG, "create RMT TX channel failed");
+    rmt_tx_event_callbacks_t rmt_cbs = {
+        .on_trans_done = led_strip_rmt_trans_done_cb,
+    };
+    ESP_GOTO_ON_ERROR(rmt_tx_register_event_callbacks(rmt_strip->rmt_chan, &rmt_cbs, rmt_strip), err, TAG, "register RMT callbacks failed");
 
     led_strip_encoder_config_t strip_encoder_conf = {
         .resolution = resolution,
@@ -164,7 +259,11 @@ esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const l
     rmt_strip->strip_len = led_config->max_leds;
     rmt_strip->base.set_pixel = led_strip_rmt_set_pixel;
     rmt_strip->base.set_pixel_rgbw = led_strip_rmt_set_pixel_rgbw;
+    rmt_strip->base.set_pixels = led_strip_rmt_set_pixels;
     rmt_strip->base.refresh = led_strip_rmt_refresh;
+    rmt_strip->base.refresh_async = led_strip_rmt_refresh_async;
+    rmt_strip->base.refresh_wait_done = led_strip_rmt_refresh_wait_done;
+    rmt_strip->base.register_event_callbacks = led_strip_rmt_register_event_callbacks;
     rmt_strip->base.clear = led_strip_rmt_clear;
     rmt_strip->base.del = led_strip_rmt_del;
 
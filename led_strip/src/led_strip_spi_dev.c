@@ -13,6 +13,7 @@
 #include "led_strip.h"
 #include "led_strip_interface.h"
 #include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
 
 #define LED_STRIP_SPI_DEFAULT_RESOLUTION (2.5 * 1000 * 1000) // 2.5MHz resolution
 #define LED_STRIP_SPI_DEFAULT_TRANS_QUEUE_SIZE 4
@@ -29,23 +30,38 @@ typedef struct {
     uint32_t strip_len;
     uint8_t bytes_per_pixel;
     led_color_component_format_t component_fmt;
-    uint8_t pixel_buf[];
+    bool tx_in_progress;           // an asynchronous refresh has been queued and its result not fetched yet
+    spi_transaction_t tx_trans;    // must stay valid while the transaction is in the SPI queue
+    led_strip_refresh_done_cb_t on_refresh_done;
+    void *user_data;
+    uint8_t *pixel_buf;            // buffer that the application draws into
+    uint8_t *tx_buf;               // buffer handed to the SPI device, only differs from pixel_buf when double buffered
+    uint8_t pixel_buf_mem[];
 } led_strip_spi_obj;
 
-// please make sure to zero-initialize the buf before calling this function
-static void __led_strip_spi_bit(uint8_t data, uint8_t *buf)
+// Each color of 1 bit is represented by 3 bits of SPI, low_level:100 ,high_level:110
+// So a color byte occupies 3 bytes of SPI, sent MSB first.
+#define LED_STRIP_SPI_BITS(d) (0x924924 | \
+                               ((d) & BIT(0) ? BIT(1) : 0) | ((d) & BIT(1) ? BIT(4) : 0) | \
+                               ((d) & BIT(2) ? BIT(7) : 0) | ((d) & BIT(3) ? BIT(10) : 0) | \
+                               ((d) & BIT(4) ? BIT(13) : 0) | ((d) & BIT(5) ? BIT(16) : 0) | \
+                               ((d) & BIT(6) ? BIT(19) : 0) | ((d) & BIT(7) ? BIT(22) : 0))
+#define LED_STRIP_SPI_PATTERN(d) { (uint8_t)(LED_STRIP_SPI_BITS(d) >> 16), (uint8_t)(LED_STRIP_SPI_BITS(d) >> 8), (uint8_t)LED_STRIP_SPI_BITS(d) }
+#define LED_STRIP_SPI_PATTERN_4(d) LED_STRIP_SPI_PATTERN(d), LED_STRIP_SPI_PATTERN((d) + 1), LED_STRIP_SPI_PATTERN((d) + 2), LED_STRIP_SPI_PATTERN((d) + 3)
+#define LED_STRIP_SPI_PATTERN_16(d) LED_STRIP_SPI_PATTERN_4(d), LED_STRIP_SPI_PATTERN_4((d) + 4), LED_STRIP_SPI_PATTERN_4((d) + 8), LED_STRIP_SPI_PATTERN_4((d) + 12)
+#define LED_STRIP_SPI_PATTERN_64(d) LED_STRIP_SPI_PATTERN_16(d), LED_STRIP_SPI_PATTERN_16((d) + 16), LED_STRIP_SPI_PATTERN_16((d) + 32), LED_STRIP_SPI_PATTERN_16((d) + 48)
+
+// lookup table of the SPI bit pattern for every color byte value, built at compile time so it's shared by all the strips
+static const uint8_t s_spi_expand_table[256][SPI_BYTES_PER_COLOR_BYTE] = {
+    LED_STRIP_SPI_PATTERN_64(0), LED_STRIP_SPI_PATTERN_64(64), LED_STRIP_SPI_PATTERN_64(128), LED_STRIP_SPI_PATTERN_64(192),
+};
+
+static inline void __led_strip_spi_expand(uint8_t data, uint8_t *buf)
 {
-    // Each color of 1 bit is represented by 3 bits of SPI, low_level:100 ,high_level:110
-    // So a color byte occupies 3 bytes of SPI.
-    *(buf + 2) |= data & BIT(0) ? BIT(2) | BIT(1) : BIT(2);
-    *(buf + 2) |= data & BIT(1) ? BIT(5) | BIT(4) : BIT(5);
-    *(buf + 2) |= data & BIT(2) ? BIT(7) : 0x00;
-    *(buf + 1) |= BIT(0);
-    *(buf + 1) |= data & BIT(3) ? BIT(3) | BIT(2) : BIT(3);
-    *(buf + 1) |= data & BIT(4) ? BIT(6) | BIT(5) : BIT(6);
-    *(buf + 0) |= data & BIT(5) ? BIT(1) | BIT(0) : BIT(1);
-    *(buf + 0) |= data & BIT(6) ? BIT(4) | BIT(3) : BIT(4);
-    *(buf + 0) |= data & BIT(7) ? BIT(7) | BIT(6) : BIT(7);
+    const uint8_t *pattern = s_spi_expand_table[data];
+    buf[0] = pattern[0];
+    buf[1] = pattern[1];
+    buf[2] = pattern[2];
 }
 
 static esp_err_t led_strip_spi_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
@@ -56,13 +72,12 @@ static esp_err_t led_strip_spi_set_pixel(led_strip_t *strip, uint32_t index, uin
     uint32_t start = index * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
     uint8_t *pixel_buf = spi_strip->pixel_buf;
     led_color_component_format_t component_fmt = spi_strip->component_fmt;
-    memset(pixel_buf + start, 0, spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
 
-    __led_strip_spi_bit(red, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.r_pos]);
-    __led_strip_spi_bit(green, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.g_pos]);
-    __led_strip_spi_bit(blue, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.b_pos]);
+    __led_strip_spi_expand(red, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.r_pos]);
+    __led_strip_spi_expand(green, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.g_pos]);
+    __led_strip_spi_expand(blue, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.b_pos]);
     if (component_fmt.format.num_components > 3) {
-        __led_strip_spi_bit(0, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.w_pos]);
+        __led_strip_spi_expand(0, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.w_pos]);
     }
 
     return ESP_OK;
@@ -78,27 +93,100 @@ static esp_err_t led_strip_spi_set_pixel_rgbw(led_strip_t *strip, uint32_t index
     // LED_PIXEL_FORMAT_GRBW takes 96bits(12bytes)
     uint32_t start = index * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
     uint8_t *pixel_buf = spi_strip->pixel_buf;
-    memset(pixel_buf + start, 0, spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
 
-    __led_strip_spi_bit(red, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.r_pos]);
-    __led_strip_spi_bit(green, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.g_pos]);
-    __led_strip_spi_bit(blue, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.b_pos]);
-    __led_strip_spi_bit(white, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.w_pos]);
+    __led_strip_spi_expand(red, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.r_pos]);
+    __led_strip_spi_expand(green, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.g_pos]);
+    __led_strip_spi_expand(blue, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.b_pos]);
+    __led_strip_spi_expand(white, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.w_pos]);
 
     return ESP_OK;
 }
 
-static esp_err_t led_strip_spi_refresh(led_strip_t *strip)
+static esp_err_t led_strip_spi_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *rgb)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
-    spi_transaction_t tx_conf;
-    memset(&tx_conf, 0, sizeof(tx_conf));
+    ESP_RETURN_ON_FALSE(start <= spi_strip->strip_len && count <= spi_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG,
+                        "pixel range out of maximum number of LEDs");
+
+    // resolve the color component order once for the whole range
+    led_color_component_format_t component_fmt = spi_strip->component_fmt;
+    uint32_t spi_bytes_per_pixel = spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    uint32_t r_off = component_fmt.format.r_pos * SPI_BYTES_PER_COLOR_BYTE;
+    uint32_t g_off = component_fmt.format.g_pos * SPI_BYTES_PER_COLOR_BYTE;
+    uint32_t b_off = component_fmt.format.b_pos * SPI_BYTES_PER_COLOR_BYTE;
+    uint32_t w_off = component_fmt.format.w_pos * SPI_BYTES_PER_COLOR_BYTE;
+    bool has_white = component_fmt.format.num_components > 3;
+    uint8_t *pixel = spi_strip->pixel_buf + start * spi_bytes_per_pixel;
 
-    tx_conf.length = spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BITS_PER_COLOR_BYTE;
-    tx_conf.tx_buffer = spi_strip->pixel_buf;
-    tx_conf.rx_buffer = NULL;
-    ESP_RETURN_ON_ERROR(spi_device_transmit(spi_strip->spi_device, &tx_conf), TAG, "transmit pixels by SPI failed");
+    for (uint32_t i = 0; i < count; i++, rgb += 3, pixel += spi_bytes_per_pixel) {
+        __led_strip_spi_expand(rgb[0], pixel + r_off);
+        __led_strip_spi_expand(rgb[1], pixel + g_off);
+        __led_strip_spi_expand(rgb[2], pixel + b_off);
+        if (has_white) {
+            __led_strip_spi_expand(0, pixel + w_off);
+        }
+    }
+    return ESP_OK;
+}
 
+static void led_strip_spi_post_trans_cb(spi_transaction_t *trans)
+{
+    led_strip_spi_obj *spi_strip = (led_strip_spi_obj *)trans->user;
+    if (spi_strip->on_refresh_done && spi_strip->on_refresh_done(&spi_strip->base, spi_strip->user_data)) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static esp_err_t led_strip_spi_refresh_wait_done(led_strip_t *strip)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    spi_transaction_t *done_trans = NULL;
+    if (!spi_strip->tx_in_progress) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(spi_device_get_trans_result(spi_strip->spi_device, &done_trans, portMAX_DELAY), TAG, "wait SPI transaction failed");
+    spi_strip->tx_in_progress = false;
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_refresh_async(led_strip_t *strip)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    size_t frame_size = spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    // the previous frame still owns the transmit buffer and the transaction descriptor
+    ESP_RETURN_ON_ERROR(led_strip_spi_refresh_wait_done(strip), TAG, "wait previous refresh failed");
+
+    if (spi_strip->tx_buf != spi_strip->pixel_buf) {
+        // swap the buffers, and let the application continue drawing based on the frame being transmitted
+        uint8_t *draw_buf = spi_strip->tx_buf;
+        spi_strip->tx_buf = spi_strip->pixel_buf;
+        spi_strip->pixel_buf = draw_buf;
+        memcpy(draw_buf, spi_strip->tx_buf, frame_size);
+    }
+
+    spi_transaction_t *tx_conf = &spi_strip->tx_trans;
+    memset(tx_conf, 0, sizeof(spi_transaction_t));
+    tx_conf->length = spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BITS_PER_COLOR_BYTE;
+    tx_conf->tx_buffer = spi_strip->tx_buf;
+    tx_conf->rx_buffer = NULL;
+    tx_conf->user = spi_strip;
+    ESP_RETURN_ON_ERROR(spi_device_queue_trans(spi_strip->spi_device, tx_conf, portMAX_DELAY), TAG, "transmit pixels by SPI failed");
+    spi_strip->tx_in_progress = true;
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_refresh(led_strip_t *strip)
+{
+    ESP_RETURN_ON_ERROR(led_strip_spi_refresh_async(strip), TAG, "start refresh failed");
+    return led_strip_spi_refresh_wait_done(strip);
+}
+
+static esp_err_t led_strip_spi_register_event_callbacks(led_strip_t *strip, const led_strip_event_callbacks_t *cbs, void *user_data)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(!spi_strip->tx_in_progress, ESP_ERR_INVALID_STATE, TAG, "refresh in progress");
+    spi_strip->on_refresh_done = cbs ? cbs->on_refresh_done : NULL;
+    spi_strip->user_data = user_data;
     return ESP_OK;
 }
 
@@ -106,10 +194,9 @@ static esp_err_t led_strip_spi_clear(led_strip_t *strip)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
     //Write zero to turn off all leds
-    memset(spi_strip->pixel_buf, 0, spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
     uint8_t *buf = spi_strip->pixel_buf;
     for (int index = 0; index < spi_strip->strip_len * spi_strip->bytes_per_pixel; index++) {
-        __led_strip_spi_bit(0, buf);
+        __led_strip_spi_expand(0, buf);
         buf += SPI_BYTES_PER_COLOR_BYTE;
     }
 
@@ -120,6 +207,7 @@ static esp_err_t led_strip_spi_del(led_strip_t *strip)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
 
+    ESP_RETURN_ON_ERROR(led_strip_spi_refresh_wait_done(strip), TAG, "wait pending refresh failed");
     ESP_RETURN_ON_ERROR(spi_bus_remove_device(spi_strip->spi_device), TAG, "delete spi device failed");
     ESP_RETURN_ON_ERROR(spi_bus_free(spi_strip->spi_host), TAG, "free spi bus failed");
 
@@ -157,9 +245,13 @@ esp_err_t led_strip_new_spi_device(const led_strip_config_t *led_config, const l
         // DMA buffer must be placed in internal SRAM
         mem_caps |= MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA;
     }
-    spi_strip = heap_caps_calloc(1, sizeof(led_strip_spi_obj) + led_config->max_leds * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE, mem_caps);
+    size_t frame_size = led_config->max_leds * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    size_t num_bufs = led_config->flags.double_buffer ? 2 : 1;
+    spi_strip = heap_caps_calloc(1, sizeof(led_strip_spi_obj) + frame_size * num_bufs, mem_caps);
 
     ESP_GOTO_ON_FALSE(spi_strip, ESP_ERR_NO_MEM, err, TAG, "no mem for spi strip");
+    spi_strip->pixel_buf = spi_strip->pixel_buf_mem;
+    spi_strip->tx_buf = spi_strip->pixel_buf_mem + frame_size * (num_bufs - 1);
 
     spi_strip->spi_host = spi_config->spi_bus;
     // for backward compatibility, if the user does not set the clk_src, use the default value
@@ -193,6 +285,7 @@ esp_err_t led_strip_new_spi_device(const led_strip_config_t *led_config, const l
         //set -1 when CS is not used
         .spics_io_num = -1,
         .queue_size = LED_STRIP_SPI_DEFAULT_TRANS_QUEUE_SIZE,
+        .post_cb = led_strip_spi_post_trans_cb,
     };
 
     ESP_GOTO_ON_ERROR(spi_bus_add_device(spi_strip->spi_host, &spi_dev_cfg, &spi_strip->spi_device), err, TAG, "Failed to add spi device");
@@ -215,7 +308,11 @@ esp_err_t led_strip_new_spi_device(const led_strip_config_t *led_config, const l
     spi_strip->strip_len = led_config->max_leds;
     spi_strip->base.set_pixel = led_strip_spi_set_pixel;
     spi_strip->base.set_pixel_rgbw = led_strip_spi_set_pixel_rgbw;
+    spi_strip->base.set_pixels = led_strip_spi_set_pixels;
     spi_strip->base.refresh = led_strip_spi_refresh;
+    spi_strip->base.refresh_async = led_strip_spi_refresh_async;
+    spi_strip->base.refresh_wait_done = led_strip_spi_refresh_wait_done;
+    spi_strip->base.register_event_callbacks = led_strip_spi_register_event_callbacks;
     spi_strip->base.clear = led_strip_spi_clear;
     spi_strip->base.del = led_strip_spi_del;
 
@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "unity.h"
+#include "driver/rmt_rx.h"
+#include "led_strip.h"
+
+#define TEST_STRIP_NUM          2
+#define TEST_STRIP_LED_COUNT    2
+#define TEST_RMT_RESOLUTION_HZ  (10 * 1000 * 1000) // 1 tick = 0.1us
+#define TEST_BITS_PER_STRIP     (TEST_STRIP_LED_COUNT * 3 * 8)
+// WS2812 timing in ticks of TEST_RMT_RESOLUTION_HZ, the captured durations are allowed to jitter a bit
+#define TEST_WS2812_T0H_TICKS   3
+#define TEST_WS2812_T1H_TICKS   9
+#define TEST_TICKS_TOLERANCE    2
+
+static const int s_strip_gpios[TEST_STRIP_NUM] = {0, 2};
+
+typedef struct {
+    QueueHandle_t queue;
+    int strip_id;
+} test_rx_context_t;
+
+typedef struct {
+    int strip_id;
+    size_t num_symbols;
+} test_rx_event_t;
+
+static bool test_rmt_rx_done_callback(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata, void *user_data)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    test_rx_context_t *ctx = (test_rx_context_t *)user_data;
+    test_rx_event_t evt = {
+        .strip_id = ctx->strip_id,
+        .num_symbols = edata->num_symbols,
+    };
+    xQueueSendFromISR(ctx->queue, &evt, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+// check the captured RMT symbols against the bytes that should be clocked out, MSB first
+static void test_check_symbols(const rmt_symbol_word_t *symbols, size_t num_symbols, const uint8_t *bytes)
+{
+    TEST_ASSERT_GREATER_OR_EQUAL(TEST_BITS_PER_STRIP, num_symbols);
+    for (int i = 0; i < TEST_BITS_PER_STRIP; i++) {
+        int bit = (bytes[i / 8] >> (7 - i % 8)) & 0x01;
+        uint32_t expect_high = bit ? TEST_WS2812_T1H_TICKS : TEST_WS2812_T0H_TICKS;
+        TEST_ASSERT_EQUAL(1, symbols[i].level0);
+        TEST_ASSERT_UINT32_WITHIN(TEST_TICKS_TOLERANCE, expect_high, symbols[i].duration0);
+    }
+}
+
+TEST_CASE("led strip group refreshes all RMT strips in parallel", "[led_strip][rmt]")
+{
+    led_strip_handle_t strips[TEST_STRIP_NUM] = {};
+    rmt_channel_handle_t rx_chans[TEST_STRIP_NUM] = {};
+    rmt_symbol_word_t *rx_symbols[TEST_STRIP_NUM] = {};
+    test_rx_context_t rx_ctx[TEST_STRIP_NUM] = {};
+    QueueHandle_t rx_queue = xQueueCreate(TEST_STRIP_NUM, sizeof(test_rx_event_t));
+    TEST_ASSERT_NOT_NULL(rx_queue);
+
+    // R-G-B colors of each pixel, different for each strip
+    const uint8_t pixels[TEST_STRIP_NUM][TEST_STRIP_LED_COUNT * 3] = {
+        {0xA5, 0x0F, 0x81, 0x00, 0xFF, 0x3C},
+        {0x12, 0x34, 0x56, 0x80, 0x01, 0xE7},
+    };
+    // the same colors in the G-R-B order on the wire
+    uint8_t wire_bytes[TEST_STRIP_NUM][TEST_STRIP_LED_COUNT * 3];
+    for (int s = 0; s < TEST_STRIP_NUM; s++) {
+        for (int p = 0; p < TEST_STRIP_LED_COUNT; p++) {
+            wire_bytes[s][p * 3 + 0] = pixels[s][p * 3 + 1];
+            wire_bytes[s][p * 3 + 1] = pixels[s][p * 3 + 0];
+            wire_bytes[s][p * 3 + 2] = pixels[s][p * 3 + 2];
+        }
+    }
+
+    for (int s = 0; s < TEST_STRIP_NUM; s++) {
+        led_strip_config_t strip_config = {
+            .strip_gpio_num = s_strip_gpios[s],
+            .max_leds = TEST_STRIP_LED_COUNT,
+            .led_model = LED_MODEL_WS2812,
+            .color_component_format = LED_STRIP_COLOR_COMPONENT_FMT_GRB,
+        };
+        led_strip_rmt_config_t rmt_config = {
+            .clk_src = RMT_CLK_SRC_DEFAULT,
+            .resolution_hz = TEST_RMT_RESOLUTION_HZ,
+        };
+        TEST_ESP_OK(led_strip_new_rmt_device(&strip_config, &rmt_config, &strips[s]));
+
+        // capture the TX signal by a RX channel on the same GPIO
+        rmt_rx_channel_config_t rx_config = {
+            .clk_src = RMT_CLK_SRC_DEFAULT,
+            .gpio_num = s_strip_gpios[s],
+            .mem_block_symbols = 64,
+            .resolution_hz = TEST_RMT_RESOLUTION_HZ,
+            .flags.io_loop_back = true,
+        };
+        TEST_ESP_OK(rmt_new_rx_channel(&rx_config, &rx_chans[s]));
+        rx_ctx[s].queue = rx_queue;
+        rx_ctx[s].strip_id = s;
+        rmt_rx_event_callbacks_t cbs = {
+            .on_recv_done = test_rmt_rx_done_callback,
+        };
+        TEST_ESP_OK(rmt_rx_register_event_callbacks(rx_chans[s], &cbs, &rx_ctx[s]));
+        TEST_ESP_OK(rmt_enable(rx_chans[s]));
+        rx_symbols[s] = calloc(64, sizeof(rmt_symbol_word_t));
+        TEST_ASSERT_NOT_NULL(rx_symbols[s]);
+
+        TEST_ESP_OK(led_strip_set_pixels(strips[s], 0, TEST_STRIP_LED_COUNT, pixels[s]));
+    }
+
+    led_strip_group_handle_t group = NULL;
+    TEST_ESP_OK(led_strip_new_group(strips, TEST_STRIP_NUM, &group));
+
+    rmt_receive_config_t receive_config = {
+        .signal_range_min_ns = 100,
+        .signal_range_max_ns = 50 * 1000, // the reset code (280us) ends the frame
+    };
+    for (int s = 0; s < TEST_STRIP_NUM; s++) {
+        TEST_ESP_OK(rmt_receive(rx_chans[s], rx_symbols[s], 64 * sizeof(rmt_symbol_word_t), &receive_config));
+    }
+    TEST_ESP_OK(led_strip_group_refresh(group));
+
+    test_rx_event_t evt;
+    bool received[TEST_STRIP_NUM] = {};
+    for (int i = 0; i < TEST_STRIP_NUM; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(rx_queue, &evt, pdMS_TO_TICKS(1000)));
+        TEST_ASSERT_FALSE(received[evt.strip_id]);
+        received[evt.strip_id] = true;
+        test_check_symbols(rx_symbols[evt.strip_id], evt.num_symbols, wire_bytes[evt.strip_id]);
+    }
+
+    TEST_ESP_OK(led_strip_del_group(group));
+    for (int s = 0; s < TEST_STRIP_NUM; s++) {
+        TEST_ESP_OK(rmt_disable(rx_chans[s]));
+        TEST_ESP_OK(rmt_del_channel(rx_chans[s]));
+        TEST_ESP_OK(led_strip_del(strips[s]));
+        free(rx_symbols[s]);
+    }
+    vQueueDelete(rx_queue);
+}
+
+TEST_CASE("led strip group rejects invalid arguments", "[led_strip]")
+{
+    led_strip_group_handle_t group = NULL;
+    led_strip_handle_t strips[1] = {NULL};
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_new_group(NULL, 1, &group));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_new_group(strips, 0, &group));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_new_group(strips, 1, &group));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, led_strip_group_refresh(NULL));
+}
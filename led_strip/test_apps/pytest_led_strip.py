@@ -0,0 +1,9 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Unlicense OR CC0-1.0
+import pytest
+from pytest_embedded import Dut
+
+
+@pytest.mark.generic
+def test_led_strip(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
@@ -289,21 +289,7 @@ static esp_err_t wifi_scan_result(uint16_t result_index,
                                   network_prov_scan_wifi_result_t *result,
                                   network_prov_scan_ctx_t **ctx)
 {
-    const wifi_ap_record_t *record = network_prov_mgr_wifi_scan_result(result_index);
-    if (!record) {
-        return ESP_FAIL;
-    }
-
-    /* Compile time check ensures memory safety in case SSID length in
-     * record / result structure definition changes in future */
-    _Static_assert(sizeof(result->ssid) == sizeof(record->ssid),
-                   "source and destination should be of same size");
-    memcpy(result->ssid, record->ssid, sizeof(record->ssid));
-    memcpy(result->bssid, record->bssid, sizeof(record->bssid));
-    result->channel = record->primary;
-    result->rssi = record->rssi;
-    result->auth = record->authmode;
-    return ESP_OK;
+    return network_prov_mgr_wifi_scan_result(result_index, result);
 }
 #endif // CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
 
@@ -17,6 +17,7 @@
 
 #include <esp_log.h>
 #include <esp_err.h>
+#include <esp_idf_version.h>
 #include <esp_wifi.h>
 #include <esp_timer.h>
 
@@ -155,9 +156,9 @@ struct network_prov_mgr_ctx {
     /* Wi-Fi scan parameters and state variables */
     uint8_t channels_per_group;
     uint16_t curr_channel;
-    uint16_t ap_list_len[14];   // 14 entries corresponding to each channel
-    wifi_ap_record_t *ap_list[14];
-    wifi_ap_record_t *ap_list_sorted[MAX_SCAN_RESULTS];
+    /* Scan results, unique by BSSID and sorted by decreasing RSSI */
+    uint16_t wifi_scan_result_count;
+    network_prov_scan_wifi_result_t wifi_scan_results[MAX_SCAN_RESULTS];
     wifi_scan_config_t scan_cfg;
 
     /* Total number of attempts done for connecting to Wi-Fi */
@@ -772,14 +773,8 @@ static bool network_prov_mgr_stop_service(bool blocking)
 
 #ifdef CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
     /* Delete all scan results */
-    for (uint16_t channel = 0; channel < 14; channel++) {
-        free(prov_ctx->ap_list[channel]);
-        prov_ctx->ap_list[channel] = NULL;
-    }
     prov_ctx->scanning = false;
-    for (uint8_t i = 0; i < MAX_SCAN_RESULTS; i++) {
-        prov_ctx->ap_list_sorted[i] = NULL;
-    }
+    prov_ctx->wifi_scan_result_count = 0;
 
     /* Remove event handler */
     esp_event_handler_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID,
@@ -884,6 +879,65 @@ esp_err_t network_prov_mgr_done(void)
 }
 
 #ifdef CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
+/* Merge an AP record into the scan results. An AP seen again (e.g. on
+ * another channel) only keeps its strongest record, and once the list
+ * is full the weakest entry is dropped to make room for a stronger one */
+static void wifi_scan_results_insert(const wifi_ap_record_t *record)
+{
+    network_prov_scan_wifi_result_t *results = prov_ctx->wifi_scan_results;
+    uint16_t count = prov_ctx->wifi_scan_result_count;
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (memcmp(results[i].bssid, record->bssid, sizeof(record->bssid)) == 0) {
+            if (results[i].rssi >= record->rssi) {
+                return;
+            }
+            /* Remove the weaker record, the new one is inserted below */
+            memmove(&results[i], &results[i + 1], (count - i - 1) * sizeof(results[0]));
+            count--;
+            break;
+        }
+    }
+
+    /* Insert after the entries with the same or a stronger RSSI */
+    uint16_t pos = count;
+    while (pos > 0 && results[pos - 1].rssi < record->rssi) {
+        pos--;
+    }
+    if (pos >= MAX_SCAN_RESULTS) {
+        prov_ctx->wifi_scan_result_count = count;
+        return;
+    }
+    if (count == MAX_SCAN_RESULTS) {
+        count--;
+    }
+    memmove(&results[pos + 1], &results[pos], (count - pos) * sizeof(results[0]));
+
+    _Static_assert(sizeof(results[pos].ssid) == sizeof(record->ssid),
+                   "source and destination should be of same size");
+    memcpy(results[pos].ssid, record->ssid, sizeof(record->ssid));
+    memcpy(results[pos].bssid, record->bssid, sizeof(record->bssid));
+    results[pos].channel = record->primary;
+    results[pos].rssi = record->rssi;
+    results[pos].auth = record->authmode;
+    prov_ctx->wifi_scan_result_count = count + 1;
+}
+
+static void wifi_scan_results_add(uint16_t index, const wifi_ap_record_t *record)
+{
+    ESP_LOGD(TAG, "\t[%2d] %-32s %02x%02x%02x%02x%02x%02x %4d %4d", index,
+             record->ssid,
+             record->bssid[0],
+             record->bssid[1],
+             record->bssid[2],
+             record->bssid[3],
+             record->bssid[4],
+             record->bssid[5],
+             record->rssi,
+             record->authmode);
+    wifi_scan_results_insert(record);
+}
+
 static esp_err_t update_wifi_scan_results(void)
 {
     if (!prov_ctx->scanning) {
@@ -895,12 +949,6 @@ static esp_err_t update_wifi_scan_results(void)
     uint16_t count = 0;
     uint16_t curr_channel = prov_ctx->curr_channel;
 
-    if (prov_ctx->ap_list[curr_channel]) {
-        free(prov_ctx->ap_list[curr_channel]);
-        prov_ctx->ap_list[curr_channel] = NULL;
-        prov_ctx->ap_list_len[curr_channel] = 0;
-    }
-
     if (esp_wifi_scan_get_ap_num(&count) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to get count of scanned APs");
         goto exit;
@@ -912,58 +960,45 @@ static esp_err_t update_wifi_scan_results(void)
         goto exit;
     }
 
+    if (prov_ctx->channels_per_group) {
+        ESP_LOGD(TAG, "Scan results for channel %d :", curr_channel);
+    } else {
+        ESP_LOGD(TAG, "Scan results :");
+    }
+    ESP_LOGD(TAG, "\tS.N. %-32s %-12s %s %s", "SSID", "BSSID", "RSSI", "AUTH");
+
+    /* Records are merged into the results after each channel group, so
+     * that results of the channels scanned so far can already be read
+     * while the scan goes on */
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+    /* Take the records out of the driver one at a time */
+    wifi_ap_record_t record;
+    for (uint16_t i = 0; i < count; i++) {
+        if (esp_wifi_scan_get_ap_record(&record) != ESP_OK) {
+            break;
+        }
+        wifi_scan_results_add(i, &record);
+    }
+    esp_wifi_clear_ap_list();
+#else
+    /* esp_wifi_scan_get_ap_record() is not available, copy the records out at once */
     uint16_t get_count = MIN(count, MAX_SCAN_RESULTS);
-    prov_ctx->ap_list[curr_channel] = (wifi_ap_record_t *) calloc(get_count, sizeof(wifi_ap_record_t));
-    if (!prov_ctx->ap_list[curr_channel]) {
+    wifi_ap_record_t *records = (wifi_ap_record_t *) calloc(get_count, sizeof(wifi_ap_record_t));
+    if (!records) {
         ESP_LOGE(TAG, "Failed to allocate memory for AP list");
         esp_wifi_clear_ap_list();
         goto exit;
     }
-    if (esp_wifi_scan_get_ap_records(&get_count, prov_ctx->ap_list[curr_channel]) != ESP_OK) {
+    if (esp_wifi_scan_get_ap_records(&get_count, records) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to get scanned AP records");
+        free(records);
         goto exit;
     }
-    prov_ctx->ap_list_len[curr_channel] = get_count;
-
-    if (prov_ctx->channels_per_group) {
-        ESP_LOGD(TAG, "Scan results for channel %d :", curr_channel);
-    } else {
-        ESP_LOGD(TAG, "Scan results :");
-    }
-    ESP_LOGD(TAG, "\tS.N. %-32s %-12s %s %s", "SSID", "BSSID", "RSSI", "AUTH");
-    for (uint8_t i = 0; i < prov_ctx->ap_list_len[curr_channel]; i++) {
-        ESP_LOGD(TAG, "\t[%2d] %-32s %02x%02x%02x%02x%02x%02x %4d %4d", i,
-                 prov_ctx->ap_list[curr_channel][i].ssid,
-                 prov_ctx->ap_list[curr_channel][i].bssid[0],
-                 prov_ctx->ap_list[curr_channel][i].bssid[1],
-                 prov_ctx->ap_list[curr_channel][i].bssid[2],
-                 prov_ctx->ap_list[curr_channel][i].bssid[3],
-                 prov_ctx->ap_list[curr_channel][i].bssid[4],
-                 prov_ctx->ap_list[curr_channel][i].bssid[5],
-                 prov_ctx->ap_list[curr_channel][i].rssi,
-                 prov_ctx->ap_list[curr_channel][i].authmode);
-    }
-
-    /* Store results in sorted list */
-    {
-        int rc = get_count;
-        int is = MAX_SCAN_RESULTS - rc - 1;
-        while (rc > 0 && is >= 0) {
-            if (prov_ctx->ap_list_sorted[is]) {
-                if (prov_ctx->ap_list_sorted[is]->rssi > prov_ctx->ap_list[curr_channel][rc - 1].rssi) {
-                    prov_ctx->ap_list_sorted[is + rc] = &prov_ctx->ap_list[curr_channel][rc - 1];
-                    rc--;
-                    continue;
-                }
-                prov_ctx->ap_list_sorted[is + rc] = prov_ctx->ap_list_sorted[is];
-            }
-            is--;
-        }
-        while (rc > 0) {
-            prov_ctx->ap_list_sorted[rc - 1] = &prov_ctx->ap_list[curr_channel][rc - 1];
-            rc--;
-        }
+    for (uint16_t i = 0; i < get_count; i++) {
+        wifi_scan_results_add(i, &records[i]);
     }
+    free(records);
+#endif
 
     ret = ESP_OK;
 exit:
@@ -1021,10 +1056,8 @@ esp_err_t network_prov_mgr_wifi_scan_start(bool blocking, bool passive,
         return ESP_OK;
     }
 
-    /* Clear sorted list for new entries */
-    for (uint8_t i = 0; i < MAX_SCAN_RESULTS; i++) {
-        prov_ctx->ap_list_sorted[i] = NULL;
-    }
+    /* Clear results list for new entries */
+    prov_ctx->wifi_scan_result_count = 0;
 
     if (passive) {
         prov_ctx->scan_cfg.scan_type = WIFI_SCAN_TYPE_PASSIVE;
@@ -1114,33 +1147,29 @@ uint16_t network_prov_mgr_wifi_scan_result_count(void)
         return rval;
     }
 
-    while (rval < MAX_SCAN_RESULTS) {
-        if (!prov_ctx->ap_list_sorted[rval]) {
-            break;
-        }
-        rval++;
-    }
+    rval = prov_ctx->wifi_scan_result_count;
     RELEASE_LOCK(prov_ctx_lock);
     return rval;
 }
 
-const wifi_ap_record_t *network_prov_mgr_wifi_scan_result(uint16_t index)
+esp_err_t network_prov_mgr_wifi_scan_result(uint16_t index, network_prov_scan_wifi_result_t *result)
 {
-    const wifi_ap_record_t *rval = NULL;
+    esp_err_t rval = ESP_FAIL;
     if (!prov_ctx_lock) {
         ESP_LOGE(TAG, "Provisioning manager not initialized");
-        return rval;
+        return ESP_ERR_INVALID_STATE;
     }
 
     ACQUIRE_LOCK(prov_ctx_lock);
     if (!prov_ctx) {
         ESP_LOGE(TAG, "Provisioning manager not initialized");
         RELEASE_LOCK(prov_ctx_lock);
-        return rval;
+        return ESP_ERR_INVALID_STATE;
     }
 
-    if (index < MAX_SCAN_RESULTS) {
-        rval = prov_ctx->ap_list_sorted[index];
+    if (index < prov_ctx->wifi_scan_result_count) {
+        *result = prov_ctx->wifi_scan_results[index];
+        rval = ESP_OK;
     }
     RELEASE_LOCK(prov_ctx_lock);
     return rval;
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "network_prov_arena.h"
+
+#define ARENA_ALIGN 8
+
+struct network_prov_arena_chunk {
+    network_prov_arena_chunk_t *next;
+    uint8_t data[];
+};
+
+static void *arena_protobuf_alloc(void *allocator_data, size_t size)
+{
+    return network_prov_arena_alloc((network_prov_arena_t *) allocator_data, size);
+}
+
+static void arena_protobuf_free(void *allocator_data, void *ptr)
+{
+    /* Memory is only given back when the whole arena is released */
+    (void) allocator_data;
+    (void) ptr;
+}
+
+static uint8_t *arena_align(uint8_t *ptr)
+{
+    return (uint8_t *) (((uintptr_t) ptr + ARENA_ALIGN - 1) & ~((uintptr_t) ARENA_ALIGN - 1));
+}
+
+void network_prov_arena_init(network_prov_arena_t *arena)
+{
+    arena->allocator.alloc = arena_protobuf_alloc;
+    arena->allocator.free = arena_protobuf_free;
+    arena->allocator.allocator_data = arena;
+    arena->pos = arena->inline_buf;
+    arena->end = arena->inline_buf + sizeof(arena->inline_buf);
+    arena->chunks = NULL;
+}
+
+void *network_prov_arena_alloc(network_prov_arena_t *arena, size_t size)
+{
+    uint8_t *ptr = arena_align(arena->pos);
+    if (ptr <= arena->end && size <= (size_t) (arena->end - ptr)) {
+        arena->pos = ptr + size;
+        return ptr;
+    }
+
+    /* Current buffer exhausted, continue in a new chunk. What is left of
+     * the previous buffer is not used anymore. */
+    if (size > SIZE_MAX - sizeof(network_prov_arena_chunk_t) - ARENA_ALIGN) {
+        return NULL;
+    }
+    size_t chunk_size = size + ARENA_ALIGN;
+    if (chunk_size < NETWORK_PROV_ARENA_CHUNK_SIZE) {
+        chunk_size = NETWORK_PROV_ARENA_CHUNK_SIZE;
+    }
+    network_prov_arena_chunk_t *chunk = malloc(sizeof(network_prov_arena_chunk_t) + chunk_size);
+    if (!chunk) {
+        return NULL;
+    }
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->end = chunk->data + chunk_size;
+
+    ptr = arena_align(chunk->data);
+    arena->pos = ptr + size;
+    return ptr;
+}
+
+void *network_prov_arena_calloc(network_prov_arena_t *arena, size_t n, size_t size)
+{
+    if (size && n > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *ptr = network_prov_arena_alloc(arena, n * size);
+    if (ptr) {
+        memset(ptr, 0, n * size);
+    }
+    return ptr;
+}
+
+void *network_prov_arena_memdup(network_prov_arena_t *arena, const void *data, size_t len)
+{
+    void *ptr = network_prov_arena_alloc(arena, len);
+    if (ptr) {
+        memcpy(ptr, data, len);
+    }
+    return ptr;
+}
+
+char *network_prov_arena_strndup(network_prov_arena_t *arena, const char *str, size_t maxlen)
+{
+    size_t len = strnlen(str, maxlen);
+    char *ptr = network_prov_arena_alloc(arena, len + 1);
+    if (ptr) {
+        memcpy(ptr, str, len);
+        ptr[len] = '\0';
+    }
+    return ptr;
+}
+
+void network_prov_arena_release(network_prov_arena_t *arena)
+{
+    while (arena->chunks) {
+        network_prov_arena_chunk_t *next = arena->chunks->next;
+        free(arena->chunks);
+        arena->chunks = next;
+    }
+    arena->pos = arena->inline_buf;
+    arena->end = arena->inline_buf + sizeof(arena->inline_buf);
+}
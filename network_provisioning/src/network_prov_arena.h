@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _PROV_NETWORK_ARENA_H_
+#define _PROV_NETWORK_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <protobuf-c/protobuf-c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the buffer embedded in the arena itself
+ *
+ * Most requests (status, config, ctrl) fit in this buffer, so that
+ * handling them does not touch the heap except for the response packet.
+ */
+#define NETWORK_PROV_ARENA_INLINE_SIZE  256
+
+/**
+ * @brief   Minimum size of the chunks allocated from the heap once the
+ *          embedded buffer is exhausted
+ */
+#define NETWORK_PROV_ARENA_CHUNK_SIZE   512
+
+typedef struct network_prov_arena_chunk network_prov_arena_chunk_t;
+
+/**
+ * @brief   Per-request memory arena
+ *
+ * The unpacked request and all the response messages of a protocomm
+ * request are bump allocated from the arena and released at once by
+ * `network_prov_arena_release()` when the response has been packed.
+ * The arena is meant to be placed on the stack of the request handler.
+ */
+typedef struct {
+    ProtobufCAllocator allocator;       /*!< Allocator to pass to the protobuf-c unpack functions */
+    uint8_t *pos;                       /*!< Next free byte of the current buffer */
+    uint8_t *end;                       /*!< End of the current buffer */
+    network_prov_arena_chunk_t *chunks; /*!< Heap chunks, most recent first */
+    uint8_t inline_buf[NETWORK_PROV_ARENA_INLINE_SIZE] __attribute__((aligned(8)));
+} network_prov_arena_t;
+
+/**
+ * @brief   Initialize an arena
+ *
+ * @param[in] arena  Arena to initialize
+ */
+void network_prov_arena_init(network_prov_arena_t *arena);
+
+/**
+ * @brief   Allocate memory from an arena
+ *
+ * The returned memory is aligned for any protobuf-c message and is not
+ * initialized. It must not be freed individually.
+ *
+ * @param[in] arena  Arena to allocate from
+ * @param[in] size   Number of bytes to allocate
+ *
+ * @return
+ *  - Pointer to the allocated memory
+ *  - NULL if the heap is exhausted
+ */
+void *network_prov_arena_alloc(network_prov_arena_t *arena, size_t size);
+
+/**
+ * @brief   Allocate zero initialized memory for an array from an arena
+ *
+ * @param[in] arena  Arena to allocate from
+ * @param[in] n      Number of elements
+ * @param[in] size   Size of each element
+ *
+ * @return
+ *  - Pointer to the allocated memory
+ *  - NULL if the heap is exhausted or the size overflows
+ */
+void *network_prov_arena_calloc(network_prov_arena_t *arena, size_t n, size_t size);
+
+/**
+ * @brief   Copy a buffer into an arena
+ *
+ * @param[in] arena  Arena to allocate from
+ * @param[in] data   Data to copy
+ * @param[in] len    Length of the data
+ *
+ * @return
+ *  - Pointer to the copy
+ *  - NULL if the heap is exhausted
+ */
+void *network_prov_arena_memdup(network_prov_arena_t *arena, const void *data, size_t len);
+
+/**
+ * @brief   Copy a string into an arena
+ *
+ * At most `maxlen` characters are copied and the copy is always NULL terminated.
+ *
+ * @param[in] arena   Arena to allocate from
+ * @param[in] str     String to copy
+ * @param[in] maxlen  Maximum number of characters to copy
+ *
+ * @return
+ *  - Pointer to the copy
+ *  - NULL if the heap is exhausted
+ */
+char *network_prov_arena_strndup(network_prov_arena_t *arena, const char *str, size_t maxlen);
+
+/**
+ * @brief   Release all the memory allocated from an arena
+ *
+ * The arena can be used again after this call.
+ *
+ * @param[in] arena  Arena to release
+ */
+void network_prov_arena_release(network_prov_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -68,14 +68,21 @@ bool network_prov_mgr_wifi_scan_finished(void);
 uint16_t network_prov_mgr_wifi_scan_result_count(void);
 
 /**
- * @brief   Get AP record for a particular index in the scan list result
+ * @brief   Get a copy of the result at a particular index in the scan list
  *
- * @param[out] index  Index of the result to fetch
+ * Results are sorted by decreasing signal strength. They can be read
+ * while a scan by groups of channels is still running, in which case
+ * the list gets updated each time a group of channels is done.
+ *
+ * @param[in]  index   Index of the result to fetch
+ * @param[out] result  Copy of the result
  *
  * @return
- *  - result : Pointer to Access Point record
+ *  - ESP_OK    : Success
+ *  - ESP_FAIL  : No result at this index
+ *  - ESP_ERR_INVALID_STATE : Provisioning manager not initialized
  */
-const wifi_ap_record_t *network_prov_mgr_wifi_scan_result(uint16_t index);
+esp_err_t network_prov_mgr_wifi_scan_result(uint16_t index, network_prov_scan_wifi_result_t *result);
 #endif // CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
 
 #ifdef CONFIG_NETWORK_PROV_NETWORK_TYPE_THREAD
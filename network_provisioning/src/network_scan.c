@@ -14,25 +14,27 @@
 
 #include <network_provisioning/network_scan.h>
 
+#include "network_prov_arena.h"
+
 static const char *TAG = "proto_network_scan";
 
 typedef struct network_prov_scan_cmd {
     int cmd_num;
     esp_err_t (*command_handler)(NetworkScanPayload *req,
-                                 NetworkScanPayload *resp, void *priv_data);
+                                 NetworkScanPayload *resp, network_prov_arena_t *arena, void *priv_data);
 } network_prov_scan_cmd_t;
 
 static esp_err_t cmd_scan_start_handler(NetworkScanPayload *req,
                                         NetworkScanPayload *resp,
-                                        void *priv_data);
+                                        network_prov_arena_t *arena, void *priv_data);
 
 static esp_err_t cmd_scan_status_handler(NetworkScanPayload *req,
         NetworkScanPayload *resp,
-        void *priv_data);
+        network_prov_arena_t *arena, void *priv_data);
 
 static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
         NetworkScanPayload *resp,
-        void *priv_data);
+        network_prov_arena_t *arena, void *priv_data);
 
 static network_prov_scan_cmd_t cmd_table[] = {
     {
@@ -62,7 +64,7 @@ static network_prov_scan_cmd_t cmd_table[] = {
 };
 
 static esp_err_t cmd_scan_start_handler(NetworkScanPayload *req,
-                                        NetworkScanPayload *resp, void *priv_data)
+                                        NetworkScanPayload *resp, network_prov_arena_t *arena, void *priv_data)
 {
     network_prov_scan_handlers_t *h = (network_prov_scan_handlers_t *) priv_data;
     if (!h) {
@@ -70,7 +72,7 @@ static esp_err_t cmd_scan_start_handler(NetworkScanPayload *req,
         return ESP_ERR_INVALID_STATE;
     }
     if (req->msg == NETWORK_SCAN_MSG_TYPE__TypeCmdScanWifiStart) {
-        RespScanWifiStart *resp_payload = (RespScanWifiStart *) malloc(sizeof(RespScanWifiStart));
+        RespScanWifiStart *resp_payload = (RespScanWifiStart *) network_prov_arena_alloc(arena, sizeof(RespScanWifiStart));
         if (!resp_payload) {
             ESP_LOGE(TAG, "Error allocating memory");
             return ESP_ERR_NO_MEM;
@@ -92,7 +94,7 @@ static esp_err_t cmd_scan_start_handler(NetworkScanPayload *req,
         resp->payload_case = NETWORK_SCAN_PAYLOAD__PAYLOAD_RESP_SCAN_WIFI_START;
         resp->resp_scan_wifi_start = resp_payload;
     } else if (req->msg == NETWORK_SCAN_MSG_TYPE__TypeCmdScanThreadStart) {
-        RespScanThreadStart *resp_payload = (RespScanThreadStart *) malloc(sizeof(RespScanThreadStart));
+        RespScanThreadStart *resp_payload = (RespScanThreadStart *) network_prov_arena_alloc(arena, sizeof(RespScanThreadStart));
         if (!resp_payload) {
             ESP_LOGE(TAG, "Error allocating memory");
             return ESP_ERR_NO_MEM;
@@ -116,7 +118,7 @@ static esp_err_t cmd_scan_start_handler(NetworkScanPayload *req,
 }
 
 static esp_err_t cmd_scan_status_handler(NetworkScanPayload *req,
-        NetworkScanPayload *resp, void *priv_data)
+        NetworkScanPayload *resp, network_prov_arena_t *arena, void *priv_data)
 {
     bool scan_finished = false;
     uint16_t result_count = 0;
@@ -127,7 +129,7 @@ static esp_err_t cmd_scan_status_handler(NetworkScanPayload *req,
         return ESP_ERR_INVALID_STATE;
     }
     if (req->msg == NETWORK_SCAN_MSG_TYPE__TypeCmdScanWifiStatus) {
-        RespScanWifiStatus *resp_payload = (RespScanWifiStatus *) malloc(sizeof(RespScanWifiStatus));
+        RespScanWifiStatus *resp_payload = (RespScanWifiStatus *) network_prov_arena_alloc(arena, sizeof(RespScanWifiStatus));
         if (!resp_payload) {
             ESP_LOGE(TAG, "Error allocating memory");
             return ESP_ERR_NO_MEM;
@@ -148,7 +150,7 @@ static esp_err_t cmd_scan_status_handler(NetworkScanPayload *req,
         resp->payload_case = NETWORK_SCAN_PAYLOAD__PAYLOAD_RESP_SCAN_WIFI_STATUS;
         resp->resp_scan_wifi_status = resp_payload;
     } else if (req->msg == NETWORK_SCAN_MSG_TYPE__TypeCmdScanThreadStatus) {
-        RespScanThreadStatus *resp_payload = (RespScanThreadStatus *) malloc(sizeof(RespScanThreadStatus));
+        RespScanThreadStatus *resp_payload = (RespScanThreadStatus *) network_prov_arena_alloc(arena, sizeof(RespScanThreadStatus));
         if (!resp_payload) {
             ESP_LOGE(TAG, "Error allocating memory");
             return ESP_ERR_NO_MEM;
@@ -173,7 +175,7 @@ static esp_err_t cmd_scan_status_handler(NetworkScanPayload *req,
 }
 
 static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
-        NetworkScanPayload *resp, void *priv_data)
+        NetworkScanPayload *resp, network_prov_arena_t *arena, void *priv_data)
 {
     esp_err_t err = ESP_OK;
     network_prov_scan_handlers_t *h = (network_prov_scan_handlers_t *) priv_data;
@@ -182,7 +184,7 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
         return ESP_ERR_INVALID_STATE;
     }
     if (req->msg == NETWORK_SCAN_MSG_TYPE__TypeCmdScanWifiResult) {
-        RespScanWifiResult *resp_payload = (RespScanWifiResult *) malloc(sizeof(RespScanWifiResult));
+        RespScanWifiResult *resp_payload = (RespScanWifiResult *) network_prov_arena_alloc(arena, sizeof(RespScanWifiResult));
         if (!resp_payload) {
             ESP_LOGE(TAG, "Error allocating memory");
             return ESP_ERR_NO_MEM;
@@ -197,8 +199,8 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
 
         /* Allocate memory only if there are non-zero scan results */
         if (req->cmd_scan_wifi_result->count) {
-            results = (WiFiScanResult **) calloc(req->cmd_scan_wifi_result->count,
-                                                 sizeof(WiFiScanResult *));
+            results = (WiFiScanResult **) network_prov_arena_calloc(arena, req->cmd_scan_wifi_result->count,
+                      sizeof(WiFiScanResult *));
             if (!results) {
                 ESP_LOGE(TAG, "Failed to allocate memory for results array");
                 return ESP_ERR_NO_MEM;
@@ -222,7 +224,7 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
                 break;
             }
 
-            results[i] = (WiFiScanResult *) malloc(sizeof(WiFiScanResult));
+            results[i] = (WiFiScanResult *) network_prov_arena_alloc(arena, sizeof(WiFiScanResult));
             if (!results[i]) {
                 ESP_LOGE(TAG, "Failed to allocate memory for result entry");
                 return ESP_ERR_NO_MEM;
@@ -230,7 +232,7 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
             wi_fi_scan_result__init(results[i]);
 
             results[i]->ssid.len = strnlen(scan_result.ssid, 32);
-            results[i]->ssid.data = (uint8_t *) strndup(scan_result.ssid, 32);
+            results[i]->ssid.data = (uint8_t *) network_prov_arena_strndup(arena, scan_result.ssid, 32);
             if (!results[i]->ssid.data) {
                 ESP_LOGE(TAG, "Failed to allocate memory for scan result entry SSID");
                 return ESP_ERR_NO_MEM;
@@ -241,18 +243,17 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
             results[i]->auth = scan_result.auth;
 
             results[i]->bssid.len = sizeof(scan_result.bssid);
-            results[i]->bssid.data = malloc(results[i]->bssid.len);
+            results[i]->bssid.data = network_prov_arena_memdup(arena, scan_result.bssid, results[i]->bssid.len);
             if (!results[i]->bssid.data) {
                 ESP_LOGE(TAG, "Failed to allocate memory for scan result entry BSSID");
                 return ESP_ERR_NO_MEM;
             }
-            memcpy(results[i]->bssid.data, scan_result.bssid, results[i]->bssid.len);
         }
 #else // CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
         resp->status = STATUS__InvalidArgument;
 #endif // !CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
     } else if (req->msg == NETWORK_SCAN_MSG_TYPE__TypeCmdScanThreadResult) {
-        RespScanThreadResult *resp_payload = (RespScanThreadResult *) malloc(sizeof(RespScanThreadResult));
+        RespScanThreadResult *resp_payload = (RespScanThreadResult *) network_prov_arena_alloc(arena, sizeof(RespScanThreadResult));
         if (!resp_payload) {
             ESP_LOGE(TAG, "Error allocating memory");
             return ESP_ERR_NO_MEM;
@@ -268,8 +269,8 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
 
         /* Allocate memory only if there are non-zero scan results */
         if (req->cmd_scan_thread_result->count) {
-            results = (ThreadScanResult **) calloc(req->cmd_scan_thread_result->count,
-                                                   sizeof(ThreadScanResult *));
+            results = (ThreadScanResult **) network_prov_arena_calloc(arena, req->cmd_scan_thread_result->count,
+                      sizeof(ThreadScanResult *));
             if (!results) {
                 ESP_LOGE(TAG, "Failed to allocate memory for results array");
                 return ESP_ERR_NO_MEM;
@@ -293,7 +294,7 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
                 break;
             }
 
-            results[i] = (ThreadScanResult *) malloc(sizeof(ThreadScanResult));
+            results[i] = (ThreadScanResult *) network_prov_arena_alloc(arena, sizeof(ThreadScanResult));
             if (!results[i]) {
                 ESP_LOGE(TAG, "Failed to allocate memory for result entry");
                 return ESP_ERR_NO_MEM;
@@ -305,26 +306,27 @@ static esp_err_t cmd_scan_result_handler(NetworkScanPayload *req,
             results[i]->lqi = scan_result.lqi;
 
             results[i]->ext_addr.len = sizeof(scan_result.ext_addr);
-            results[i]->ext_addr.data = (uint8_t *)malloc(results[i]->ext_addr.len);
+            results[i]->ext_addr.data = network_prov_arena_memdup(arena, scan_result.ext_addr,
+                                        results[i]->ext_addr.len);
             if (!results[i]->ext_addr.data) {
                 ESP_LOGE(TAG, "Failed to allocate memory for scan result entry extended address");
                 return ESP_ERR_NO_MEM;
             }
-            memcpy(results[i]->ext_addr.data, scan_result.ext_addr, results[i]->ext_addr.len);
 
             results[i]->ext_pan_id.len = sizeof(scan_result.ext_pan_id);
-            results[i]->ext_pan_id.data = (uint8_t *)malloc(results[i]->ext_pan_id.len);
+            results[i]->ext_pan_id.data = network_prov_arena_memdup(arena, scan_result.ext_pan_id,
+                                          results[i]->ext_pan_id.len);
             if (!results[i]->ext_pan_id.data) {
                 ESP_LOGE(TAG, "Failed to allocate memory for scan result entry extended PAN ID");
                 return ESP_ERR_NO_MEM;
             }
-            memcpy(results[i]->ext_pan_id.data, scan_result.ext_pan_id, results[i]->ext_pan_id.len);
 
-            results[i]->network_name = (char *)malloc(sizeof(scan_result.network_name));
+            results[i]->network_name = network_prov_arena_strndup(arena, scan_result.network_name,
+                                       sizeof(scan_result.network_name));
             if (!results[i]->network_name) {
                 ESP_LOGE(TAG, "Failed to allocate memory for scan result entry networkname");
+                return ESP_ERR_NO_MEM;
             }
-            memcpy(results[i]->network_name, scan_result.network_name, sizeof(scan_result.network_name));
         }
 #else // CONFIG_NETWORK_PROV_NETWORK_TYPE_THREAD
         resp->status = STATUS__InvalidArgument;
@@ -346,75 +348,8 @@ static int lookup_cmd_handler(int cmd_id)
     return -1;
 }
 
-static void network_prov_scan_cmd_cleanup(NetworkScanPayload *resp, void *priv_data)
-{
-    switch (resp->msg) {
-    case NETWORK_SCAN_MSG_TYPE__TypeRespScanWifiStart: {
-        free(resp->resp_scan_wifi_start);
-    }
-    break;
-    case NETWORK_SCAN_MSG_TYPE__TypeRespScanThreadStart: {
-        free(resp->resp_scan_thread_start);
-    }
-    break;
-    case NETWORK_SCAN_MSG_TYPE__TypeRespScanWifiStatus: {
-        free(resp->resp_scan_wifi_status);
-    }
-    break;
-    case NETWORK_SCAN_MSG_TYPE__TypeRespScanThreadStatus: {
-        free(resp->resp_scan_thread_status);
-    }
-    break;
-
-    case NETWORK_SCAN_MSG_TYPE__TypeRespScanWifiResult: {
-        if (!resp->resp_scan_wifi_result) {
-            return;
-        }
-#ifdef CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
-        if (resp->resp_scan_wifi_result->entries) {
-            for (uint16_t i = 0; i < resp->resp_scan_wifi_result->n_entries; i++) {
-                if (!resp->resp_scan_wifi_result->entries[i]) {
-                    continue;
-                }
-                free(resp->resp_scan_wifi_result->entries[i]->ssid.data);
-                free(resp->resp_scan_wifi_result->entries[i]->bssid.data);
-            }
-            free(resp->resp_scan_wifi_result->entries);
-        }
-#endif // CONFIG_NETWORK_PROV_NETWORK_TYPE_WIFI
-        free(resp->resp_scan_wifi_result);
-    }
-    break;
-    case NETWORK_SCAN_MSG_TYPE__TypeRespScanThreadResult: {
-        if (!resp->resp_scan_thread_result) {
-            return;
-        }
-#ifdef CONFIG_NETWORK_PROV_NETWORK_TYPE_THREAD
-        if (resp->resp_scan_thread_result->entries) {
-            for (uint16_t i = 0; i < resp->resp_scan_thread_result->n_entries; i++) {
-                if (!resp->resp_scan_thread_result->entries[i]) {
-                    continue;
-                }
-                free(resp->resp_scan_thread_result->entries[i]->ext_addr.data);
-                free(resp->resp_scan_thread_result->entries[i]->ext_pan_id.data);
-                free(resp->resp_scan_thread_result->entries[i]->network_name);
-                free(resp->resp_scan_thread_result->entries[i]);
-            }
-            free(resp->resp_scan_thread_result->entries);
-        }
-#endif // CONFIG_NETWORK_PROV_NETWORK_TYPE_THREAD
-        free(resp->resp_scan_thread_result);
-    }
-    break;
-    default:
-        ESP_LOGE(TAG, "Unsupported response type in cleanup_handler");
-        break;
-    }
-    return;
-}
-
 static esp_err_t network_prov_scan_cmd_dispatcher(NetworkScanPayload *req,
-        NetworkScanPayload *resp, void *priv_data)
+        NetworkScanPayload *resp, network_prov_arena_t *arena, void *priv_data)
 {
     esp_err_t ret;
 
@@ -426,7 +361,7 @@ static esp_err_t network_prov_scan_cmd_dispatcher(NetworkScanPayload *req,
         return ESP_FAIL;
     }
 
-    ret = cmd_table[cmd_index].command_handler(req, resp, priv_data);
+    ret = cmd_table[cmd_index].command_handler(req, resp, arena, priv_data);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Error executing command handler");
         return ESP_FAIL;
@@ -440,16 +375,21 @@ esp_err_t network_prov_scan_handler(uint32_t session_id, const uint8_t *inbuf, s
 {
     NetworkScanPayload *req;
     NetworkScanPayload resp;
+    network_prov_arena_t arena;
     esp_err_t ret = ESP_OK;
 
-    req = network_scan_payload__unpack(NULL, inlen, inbuf);
+    /* The request and the whole response are allocated from the arena,
+     * only the packed response outlives this function */
+    network_prov_arena_init(&arena);
+    req = network_scan_payload__unpack(&arena.allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack scan message");
-        return ESP_ERR_INVALID_ARG;
+        ret = ESP_ERR_INVALID_ARG;
+        goto exit;
     }
 
     network_scan_payload__init(&resp);
-    ret = network_prov_scan_cmd_dispatcher(req, &resp, priv_data);
+    ret = network_prov_scan_cmd_dispatcher(req, &resp, &arena, priv_data);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Command dispatcher error %d", ret);
         ret = ESP_FAIL;
@@ -474,7 +414,6 @@ esp_err_t network_prov_scan_handler(uint32_t session_id, const uint8_t *inbuf, s
     ESP_LOGD(TAG, "Response packet size : %d", *outlen);
 exit:
 
-    network_scan_payload__free_unpacked(req, NULL);
-    network_prov_scan_cmd_cleanup(&resp, priv_data);
+    network_prov_arena_release(&arena);
     return ret;
 }
@@ -0,0 +1,281 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "unity.h"
+#include "onewire_bus.h"
+#include "onewire_bus_interface.h"
+#include "onewire_cmd.h"
+#include "onewire_crc.h"
+#include "onewire_bus_sim.h"
+
+#define SIM_CMD_CONVERT_T        0x44
+#define SIM_CMD_READ_SCRATCHPAD  0xBE
+#define SIM_FAMILY_CODE          0x28
+
+typedef enum {
+    SIM_STATE_IDLE,       // waiting for a reset pulse
+    SIM_STATE_ROM_CMD,    // waiting for a ROM command
+    SIM_STATE_MATCH_ROM,  // receiving the ROM code after MATCH ROM
+    SIM_STATE_FUNC_CMD,   // waiting for a function command
+    SIM_STATE_SEARCH,     // ROM search in progress
+    SIM_STATE_READ,       // sending the scratchpad of the selected device
+} sim_state_t;
+
+typedef struct {
+    uint8_t rom[8];
+    int16_t temperature;
+    bool converted;
+    bool corrupt;
+    bool selected;
+} sim_device_t;
+
+typedef struct {
+    onewire_bus_t base; // must be the first member, the bus handle is cast to the simulated bus
+    uint32_t op_time_ms;
+    sim_device_t devices[ONEWIRE_BUS_SIM_MAX_DEVICES];
+    size_t num_devices;
+    sim_state_t state;
+    uint8_t match_rom[8];
+    size_t match_pos;
+    uint16_t search_bit;  // bit of the ROM code being searched
+    uint8_t search_phase; // 0: send bit, 1: send complement, 2: receive direction
+    uint8_t read_buf[ONEWIRE_BUS_SIM_SCRATCHPAD_SIZE];
+    size_t read_pos;
+    onewire_bus_sim_stats_t stats;
+} onewire_bus_sim_t;
+
+static void sim_bus_delay(onewire_bus_sim_t *sim)
+{
+    if (sim->op_time_ms) {
+        vTaskDelay(pdMS_TO_TICKS(sim->op_time_ms));
+    }
+}
+
+static uint8_t sim_rom_bit(const sim_device_t *dev, uint16_t bit)
+{
+    return (dev->rom[bit / 8] >> (bit % 8)) & 0x01;
+}
+
+static void sim_select_all(onewire_bus_sim_t *sim, bool selected)
+{
+    for (size_t i = 0; i < sim->num_devices; i++) {
+        sim->devices[i].selected = selected;
+    }
+}
+
+static void sim_function_cmd(onewire_bus_sim_t *sim, uint8_t cmd)
+{
+    if (cmd == SIM_CMD_CONVERT_T) {
+        for (size_t i = 0; i < sim->num_devices; i++) {
+            if (sim->devices[i].selected) {
+                sim->devices[i].converted = true;
+            }
+        }
+        sim->stats.conversions++;
+        sim->state = SIM_STATE_IDLE;
+        return;
+    }
+    if (cmd == SIM_CMD_READ_SCRATCHPAD) {
+        // the devices put their bits on the bus at the same time, which is a wired AND
+        memset(sim->read_buf, 0xFF, sizeof(sim->read_buf));
+        for (size_t i = 0; i < sim->num_devices; i++) {
+            sim_device_t *dev = &sim->devices[i];
+            if (!dev->selected) {
+                continue;
+            }
+            // 85 degrees is the power-on value, returned when no conversion has been done
+            int16_t temperature = dev->converted ? dev->temperature : 85 * 16;
+            uint8_t scratchpad[ONEWIRE_BUS_SIM_SCRATCHPAD_SIZE] = {
+                temperature & 0xFF, temperature >> 8, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10
+            };
+            scratchpad[8] = onewire_crc8(0, scratchpad, 8);
+            if (dev->corrupt) {
+                scratchpad[0] ^= 0x01;
+            }
+            for (size_t j = 0; j < sizeof(scratchpad); j++) {
+                sim->read_buf[j] &= scratchpad[j];
+            }
+            sim->stats.reads++;
+        }
+        sim->read_pos = 0;
+        sim->state = SIM_STATE_READ;
+        return;
+    }
+    sim->state = SIM_STATE_IDLE;
+}
+
+static esp_err_t sim_write_bytes(onewire_bus_t *bus, const uint8_t *tx_data, uint8_t tx_data_size)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+    sim_bus_delay(sim);
+
+    for (size_t i = 0; i < tx_data_size; i++) {
+        uint8_t byte = tx_data[i];
+        switch (sim->state) {
+        case SIM_STATE_ROM_CMD:
+            if (byte == ONEWIRE_CMD_SKIP_ROM) {
+                sim_select_all(sim, true);
+                sim->state = SIM_STATE_FUNC_CMD;
+            } else if (byte == ONEWIRE_CMD_MATCH_ROM) {
+                sim->match_pos = 0;
+                sim->state = SIM_STATE_MATCH_ROM;
+            } else if (byte == ONEWIRE_CMD_SEARCH_NORMAL) {
+                sim_select_all(sim, true);
+                sim->search_bit = 0;
+                sim->search_phase = 0;
+                sim->state = SIM_STATE_SEARCH;
+            } else {
+                sim->state = SIM_STATE_IDLE;
+            }
+            break;
+        case SIM_STATE_MATCH_ROM:
+            sim->match_rom[sim->match_pos++] = byte;
+            if (sim->match_pos == sizeof(sim->match_rom)) {
+                for (size_t j = 0; j < sim->num_devices; j++) {
+                    sim->devices[j].selected = !memcmp(sim->devices[j].rom, sim->match_rom, sizeof(sim->match_rom));
+                }
+                sim->state = SIM_STATE_FUNC_CMD;
+            }
+            break;
+        case SIM_STATE_FUNC_CMD:
+            sim_function_cmd(sim, byte);
+            break;
+        default:
+            // the devices ignore the bytes they don't expect
+            sim->state = SIM_STATE_IDLE;
+            break;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sim_read_bytes(onewire_bus_t *bus, uint8_t *rx_buf, size_t rx_buf_size)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+    sim_bus_delay(sim);
+
+    for (size_t i = 0; i < rx_buf_size; i++) {
+        // nobody pulls the bus low when no device is sending
+        rx_buf[i] = 0xFF;
+        if (sim->state == SIM_STATE_READ && sim->read_pos < sizeof(sim->read_buf)) {
+            rx_buf[i] = sim->read_buf[sim->read_pos++];
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sim_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+
+    *rx_bit = 1;
+    if (sim->state != SIM_STATE_SEARCH || sim->search_phase > 1) {
+        return ESP_OK;
+    }
+    // each participating device sends its ROM bit then its complement, the bus being a wired AND
+    for (size_t i = 0; i < sim->num_devices; i++) {
+        if (sim->devices[i].selected) {
+            *rx_bit &= sim_rom_bit(&sim->devices[i], sim->search_bit) ^ sim->search_phase;
+        }
+    }
+    sim->search_phase++;
+    return ESP_OK;
+}
+
+static esp_err_t sim_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+
+    if (sim->state != SIM_STATE_SEARCH || sim->search_phase != 2) {
+        return ESP_OK;
+    }
+    // the devices whose ROM bit doesn't match the direction leave the search
+    for (size_t i = 0; i < sim->num_devices; i++) {
+        if (sim_rom_bit(&sim->devices[i], sim->search_bit) != !!tx_bit) {
+            sim->devices[i].selected = false;
+        }
+    }
+    sim->search_phase = 0;
+    if (++sim->search_bit == 64) {
+        sim->state = SIM_STATE_FUNC_CMD;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sim_reset(onewire_bus_t *bus)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+    sim_bus_delay(sim);
+
+    sim->stats.resets++;
+    sim_select_all(sim, false);
+    if (!sim->num_devices) {
+        sim->state = SIM_STATE_IDLE;
+        return ESP_ERR_NOT_FOUND;
+    }
+    sim->state = SIM_STATE_ROM_CMD;
+    return ESP_OK;
+}
+
+static esp_err_t sim_del(onewire_bus_t *bus)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+    free(sim);
+    return ESP_OK;
+}
+
+void onewire_bus_sim_new(uint32_t op_time_ms, onewire_bus_handle_t *ret_bus)
+{
+    onewire_bus_sim_t *sim = calloc(1, sizeof(onewire_bus_sim_t));
+    TEST_ASSERT_NOT_NULL(sim);
+
+    sim->op_time_ms = op_time_ms;
+    sim->base.write_bytes = sim_write_bytes;
+    sim->base.read_bytes = sim_read_bytes;
+    sim->base.write_bit = sim_write_bit;
+    sim->base.read_bit = sim_read_bit;
+    sim->base.reset = sim_reset;
+    sim->base.del = sim_del;
+    *ret_bus = &sim->base;
+}
+
+onewire_device_address_t onewire_bus_sim_add_device(onewire_bus_handle_t bus, uint64_t rom, int16_t temperature)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+    TEST_ASSERT_LESS_THAN(ONEWIRE_BUS_SIM_MAX_DEVICES, sim->num_devices);
+
+    sim_device_t *dev = &sim->devices[sim->num_devices++];
+    dev->rom[0] = SIM_FAMILY_CODE;
+    for (int i = 1; i < 7; i++) {
+        dev->rom[i] = rom >> (8 * (i - 1));
+    }
+    dev->rom[7] = onewire_crc8(0, dev->rom, 7);
+    dev->temperature = temperature;
+
+    onewire_device_address_t address;
+    memcpy(&address, dev->rom, sizeof(address));
+    return address;
+}
+
+void onewire_bus_sim_corrupt_device(onewire_bus_handle_t bus, onewire_device_address_t address, bool corrupt)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+
+    for (size_t i = 0; i < sim->num_devices; i++) {
+        if (!memcmp(sim->devices[i].rom, &address, sizeof(address))) {
+            sim->devices[i].corrupt = corrupt;
+        }
+    }
+}
+
+void onewire_bus_sim_get_stats(onewire_bus_handle_t bus, onewire_bus_sim_stats_t *stats)
+{
+    onewire_bus_sim_t *sim = (onewire_bus_sim_t *)bus;
+    *stats = sim->stats;
+}
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "onewire_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ONEWIRE_BUS_SIM_MAX_DEVICES  16
+#define ONEWIRE_BUS_SIM_SCRATCHPAD_SIZE 9
+
+/**
+ * @brief Counters of the operations done on a simulated bus
+ */
+typedef struct {
+    uint32_t resets;      /*!< Number of reset pulses */
+    uint32_t conversions; /*!< Number of convert commands, a broadcast one counting once */
+    uint32_t reads;       /*!< Number of scratchpad reads */
+} onewire_bus_sim_stats_t;
+
+/**
+ * @brief Create a simulated 1-Wire bus, implementing the bus interface without any hardware
+ *
+ * The simulated devices behave like DS18B20 temperature sensors: the convert command (0x44) updates the
+ * temperature in their scratchpad, and the read scratchpad command (0xBE) returns it followed by its CRC8.
+ *
+ * @param[in] op_time_ms Time taken by each reset, write or read operation on the bus, 0 for none
+ * @param[out] ret_bus Returned bus handle
+ */
+void onewire_bus_sim_new(uint32_t op_time_ms, onewire_bus_handle_t *ret_bus);
+
+/**
+ * @brief Add a device to a simulated bus
+ *
+ * @param[in] bus Simulated bus
+ * @param[in] rom ROM code of the device, its family code and CRC are filled in by the simulation
+ * @param[in] temperature Raw temperature reported by the device after a conversion
+ * @return Address of the device, as read from the bus
+ */
+onewire_device_address_t onewire_bus_sim_add_device(onewire_bus_handle_t bus, uint64_t rom, int16_t temperature);
+
+/**
+ * @brief Make a device of a simulated bus return a corrupted scratchpad
+ */
+void onewire_bus_sim_corrupt_device(onewire_bus_handle_t bus, onewire_device_address_t address, bool corrupt);
+
+/**
+ * @brief Get the operation counters of a simulated bus
+ */
+void onewire_bus_sim_get_stats(onewire_bus_handle_t bus, onewire_bus_sim_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
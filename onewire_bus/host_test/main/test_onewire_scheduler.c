@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "unity.h"
+#include "onewire_bus.h"
+#include "onewire_device.h"
+#include "onewire_scheduler.h"
+#include "onewire_bus_sim.h"
+
+#define TEST_NUM_BUSES          4
+#define TEST_DEVICES_PER_BUS    4
+#define TEST_SCRATCHPAD_SIZE    ONEWIRE_BUS_SIM_SCRATCHPAD_SIZE
+
+static const onewire_scheduler_config_t s_ds18b20_config = {
+    .convert_cmd = 0x44,
+    .convert_time_ms = 20,
+    .read_cmd = 0xBE,
+    .read_size = TEST_SCRATCHPAD_SIZE,
+};
+
+static int16_t test_temperature(size_t bus_index, size_t device_index)
+{
+    return (int16_t)(bus_index * 100 + device_index) * 16;
+}
+
+// create the buses, and add all their devices to the scheduler
+static void test_setup_buses(onewire_scheduler_handle_t scheduler, uint32_t op_time_ms, onewire_bus_handle_t *buses,
+                             onewire_device_address_t addresses[][TEST_DEVICES_PER_BUS])
+{
+    for (size_t i = 0; i < TEST_NUM_BUSES; i++) {
+        onewire_bus_sim_new(op_time_ms, &buses[i]);
+        for (size_t j = 0; j < TEST_DEVICES_PER_BUS; j++) {
+            addresses[i][j] = onewire_bus_sim_add_device(buses[i], 0x123456789A00ULL + i * 0x10 + j, test_temperature(i, j));
+            onewire_device_t device = {
+                .bus = buses[i],
+                .address = addresses[i][j],
+            };
+            size_t index = 0;
+            TEST_ASSERT_EQUAL(ESP_OK, onewire_scheduler_add_device(scheduler, &device, &index));
+            TEST_ASSERT_EQUAL(i * TEST_DEVICES_PER_BUS + j, index);
+        }
+    }
+}
+
+static void test_del_scheduler(onewire_scheduler_handle_t scheduler)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_del_scheduler(scheduler));
+    // let the idle task free the bus tasks before the leak check
+    vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+static void test_teardown_buses(onewire_bus_handle_t *buses)
+{
+    for (size_t i = 0; i < TEST_NUM_BUSES; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, onewire_bus_del(buses[i]));
+    }
+}
+
+TEST_CASE("onewire search all devices on simulated bus", "[onewire]")
+{
+    onewire_bus_handle_t bus = NULL;
+    onewire_bus_sim_new(0, &bus);
+
+    onewire_device_address_t expected[8];
+    for (size_t i = 0; i < 8; i++) {
+        expected[i] = onewire_bus_sim_add_device(bus, 0xA5C3F0000000ULL ^ (i * 0x010203040506ULL), 0);
+    }
+
+    onewire_device_address_t found[8];
+    size_t num_found = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_device_search_all(bus, found, 8, &num_found));
+    TEST_ASSERT_EQUAL(8, num_found);
+    for (size_t i = 0; i < 8; i++) {
+        bool is_found = false;
+        for (size_t j = 0; j < num_found; j++) {
+            is_found |= found[j] == expected[i];
+        }
+        TEST_ASSERT_TRUE(is_found);
+    }
+
+    // more devices than room in the list
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, onewire_device_search_all(bus, found, 4, &num_found));
+    TEST_ASSERT_EQUAL(4, num_found);
+
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_bus_del(bus));
+}
+
+TEST_CASE("onewire scheduler samples all buses with one convert per bus", "[onewire]")
+{
+    onewire_scheduler_handle_t scheduler = NULL;
+    onewire_bus_handle_t buses[TEST_NUM_BUSES];
+    onewire_device_address_t addresses[TEST_NUM_BUSES][TEST_DEVICES_PER_BUS];
+    uint8_t data[TEST_NUM_BUSES * TEST_DEVICES_PER_BUS][TEST_SCRATCHPAD_SIZE];
+    esp_err_t status[TEST_NUM_BUSES * TEST_DEVICES_PER_BUS];
+
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_new_scheduler(&s_ds18b20_config, &scheduler));
+    test_setup_buses(scheduler, 0, buses, addresses);
+
+    for (int round = 0; round < 3; round++) {
+        TEST_ASSERT_EQUAL(ESP_OK, onewire_scheduler_sample(scheduler, &data[0][0], status));
+    }
+
+    for (size_t i = 0; i < TEST_NUM_BUSES; i++) {
+        for (size_t j = 0; j < TEST_DEVICES_PER_BUS; j++) {
+            size_t index = i * TEST_DEVICES_PER_BUS + j;
+            TEST_ASSERT_EQUAL(ESP_OK, status[index]);
+            TEST_ASSERT_EQUAL_INT16(test_temperature(i, j), (int16_t)(data[index][0] | (data[index][1] << 8)));
+        }
+        onewire_bus_sim_stats_t stats;
+        onewire_bus_sim_get_stats(buses[i], &stats);
+        TEST_ASSERT_EQUAL(3, stats.conversions);
+        TEST_ASSERT_EQUAL(3 * TEST_DEVICES_PER_BUS, stats.reads);
+        TEST_ASSERT_EQUAL(3 * (1 + TEST_DEVICES_PER_BUS), stats.resets);
+    }
+
+    test_del_scheduler(scheduler);
+    test_teardown_buses(buses);
+}
+
+TEST_CASE("onewire scheduler reports per device errors", "[onewire]")
+{
+    onewire_scheduler_handle_t scheduler = NULL;
+    onewire_bus_handle_t buses[TEST_NUM_BUSES];
+    onewire_device_address_t addresses[TEST_NUM_BUSES][TEST_DEVICES_PER_BUS];
+    uint8_t data[TEST_NUM_BUSES * TEST_DEVICES_PER_BUS + 1][TEST_SCRATCHPAD_SIZE];
+    esp_err_t status[TEST_NUM_BUSES * TEST_DEVICES_PER_BUS + 1];
+
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_new_scheduler(&s_ds18b20_config, &scheduler));
+    test_setup_buses(scheduler, 0, buses, addresses);
+
+    // a bus on which no device answers the reset pulse
+    onewire_bus_handle_t empty_bus = NULL;
+    onewire_bus_sim_new(0, &empty_bus);
+    onewire_device_t missing_device = {
+        .bus = empty_bus,
+        .address = addresses[0][0],
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_scheduler_add_device(scheduler, &missing_device, NULL));
+
+    onewire_bus_sim_corrupt_device(buses[1], addresses[1][2], true);
+    TEST_ASSERT_EQUAL(ESP_FAIL, onewire_scheduler_sample(scheduler, &data[0][0], status));
+
+    for (size_t i = 0; i < TEST_NUM_BUSES * TEST_DEVICES_PER_BUS; i++) {
+        TEST_ASSERT_EQUAL(i == 1 * TEST_DEVICES_PER_BUS + 2 ? ESP_ERR_INVALID_CRC : ESP_OK, status[i]);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, status[TEST_NUM_BUSES * TEST_DEVICES_PER_BUS]);
+
+    onewire_bus_sim_corrupt_device(buses[1], addresses[1][2], false);
+    TEST_ASSERT_EQUAL(ESP_FAIL, onewire_scheduler_sample(scheduler, &data[0][0], status));
+    TEST_ASSERT_EQUAL(ESP_OK, status[1 * TEST_DEVICES_PER_BUS + 2]);
+
+    test_del_scheduler(scheduler);
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_bus_del(empty_bus));
+    test_teardown_buses(buses);
+}
+
+TEST_CASE("onewire scheduler drives the buses concurrently", "[onewire]")
+{
+    const uint32_t op_time_ms = 5;
+    onewire_scheduler_handle_t scheduler = NULL;
+    onewire_bus_handle_t buses[TEST_NUM_BUSES];
+    onewire_device_address_t addresses[TEST_NUM_BUSES][TEST_DEVICES_PER_BUS];
+    uint8_t data[TEST_NUM_BUSES * TEST_DEVICES_PER_BUS][TEST_SCRATCHPAD_SIZE];
+    esp_err_t status[TEST_NUM_BUSES * TEST_DEVICES_PER_BUS];
+
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_new_scheduler(&s_ds18b20_config, &scheduler));
+    test_setup_buses(scheduler, op_time_ms, buses, addresses);
+
+    TickType_t start = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL(ESP_OK, onewire_scheduler_sample(scheduler, &data[0][0], status));
+    uint32_t elapsed_ms = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+
+    // convert: reset + write, then each device: reset + write + read
+    uint32_t bus_time_ms = (2 + 3 * TEST_DEVICES_PER_BUS) * op_time_ms;
+    uint32_t sequential_ms = TEST_NUM_BUSES * bus_time_ms + s_ds18b20_config.convert_time_ms;
+    printf("sampling %d devices took %"PRIu32" ms, %"PRIu32" ms if the buses were driven one after the other\n",
+           TEST_NUM_BUSES * TEST_DEVICES_PER_BUS, elapsed_ms, sequential_ms);
+    TEST_ASSERT_GREATER_OR_EQUAL(bus_time_ms + s_ds18b20_config.convert_time_ms, elapsed_ms);
+    TEST_ASSERT_LESS_THAN(sequential_ms * 2 / 3, elapsed_ms);
+
+    test_del_scheduler(scheduler);
+    test_teardown_buses(buses);
+}
@@ -0,0 +1,14 @@
+import pytest
+from pytest_embedded import Dut
+import glob
+from pathlib import Path
+
+
+@pytest.mark.host_test
+@pytest.mark.skipif(
+    not bool(glob.glob(f'{Path(__file__).parent.absolute()}/build*/')),
+    reason="Skip the idf version that did not build"
+)
+@pytest.mark.parametrize('target', ['linux'], indirect=['target'])
+def host_test_onewire_bus(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
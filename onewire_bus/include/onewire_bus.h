@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -62,6 +62,25 @@ esp_err_t onewire_bus_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit);
  */
 esp_err_t onewire_bus_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit);
 
+/**
+ * @brief Run one step of the ROM search ("search triplet")
+ *
+ * Reads a ROM bit and its complement from the devices participating in the search, then writes the search direction,
+ * which is the bit value when all the devices agree, `search_direction` otherwise.
+ * Backends supporting it do this in a single bus transaction.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] search_direction direction to take if the participating devices have both 0 and 1 at this bit
+ * @param[out] rom_bit received bit
+ * @param[out] rom_bit_complement received complement bit, `rom_bit` and `rom_bit_complement` both being 1 means no device is participating
+ * @param[out] taken_direction direction that has been written to the bus
+ * @return
+ *         - ESP_OK                Search step done successfully.
+ *         - ESP_ERR_INVALID_ARG   Invalid argument.
+ */
+esp_err_t onewire_bus_search_triplet(onewire_bus_handle_t bus, uint8_t search_direction,
+                                     uint8_t *rom_bit, uint8_t *rom_bit_complement, uint8_t *taken_direction);
+
 /**
  * @brief Send reset pulse to the bus, and check if there are devices attached to the bus
  *
@@ -1,11 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "onewire_types.h"
 
@@ -58,6 +59,24 @@ esp_err_t onewire_del_device_iter(onewire_device_iter_handle_t iter);
  */
 esp_err_t onewire_device_iter_get_next(onewire_device_iter_handle_t iter, onewire_device_t *dev);
 
+/**
+ * @brief Search all the 1-Wire devices on the bus
+ *
+ * This runs the whole ROM search at once, without creating a device iterator.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[out] addr_list Array to store the addresses of the found devices, in the search order
+ * @param[in] max_devices Number of addresses that `addr_list` can hold
+ * @param[out] ret_num_devices Returned number of devices found
+ * @return
+ *      - ESP_OK: Search all devices successfully, including when no device is found
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_SIZE: There are more devices on the bus than `max_devices`, the first `max_devices` ones are returned
+ *      - ESP_ERR_INVALID_CRC: A device address failed the CRC check, the devices found before it are returned
+ *      - ESP_FAIL: Other errors
+ */
+esp_err_t onewire_device_search_all(onewire_bus_handle_t bus, onewire_device_address_t *addr_list, size_t max_devices, size_t *ret_num_devices);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "onewire_types.h"
+#include "onewire_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum number of buses driven by one scheduler
+ */
+#define ONEWIRE_SCHEDULER_MAX_BUSES 8
+
+/**
+ * @brief Type of 1-Wire scheduler handle
+ */
+typedef struct onewire_scheduler_t *onewire_scheduler_handle_t;
+
+/**
+ * @brief 1-Wire scheduler configuration
+ *
+ * For DS18B20 temperature sensors: `convert_cmd` = 0x44 (Convert T), `read_cmd` = 0xBE (Read Scratchpad),
+ * `read_size` = 9 and `convert_time_ms` = 750 for the 12-bit resolution.
+ */
+typedef struct {
+    uint8_t convert_cmd;      /*!< Function command sent to all the devices at once (after SKIP ROM) to start a conversion */
+    uint32_t convert_time_ms; /*!< Time the devices need to complete the conversion, in ms */
+    uint8_t read_cmd;         /*!< Function command sent to each device (after MATCH ROM) to read the result of the conversion */
+    uint8_t read_size;        /*!< Number of bytes read after `read_cmd`, the last one being the CRC8 of the others.
+                                   For the RMT backend, `max_rx_bytes` of the buses must be at least this size */
+    uint32_t task_stack_size; /*!< Stack size of the task driving each bus, 0 for the default */
+    uint32_t task_priority;   /*!< Priority of the task driving each bus, 0 for the default */
+} onewire_scheduler_config_t;
+
+/**
+ * @brief Create a scheduler sampling the 1-Wire devices of several buses
+ *
+ * Each bus is driven by its own task, so that all the buses are accessed concurrently.
+ *
+ * @param[in] config Scheduler configuration
+ * @param[out] ret_scheduler Returned scheduler handle
+ * @return
+ *      - ESP_OK: Create scheduler successfully
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: No memory to create the scheduler
+ */
+esp_err_t onewire_new_scheduler(const onewire_scheduler_config_t *config, onewire_scheduler_handle_t *ret_scheduler);
+
+/**
+ * @brief Delete the scheduler
+ *
+ * @note The buses are not deleted
+ *
+ * @param[in] scheduler Scheduler handle
+ * @return
+ *      - ESP_OK: Delete scheduler successfully
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t onewire_del_scheduler(onewire_scheduler_handle_t scheduler);
+
+/**
+ * @brief Add a device to sample
+ *
+ * The bus of the device is added to the scheduler if it's not driven by it yet.
+ *
+ * @param[in] scheduler Scheduler handle
+ * @param[in] device Device to sample, e.g. returned by `onewire_device_iter_get_next()`
+ * @param[out] ret_index Returned index of the device in the sampling results, can be NULL
+ * @return
+ *      - ESP_OK: Add device successfully
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: No memory to add the device or to create the task driving its bus
+ *      - ESP_ERR_NOT_SUPPORTED: Already `ONEWIRE_SCHEDULER_MAX_BUSES` buses driven by the scheduler
+ */
+esp_err_t onewire_scheduler_add_device(onewire_scheduler_handle_t scheduler, const onewire_device_t *device, size_t *ret_index);
+
+/**
+ * @brief Sample all the devices
+ *
+ * A conversion is started on all the devices of all the buses at once (SKIP ROM + `convert_cmd`), then after
+ * `convert_time_ms` the result of each device is read (MATCH ROM + `read_cmd`) and its CRC8 checked.
+ *
+ * @param[in] scheduler Scheduler handle
+ * @param[out] data Buffer of `read_size` bytes for each device, in the order the devices have been added
+ * @param[out] status Result for each device: ESP_OK, ESP_ERR_INVALID_CRC if its data are corrupted,
+ *                    ESP_ERR_NOT_FOUND if no device answered the reset pulse on its bus or an other error from the bus
+ * @return
+ *      - ESP_OK: All the devices have been sampled successfully
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_FAIL: Sampling failed for some devices, see `status`
+ */
+esp_err_t onewire_scheduler_sample(onewire_scheduler_handle_t scheduler, uint8_t *data, esp_err_t *status);
+
+#ifdef __cplusplus
+}
+#endif
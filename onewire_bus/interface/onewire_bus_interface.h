@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -68,6 +68,23 @@ struct onewire_bus_t {
      */
     esp_err_t (*read_bit)(onewire_bus_handle_t handle, uint8_t *rx_bit);
 
+    /**
+     * @brief Run one step of the ROM search: read a bit and its complement, then write the search direction
+     *
+     * @note This is optional, when it's NULL the step is done with `read_bit` and `write_bit`
+     *
+     * @param[in] handle 1-wire bus handle
+     * @param[in] search_direction direction to take if the participating devices have both 0 and 1 at this bit
+     * @param[out] rom_bit received bit
+     * @param[out] rom_bit_complement received complement bit
+     * @param[out] taken_direction direction that has been written to the bus
+     * @return
+     *         - ESP_OK                Search step done successfully.
+     *         - ESP_ERR_INVALID_ARG   Invalid argument.
+     */
+    esp_err_t (*search_triplet)(onewire_bus_handle_t handle, uint8_t search_direction,
+                                uint8_t *rom_bit, uint8_t *rom_bit_complement, uint8_t *taken_direction);
+
     /**
      * @brief Send reset pulse to the bus, and check if there are devices attached to the bus
      *
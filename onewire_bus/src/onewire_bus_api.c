@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -40,6 +40,21 @@ esp_err_t onewire_bus_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit)
     return bus->read_bit(bus, rx_bit);
 }
 
+esp_err_t onewire_bus_search_triplet(onewire_bus_handle_t bus, uint8_t search_direction,
+                                     uint8_t *rom_bit, uint8_t *rom_bit_complement, uint8_t *taken_direction)
+{
+    ESP_RETURN_ON_FALSE(bus && rom_bit && rom_bit_complement && taken_direction, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (bus->search_triplet) {
+        return bus->search_triplet(bus, search_direction, rom_bit, rom_bit_complement, taken_direction);
+    }
+
+    // generic implementation for the backends without a dedicated one
+    ESP_RETURN_ON_ERROR(bus->read_bit(bus, rom_bit), TAG, "read rom_bit error");
+    ESP_RETURN_ON_ERROR(bus->read_bit(bus, rom_bit_complement), TAG, "read rom_bit_complement error");
+    *taken_direction = (*rom_bit != *rom_bit_complement) ? *rom_bit : (search_direction ? 1 : 0);
+    return bus->write_bit(bus, *taken_direction);
+}
+
 esp_err_t onewire_bus_del(onewire_bus_handle_t bus)
 {
     ESP_RETURN_ON_FALSE(bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
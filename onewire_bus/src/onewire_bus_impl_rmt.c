@@ -128,6 +128,10 @@ typedef struct {
 
     QueueHandle_t receive_queue;
     SemaphoreHandle_t bus_mutex;
+
+    bool triplet_pending; /*!< the ongoing receive is for a search triplet */
+    uint8_t triplet_search_direction; /*!< direction to take on a discrepancy, for the ongoing search triplet */
+    uint8_t triplet_result; /*!< result of the search triplet decided in the RX done callback */
 } onewire_bus_rmt_obj_t;
 
 static rmt_symbol_word_t onewire_reset_pulse_symbol = {
@@ -151,6 +155,22 @@ static rmt_symbol_word_t onewire_bit1_symbol = {
     .duration1 = ONEWIRE_SLOT_BIT_DURATION + ONEWIRE_SLOT_RECOVERY_DURATION
 };
 
+// two read slots, to read a ROM bit and its complement during the ROM search
+static rmt_symbol_word_t onewire_search_read_symbols[2] = {
+    {
+        .level0 = 0,
+        .duration0 = ONEWIRE_SLOT_START_DURATION,
+        .level1 = 1,
+        .duration1 = ONEWIRE_SLOT_BIT_DURATION + ONEWIRE_SLOT_RECOVERY_DURATION
+    },
+    {
+        .level0 = 0,
+        .duration0 = ONEWIRE_SLOT_START_DURATION,
+        .level1 = 1,
+        .duration1 = ONEWIRE_SLOT_BIT_DURATION + ONEWIRE_SLOT_RECOVERY_DURATION
+    },
+};
+
 const static rmt_transmit_config_t onewire_rmt_tx_config = {
     .loop_count = 0,     // no transfer loop
     .flags.eot_level = 1 // onewire bus should be released in IDLE
@@ -161,20 +181,59 @@ const static rmt_receive_config_t onewire_rmt_rx_config = {
     .signal_range_max_ns = (ONEWIRE_RESET_PULSE_DURATION + ONEWIRE_RESET_WAIT_DURATION) * 1000,
 };
 
+// read slots never stay at the same level longer than one slot, so the receive can end much sooner after the last slot
+const static rmt_receive_config_t onewire_rmt_rx_triplet_config = {
+    .signal_range_min_ns = 1000000000 / ONEWIRE_RMT_RESOLUTION_HZ,
+    .signal_range_max_ns = (ONEWIRE_SLOT_START_DURATION + ONEWIRE_SLOT_BIT_DURATION + ONEWIRE_SLOT_RECOVERY_DURATION) * 2 * 1000,
+};
+
 static esp_err_t onewire_bus_rmt_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit);
 static esp_err_t onewire_bus_rmt_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit);
 static esp_err_t onewire_bus_rmt_read_bytes(onewire_bus_handle_t bus, uint8_t *rx_buf, size_t rx_buf_size);
 static esp_err_t onewire_bus_rmt_write_bytes(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size);
 static esp_err_t onewire_bus_rmt_reset(onewire_bus_handle_t bus);
+static esp_err_t onewire_bus_rmt_search_triplet(onewire_bus_handle_t bus, uint8_t search_direction,
+        uint8_t *rom_bit, uint8_t *rom_bit_complement, uint8_t *taken_direction);
 static esp_err_t onewire_bus_rmt_del(onewire_bus_handle_t bus);
 static esp_err_t onewire_bus_rmt_destroy(onewire_bus_rmt_obj_t *bus_rmt);
 
+#define ONEWIRE_TRIPLET_ROM_BIT             (1 << 0)
+#define ONEWIRE_TRIPLET_ROM_BIT_COMPLEMENT  (1 << 1)
+#define ONEWIRE_TRIPLET_DIRECTION           (1 << 2)
+
+// decode the two read slots of a search triplet and decide the search direction
+IRAM_ATTR
+static uint8_t onewire_rmt_decide_triplet(const rmt_symbol_word_t *rmt_symbols, size_t symbol_num, uint8_t search_direction)
+{
+    uint8_t result = 0;
+    // a missing slot is read as 1, as nobody pulled the bus down
+    if (symbol_num < 1 || rmt_symbols[0].duration0 <= ONEWIRE_SLOT_BIT_SAMPLE_TIME) {
+        result |= ONEWIRE_TRIPLET_ROM_BIT;
+    }
+    if (symbol_num < 2 || rmt_symbols[1].duration0 <= ONEWIRE_SLOT_BIT_SAMPLE_TIME) {
+        result |= ONEWIRE_TRIPLET_ROM_BIT_COMPLEMENT;
+    }
+
+    bool rom_bit = result & ONEWIRE_TRIPLET_ROM_BIT;
+    bool rom_bit_complement = result & ONEWIRE_TRIPLET_ROM_BIT_COMPLEMENT;
+    if (rom_bit != rom_bit_complement ? rom_bit : search_direction) {
+        result |= ONEWIRE_TRIPLET_DIRECTION;
+    }
+    return result;
+}
+
 IRAM_ATTR
 bool onewire_rmt_rx_done_callback(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata, void *user_data)
 {
     BaseType_t task_woken = pdFALSE;
     onewire_bus_rmt_obj_t *bus_rmt = (onewire_bus_rmt_obj_t *)user_data;
 
+    if (bus_rmt->triplet_pending) {
+        // decide the direction here, so that the task can send it as soon as it wakes up
+        bus_rmt->triplet_result = onewire_rmt_decide_triplet(edata->received_symbols, edata->num_symbols,
+                                  bus_rmt->triplet_search_direction);
+    }
+
     xQueueSendFromISR(bus_rmt->receive_queue, edata, &task_woken);
 
     return task_woken;
@@ -350,6 +409,7 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     bus_rmt->base.write_bytes = onewire_bus_rmt_write_bytes;
     bus_rmt->base.read_bit = onewire_bus_rmt_read_bit;
     bus_rmt->base.read_bytes = onewire_bus_rmt_read_bytes;
+    bus_rmt->base.search_triplet = onewire_bus_rmt_search_triplet;
     *ret_bus = &bus_rmt->base;
 
     return ret;
@@ -519,3 +579,43 @@ err:
     xSemaphoreGive(bus_rmt->bus_mutex);
     return ret;
 }
+
+// Both read slots of a search triplet are generated by one RMT transmission and recorded by one receive,
+// the search direction is decided in the RX done callback and written right after.
+static esp_err_t onewire_bus_rmt_search_triplet(onewire_bus_handle_t bus, uint8_t search_direction,
+        uint8_t *rom_bit, uint8_t *rom_bit_complement, uint8_t *taken_direction)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+    esp_err_t ret = ESP_OK;
+
+    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+
+    bus_rmt->triplet_search_direction = search_direction ? 1 : 0;
+    bus_rmt->triplet_pending = true;
+    // transmit 2 read slots while receiving
+    ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, sizeof(onewire_search_read_symbols), &onewire_rmt_rx_triplet_config),
+                      err, TAG, "1-wire search triplet receive failed");
+    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, onewire_search_read_symbols, sizeof(onewire_search_read_symbols), &onewire_rmt_tx_config),
+                      err, TAG, "1-wire search triplet transmit failed");
+
+    // wait the read slots to be received, the result is ready at the same time
+    rmt_rx_done_event_data_t rmt_rx_evt_data;
+    ESP_GOTO_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS, ESP_ERR_TIMEOUT,
+                      err, TAG, "1-wire search triplet receive timeout");
+    uint8_t result = bus_rmt->triplet_result;
+    *rom_bit = (result & ONEWIRE_TRIPLET_ROM_BIT) ? 1 : 0;
+    *rom_bit_complement = (result & ONEWIRE_TRIPLET_ROM_BIT_COMPLEMENT) ? 1 : 0;
+    *taken_direction = (result & ONEWIRE_TRIPLET_DIRECTION) ? 1 : 0;
+
+    // transmit the direction bit
+    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, *taken_direction ? &onewire_bit1_symbol : &onewire_bit0_symbol,
+                                   sizeof(rmt_symbol_word_t), &onewire_rmt_tx_config),
+                      err, TAG, "1-wire search direction transmit failed");
+    // wait the transmission to complete, before the next receive can start
+    ESP_GOTO_ON_ERROR(rmt_tx_wait_all_done(bus_rmt->tx_channel, 50), err, TAG, "wait for 1-wire search direction transmit failed");
+
+err:
+    bus_rmt->triplet_pending = false;
+    xSemaphoreGive(bus_rmt->bus_mutex);
+    return ret;
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -70,10 +70,20 @@ esp_err_t onewire_device_iter_get_next(onewire_device_iter_handle_t iter, onewir
         uint8_t rom_byte_index = rom_bit_index / 8;
         uint8_t rom_bit_mask = 1 << (rom_bit_index % 8); // calculate byte index and bit mask in advance for convenience
 
+        // direction to take if there is a discrepancy at this bit
+        uint8_t search_direction;
+        if (rom_bit_index < iter->last_discrepancy) { // current id bit is before the last discrepancy bit
+            search_direction = (iter->rom_number[rom_byte_index] & rom_bit_mask) ? 0x01 : 0x00; // follow previous way
+        } else {
+            search_direction = (rom_bit_index == iter->last_discrepancy) ? 0x01 : 0x00; // search for 0 bit first
+        }
+
+        // read a bit and its complement, then set search direction
         uint8_t rom_bit = 0;
         uint8_t rom_bit_complement = 0;
-        ESP_RETURN_ON_ERROR(onewire_bus_read_bit(bus, &rom_bit), TAG, "read rom_bit error"); // write 1 bit to read from the bus
-        ESP_RETURN_ON_ERROR(onewire_bus_read_bit(bus, &rom_bit_complement), TAG, "read rom_bit_complement error"); // read a bit and its complement
+        uint8_t taken_direction = 0;
+        ESP_RETURN_ON_ERROR(onewire_bus_search_triplet(bus, search_direction, &rom_bit, &rom_bit_complement, &taken_direction),
+                            TAG, "search triplet error");
 
         // No devices participating in search.
         if (rom_bit && rom_bit_complement) {
@@ -81,29 +91,16 @@ esp_err_t onewire_device_iter_get_next(onewire_device_iter_handle_t iter, onewir
             return ESP_ERR_NOT_FOUND;
         }
 
-        uint8_t search_direction;
-        if (rom_bit != rom_bit_complement) { // There are only 0s or 1s in the bit of the participating ROM numbers.
-            search_direction = rom_bit;  // just go ahead
-        } else { // There are both 0s and 1s in the current bit position of the participating ROM numbers. This is a discrepancy.
-            if (rom_bit_index < iter->last_discrepancy) { // current id bit is before the last discrepancy bit
-                search_direction = (iter->rom_number[rom_byte_index] & rom_bit_mask) ? 0x01 : 0x00; // follow previous way
-            } else {
-                search_direction = (rom_bit_index == iter->last_discrepancy) ? 0x01 : 0x00; // search for 0 bit first
-            }
-
-            if (search_direction == 0) { // record zero's position in last zero
-                last_zero = rom_bit_index;
-            }
+        // There are both 0s and 1s in the current bit position of the participating ROM numbers. This is a discrepancy.
+        if (rom_bit == rom_bit_complement && taken_direction == 0) {
+            last_zero = rom_bit_index; // record zero's position in last zero
         }
 
-        if (search_direction == 1) { // set corresponding rom bit by search direction
+        if (taken_direction == 1) { // set corresponding rom bit by search direction
             iter->rom_number[rom_byte_index] |= rom_bit_mask;
         } else {
             iter->rom_number[rom_byte_index] &= ~rom_bit_mask;
         }
-
-        // set search direction
-        ESP_RETURN_ON_ERROR(onewire_bus_write_bit(bus, search_direction), TAG, "write direction bit error");
     }
 
     // if the search was successful
@@ -122,3 +119,35 @@ esp_err_t onewire_device_iter_get_next(onewire_device_iter_handle_t iter, onewir
 
     return ESP_OK;
 }
+
+esp_err_t onewire_device_search_all(onewire_bus_handle_t bus, onewire_device_address_t *addr_list, size_t max_devices, size_t *ret_num_devices)
+{
+    ESP_RETURN_ON_FALSE(bus && addr_list && max_devices && ret_num_devices, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    // the iterator is only needed for the duration of the search, so keep it on the stack
+    onewire_device_iter_t iter = {
+        .bus = bus,
+    };
+    onewire_device_t dev;
+    size_t num_devices = 0;
+    esp_err_t ret = ESP_OK;
+
+    while (num_devices < max_devices) {
+        ret = onewire_device_iter_get_next(&iter, &dev);
+        if (ret != ESP_OK) {
+            break;
+        }
+        addr_list[num_devices++] = dev.address;
+    }
+    *ret_num_devices = num_devices;
+
+    if (ret == ESP_ERR_NOT_FOUND) { // end of the search
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(ret, TAG, "device search failed");
+    if (!iter.is_last_device) {
+        ESP_LOGW(TAG, "more than %u devices on the bus", (unsigned int)max_devices);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,272 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "onewire_bus.h"
+#include "onewire_cmd.h"
+#include "onewire_crc.h"
+#include "onewire_scheduler.h"
+
+static const char *TAG = "1-wire.scheduler";
+
+#define ONEWIRE_SCHEDULER_DEFAULT_TASK_STACK_SIZE   4096
+
+// commands sent to the bus tasks through task notifications
+typedef enum {
+    ONEWIRE_SCHEDULER_CMD_CONVERT = 1,
+    ONEWIRE_SCHEDULER_CMD_READ,
+    ONEWIRE_SCHEDULER_CMD_EXIT,
+} onewire_scheduler_cmd_t;
+
+typedef struct onewire_scheduler_t onewire_scheduler_t;
+
+typedef struct {
+    onewire_scheduler_t *scheduler;
+    onewire_bus_handle_t bus;
+    TaskHandle_t task;
+    esp_err_t convert_result; // result of the last conversion start, the devices are not read if it failed
+} onewire_scheduler_bus_t;
+
+typedef struct {
+    onewire_device_address_t address;
+    uint8_t bus_index;
+} onewire_scheduler_device_t;
+
+struct onewire_scheduler_t {
+    onewire_scheduler_config_t config;
+    onewire_scheduler_bus_t buses[ONEWIRE_SCHEDULER_MAX_BUSES];
+    size_t num_buses;
+    onewire_scheduler_device_t *devices;
+    size_t num_devices;
+    size_t devices_capacity;
+    SemaphoreHandle_t mutex;    // serializes the API calls
+    SemaphoreHandle_t done_sem; // given by each bus task when it has executed a command
+    // output of the ongoing sampling, each bus task only writes the entries of its own devices
+    uint8_t *out_data;
+    esp_err_t *out_status;
+};
+
+static void onewire_scheduler_convert(onewire_scheduler_bus_t *sched_bus)
+{
+    const onewire_scheduler_config_t *config = &sched_bus->scheduler->config;
+
+    sched_bus->convert_result = onewire_bus_reset(sched_bus->bus);
+    if (sched_bus->convert_result != ESP_OK) {
+        return;
+    }
+    // all the devices of the bus start their conversion at once
+    sched_bus->convert_result = onewire_bus_write_bytes(sched_bus->bus, (uint8_t[]) {
+        ONEWIRE_CMD_SKIP_ROM, config->convert_cmd
+    }, 2);
+}
+
+static esp_err_t onewire_scheduler_read_device(onewire_scheduler_bus_t *sched_bus, onewire_device_address_t address, uint8_t *data)
+{
+    const onewire_scheduler_config_t *config = &sched_bus->scheduler->config;
+    uint8_t tx_buffer[1 + sizeof(onewire_device_address_t) + 1];
+
+    ESP_RETURN_ON_ERROR(onewire_bus_reset(sched_bus->bus), TAG, "reset bus failed");
+
+    // MATCH ROM, ROM code and function command are sent in a single write
+    tx_buffer[0] = ONEWIRE_CMD_MATCH_ROM;
+    memcpy(&tx_buffer[1], &address, sizeof(address));
+    tx_buffer[sizeof(tx_buffer) - 1] = config->read_cmd;
+    ESP_RETURN_ON_ERROR(onewire_bus_write_bytes(sched_bus->bus, tx_buffer, sizeof(tx_buffer)), TAG, "send read command failed");
+    ESP_RETURN_ON_ERROR(onewire_bus_read_bytes(sched_bus->bus, data, config->read_size), TAG, "read data failed");
+
+    if (onewire_crc8(0, data, config->read_size - 1) != data[config->read_size - 1]) {
+        ESP_LOGD(TAG, "bad data crc, device %016llX", address);
+        return ESP_ERR_INVALID_CRC;
+    }
+    return ESP_OK;
+}
+
+static void onewire_scheduler_read(onewire_scheduler_bus_t *sched_bus)
+{
+    onewire_scheduler_t *scheduler = sched_bus->scheduler;
+    uint8_t bus_index = sched_bus - scheduler->buses;
+
+    for (size_t i = 0; i < scheduler->num_devices; i++) {
+        if (scheduler->devices[i].bus_index != bus_index) {
+            continue;
+        }
+        uint8_t *data = &scheduler->out_data[i * scheduler->config.read_size];
+        if (sched_bus->convert_result != ESP_OK) {
+            memset(data, 0, scheduler->config.read_size);
+            scheduler->out_status[i] = sched_bus->convert_result;
+            continue;
+        }
+        scheduler->out_status[i] = onewire_scheduler_read_device(sched_bus, scheduler->devices[i].address, data);
+    }
+}
+
+static void onewire_scheduler_bus_task(void *arg)
+{
+    onewire_scheduler_bus_t *sched_bus = (onewire_scheduler_bus_t *)arg;
+    SemaphoreHandle_t done_sem = sched_bus->scheduler->done_sem;
+    uint32_t cmd = 0;
+
+    while (true) {
+        xTaskNotifyWait(0, UINT32_MAX, &cmd, portMAX_DELAY);
+        if (cmd == ONEWIRE_SCHEDULER_CMD_EXIT) {
+            break;
+        }
+        if (cmd == ONEWIRE_SCHEDULER_CMD_CONVERT) {
+            onewire_scheduler_convert(sched_bus);
+        } else if (cmd == ONEWIRE_SCHEDULER_CMD_READ) {
+            onewire_scheduler_read(sched_bus);
+        }
+        xSemaphoreGive(done_sem);
+    }
+
+    xSemaphoreGive(done_sem);
+    vTaskDelete(NULL);
+}
+
+// send a command to all the bus tasks, and wait for all of them to execute it
+static void onewire_scheduler_run(onewire_scheduler_t *scheduler, onewire_scheduler_cmd_t cmd)
+{
+    for (size_t i = 0; i < scheduler->num_buses; i++) {
+        xTaskNotify(scheduler->buses[i].task, cmd, eSetValueWithOverwrite);
+    }
+    for (size_t i = 0; i < scheduler->num_buses; i++) {
+        xSemaphoreTake(scheduler->done_sem, portMAX_DELAY);
+    }
+}
+
+static esp_err_t onewire_scheduler_destroy(onewire_scheduler_t *scheduler)
+{
+    // bus tasks are only created once the semaphores exist
+    onewire_scheduler_run(scheduler, ONEWIRE_SCHEDULER_CMD_EXIT);
+    if (scheduler->done_sem) {
+        vSemaphoreDelete(scheduler->done_sem);
+    }
+    if (scheduler->mutex) {
+        vSemaphoreDelete(scheduler->mutex);
+    }
+    free(scheduler->devices);
+    free(scheduler);
+    return ESP_OK;
+}
+
+esp_err_t onewire_new_scheduler(const onewire_scheduler_config_t *config, onewire_scheduler_handle_t *ret_scheduler)
+{
+    esp_err_t ret = ESP_OK;
+    onewire_scheduler_t *scheduler = NULL;
+    ESP_RETURN_ON_FALSE(config && ret_scheduler && config->read_size >= 2, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    scheduler = calloc(1, sizeof(onewire_scheduler_t));
+    ESP_RETURN_ON_FALSE(scheduler, ESP_ERR_NO_MEM, TAG, "no mem for scheduler");
+    scheduler->config = *config;
+    if (!scheduler->config.task_stack_size) {
+        scheduler->config.task_stack_size = ONEWIRE_SCHEDULER_DEFAULT_TASK_STACK_SIZE;
+    }
+    if (!scheduler->config.task_priority) {
+        scheduler->config.task_priority = uxTaskPriorityGet(NULL);
+    }
+
+    scheduler->mutex = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(scheduler->mutex, ESP_ERR_NO_MEM, err, TAG, "scheduler mutex creation failed");
+    scheduler->done_sem = xSemaphoreCreateCounting(ONEWIRE_SCHEDULER_MAX_BUSES, 0);
+    ESP_GOTO_ON_FALSE(scheduler->done_sem, ESP_ERR_NO_MEM, err, TAG, "scheduler semaphore creation failed");
+
+    *ret_scheduler = scheduler;
+    return ESP_OK;
+
+err:
+    onewire_scheduler_destroy(scheduler);
+    return ret;
+}
+
+esp_err_t onewire_del_scheduler(onewire_scheduler_handle_t scheduler)
+{
+    ESP_RETURN_ON_FALSE(scheduler, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return onewire_scheduler_destroy(scheduler);
+}
+
+static esp_err_t onewire_scheduler_get_bus_index(onewire_scheduler_t *scheduler, onewire_bus_handle_t bus, uint8_t *ret_index)
+{
+    for (size_t i = 0; i < scheduler->num_buses; i++) {
+        if (scheduler->buses[i].bus == bus) {
+            *ret_index = i;
+            return ESP_OK;
+        }
+    }
+
+    ESP_RETURN_ON_FALSE(scheduler->num_buses < ONEWIRE_SCHEDULER_MAX_BUSES, ESP_ERR_NOT_SUPPORTED, TAG, "too many buses");
+    onewire_scheduler_bus_t *sched_bus = &scheduler->buses[scheduler->num_buses];
+    sched_bus->scheduler = scheduler;
+    sched_bus->bus = bus;
+    ESP_RETURN_ON_FALSE(xTaskCreate(onewire_scheduler_bus_task, "onewire_sched", scheduler->config.task_stack_size, sched_bus,
+                                    scheduler->config.task_priority, &sched_bus->task) == pdPASS,
+                        ESP_ERR_NO_MEM, TAG, "bus task creation failed");
+    *ret_index = scheduler->num_buses++;
+    return ESP_OK;
+}
+
+esp_err_t onewire_scheduler_add_device(onewire_scheduler_handle_t scheduler, const onewire_device_t *device, size_t *ret_index)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(scheduler && device && device->bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    xSemaphoreTake(scheduler->mutex, portMAX_DELAY);
+
+    if (scheduler->num_devices == scheduler->devices_capacity) {
+        size_t new_capacity = scheduler->devices_capacity ? scheduler->devices_capacity * 2 : 8;
+        onewire_scheduler_device_t *devices = realloc(scheduler->devices, new_capacity * sizeof(onewire_scheduler_device_t));
+        ESP_GOTO_ON_FALSE(devices, ESP_ERR_NO_MEM, err, TAG, "no mem for device list");
+        scheduler->devices = devices;
+        scheduler->devices_capacity = new_capacity;
+    }
+
+    uint8_t bus_index = 0;
+    ESP_GOTO_ON_ERROR(onewire_scheduler_get_bus_index(scheduler, device->bus, &bus_index), err, TAG, "add bus failed");
+
+    scheduler->devices[scheduler->num_devices].address = device->address;
+    scheduler->devices[scheduler->num_devices].bus_index = bus_index;
+    if (ret_index) {
+        *ret_index = scheduler->num_devices;
+    }
+    scheduler->num_devices++;
+
+err:
+    xSemaphoreGive(scheduler->mutex);
+    return ret;
+}
+
+esp_err_t onewire_scheduler_sample(onewire_scheduler_handle_t scheduler, uint8_t *data, esp_err_t *status)
+{
+    ESP_RETURN_ON_FALSE(scheduler && data && status, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    xSemaphoreTake(scheduler->mutex, portMAX_DELAY);
+    scheduler->out_data = data;
+    scheduler->out_status = status;
+
+    // start the conversion on all the buses, then wait for it only once
+    onewire_scheduler_run(scheduler, ONEWIRE_SCHEDULER_CMD_CONVERT);
+    if (scheduler->config.convert_time_ms) {
+        // one more tick, as the current one is already partly elapsed
+        vTaskDelay(pdMS_TO_TICKS(scheduler->config.convert_time_ms) + 1);
+    }
+    onewire_scheduler_run(scheduler, ONEWIRE_SCHEDULER_CMD_READ);
+
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < scheduler->num_devices; i++) {
+        if (status[i] != ESP_OK) {
+            ret = ESP_FAIL;
+            break;
+        }
+    }
+    scheduler->out_data = NULL;
+    scheduler->out_status = NULL;
+    xSemaphoreGive(scheduler->mutex);
+    return ret;
+}
@@ -52,6 +52,18 @@ void app_main(void)
     ESP_ERROR_CHECK(onewire_del_device_iter(iter));
     ESP_LOGI(TAG, "Searching done, %d device(s) found", onewire_device_found);
 
+    // search again, all the devices at once
+    onewire_device_address_t addr_list[EXAMPLE_ONEWIRE_MAX_DEVICES];
+    size_t num_devices = 0;
+    search_result = onewire_device_search_all(bus, addr_list, EXAMPLE_ONEWIRE_MAX_DEVICES, &num_devices);
+    if (search_result != ESP_ERR_INVALID_SIZE) {
+        ESP_ERROR_CHECK(search_result);
+    }
+    for (size_t i = 0; i < num_devices; i++) {
+        ESP_LOGI(TAG, "Device %u, address: %016llX", (unsigned int)i, addr_list[i]);
+    }
+    ESP_LOGI(TAG, "Bulk searching done, %u device(s) found", (unsigned int)num_devices);
+
     // delete the bus
     ESP_LOGI(TAG, "Deleting bus...");
     ESP_ERROR_CHECK(onewire_bus_del(bus));
@@ -8,3 +8,4 @@ def test_onewire_bus(dut: Dut) -> None:
     dut.expect_exact('test-app: 1-Wire bus installed on GPIO')
     dut.expect_exact('test-app: Device iterator created, start searching')
     dut.expect_exact('test-app: Searching done')
+    dut.expect_exact('test-app: Bulk searching done')
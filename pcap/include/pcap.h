@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdio.h>
+#include <stdint.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -15,6 +16,8 @@ extern "C" {
 #define PCAP_DEFAULT_VERSION_MAJOR 0x02 /*!< Major Version */
 #define PCAP_DEFAULT_VERSION_MINOR 0x04 /*!< Minor Version */
 #define PCAP_DEFAULT_TIME_ZONE_GMT 0x00 /*!< Time Zone */
+#define PCAP_DEFAULT_SNAPLEN 0x40000      /*!< Default max length of each captured packet */
+#define PCAP_ASYNC_MIN_TASK_STACK_SIZE 2048 /*!< Min stack size of the writer task of the asynchronous capture, in bytes */
 
 /**
  * @brief Type of pcap file handle
@@ -54,11 +57,35 @@ typedef struct {
     unsigned int major_version; /*!< Pcap version: major */
     unsigned int minor_version; /*!< Pcap version: minor */
     unsigned int time_zone;     /*!< Pcap timezone code */
+    uint32_t snaplen;           /*!< Max bytes saved for each packet, longer packets are truncated. Set to 0 to use PCAP_DEFAULT_SNAPLEN */
     struct {
         unsigned int little_endian: 1; /*!< Whether the pcap file is recorded in little endian format */
     } flags;
 } pcap_config_t;
 
+/**
+* @brief Asynchronous capture configuration Type Definition
+*
+*/
+typedef struct {
+    size_t ring_buffer_size;    /*!< Size of the ring buffer that holds the pending packets, in bytes */
+    uint32_t flush_interval_ms; /*!< Max interval between two flushes of the File Stream, set to 0 to flush once the ring buffer is drained */
+    uint32_t task_priority;     /*!< Priority of the writer task */
+    uint32_t task_stack_size;   /*!< Stack size of the writer task, in bytes, at least PCAP_ASYNC_MIN_TASK_STACK_SIZE */
+    int task_core_id;           /*!< CPU core that the writer task is pinned to, set to tskNO_AFFINITY to not pin the task */
+} pcap_async_config_t;
+
+/**
+* @brief Pcap capture statistics Type Definition
+*
+*/
+typedef struct {
+    uint32_t captured_packets;  /*!< Number of packets written to the File Stream */
+    uint32_t dropped_packets;   /*!< Number of packets dropped because the ring buffer was full */
+    uint32_t truncated_packets; /*!< Number of packets truncated to the snaplen */
+    uint32_t write_errors;      /*!< Number of packets failed to be written to the File Stream */
+} pcap_capture_stats_t;
+
 /**
  * @brief Create a new pcap session, and returns pcap file handle
  *
@@ -112,6 +139,70 @@ esp_err_t pcap_write_header(pcap_file_handle_t pcap, pcap_link_type_t link_type)
  */
 esp_err_t pcap_capture_packet(pcap_file_handle_t pcap, void *payload, uint32_t length, uint32_t seconds, uint32_t microseconds);
 
+/**
+ * @brief Start the asynchronous capture mode
+ *
+ * @note A writer task is created to move the packets from a preallocated ring buffer to the File Stream in batches,
+ *       so `pcap_capture_packet_async()` can be called from the time critical context, e.g. the Wi-Fi promiscuous callback.
+ * @note The pcap file header should be written by `pcap_write_header()` before starting the asynchronous capture.
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @param[in] config asynchronous capture configuration
+ * @return
+ *      - ESP_OK: Start asynchronous capture successfully
+ *      - ESP_ERR_INVALID_ARG: Start asynchronous capture failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Start asynchronous capture failed because it's already started
+ *      - ESP_ERR_NO_MEM: Start asynchronous capture failed because out of memory
+ */
+esp_err_t pcap_start_async_capture(pcap_file_handle_t pcap, const pcap_async_config_t *config);
+
+/**
+ * @brief Stop the asynchronous capture mode
+ *
+ * @note No packet is accepted anymore once this function is called. It waits for the `pcap_capture_packet_async()`
+ *       calls in progress to complete, then the packets pending in the ring buffer are written and the File Stream
+ *       is flushed before this function returns.
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @return
+ *      - ESP_OK: Stop asynchronous capture successfully
+ *      - ESP_ERR_INVALID_ARG: Stop asynchronous capture failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Stop asynchronous capture failed because it's not started
+ */
+esp_err_t pcap_stop_async_capture(pcap_file_handle_t pcap);
+
+/**
+ * @brief Capture one packet into the ring buffer, without blocking
+ *
+ * @note The payload is copied (truncated to the snaplen), so the buffer can be reused once this function returns.
+ * @note This function can be called from several tasks at the same time, but not from an ISR.
+ * @note Packets arriving while `pcap_stop_async_capture()` is in progress are rejected without logging an error.
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @param[in] payload pointer of the captured data buffer
+ * @param[in] length length of captured data buffer
+ * @param[in] seconds second of capture time
+ * @param[in] microseconds microsecond of capture time
+ * @return
+ *      - ESP_OK: Queue network packet successfully
+ *      - ESP_ERR_INVALID_ARG: Queue network packet failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Queue network packet failed because the asynchronous capture is not started or is
+ *                               being stopped, or because it's called from an ISR
+ *      - ESP_ERR_NO_MEM: The packet is dropped because the ring buffer is full
+ */
+esp_err_t pcap_capture_packet_async(pcap_file_handle_t pcap, const void *payload, uint32_t length, uint32_t seconds, uint32_t microseconds);
+
+/**
+ * @brief Get the capture statistics
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @param[out] stats returned statistics
+ * @return
+ *      - ESP_OK: Get statistics successfully
+ *      - ESP_ERR_INVALID_ARG: Get statistics failed because of invalid argument
+ */
+esp_err_t pcap_get_capture_stats(pcap_file_handle_t pcap, pcap_capture_stats_t *stats);
+
 /**
  * @brief Print the summary of pcap file into stream
  *
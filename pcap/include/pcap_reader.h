@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "pcap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PCAP_READER_DEFAULT_MAX_PACKET_SIZE 2048 /*!< Default size of the reader's payload buffer */
+
+/**
+ * @brief Type of pcap reader handle
+ *
+ */
+typedef struct pcap_reader_t *pcap_reader_handle_t;
+
+/**
+* @brief Pcap reader configuration Type Definition
+*
+*/
+typedef struct {
+    FILE *fp;                 /*!< Pointer to a standard file handle, opened for reading */
+    uint32_t max_packet_size; /*!< Size of the payload buffer, longer packets are truncated. Set to 0 to use PCAP_READER_DEFAULT_MAX_PACKET_SIZE */
+} pcap_reader_config_t;
+
+/**
+* @brief Packet returned by the pcap reader Type Definition
+*
+*/
+typedef struct {
+    uint32_t interface_id;      /*!< Interface the packet is captured on, always 0 for the classic pcap format */
+    pcap_link_type_t link_type; /*!< Network link layer type of the interface */
+    uint64_t timestamp_ns;      /*!< Capture time, in nanoseconds since January 1st, 1970, 00:00:00 GMT */
+    uint32_t capture_length;    /*!< Number of bytes in the payload buffer */
+    uint32_t packet_length;     /*!< Actual length of the packet on the wire */
+    const uint8_t *payload;     /*!< Packet payload, only valid until the next call to `pcap_reader_next_packet()` */
+} pcap_reader_packet_t;
+
+/**
+ * @brief Create a reader that iterates the packets of a pcap or pcapng file
+ *
+ * @note The file format (classic pcap or pcapng) and the byte order are detected from the file header.
+ * @note The packets are read one by one from the File Stream, the file is never loaded into memory as a whole.
+ *
+ * @param[in] config reader configuration
+ * @param[out] ret_reader Returned reader handle
+ * @return
+ *      - ESP_OK: Create reader successfully
+ *      - ESP_ERR_INVALID_ARG: Create reader failed because of invalid argument
+ *      - ESP_ERR_INVALID_VERSION: Create reader failed because the file is neither a pcap nor a pcapng file
+ *      - ESP_ERR_NO_MEM: Create reader failed because out of memory
+ *      - ESP_FAIL: Create reader failed because reading the file header failed
+ */
+esp_err_t pcap_new_reader(const pcap_reader_config_t *config, pcap_reader_handle_t *ret_reader);
+
+/**
+ * @brief Read the next packet
+ *
+ * @param[in] reader reader handle created by `pcap_new_reader()`
+ * @param[out] packet Returned packet
+ * @return
+ *      - ESP_OK: Read packet successfully
+ *      - ESP_ERR_INVALID_ARG: Read packet failed because of invalid argument
+ *      - ESP_ERR_NOT_FOUND: There are no more packets in the file
+ *      - ESP_ERR_INVALID_SIZE: Read packet failed because the file is corrupted
+ *      - ESP_ERR_NOT_SUPPORTED: Read packet failed because the timestamp resolution of the interface is not supported
+ *      - ESP_ERR_NO_MEM: Read packet failed because out of memory for the interface list
+ */
+esp_err_t pcap_reader_next_packet(pcap_reader_handle_t reader, pcap_reader_packet_t *packet);
+
+/**
+ * @brief Delete the reader
+ *
+ * @note The File Stream is not closed, as it's owned by the caller.
+ *
+ * @param[in] reader reader handle created by `pcap_new_reader()`
+ * @return
+ *      - ESP_OK: Delete reader successfully
+ *      - ESP_ERR_INVALID_ARG: Delete reader failed because of invalid argument
+ */
+esp_err_t pcap_del_reader(pcap_reader_handle_t reader);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "pcap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Type of pcapng file handle
+ *
+ */
+typedef struct pcapng_file_t *pcapng_file_handle_t;
+
+/**
+* @brief Pcapng configuration Type Definition
+*
+*/
+typedef struct {
+    FILE *fp;                /*!< Pointer to a standard file handle */
+    const char *hardware;    /*!< Optional description of the capturing hardware, saved in the section header */
+    const char *os;          /*!< Optional name of the operating system, saved in the section header */
+    const char *application; /*!< Optional name of the capturing application, saved in the section header */
+} pcapng_config_t;
+
+/**
+* @brief Pcapng interface configuration Type Definition
+*
+*/
+typedef struct {
+    pcap_link_type_t link_type; /*!< Network link layer type of the packets captured on this interface */
+    uint32_t snaplen;           /*!< Max bytes saved for each packet, set to 0 to use PCAP_DEFAULT_SNAPLEN */
+    const char *name;           /*!< Optional interface name, e.g. "wlan0" */
+    const char *description;    /*!< Optional interface description */
+} pcapng_interface_config_t;
+
+/**
+* @brief Pcapng packet information Type Definition
+*
+*/
+typedef struct {
+    uint32_t interface_id; /*!< Interface the packet is captured on, returned by `pcapng_add_interface()` */
+    uint64_t timestamp_ns; /*!< Capture time, in nanoseconds since January 1st, 1970, 00:00:00 GMT */
+    const char *comment;   /*!< Optional comment attached to the packet, NULL if not used */
+    uint32_t drop_count;   /*!< Number of packets lost on this interface since the previous packet, saved only if non-zero */
+} pcapng_packet_info_t;
+
+/**
+ * @brief Create a new pcapng session, and write the Section Header Block
+ *
+ * @note This function won't create the low level FILE* object, the user should take care of the creation of the File Stream.
+ *
+ * @param[in] config pcapng file configuration
+ * @param[out] ret_pcapng Returned pcapng file handle
+ * @return
+ *      - ESP_OK: Create pcapng file successfully
+ *      - ESP_ERR_INVALID_ARG: Create pcapng file failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Create pcapng file failed because out of memory
+ *      - ESP_FAIL: Create pcapng file failed because writing the section header failed
+ */
+esp_err_t pcapng_new_session(const pcapng_config_t *config, pcapng_file_handle_t *ret_pcapng);
+
+/**
+ * @brief Delete the pcapng session, flush and close the File Stream
+ *
+ * @param[in] pcapng pcapng file handle created by `pcapng_new_session()`
+ * @return
+ *      - ESP_OK: Delete pcapng session successfully
+ *      - ESP_ERR_INVALID_ARG: Delete pcapng session failed because of invalid argument
+ */
+esp_err_t pcapng_del_session(pcapng_file_handle_t pcapng);
+
+/**
+ * @brief Add a capture interface, by writing an Interface Description Block
+ *
+ * @note The timestamps of the packets on all the interfaces are saved in nanosecond resolution.
+ *
+ * @param[in] pcapng pcapng file handle created by `pcapng_new_session()`
+ * @param[in] config interface configuration
+ * @param[out] ret_interface_id Returned interface ID, used by `pcapng_capture_packet()`
+ * @return
+ *      - ESP_OK: Add interface successfully
+ *      - ESP_ERR_INVALID_ARG: Add interface failed because of invalid argument
+ *      - ESP_FAIL: Add interface failed because writing the interface description failed
+ */
+esp_err_t pcapng_add_interface(pcapng_file_handle_t pcapng, const pcapng_interface_config_t *config, uint32_t *ret_interface_id);
+
+/**
+ * @brief Capture one packet into pcapng file, by writing an Enhanced Packet Block
+ *
+ * @note This function is thread safe, packets from different interfaces can be captured from different tasks.
+ * @note The File Stream is not flushed for every packet, call `pcapng_flush()` to do it explicitly.
+ *
+ * @param[in] pcapng pcapng file handle created by `pcapng_new_session()`
+ * @param[in] info packet information
+ * @param[in] payload pointer of the captured data buffer
+ * @param[in] length length of captured data buffer, truncated to the snaplen of the interface
+ * @return
+ *      - ESP_OK: Write network packet into pcapng file successfully
+ *      - ESP_ERR_INVALID_ARG: Write network packet into pcapng file failed because of invalid argument
+ *      - ESP_FAIL: Write network packet into pcapng file failed
+ */
+esp_err_t pcapng_capture_packet(pcapng_file_handle_t pcapng, const pcapng_packet_info_t *info, const void *payload, uint32_t length);
+
+/**
+ * @brief Flush the written blocks into the device
+ *
+ * @param[in] pcapng pcapng file handle created by `pcapng_new_session()`
+ * @return
+ *      - ESP_OK: Flush successfully
+ *      - ESP_ERR_INVALID_ARG: Flush failed because of invalid argument
+ *      - ESP_FAIL: Flush failed
+ */
+esp_err_t pcapng_flush(pcapng_file_handle_t pcapng);
+
+#ifdef __cplusplus
+}
+#endif
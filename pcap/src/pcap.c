@@ -10,39 +10,31 @@
 #include <inttypes.h>
 #include "esp_log.h"
 #include "esp_check.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/ringbuf.h"
 #include "pcap.h"
+#include "pcap_format.h"
 
 static const char *TAG = "pcap";
 
-#define PCAP_MAGIC_BIG_ENDIAN 0xA1B2C3D4    /*!< Big-Endian */
-#define PCAP_MAGIC_LITTLE_ENDIAN 0xD4C3B2A1 /*!< Little-Endian */
+#define PCAP_ASYNC_IDLE_WAIT_MS 100 /*!< Max time the writer task sleeps without checking the stop request */
 
 typedef struct pcap_file_t pcap_file_t;
 
 /**
- * @brief Pcap File Header
+ * @brief Pcap Asynchronous Capture Context
  *
  */
 typedef struct {
-    uint32_t magic;     /*!< Magic Number */
-    uint16_t major;     /*!< Major Version */
-    uint16_t minor;     /*!< Minor Version */
-    uint32_t zone;      /*!< Time Zone Offset */
-    uint32_t sigfigs;   /*!< Timestamp Accuracy */
-    uint32_t snaplen;   /*!< Max Length to Capture */
-    uint32_t link_type; /*!< Link Layer Type */
-} pcap_file_header_t;
-
-/**
- * @brief Pcap Packet Header
- *
- */
-typedef struct {
-    uint32_t seconds;        /*!< Number of seconds since January 1st, 1970, 00:00:00 GMT */
-    uint32_t microseconds;   /*!< Number of microseconds when the packet was captured (offset from seconds) */
-    uint32_t capture_length; /*!< Number of bytes of captured data, no longer than packet_length */
-    uint32_t packet_length;  /*!< Actual length of current packet */
-} pcap_packet_header_t;
+    RingbufHandle_t ring;          /*!< Ring buffer of the pending records, each record is a packet header followed by the payload */
+    TaskHandle_t writer_task;      /*!< Task that moves the records from the ring buffer to the File Stream */
+    TaskHandle_t stopper_task;     /*!< Task waiting for the writer task to exit */
+    TickType_t flush_interval;     /*!< Max interval between two flushes, 0 means flushing once the ring buffer is drained */
+    volatile bool stop_requested;  /*!< Set to ask the writer task to drain the ring buffer and exit */
+    bool stopping;                 /*!< Set once the capture is being stopped, no new producer is admitted. Protected by async_lock */
+    uint32_t producers;            /*!< Number of producers using the ring buffer. Protected by async_lock */
+} pcap_async_t;
 
 /**
  * @brief Pcap Runtime Handle
@@ -55,6 +47,11 @@ struct pcap_file_t {
     unsigned int minor_version; /*!< Pcap version: minor */
     unsigned int time_zone;     /*!< Pcap timezone code */
     uint32_t endian_magic;      /*!< Magic value related to endian format */
+    uint32_t snaplen;           /*!< Max bytes saved for each packet */
+    pcap_async_t *async;        /*!< Asynchronous capture context, NULL if not started */
+    pcap_capture_stats_t stats; /*!< Capture statistics */
+    portMUX_TYPE stats_lock;    /*!< Spinlock protecting the statistics, which are updated by multiple producers */
+    portMUX_TYPE async_lock;    /*!< Spinlock protecting the asynchronous capture context against the producers */
 };
 
 esp_err_t pcap_new_session(const pcap_config_t *config, pcap_file_handle_t *ret_pcap)
@@ -70,6 +67,9 @@ esp_err_t pcap_new_session(const pcap_config_t *config, pcap_file_handle_t *ret_
     pcap->minor_version = config->minor_version;
     pcap->endian_magic = config->flags.little_endian ? PCAP_MAGIC_LITTLE_ENDIAN : PCAP_MAGIC_BIG_ENDIAN;
     pcap->time_zone = config->time_zone;
+    pcap->snaplen = config->snaplen ? config->snaplen : PCAP_DEFAULT_SNAPLEN;
+    portMUX_INITIALIZE(&pcap->stats_lock);
+    portMUX_INITIALIZE(&pcap->async_lock);
     *ret_pcap = pcap;
     return ret;
 err:
@@ -82,6 +82,9 @@ err:
 esp_err_t pcap_del_session(pcap_file_handle_t pcap)
 {
     ESP_RETURN_ON_FALSE(pcap, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (pcap->async) {
+        ESP_RETURN_ON_ERROR(pcap_stop_async_capture(pcap), TAG, "stop async capture failed");
+    }
     if (pcap->file) {
         fclose(pcap->file);
         pcap->file = NULL;
@@ -100,7 +103,7 @@ esp_err_t pcap_write_header(pcap_file_handle_t pcap, pcap_link_type_t link_type)
         .minor = pcap->minor_version,
         .zone = pcap->time_zone,
         .sigfigs = 0,
-        .snaplen = 0x40000,
+        .snaplen = pcap->snaplen,
         .link_type = link_type,
     };
     size_t real_write = fwrite(&header, sizeof(header), 1, pcap->file);
@@ -115,19 +118,185 @@ esp_err_t pcap_write_header(pcap_file_handle_t pcap, pcap_link_type_t link_type)
 esp_err_t pcap_capture_packet(pcap_file_handle_t pcap, void *payload, uint32_t length, uint32_t seconds, uint32_t microseconds)
 {
     ESP_RETURN_ON_FALSE(pcap && payload, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!pcap->async, ESP_ERR_INVALID_STATE, TAG, "async capture in progress, use pcap_capture_packet_async");
     size_t real_write = 0;
+    uint32_t capture_length = length > pcap->snaplen ? pcap->snaplen : length;
     pcap_packet_header_t header = {
         .seconds = seconds,
         .microseconds = microseconds,
-        .capture_length = length,
+        .capture_length = capture_length,
         .packet_length = length
     };
     real_write = fwrite(&header, sizeof(header), 1, pcap->file);
     ESP_RETURN_ON_FALSE(real_write == 1, ESP_FAIL, TAG, "write packet header failed");
-    real_write = fwrite(payload, sizeof(uint8_t), length, pcap->file);
-    ESP_RETURN_ON_FALSE(real_write == length, ESP_FAIL, TAG, "write packet payload failed");
+    real_write = fwrite(payload, sizeof(uint8_t), capture_length, pcap->file);
+    ESP_RETURN_ON_FALSE(real_write == capture_length, ESP_FAIL, TAG, "write packet payload failed");
     /* Flush content in the buffer into device */
     fflush(pcap->file);
+    portENTER_CRITICAL(&pcap->stats_lock);
+    pcap->stats.captured_packets++;
+    if (capture_length < length) {
+        pcap->stats.truncated_packets++;
+    }
+    portEXIT_CRITICAL(&pcap->stats_lock);
+    return ESP_OK;
+}
+
+static void pcap_async_writer_task(void *arg)
+{
+    pcap_file_t *pcap = (pcap_file_t *)arg;
+    pcap_async_t *async = pcap->async;
+    TickType_t idle_wait = async->flush_interval ? async->flush_interval : pdMS_TO_TICKS(PCAP_ASYNC_IDLE_WAIT_MS);
+    TickType_t last_flush = xTaskGetTickCount();
+    bool dirty = false;
+    size_t record_size = 0;
+
+    while (1) {
+        // without a flush interval, don't sleep while there's unflushed data, flush as soon as the ring buffer is drained
+        TickType_t wait_ticks = (dirty && !async->flush_interval) ? 0 : idle_wait;
+        uint8_t *record = xRingbufferReceive(async->ring, &record_size, wait_ticks);
+        if (record) {
+            // the record is the packet header and payload laid out contiguously, write them in one go
+            size_t real_write = fwrite(record, 1, record_size, pcap->file);
+            vRingbufferReturnItem(async->ring, record);
+            portENTER_CRITICAL(&pcap->stats_lock);
+            if (real_write == record_size) {
+                pcap->stats.captured_packets++;
+            } else {
+                pcap->stats.write_errors++;
+            }
+            portEXIT_CRITICAL(&pcap->stats_lock);
+            dirty = true;
+        }
+        TickType_t now = xTaskGetTickCount();
+        if (dirty && (!record || (async->flush_interval && now - last_flush >= async->flush_interval))) {
+            fflush(pcap->file);
+            dirty = false;
+            last_flush = now;
+        }
+        if (!record && async->stop_requested) {
+            break;
+        }
+    }
+    xTaskNotifyGive(async->stopper_task);
+    vTaskDelete(NULL);
+}
+
+esp_err_t pcap_start_async_capture(pcap_file_handle_t pcap, const pcap_async_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    pcap_async_t *async = NULL;
+    ESP_RETURN_ON_FALSE(pcap && config && config->ring_buffer_size, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->task_stack_size >= PCAP_ASYNC_MIN_TASK_STACK_SIZE, ESP_ERR_INVALID_ARG, TAG,
+                        "task stack size must be at least %d bytes", PCAP_ASYNC_MIN_TASK_STACK_SIZE);
+    ESP_RETURN_ON_FALSE(!pcap->async, ESP_ERR_INVALID_STATE, TAG, "async capture already started");
+    async = calloc(1, sizeof(pcap_async_t));
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_NO_MEM, TAG, "no mem for async capture context");
+    // use the no-split ring buffer, so that each record can be written to the File Stream directly
+    async->ring = xRingbufferCreate(config->ring_buffer_size, RINGBUF_TYPE_NOSPLIT);
+    ESP_GOTO_ON_FALSE(async->ring, ESP_ERR_NO_MEM, err, TAG, "no mem for ring buffer");
+    async->flush_interval = pdMS_TO_TICKS(config->flush_interval_ms);
+    // the writer task gets the context from the pcap handle, the producers are only admitted once it's created
+    async->stopping = true;
+    pcap->async = async;
+    BaseType_t res = xTaskCreatePinnedToCore(pcap_async_writer_task, "pcap_writer", config->task_stack_size, pcap,
+                                             config->task_priority, &async->writer_task, config->task_core_id);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "create writer task failed");
+    portENTER_CRITICAL(&pcap->async_lock);
+    async->stopping = false;
+    portEXIT_CRITICAL(&pcap->async_lock);
+    return ESP_OK;
+err:
+    pcap->async = NULL;
+    if (async->ring) {
+        vRingbufferDelete(async->ring);
+    }
+    free(async);
+    return ret;
+}
+
+esp_err_t pcap_stop_async_capture(pcap_file_handle_t pcap)
+{
+    ESP_RETURN_ON_FALSE(pcap, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    pcap_async_t *async = pcap->async;
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_INVALID_STATE, TAG, "async capture not started");
+    // stop admitting producers, and wait for the ones already using the ring buffer to complete
+    portENTER_CRITICAL(&pcap->async_lock);
+    async->stopping = true;
+    while (async->producers) {
+        portEXIT_CRITICAL(&pcap->async_lock);
+        vTaskDelay(1);
+        portENTER_CRITICAL(&pcap->async_lock);
+    }
+    portEXIT_CRITICAL(&pcap->async_lock);
+    async->stopper_task = xTaskGetCurrentTaskHandle();
+    async->stop_requested = true;
+    // the writer task drains the ring buffer and flushes the File Stream before exiting
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    portENTER_CRITICAL(&pcap->async_lock);
+    pcap->async = NULL;
+    portEXIT_CRITICAL(&pcap->async_lock);
+    vRingbufferDelete(async->ring);
+    free(async);
+    return ESP_OK;
+}
+
+esp_err_t pcap_capture_packet_async(pcap_file_handle_t pcap, const void *payload, uint32_t length, uint32_t seconds, uint32_t microseconds)
+{
+    // the ring buffer can't be written from an ISR, xRingbufferSendAcquire() has no ISR version
+    ESP_RETURN_ON_FALSE_ISR(!xPortInIsrContext(), ESP_ERR_INVALID_STATE, TAG, "not allowed in ISR context");
+    ESP_RETURN_ON_FALSE(pcap && payload, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    // register as a producer, so that the context isn't freed while the ring buffer is in use
+    portENTER_CRITICAL(&pcap->async_lock);
+    pcap_async_t *async = pcap->async;
+    bool stopping = async && async->stopping;
+    if (async && !stopping) {
+        async->producers++;
+    } else {
+        async = NULL;
+    }
+    portEXIT_CRITICAL(&pcap->async_lock);
+    if (stopping) {
+        // the producers still running while the capture stops are expected, reject their packets silently
+        return ESP_ERR_INVALID_STATE;
+    }
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_INVALID_STATE, TAG, "async capture not started");
+    esp_err_t ret = ESP_OK;
+    uint32_t capture_length = length > pcap->snaplen ? pcap->snaplen : length;
+    void *record = NULL;
+    // never block the producer, count the packet as dropped if there's no room
+    if (xRingbufferSendAcquire(async->ring, &record, sizeof(pcap_packet_header_t) + capture_length, 0) != pdTRUE) {
+        portENTER_CRITICAL(&pcap->stats_lock);
+        pcap->stats.dropped_packets++;
+        portEXIT_CRITICAL(&pcap->stats_lock);
+        ret = ESP_ERR_NO_MEM;
+        goto out;
+    }
+    pcap_packet_header_t *header = (pcap_packet_header_t *)record;
+    header->seconds = seconds;
+    header->microseconds = microseconds;
+    header->capture_length = capture_length;
+    header->packet_length = length;
+    memcpy(header + 1, payload, capture_length);
+    xRingbufferSendComplete(async->ring, record);
+    if (capture_length < length) {
+        portENTER_CRITICAL(&pcap->stats_lock);
+        pcap->stats.truncated_packets++;
+        portEXIT_CRITICAL(&pcap->stats_lock);
+    }
+out:
+    portENTER_CRITICAL(&pcap->async_lock);
+    async->producers--;
+    portEXIT_CRITICAL(&pcap->async_lock);
+    return ret;
+}
+
+esp_err_t pcap_get_capture_stats(pcap_file_handle_t pcap, pcap_capture_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(pcap && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    portENTER_CRITICAL(&pcap->stats_lock);
+    *stats = pcap->stats;
+    portEXIT_CRITICAL(&pcap->stats_lock);
     return ESP_OK;
 }
 
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PCAP_MAGIC_BIG_ENDIAN 0xA1B2C3D4    /*!< Big-Endian */
+#define PCAP_MAGIC_LITTLE_ENDIAN 0xD4C3B2A1 /*!< Little-Endian */
+
+#define PCAP_MAGIC_NANO_BIG_ENDIAN 0xA1B23C4D    /*!< Big-Endian, nanosecond timestamp */
+#define PCAP_MAGIC_NANO_LITTLE_ENDIAN 0x4D3CB2A1 /*!< Little-Endian, nanosecond timestamp */
+
+/**
+ * @brief Pcap File Header
+ *
+ */
+typedef struct {
+    uint32_t magic;     /*!< Magic Number */
+    uint16_t major;     /*!< Major Version */
+    uint16_t minor;     /*!< Minor Version */
+    uint32_t zone;      /*!< Time Zone Offset */
+    uint32_t sigfigs;   /*!< Timestamp Accuracy */
+    uint32_t snaplen;   /*!< Max Length to Capture */
+    uint32_t link_type; /*!< Link Layer Type */
+} pcap_file_header_t;
+
+/**
+ * @brief Pcap Packet Header
+ *
+ */
+typedef struct {
+    uint32_t seconds;        /*!< Number of seconds since January 1st, 1970, 00:00:00 GMT */
+    uint32_t microseconds;   /*!< Number of microseconds when the packet was captured (offset from seconds) */
+    uint32_t capture_length; /*!< Number of bytes of captured data, no longer than packet_length */
+    uint32_t packet_length;  /*!< Actual length of current packet */
+} pcap_packet_header_t;
+
+#define PCAPNG_BLOCK_TYPE_SHB 0x0A0D0D0A /*!< Section Header Block */
+#define PCAPNG_BLOCK_TYPE_IDB 0x00000001 /*!< Interface Description Block */
+#define PCAPNG_BLOCK_TYPE_SPB 0x00000003 /*!< Simple Packet Block */
+#define PCAPNG_BLOCK_TYPE_EPB 0x00000006 /*!< Enhanced Packet Block */
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D  /*!< Byte order magic of the Section Header Block */
+
+#define PCAPNG_OPT_ENDOFOPT 0    /*!< End of options */
+#define PCAPNG_OPT_COMMENT 1     /*!< Comment, UTF-8 string */
+#define PCAPNG_OPT_SHB_HARDWARE 2 /*!< Section Header Block: hardware description */
+#define PCAPNG_OPT_SHB_OS 3       /*!< Section Header Block: operating system */
+#define PCAPNG_OPT_SHB_USERAPPL 4 /*!< Section Header Block: application that created the file */
+#define PCAPNG_OPT_IF_NAME 2      /*!< Interface Description Block: interface name */
+#define PCAPNG_OPT_IF_DESCRIPTION 3 /*!< Interface Description Block: interface description */
+#define PCAPNG_OPT_IF_TSRESOL 9   /*!< Interface Description Block: timestamp resolution */
+#define PCAPNG_OPT_EPB_DROPCOUNT 4 /*!< Enhanced Packet Block: packets lost between this packet and the preceding one */
+
+/**
+ * @brief Pcapng Generic Block Header
+ *
+ */
+typedef struct {
+    uint32_t block_type;         /*!< Block Type */
+    uint32_t block_total_length; /*!< Block Total Length, including the header and the trailing length field */
+} pcapng_block_header_t;
+
+/**
+ * @brief Pcapng Section Header Block Body
+ *
+ */
+typedef struct {
+    uint32_t byte_order_magic; /*!< Byte-Order Magic */
+    uint16_t major;            /*!< Major Version */
+    uint16_t minor;            /*!< Minor Version */
+    int64_t section_length;    /*!< Section Length, -1 if not specified */
+} __attribute__((packed)) pcapng_section_header_t;
+
+/**
+ * @brief Pcapng Interface Description Block Body
+ *
+ */
+typedef struct {
+    uint16_t link_type; /*!< Link Layer Type */
+    uint16_t reserved;  /*!< Reserved */
+    uint32_t snaplen;   /*!< Max Length to Capture */
+} pcapng_interface_description_t;
+
+/**
+ * @brief Pcapng Enhanced Packet Block Body
+ *
+ */
+typedef struct {
+    uint32_t interface_id;   /*!< Interface ID, the order of the Interface Description Block in the section */
+    uint32_t timestamp_high; /*!< Upper 32 bits of the timestamp */
+    uint32_t timestamp_low;  /*!< Lower 32 bits of the timestamp */
+    uint32_t capture_length; /*!< Number of bytes of captured data */
+    uint32_t packet_length;  /*!< Actual length of current packet */
+} pcapng_enhanced_packet_t;
+
+/**
+ * @brief Pcapng Option Header
+ *
+ */
+typedef struct {
+    uint16_t code;   /*!< Option Code */
+    uint16_t length; /*!< Option Value Length, without padding */
+} pcapng_option_header_t;
+
+/**
+ * @brief Round up the length to the 32-bit boundary, as required by the pcapng blocks and options
+ */
+#define PCAPNG_PAD32(len) (((len) + 3) & ~3U)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,325 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "pcap_reader.h"
+#include "pcap_format.h"
+
+static const char *TAG = "pcap_reader";
+
+#define PCAP_NSEC_PER_SEC 1000000000ULL
+#define PCAP_TSRESOL_MAX_POW2 63 /*!< Max exponent of a negative power of 2 timestamp resolution */
+
+typedef struct pcap_reader_t pcap_reader_t;
+
+/**
+ * @brief Pcapng Interface Information, collected from the Interface Description Blocks
+ *
+ */
+typedef struct {
+    pcap_link_type_t link_type; /*!< Link Layer Type */
+    uint32_t snaplen;           /*!< Max Length to Capture */
+    uint8_t tsresol;            /*!< Timestamp resolution, as encoded in the if_tsresol option */
+} pcap_reader_interface_t;
+
+/**
+ * @brief Pcap Reader Runtime Handle
+ *
+ */
+struct pcap_reader_t {
+    FILE *file;                          /*!< File handle */
+    bool is_pcapng;                      /*!< Whether the file is in pcapng format */
+    bool swapped;                        /*!< Whether the file is recorded in the opposite byte order of the host */
+    bool nano;                           /*!< Classic pcap only: whether the timestamps are in nanoseconds */
+    pcap_link_type_t link_type;          /*!< Classic pcap only: link layer type of the file */
+    pcap_reader_interface_t *interfaces; /*!< Pcapng only: interfaces of the current section */
+    uint32_t num_interfaces;             /*!< Pcapng only: number of interfaces in the current section */
+    uint32_t max_packet_size;            /*!< Size of the payload buffer */
+    uint8_t *payload;                    /*!< Payload buffer */
+};
+
+static inline uint16_t pcap_reader_u16(const pcap_reader_t *reader, uint16_t value)
+{
+    return reader->swapped ? __builtin_bswap16(value) : value;
+}
+
+static inline uint32_t pcap_reader_u32(const pcap_reader_t *reader, uint32_t value)
+{
+    return reader->swapped ? __builtin_bswap32(value) : value;
+}
+
+static bool pcap_reader_read(pcap_reader_t *reader, void *buf, size_t size)
+{
+    return fread(buf, 1, size, reader->file) == size;
+}
+
+static bool pcap_reader_skip(pcap_reader_t *reader, size_t size)
+{
+    return size == 0 || fseek(reader->file, size, SEEK_CUR) == 0;
+}
+
+/* Read the payload into the buffer, the part that doesn't fit in the buffer is skipped */
+static bool pcap_reader_read_payload(pcap_reader_t *reader, uint32_t length, uint32_t *ret_saved)
+{
+    uint32_t saved = length > reader->max_packet_size ? reader->max_packet_size : length;
+    *ret_saved = saved;
+    return pcap_reader_read(reader, reader->payload, saved) && pcap_reader_skip(reader, length - saved);
+}
+
+/* Convert a pcapng timestamp to nanoseconds, according to the if_tsresol option of the interface */
+static uint64_t pcap_reader_timestamp_to_ns(uint64_t timestamp, uint8_t tsresol)
+{
+    uint8_t exponent = tsresol & 0x7F;
+    if (tsresol & 0x80) {
+        // negative power of 2, split the timestamp to avoid overflow
+        uint64_t seconds = timestamp >> exponent;
+        uint64_t fraction = timestamp & ((1ULL << exponent) - 1);
+        // keep at most 32 bits of fraction, so that the multiplication doesn't overflow
+        if (exponent > 32) {
+            fraction >>= exponent - 32;
+            exponent = 32;
+        }
+        return seconds * PCAP_NSEC_PER_SEC + ((fraction * PCAP_NSEC_PER_SEC) >> exponent);
+    }
+    // negative power of 10
+    while (exponent < 9) {
+        timestamp *= 10;
+        exponent++;
+    }
+    while (exponent > 9) {
+        timestamp /= 10;
+        exponent--;
+    }
+    return timestamp;
+}
+
+static esp_err_t pcap_reader_parse_section(pcap_reader_t *reader, uint32_t raw_total_length)
+{
+    pcapng_section_header_t section;
+    ESP_RETURN_ON_FALSE(pcap_reader_read(reader, &section, sizeof(section)), ESP_ERR_INVALID_SIZE, TAG, "read section header failed");
+    if (section.byte_order_magic == PCAPNG_BYTE_ORDER_MAGIC) {
+        reader->swapped = false;
+    } else if (section.byte_order_magic == __builtin_bswap32(PCAPNG_BYTE_ORDER_MAGIC)) {
+        reader->swapped = true;
+    } else {
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_VERSION, TAG, "invalid byte order magic");
+    }
+    uint32_t total_length = pcap_reader_u32(reader, raw_total_length);
+    uint32_t header_size = sizeof(pcapng_block_header_t) + sizeof(pcapng_section_header_t);
+    ESP_RETURN_ON_FALSE(total_length >= header_size + sizeof(uint32_t), ESP_ERR_INVALID_SIZE, TAG, "invalid section length");
+    // interfaces are numbered per section
+    reader->num_interfaces = 0;
+    ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, total_length - header_size), ESP_ERR_INVALID_SIZE, TAG, "skip section options failed");
+    return ESP_OK;
+}
+
+static esp_err_t pcap_reader_parse_interface(pcap_reader_t *reader, uint32_t body_length)
+{
+    pcapng_interface_description_t description;
+    ESP_RETURN_ON_FALSE(body_length >= sizeof(description) && pcap_reader_read(reader, &description, sizeof(description)),
+                        ESP_ERR_INVALID_SIZE, TAG, "read interface description failed");
+    pcap_reader_interface_t *interfaces = realloc(reader->interfaces, (reader->num_interfaces + 1) * sizeof(pcap_reader_interface_t));
+    ESP_RETURN_ON_FALSE(interfaces, ESP_ERR_NO_MEM, TAG, "no mem for interface list");
+    reader->interfaces = interfaces;
+    pcap_reader_interface_t *interface = &interfaces[reader->num_interfaces++];
+    interface->link_type = pcap_reader_u16(reader, description.link_type);
+    interface->snaplen = pcap_reader_u32(reader, description.snaplen);
+    interface->tsresol = 6; // microseconds, if the if_tsresol option is absent
+
+    // walk through the options, only the timestamp resolution matters
+    uint32_t remain = body_length - sizeof(description);
+    while (remain >= sizeof(pcapng_option_header_t)) {
+        pcapng_option_header_t option;
+        ESP_RETURN_ON_FALSE(pcap_reader_read(reader, &option, sizeof(option)), ESP_ERR_INVALID_SIZE, TAG, "read option failed");
+        remain -= sizeof(option);
+        uint16_t code = pcap_reader_u16(reader, option.code);
+        uint32_t value_size = PCAPNG_PAD32(pcap_reader_u16(reader, option.length));
+        if (code == PCAPNG_OPT_ENDOFOPT) {
+            break;
+        }
+        ESP_RETURN_ON_FALSE(value_size <= remain, ESP_ERR_INVALID_SIZE, TAG, "invalid option length");
+        if (code == PCAPNG_OPT_IF_TSRESOL && value_size > 0) {
+            ESP_RETURN_ON_FALSE(pcap_reader_read(reader, &interface->tsresol, 1), ESP_ERR_INVALID_SIZE, TAG, "read option failed");
+            ESP_RETURN_ON_FALSE(!(interface->tsresol & 0x80) || (interface->tsresol & 0x7F) <= PCAP_TSRESOL_MAX_POW2,
+                                ESP_ERR_NOT_SUPPORTED, TAG, "unsupported timestamp resolution: 0x%x", interface->tsresol);
+            ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, value_size - 1), ESP_ERR_INVALID_SIZE, TAG, "skip option failed");
+        } else {
+            ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, value_size), ESP_ERR_INVALID_SIZE, TAG, "skip option failed");
+        }
+        remain -= value_size;
+    }
+    ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, remain), ESP_ERR_INVALID_SIZE, TAG, "skip interface options failed");
+    return ESP_OK;
+}
+
+static esp_err_t pcap_reader_next_pcapng(pcap_reader_t *reader, pcap_reader_packet_t *packet)
+{
+    while (1) {
+        pcapng_block_header_t block;
+        if (!pcap_reader_read(reader, &block, sizeof(block))) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        if (block.block_type == PCAPNG_BLOCK_TYPE_SHB) {
+            // the section header block type is a palindrome, the byte order is determined after parsing it
+            ESP_RETURN_ON_ERROR(pcap_reader_parse_section(reader, block.block_total_length), TAG, "parse section header failed");
+            continue;
+        }
+        uint32_t block_type = pcap_reader_u32(reader, block.block_type);
+        uint32_t total_length = pcap_reader_u32(reader, block.block_total_length);
+        ESP_RETURN_ON_FALSE(total_length >= sizeof(block) + sizeof(uint32_t) && (total_length & 0x03) == 0,
+                            ESP_ERR_INVALID_SIZE, TAG, "invalid block length");
+        // block body, excluding the header and the trailing length
+        uint32_t body_length = total_length - sizeof(block) - sizeof(uint32_t);
+
+        if (block_type == PCAPNG_BLOCK_TYPE_IDB) {
+            ESP_RETURN_ON_ERROR(pcap_reader_parse_interface(reader, body_length), TAG, "parse interface description failed");
+            ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, sizeof(uint32_t)), ESP_ERR_INVALID_SIZE, TAG, "skip block failed");
+        } else if (block_type == PCAPNG_BLOCK_TYPE_EPB) {
+            pcapng_enhanced_packet_t epb;
+            ESP_RETURN_ON_FALSE(body_length >= sizeof(epb) && pcap_reader_read(reader, &epb, sizeof(epb)),
+                                ESP_ERR_INVALID_SIZE, TAG, "read enhanced packet block failed");
+            uint32_t interface_id = pcap_reader_u32(reader, epb.interface_id);
+            uint32_t capture_length = pcap_reader_u32(reader, epb.capture_length);
+            ESP_RETURN_ON_FALSE(interface_id < reader->num_interfaces, ESP_ERR_INVALID_SIZE, TAG, "unknown interface %"PRIu32, interface_id);
+            // check the length before padding it, the padding of a huge length wraps around
+            ESP_RETURN_ON_FALSE(capture_length <= body_length - sizeof(epb) && PCAPNG_PAD32(capture_length) <= body_length - sizeof(epb),
+                                ESP_ERR_INVALID_SIZE, TAG, "invalid capture length");
+            const pcap_reader_interface_t *interface = &reader->interfaces[interface_id];
+            uint64_t timestamp = ((uint64_t)pcap_reader_u32(reader, epb.timestamp_high) << 32) | pcap_reader_u32(reader, epb.timestamp_low);
+            ESP_RETURN_ON_FALSE(pcap_reader_read_payload(reader, capture_length, &packet->capture_length),
+                                ESP_ERR_INVALID_SIZE, TAG, "read packet payload failed");
+            // skip the padding, the options and the trailing length
+            ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, body_length - sizeof(epb) - capture_length + sizeof(uint32_t)),
+                                ESP_ERR_INVALID_SIZE, TAG, "skip block failed");
+            packet->interface_id = interface_id;
+            packet->link_type = interface->link_type;
+            packet->timestamp_ns = pcap_reader_timestamp_to_ns(timestamp, interface->tsresol);
+            packet->packet_length = pcap_reader_u32(reader, epb.packet_length);
+            packet->payload = reader->payload;
+            return ESP_OK;
+        } else if (block_type == PCAPNG_BLOCK_TYPE_SPB) {
+            uint32_t packet_length = 0;
+            ESP_RETURN_ON_FALSE(body_length >= sizeof(packet_length) && pcap_reader_read(reader, &packet_length, sizeof(packet_length)),
+                                ESP_ERR_INVALID_SIZE, TAG, "read simple packet block failed");
+            ESP_RETURN_ON_FALSE(reader->num_interfaces > 0, ESP_ERR_INVALID_SIZE, TAG, "simple packet block without interface");
+            packet_length = pcap_reader_u32(reader, packet_length);
+            // the captured length of the simple packet block is implied by the block length
+            uint32_t capture_length = body_length - sizeof(packet_length);
+            if (capture_length > packet_length) {
+                capture_length = packet_length;
+            }
+            ESP_RETURN_ON_FALSE(pcap_reader_read_payload(reader, capture_length, &packet->capture_length),
+                                ESP_ERR_INVALID_SIZE, TAG, "read packet payload failed");
+            ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, body_length - sizeof(packet_length) - capture_length + sizeof(uint32_t)),
+                                ESP_ERR_INVALID_SIZE, TAG, "skip block failed");
+            packet->interface_id = 0;
+            packet->link_type = reader->interfaces[0].link_type;
+            packet->timestamp_ns = 0; // simple packet block carries no timestamp
+            packet->packet_length = packet_length;
+            packet->payload = reader->payload;
+            return ESP_OK;
+        } else {
+            // blocks that don't carry packets (statistics, name resolution, custom blocks...)
+            ESP_RETURN_ON_FALSE(pcap_reader_skip(reader, body_length + sizeof(uint32_t)), ESP_ERR_INVALID_SIZE, TAG, "skip block failed");
+        }
+    }
+}
+
+static esp_err_t pcap_reader_next_pcap(pcap_reader_t *reader, pcap_reader_packet_t *packet)
+{
+    pcap_packet_header_t header;
+    if (!pcap_reader_read(reader, &header, sizeof(header))) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    uint32_t seconds = pcap_reader_u32(reader, header.seconds);
+    uint32_t fraction = pcap_reader_u32(reader, header.microseconds);
+    uint32_t capture_length = pcap_reader_u32(reader, header.capture_length);
+    ESP_RETURN_ON_FALSE(pcap_reader_read_payload(reader, capture_length, &packet->capture_length),
+                        ESP_ERR_INVALID_SIZE, TAG, "read packet payload failed");
+    packet->interface_id = 0;
+    packet->link_type = reader->link_type;
+    packet->timestamp_ns = seconds * PCAP_NSEC_PER_SEC + (reader->nano ? fraction : fraction * 1000ULL);
+    packet->packet_length = pcap_reader_u32(reader, header.packet_length);
+    packet->payload = reader->payload;
+    return ESP_OK;
+}
+
+esp_err_t pcap_new_reader(const pcap_reader_config_t *config, pcap_reader_handle_t *ret_reader)
+{
+    esp_err_t ret = ESP_OK;
+    pcap_reader_t *reader = NULL;
+    ESP_GOTO_ON_FALSE(config && ret_reader, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(config->fp, ESP_ERR_INVALID_ARG, err, TAG, "pcap file handle can't be NULL");
+    reader = calloc(1, sizeof(pcap_reader_t));
+    ESP_GOTO_ON_FALSE(reader, ESP_ERR_NO_MEM, err, TAG, "no mem for pcap reader object");
+    reader->file = config->fp;
+    reader->max_packet_size = config->max_packet_size ? config->max_packet_size : PCAP_READER_DEFAULT_MAX_PACKET_SIZE;
+    reader->payload = malloc(reader->max_packet_size);
+    ESP_GOTO_ON_FALSE(reader->payload, ESP_ERR_NO_MEM, err, TAG, "no mem for payload buffer");
+
+    uint32_t magic = 0;
+    ESP_GOTO_ON_FALSE(pcap_reader_read(reader, &magic, sizeof(magic)), ESP_FAIL, err, TAG, "read file magic failed");
+    if (magic == PCAPNG_BLOCK_TYPE_SHB) {
+        uint32_t total_length = 0;
+        ESP_GOTO_ON_FALSE(pcap_reader_read(reader, &total_length, sizeof(total_length)), ESP_FAIL, err, TAG, "read section header failed");
+        reader->is_pcapng = true;
+        ESP_GOTO_ON_ERROR(pcap_reader_parse_section(reader, total_length), err, TAG, "parse section header failed");
+    } else {
+        switch (magic) {
+        case PCAP_MAGIC_BIG_ENDIAN:
+            break;
+        case PCAP_MAGIC_NANO_BIG_ENDIAN:
+            reader->nano = true;
+            break;
+        case PCAP_MAGIC_LITTLE_ENDIAN:
+            reader->swapped = true;
+            break;
+        case PCAP_MAGIC_NANO_LITTLE_ENDIAN:
+            reader->swapped = true;
+            reader->nano = true;
+            break;
+        default:
+            ESP_GOTO_ON_FALSE(false, ESP_ERR_INVALID_VERSION, err, TAG, "unknown file magic: %"PRIx32, magic);
+        }
+        pcap_file_header_t header;
+        // the magic has been consumed already
+        ESP_GOTO_ON_FALSE(pcap_reader_read(reader, (uint8_t *)&header + sizeof(magic), sizeof(header) - sizeof(magic)),
+                          ESP_FAIL, err, TAG, "read pcap file header failed");
+        reader->link_type = pcap_reader_u32(reader, header.link_type);
+    }
+    *ret_reader = reader;
+    return ESP_OK;
+err:
+    if (reader) {
+        free(reader->payload);
+        free(reader);
+    }
+    return ret;
+}
+
+esp_err_t pcap_reader_next_packet(pcap_reader_handle_t reader, pcap_reader_packet_t *packet)
+{
+    ESP_RETURN_ON_FALSE(reader && packet, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (reader->is_pcapng) {
+        return pcap_reader_next_pcapng(reader, packet);
+    }
+    return pcap_reader_next_pcap(reader, packet);
+}
+
+esp_err_t pcap_del_reader(pcap_reader_handle_t reader)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(reader->interfaces);
+    free(reader->payload);
+    free(reader);
+    return ESP_OK;
+}
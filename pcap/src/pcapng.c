@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "pcapng.h"
+#include "pcap_format.h"
+
+static const char *TAG = "pcapng";
+
+#define PCAPNG_MAX_INTERFACES 8   /*!< Max number of interfaces in one section */
+#define PCAPNG_TSRESOL_NANO 9     /*!< if_tsresol value for nanosecond resolution, i.e. 10^-9 seconds */
+
+typedef struct pcapng_file_t pcapng_file_t;
+
+/**
+ * @brief Pcapng Runtime Handle
+ *
+ */
+struct pcapng_file_t {
+    FILE *file;                                 /*!< File handle */
+    SemaphoreHandle_t lock;                     /*!< Mutex that keeps each block contiguous when capturing from multiple tasks */
+    uint32_t num_interfaces;                    /*!< Number of interfaces added to the section */
+    uint32_t snaplen[PCAPNG_MAX_INTERFACES];    /*!< Snaplen of each interface */
+};
+
+static const uint8_t s_zero_padding[4];
+
+/* Size of an option in the block, including the header, the padded value. 0 if the option is not used */
+static size_t pcapng_option_size(const void *value, size_t length)
+{
+    return value ? sizeof(pcapng_option_header_t) + PCAPNG_PAD32(length) : 0;
+}
+
+static bool pcapng_write_option(FILE *file, uint16_t code, const void *value, size_t length)
+{
+    if (!value) {
+        return true;
+    }
+    pcapng_option_header_t option = {
+        .code = code,
+        .length = length,
+    };
+    size_t padding = PCAPNG_PAD32(length) - length;
+    return fwrite(&option, sizeof(option), 1, file) == 1 &&
+           fwrite(value, 1, length, file) == length &&
+           fwrite(s_zero_padding, 1, padding, file) == padding;
+}
+
+/* Write the end-of-options marker (only if any option was written) and the trailing block length */
+static bool pcapng_write_block_end(FILE *file, bool has_options, uint32_t block_total_length)
+{
+    if (has_options) {
+        pcapng_option_header_t end = {
+            .code = PCAPNG_OPT_ENDOFOPT,
+            .length = 0,
+        };
+        if (fwrite(&end, sizeof(end), 1, file) != 1) {
+            return false;
+        }
+    }
+    return fwrite(&block_total_length, sizeof(block_total_length), 1, file) == 1;
+}
+
+static size_t pcapng_strlen(const char *str)
+{
+    return str ? strlen(str) : 0;
+}
+
+esp_err_t pcapng_new_session(const pcapng_config_t *config, pcapng_file_handle_t *ret_pcapng)
+{
+    esp_err_t ret = ESP_OK;
+    pcapng_file_t *pcapng = NULL;
+    ESP_GOTO_ON_FALSE(config && ret_pcapng, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(config->fp, ESP_ERR_INVALID_ARG, err, TAG, "pcapng file handle can't be NULL");
+    pcapng = calloc(1, sizeof(pcapng_file_t));
+    ESP_GOTO_ON_FALSE(pcapng, ESP_ERR_NO_MEM, err, TAG, "no mem for pcapng file object");
+    pcapng->lock = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(pcapng->lock, ESP_ERR_NO_MEM, err, TAG, "no mem for pcapng lock");
+    pcapng->file = config->fp;
+
+    size_t hardware_len = pcapng_strlen(config->hardware);
+    size_t os_len = pcapng_strlen(config->os);
+    size_t application_len = pcapng_strlen(config->application);
+    size_t options_size = pcapng_option_size(config->hardware, hardware_len) +
+                          pcapng_option_size(config->os, os_len) +
+                          pcapng_option_size(config->application, application_len);
+    bool has_options = options_size > 0;
+    if (has_options) {
+        options_size += sizeof(pcapng_option_header_t);
+    }
+    pcapng_block_header_t block = {
+        .block_type = PCAPNG_BLOCK_TYPE_SHB,
+        .block_total_length = sizeof(pcapng_block_header_t) + sizeof(pcapng_section_header_t) + options_size + sizeof(uint32_t),
+    };
+    pcapng_section_header_t section = {
+        .byte_order_magic = PCAPNG_BYTE_ORDER_MAGIC,
+        .major = 1,
+        .minor = 0,
+        .section_length = -1,
+    };
+    bool ok = fwrite(&block, sizeof(block), 1, pcapng->file) == 1 &&
+              fwrite(&section, sizeof(section), 1, pcapng->file) == 1 &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_SHB_HARDWARE, config->hardware, hardware_len) &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_SHB_OS, config->os, os_len) &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_SHB_USERAPPL, config->application, application_len) &&
+              pcapng_write_block_end(pcapng->file, has_options, block.block_total_length);
+    ESP_GOTO_ON_FALSE(ok, ESP_FAIL, err, TAG, "write section header block failed");
+    *ret_pcapng = pcapng;
+    return ESP_OK;
+err:
+    if (pcapng) {
+        if (pcapng->lock) {
+            vSemaphoreDelete(pcapng->lock);
+        }
+        free(pcapng);
+    }
+    return ret;
+}
+
+esp_err_t pcapng_del_session(pcapng_file_handle_t pcapng)
+{
+    ESP_RETURN_ON_FALSE(pcapng, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (pcapng->file) {
+        fclose(pcapng->file);
+        pcapng->file = NULL;
+    }
+    vSemaphoreDelete(pcapng->lock);
+    free(pcapng);
+    return ESP_OK;
+}
+
+esp_err_t pcapng_add_interface(pcapng_file_handle_t pcapng, const pcapng_interface_config_t *config, uint32_t *ret_interface_id)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(pcapng && config && ret_interface_id, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    uint8_t tsresol = PCAPNG_TSRESOL_NANO;
+    size_t name_len = pcapng_strlen(config->name);
+    size_t description_len = pcapng_strlen(config->description);
+    // the if_tsresol option is always present, so is the end-of-options marker
+    size_t options_size = pcapng_option_size(config->name, name_len) +
+                          pcapng_option_size(config->description, description_len) +
+                          pcapng_option_size(&tsresol, sizeof(tsresol)) +
+                          sizeof(pcapng_option_header_t);
+    uint32_t snaplen = config->snaplen ? config->snaplen : PCAP_DEFAULT_SNAPLEN;
+    pcapng_block_header_t block = {
+        .block_type = PCAPNG_BLOCK_TYPE_IDB,
+        .block_total_length = sizeof(pcapng_block_header_t) + sizeof(pcapng_interface_description_t) + options_size + sizeof(uint32_t),
+    };
+    pcapng_interface_description_t interface = {
+        .link_type = config->link_type,
+        .reserved = 0,
+        .snaplen = snaplen,
+    };
+
+    xSemaphoreTake(pcapng->lock, portMAX_DELAY);
+    ESP_GOTO_ON_FALSE(pcapng->num_interfaces < PCAPNG_MAX_INTERFACES, ESP_ERR_INVALID_ARG, out, TAG, "too many interfaces");
+    bool ok = fwrite(&block, sizeof(block), 1, pcapng->file) == 1 &&
+              fwrite(&interface, sizeof(interface), 1, pcapng->file) == 1 &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_IF_NAME, config->name, name_len) &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_IF_DESCRIPTION, config->description, description_len) &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_IF_TSRESOL, &tsresol, sizeof(tsresol)) &&
+              pcapng_write_block_end(pcapng->file, true, block.block_total_length);
+    ESP_GOTO_ON_FALSE(ok, ESP_FAIL, out, TAG, "write interface description block failed");
+    pcapng->snaplen[pcapng->num_interfaces] = snaplen;
+    *ret_interface_id = pcapng->num_interfaces++;
+out:
+    xSemaphoreGive(pcapng->lock);
+    return ret;
+}
+
+esp_err_t pcapng_capture_packet(pcapng_file_handle_t pcapng, const pcapng_packet_info_t *info, const void *payload, uint32_t length)
+{
+    ESP_RETURN_ON_FALSE(pcapng && info && payload, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    // the interface list only grows, and the new entry is published before its ID is returned
+    ESP_RETURN_ON_FALSE(info->interface_id < pcapng->num_interfaces, ESP_ERR_INVALID_ARG, TAG, "invalid interface ID");
+    uint32_t capture_length = length > pcapng->snaplen[info->interface_id] ? pcapng->snaplen[info->interface_id] : length;
+    size_t comment_len = pcapng_strlen(info->comment);
+    uint64_t drop_count = info->drop_count;
+    const void *drop_count_opt = info->drop_count ? &drop_count : NULL;
+    size_t options_size = pcapng_option_size(info->comment, comment_len) +
+                          pcapng_option_size(drop_count_opt, sizeof(drop_count));
+    bool has_options = options_size > 0;
+    if (has_options) {
+        options_size += sizeof(pcapng_option_header_t);
+    }
+    size_t padding = PCAPNG_PAD32(capture_length) - capture_length;
+    pcapng_block_header_t block = {
+        .block_type = PCAPNG_BLOCK_TYPE_EPB,
+        .block_total_length = sizeof(pcapng_block_header_t) + sizeof(pcapng_enhanced_packet_t) +
+        capture_length + padding + options_size + sizeof(uint32_t),
+    };
+    pcapng_enhanced_packet_t packet = {
+        .interface_id = info->interface_id,
+        .timestamp_high = (uint32_t)(info->timestamp_ns >> 32),
+        .timestamp_low = (uint32_t)info->timestamp_ns,
+        .capture_length = capture_length,
+        .packet_length = length,
+    };
+
+    xSemaphoreTake(pcapng->lock, portMAX_DELAY);
+    bool ok = fwrite(&block, sizeof(block), 1, pcapng->file) == 1 &&
+              fwrite(&packet, sizeof(packet), 1, pcapng->file) == 1 &&
+              fwrite(payload, 1, capture_length, pcapng->file) == capture_length &&
+              fwrite(s_zero_padding, 1, padding, pcapng->file) == padding &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_COMMENT, info->comment, comment_len) &&
+              pcapng_write_option(pcapng->file, PCAPNG_OPT_EPB_DROPCOUNT, drop_count_opt, sizeof(drop_count)) &&
+              pcapng_write_block_end(pcapng->file, has_options, block.block_total_length);
+    xSemaphoreGive(pcapng->lock);
+    ESP_RETURN_ON_FALSE(ok, ESP_FAIL, TAG, "write enhanced packet block failed");
+    return ESP_OK;
+}
+
+esp_err_t pcapng_flush(pcapng_file_handle_t pcapng)
+{
+    ESP_RETURN_ON_FALSE(pcapng, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    xSemaphoreTake(pcapng->lock, portMAX_DELAY);
+    int res = fflush(pcapng->file);
+    xSemaphoreGive(pcapng->lock);
+    ESP_RETURN_ON_FALSE(res == 0, ESP_FAIL, TAG, "flush pcapng file failed");
+    return ESP_OK;
+}
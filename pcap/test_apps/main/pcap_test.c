@@ -1,6 +1,295 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
 #include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+#include "esp_newlib.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "pcap.h"
+#include "pcapng.h"
+#include "pcap_reader.h"
 
-void app_main(void)
+#define TEST_FILE_SIZE      4096
+#define TEST_PACKET_SIZE    64
+
+static uint8_t s_file_buf[TEST_FILE_SIZE];
+static uint8_t s_packet[TEST_PACKET_SIZE];
+
+static void fill_packet(uint8_t seed)
+{
+    for (int i = 0; i < TEST_PACKET_SIZE; i++) {
+        s_packet[i] = (uint8_t)(seed + i);
+    }
+}
+
+static void close_reader(pcap_reader_handle_t reader, FILE *fp)
+{
+    TEST_ESP_OK(pcap_del_reader(reader));
+    fclose(fp);
+}
+
+TEST_CASE("pcap file write and read back", "[pcap]")
+{
+    FILE *fp = fmemopen(s_file_buf, TEST_FILE_SIZE, "w+b");
+    TEST_ASSERT_NOT_NULL(fp);
+    pcap_config_t config = {
+        .fp = fp,
+        .major_version = PCAP_DEFAULT_VERSION_MAJOR,
+        .minor_version = PCAP_DEFAULT_VERSION_MINOR,
+        .time_zone = PCAP_DEFAULT_TIME_ZONE_GMT,
+        .snaplen = 32,
+    };
+    pcap_file_handle_t pcap = NULL;
+    TEST_ESP_OK(pcap_new_session(&config, &pcap));
+    TEST_ESP_OK(pcap_write_header(pcap, PCAP_LINK_TYPE_ETHERNET));
+    fill_packet(1);
+    TEST_ESP_OK(pcap_capture_packet(pcap, s_packet, 20, 100, 5));
+    fill_packet(2);
+    TEST_ESP_OK(pcap_capture_packet(pcap, s_packet, TEST_PACKET_SIZE, 101, 6));
+    size_t file_size = ftell(fp);
+    TEST_ESP_OK(pcap_del_session(pcap));
+
+    fp = fmemopen(s_file_buf, file_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    pcap_reader_config_t reader_config = { .fp = fp };
+    pcap_reader_handle_t reader = NULL;
+    TEST_ESP_OK(pcap_new_reader(&reader_config, &reader));
+    pcap_reader_packet_t packet;
+
+    TEST_ESP_OK(pcap_reader_next_packet(reader, &packet));
+    TEST_ASSERT_EQUAL(PCAP_LINK_TYPE_ETHERNET, packet.link_type);
+    TEST_ASSERT_EQUAL_UINT64(100 * 1000000000ULL + 5000, packet.timestamp_ns);
+    TEST_ASSERT_EQUAL(20, packet.capture_length);
+    TEST_ASSERT_EQUAL(20, packet.packet_length);
+    fill_packet(1);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_packet, packet.payload, 20);
+
+    // truncated to the snaplen by the writer
+    TEST_ESP_OK(pcap_reader_next_packet(reader, &packet));
+    TEST_ASSERT_EQUAL(32, packet.capture_length);
+    TEST_ASSERT_EQUAL(TEST_PACKET_SIZE, packet.packet_length);
+    fill_packet(2);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_packet, packet.payload, 32);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, pcap_reader_next_packet(reader, &packet));
+    close_reader(reader, fp);
+}
+
+TEST_CASE("pcap asynchronous capture and read back", "[pcap]")
+{
+    FILE *fp = fmemopen(s_file_buf, TEST_FILE_SIZE, "w+b");
+    TEST_ASSERT_NOT_NULL(fp);
+    pcap_config_t config = {
+        .fp = fp,
+        .major_version = PCAP_DEFAULT_VERSION_MAJOR,
+        .minor_version = PCAP_DEFAULT_VERSION_MINOR,
+        .time_zone = PCAP_DEFAULT_TIME_ZONE_GMT,
+    };
+    pcap_file_handle_t pcap = NULL;
+    TEST_ESP_OK(pcap_new_session(&config, &pcap));
+    TEST_ESP_OK(pcap_write_header(pcap, PCAP_LINK_TYPE_802_11));
+
+    pcap_async_config_t async_config = {
+        .ring_buffer_size = 1024,
+        .task_priority = 5,
+        .task_stack_size = PCAP_ASYNC_MIN_TASK_STACK_SIZE - 1,
+        .task_core_id = tskNO_AFFINITY,
+    };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pcap_start_async_capture(pcap, &async_config));
+    async_config.task_stack_size = 4096;
+    TEST_ESP_OK(pcap_start_async_capture(pcap, &async_config));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, pcap_capture_packet(pcap, s_packet, TEST_PACKET_SIZE, 0, 0));
+    for (int i = 0; i < 10; i++) {
+        fill_packet(i);
+        TEST_ESP_OK(pcap_capture_packet_async(pcap, s_packet, TEST_PACKET_SIZE, i, 0));
+        vTaskDelay(1);
+    }
+    TEST_ESP_OK(pcap_stop_async_capture(pcap));
+    // no packet is accepted once the capture is stopped
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, pcap_capture_packet_async(pcap, s_packet, TEST_PACKET_SIZE, 0, 0));
+    pcap_capture_stats_t stats;
+    TEST_ESP_OK(pcap_get_capture_stats(pcap, &stats));
+    TEST_ASSERT_EQUAL(10, stats.captured_packets);
+    TEST_ASSERT_EQUAL(0, stats.dropped_packets);
+    size_t file_size = ftell(fp);
+    TEST_ESP_OK(pcap_del_session(pcap));
+
+    fp = fmemopen(s_file_buf, file_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    pcap_reader_config_t reader_config = { .fp = fp };
+    pcap_reader_handle_t reader = NULL;
+    TEST_ESP_OK(pcap_new_reader(&reader_config, &reader));
+    pcap_reader_packet_t packet;
+    for (int i = 0; i < 10; i++) {
+        TEST_ESP_OK(pcap_reader_next_packet(reader, &packet));
+        TEST_ASSERT_EQUAL_UINT64(i * 1000000000ULL, packet.timestamp_ns);
+        TEST_ASSERT_EQUAL(TEST_PACKET_SIZE, packet.capture_length);
+        fill_packet(i);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(s_packet, packet.payload, TEST_PACKET_SIZE);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, pcap_reader_next_packet(reader, &packet));
+    close_reader(reader, fp);
+}
+
+TEST_CASE("pcapng file write and read back", "[pcap]")
+{
+    FILE *fp = fmemopen(s_file_buf, TEST_FILE_SIZE, "w+b");
+    TEST_ASSERT_NOT_NULL(fp);
+    pcapng_config_t config = {
+        .fp = fp,
+        .hardware = "esp32",
+        .application = "pcap_test",
+    };
+    pcapng_file_handle_t pcapng = NULL;
+    TEST_ESP_OK(pcapng_new_session(&config, &pcapng));
+    uint32_t wifi_id;
+    uint32_t eth_id;
+    pcapng_interface_config_t if_config = {
+        .link_type = PCAP_LINK_TYPE_802_11,
+        .name = "wlan0",
+    };
+    TEST_ESP_OK(pcapng_add_interface(pcapng, &if_config, &wifi_id));
+    if_config.link_type = PCAP_LINK_TYPE_ETHERNET;
+    if_config.name = "eth0";
+    if_config.snaplen = 16;
+    TEST_ESP_OK(pcapng_add_interface(pcapng, &if_config, &eth_id));
+
+    pcapng_packet_info_t info = {
+        .interface_id = wifi_id,
+        .timestamp_ns = 1700000000123456789ULL,
+        .comment = "first packet",
+        .drop_count = 3,
+    };
+    fill_packet(3);
+    TEST_ESP_OK(pcapng_capture_packet(pcapng, &info, s_packet, 33));
+    info.interface_id = eth_id;
+    info.timestamp_ns = 5;
+    info.comment = NULL;
+    info.drop_count = 0;
+    fill_packet(4);
+    TEST_ESP_OK(pcapng_capture_packet(pcapng, &info, s_packet, TEST_PACKET_SIZE));
+    TEST_ESP_OK(pcapng_flush(pcapng));
+    size_t file_size = ftell(fp);
+    TEST_ESP_OK(pcapng_del_session(pcapng));
+
+    fp = fmemopen(s_file_buf, file_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    // the reader buffer is shorter than the first packet
+    pcap_reader_config_t reader_config = {
+        .fp = fp,
+        .max_packet_size = 20,
+    };
+    pcap_reader_handle_t reader = NULL;
+    TEST_ESP_OK(pcap_new_reader(&reader_config, &reader));
+    pcap_reader_packet_t packet;
+
+    TEST_ESP_OK(pcap_reader_next_packet(reader, &packet));
+    TEST_ASSERT_EQUAL(wifi_id, packet.interface_id);
+    TEST_ASSERT_EQUAL(PCAP_LINK_TYPE_802_11, packet.link_type);
+    TEST_ASSERT_EQUAL_UINT64(1700000000123456789ULL, packet.timestamp_ns);
+    TEST_ASSERT_EQUAL(20, packet.capture_length);
+    TEST_ASSERT_EQUAL(33, packet.packet_length);
+    fill_packet(3);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_packet, packet.payload, 20);
+
+    TEST_ESP_OK(pcap_reader_next_packet(reader, &packet));
+    TEST_ASSERT_EQUAL(eth_id, packet.interface_id);
+    TEST_ASSERT_EQUAL(PCAP_LINK_TYPE_ETHERNET, packet.link_type);
+    TEST_ASSERT_EQUAL_UINT64(5, packet.timestamp_ns);
+    TEST_ASSERT_EQUAL(16, packet.capture_length);
+    TEST_ASSERT_EQUAL(TEST_PACKET_SIZE, packet.packet_length);
+    fill_packet(4);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_packet, packet.payload, 16);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, pcap_reader_next_packet(reader, &packet));
+    close_reader(reader, fp);
+}
+
+/*
+ * Build a pcapng file in the memory buffer, made of a section header, an interface
+ * with the given if_tsresol, and an enhanced packet block of 4 bytes of payload
+ * claiming the given capture length. Returns the size of the file.
+ */
+static size_t build_pcapng(uint8_t tsresol, uint32_t capture_length)
+{
+    const uint32_t words[] = {
+        // Section Header Block
+        0x0A0D0D0A, 28, 0x1A2B3C4D, 0x00000001, 0xFFFFFFFF, 0xFFFFFFFF, 28,
+        // Interface Description Block, link type 1, if_tsresol option, end of options
+        0x00000001, 32, 0x00000001, 0, 0x00010009, tsresol, 0, 32,
+        // Enhanced Packet Block, interface 0, timestamp 2^32 + 1, 4 bytes of payload
+        0x00000006, 36, 0, 1, 1, capture_length, 4, 0xDDCCBBAA, 36,
+    };
+    memcpy(s_file_buf, words, sizeof(words));
+    return sizeof(words);
+}
+
+TEST_CASE("pcapng reader rejects malformed blocks", "[pcap]")
 {
+    pcap_reader_packet_t packet;
+    pcap_reader_handle_t reader;
+    FILE *fp;
+
+    // well formed file, timestamps in 2^-40 seconds
+    size_t file_size = build_pcapng(0x80 | 40, 4);
+    fp = fmemopen(s_file_buf, file_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    pcap_reader_config_t config = { .fp = fp };
+    TEST_ESP_OK(pcap_new_reader(&config, &reader));
+    TEST_ESP_OK(pcap_reader_next_packet(reader, &packet));
+    TEST_ASSERT_EQUAL(4, packet.capture_length);
+    TEST_ASSERT_EQUAL_UINT64(((1ULL << 32) * 1000000000ULL) >> 40, packet.timestamp_ns);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, pcap_reader_next_packet(reader, &packet));
+    close_reader(reader, fp);
+
+    // the padding of a capture length close to 4 GiB wraps around to 0
+    file_size = build_pcapng(9, 0xFFFFFFFD);
+    fp = fmemopen(s_file_buf, file_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    config.fp = fp;
+    TEST_ESP_OK(pcap_new_reader(&config, &reader));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, pcap_reader_next_packet(reader, &packet));
+    close_reader(reader, fp);
 
+    // capture length longer than the block
+    file_size = build_pcapng(9, 8);
+    fp = fmemopen(s_file_buf, file_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    config.fp = fp;
+    TEST_ESP_OK(pcap_new_reader(&config, &reader));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, pcap_reader_next_packet(reader, &packet));
+    close_reader(reader, fp);
+
+    // timestamp resolution of 2^-64 seconds
+    file_size = build_pcapng(0x80 | 64, 4);
+    fp = fmemopen(s_file_buf, file_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    config.fp = fp;
+    TEST_ESP_OK(pcap_new_reader(&config, &reader));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, pcap_reader_next_packet(reader, &packet));
+    close_reader(reader, fp);
+}
+
+void setUp(void)
+{
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    esp_reent_cleanup();    /* clean up some of the newlib's lazy allocations */
+    unity_utils_evaluate_leaks_direct(200);
+}
+
+void app_main(void)
+{
+    printf("Running pcap component tests\n");
+    unity_run_menu();
 }
@@ -23,6 +23,75 @@ static const char *TAG = "sh2lib";
 
 #define DBG_FRAME_SEND 1
 
+/* Size of the HTTP/2 frame header, see RFC 9113 section 4.1 */
+#define SH2LIB_FRAME_HDLEN SH2LIB_MIN_SEND_BUF_SIZE
+
+/*
+ * Every request gets one of these as its nghttp2 stream user data. Requests
+ * set up through the sh2lib_do_*() APIs only fill in legacy_recv_cb.
+ */
+struct sh2lib_stream {
+    struct sh2lib_stream *next;
+    int32_t stream_id;
+    sh2lib_frame_data_recv_cb_t legacy_recv_cb;
+    sh2lib_stream_config_t cfg;
+    sh2lib_stream_stats_t stats;
+};
+
+static struct sh2lib_stream *sh2lib_stream_new(struct sh2lib_handle *hd)
+{
+    struct sh2lib_stream *stream = calloc(1, sizeof(struct sh2lib_stream));
+    if (stream) {
+        stream->next = hd->streams;
+        hd->streams = stream;
+    }
+    return stream;
+}
+
+static void sh2lib_stream_free(struct sh2lib_handle *hd, struct sh2lib_stream *stream)
+{
+    struct sh2lib_stream **it = &hd->streams;
+    while (*it && *it != stream) {
+        it = &(*it)->next;
+    }
+    if (*it) {
+        *it = stream->next;
+    }
+    free(stream);
+}
+
+static struct sh2lib_stream *sh2lib_stream_find(struct sh2lib_handle *hd, int32_t stream_id)
+{
+    struct sh2lib_stream *stream = hd->streams;
+    while (stream && stream->stream_id != stream_id) {
+        stream = stream->next;
+    }
+    return stream;
+}
+
+static void sh2lib_stream_recv(struct sh2lib_handle *hd, struct sh2lib_stream *stream, const char *data, size_t len, int flags)
+{
+    if (stream->legacy_recv_cb) {
+        (*stream->legacy_recv_cb)(hd, data, len, flags);
+    } else if (stream->cfg.recv_cb) {
+        (*stream->cfg.recv_cb)(hd, stream->stream_id, data, len, flags, stream->cfg.user_ctx);
+    }
+}
+
+/*
+ * Report the end of the stream to the user and release it. The nghttp2 stream,
+ * if it was ever opened, no longer points to it.
+ */
+static void sh2lib_stream_close(struct sh2lib_handle *hd, struct sh2lib_stream *stream, uint32_t error_code)
+{
+    sh2lib_stream_recv(hd, stream, NULL, 0, DATA_RECV_RST_STREAM);
+    if (stream->cfg.close_cb) {
+        (*stream->cfg.close_cb)(hd, stream->stream_id, error_code, &stream->stats, stream->cfg.user_ctx);
+    }
+    nghttp2_session_set_stream_user_data(hd->http2_sess, stream->stream_id, NULL);
+    sh2lib_stream_free(hd, stream);
+}
+
 /*
  * The implementation of nghttp2_send_callback type. Here we write
  * |data| with size |length| to the network and return the number of
@@ -51,31 +120,124 @@ static int callback_error(nghttp2_session *session, int lib_error_code,
     return 0;
 }
 
+/*
+ * Write out the pending bytes of the coalescing buffer. Returns 0 if the
+ * buffer is drained, or the error code from callback_send_inner(), in which
+ * case the bytes that have not been written are kept at the buffer head.
+ */
+static int sh2lib_flush_send_buf(struct sh2lib_handle *hd)
+{
+    int rv = 0;
+    size_t offset = 0;
+    while (offset < hd->send_buf_len) {
+        rv = callback_send_inner(hd, hd->send_buf + offset, hd->send_buf_len - offset);
+        if (rv <= 0) {
+            break;
+        }
+        offset += rv;
+        hd->tls_write_count++;
+        hd->tls_write_bytes += rv;
+        rv = 0;
+    }
+    if (offset) {
+        memmove(hd->send_buf, hd->send_buf + offset, hd->send_buf_len - offset);
+        hd->send_buf_len -= offset;
+    }
+    return rv;
+}
+
 static ssize_t callback_send(nghttp2_session *session, const uint8_t *data,
                              size_t length, int flags, void *user_data)
 {
-    int rv = 0;
     struct sh2lib_handle *hd = user_data;
+    size_t accepted = 0;
+
+    /*
+     * nghttp2 hands over the frames piece by piece (frame header, padding, payload),
+     * collect them so that each TLS record is as large as possible
+     */
+    while (accepted < length) {
+        if (hd->send_buf_len == hd->send_buf_size) {
+            int rv = sh2lib_flush_send_buf(hd);
+            if (rv < 0 && rv != NGHTTP2_ERR_WOULDBLOCK) {
+                /* If no data is accepted, send the error code */
+                return accepted ? (ssize_t)accepted : rv;
+            }
+            if (hd->send_buf_len == hd->send_buf_size) {
+                break;
+            }
+        }
+        size_t copy_len = length - accepted;
+        if (copy_len > hd->send_buf_size - hd->send_buf_len) {
+            copy_len = hd->send_buf_size - hd->send_buf_len;
+        }
+        memcpy(hd->send_buf + hd->send_buf_len, data + accepted, copy_len);
+        hd->send_buf_len += copy_len;
+        accepted += copy_len;
+    }
+    return accepted ? (ssize_t)accepted : NGHTTP2_ERR_WOULDBLOCK;
+}
+
+/*
+ * The implementation of nghttp2_send_data_callback type, used for the DATA
+ * frames of zero-copy requests. The frame header goes through the coalescing
+ * buffer, the payload is written straight from the application buffer.
+ *
+ * nghttp2 calls this again with the same arguments after NGHTTP2_ERR_WOULDBLOCK,
+ * the progress is kept in the handle so that the write resumes where it stopped.
+ */
+static int callback_send_data(nghttp2_session *session, nghttp2_frame *frame,
+                              const uint8_t *framehd, size_t length,
+                              nghttp2_data_source *source, void *user_data)
+{
+    struct sh2lib_handle *hd = user_data;
+    int rv;
+
+    /* Padding is never enabled on the session */
+    if (frame->data.padlen != 0) {
+        return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
 
-    int copy_offset = 0;
-    int pending_data = length;
-
-    /* Send data in 1000 byte chunks */
-    while (copy_offset != length) {
-        int chunk_len = pending_data > 1000 ? 1000 : pending_data;
-        int subrv = callback_send_inner(hd, data + copy_offset, chunk_len);
-        if (subrv <= 0) {
-            if (copy_offset == 0) {
-                /* If no data is transferred, send the error code */
-                rv = subrv;
+    if (!hd->nocopy_hdr_queued) {
+        if (hd->send_buf_size - hd->send_buf_len < SH2LIB_FRAME_HDLEN) {
+            rv = sh2lib_flush_send_buf(hd);
+            if (rv < 0) {
+                return rv;
             }
-            break;
         }
-        copy_offset += subrv;
-        pending_data -= subrv;
-        rv += subrv;
+        memcpy(hd->send_buf + hd->send_buf_len, framehd, SH2LIB_FRAME_HDLEN);
+        hd->send_buf_len += SH2LIB_FRAME_HDLEN;
+        hd->nocopy_hdr_queued = true;
+
+        /* Small payloads are better coalesced with the header than written on their own */
+        if (length <= hd->send_buf_size - hd->send_buf_len) {
+            memcpy(hd->send_buf + hd->send_buf_len, hd->nocopy_data, length);
+            hd->send_buf_len += length;
+            hd->nocopy_sent = length;
+        }
     }
-    return rv;
+
+    if (hd->nocopy_sent < length) {
+        /* Everything queued before the payload has to be on the wire first */
+        rv = sh2lib_flush_send_buf(hd);
+        if (rv < 0) {
+            return rv;
+        }
+        while (hd->nocopy_sent < length) {
+            rv = callback_send_inner(hd, hd->nocopy_data + hd->nocopy_sent, length - hd->nocopy_sent);
+            if (rv <= 0) {
+                return rv;
+            }
+            hd->nocopy_sent += rv;
+            hd->tls_write_count++;
+            hd->tls_write_bytes += rv;
+        }
+    }
+
+    hd->nocopy_data = NULL;
+    hd->nocopy_sent = 0;
+    hd->nocopy_hdr_queued = false;
+    return 0;
 }
 
 /*
@@ -136,8 +298,16 @@ const char *sh2lib_frame_type_str(int type)
 static int callback_on_frame_send(nghttp2_session *session,
                                   const nghttp2_frame *frame, void *user_data)
 {
+    struct sh2lib_stream *stream;
     ESP_LOGD(TAG, "[frame-send] frame type %s", sh2lib_frame_type_str(frame->hd.type));
     switch (frame->hd.type) {
+    case NGHTTP2_DATA:
+        stream = nghttp2_session_get_stream_user_data(session, frame->hd.stream_id);
+        if (stream) {
+            stream->stats.data_frames_sent++;
+            stream->stats.bytes_sent += frame->hd.length - frame->data.padlen;
+        }
+        break;
     case NGHTTP2_HEADERS:
         if (nghttp2_session_get_stream_user_data(session, frame->hd.stream_id)) {
             ESP_LOGD(TAG, "[frame-send] C ----------------------------> S (HEADERS)");
@@ -159,6 +329,17 @@ static int callback_on_frame_not_send(nghttp2_session *session,
                                       const nghttp2_frame *frame, int lib_error_code, void *user_data)
 {
     ESP_LOGW(TAG, "[frame-not-send] code %i frame type %s", lib_error_code, sh2lib_frame_type_str(frame->hd.type));
+    if (frame->hd.type == NGHTTP2_HEADERS) {
+        /*
+         * The request will never be sent, e.g. after GOAWAY. Release it here rather than
+         * relying on nghttp2 to close a stream it may not have opened yet.
+         */
+        struct sh2lib_handle *h2 = user_data;
+        struct sh2lib_stream *stream = sh2lib_stream_find(h2, frame->hd.stream_id);
+        if (stream) {
+            sh2lib_stream_close(h2, stream, NGHTTP2_REFUSED_STREAM);
+        }
+    }
     return 0;
 }
 
@@ -167,9 +348,10 @@ static int callback_on_frame_recv(nghttp2_session *session,
 {
     struct sh2lib_handle *h2 = user_data;
     ESP_LOGD(TAG, "[frame-recv][sid: %" PRIi32 "] frame type  %s", frame->hd.stream_id, sh2lib_frame_type_str(frame->hd.type));
-    sh2lib_frame_data_recv_cb_t data_recv_cb = nghttp2_session_get_stream_user_data(session, frame->hd.stream_id);
-    if (frame->hd.type == NGHTTP2_DATA && data_recv_cb) {
-        (*data_recv_cb)(h2, NULL, 0, DATA_RECV_FRAME_COMPLETE);
+    struct sh2lib_stream *stream = nghttp2_session_get_stream_user_data(session, frame->hd.stream_id);
+    if (frame->hd.type == NGHTTP2_DATA && stream) {
+        stream->stats.data_frames_recv++;
+        sh2lib_stream_recv(h2, stream, NULL, 0, DATA_RECV_FRAME_COMPLETE);
     }
     if (frame->hd.type == NGHTTP2_GOAWAY) {
         ESP_LOGW(TAG, "[frame-recv] GOAWAY: no more requests may be sent");
@@ -182,10 +364,9 @@ static int callback_on_stream_close(nghttp2_session *session, int32_t stream_id,
                                     uint32_t error_code, void *user_data)
 {
     ESP_LOGD(TAG, "[stream-close][sid %" PRIi32 "]", stream_id);
-    sh2lib_frame_data_recv_cb_t data_recv_cb = nghttp2_session_get_stream_user_data(session, stream_id);
-    if (data_recv_cb) {
-        struct sh2lib_handle *h2 = user_data;
-        (*data_recv_cb)(h2, NULL, 0, DATA_RECV_RST_STREAM);
+    struct sh2lib_stream *stream = nghttp2_session_get_stream_user_data(session, stream_id);
+    if (stream) {
+        sh2lib_stream_close(user_data, stream, error_code);
     }
     return 0;
 }
@@ -194,15 +375,16 @@ static int callback_on_data_chunk_recv(nghttp2_session *session, uint8_t flags,
                                        int32_t stream_id, const uint8_t *data,
                                        size_t len, void *user_data)
 {
-    sh2lib_frame_data_recv_cb_t data_recv_cb;
+    struct sh2lib_stream *stream;
     ESP_LOGD(TAG, "[data-chunk][sid: %" PRIi32 "]", stream_id);
-    data_recv_cb = nghttp2_session_get_stream_user_data(session, stream_id);
-    if (data_recv_cb) {
+    stream = nghttp2_session_get_stream_user_data(session, stream_id);
+    if (stream) {
         ESP_LOGD(TAG, "[data-chunk] C <---------------------------- S (DATA chunk)"
                  "%lu bytes",
                  (unsigned long int)len);
         struct sh2lib_handle *h2 = user_data;
-        (*data_recv_cb)(h2, (char *)data, len, 0);
+        stream->stats.bytes_recv += len;
+        sh2lib_stream_recv(h2, stream, (char *)data, len, 0);
         /* TODO: What to do with the return value: look for pause/abort */
     }
     return 0;
@@ -224,7 +406,7 @@ static int callback_on_invalid_header(nghttp2_session *session, const nghttp2_fr
     return 0;
 }
 
-static int do_http2_connect(struct sh2lib_handle *hd)
+static int do_http2_connect(struct sh2lib_handle *hd, const struct sh2lib_config_t *cfg)
 {
     int ret;
     nghttp2_session_callbacks *callbacks;
@@ -232,6 +414,7 @@ static int do_http2_connect(struct sh2lib_handle *hd)
     nghttp2_session_callbacks_set_error_callback2(callbacks, callback_error);
     nghttp2_session_callbacks_set_send_callback(callbacks, callback_send);
     nghttp2_session_callbacks_set_recv_callback(callbacks, callback_recv);
+    nghttp2_session_callbacks_set_send_data_callback(callbacks, callback_send_data);
     nghttp2_session_callbacks_set_on_frame_send_callback(callbacks, callback_on_frame_send);
     nghttp2_session_callbacks_set_on_frame_not_send_callback(callbacks, callback_on_frame_not_send);
     nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks, callback_on_frame_recv);
@@ -248,11 +431,32 @@ static int do_http2_connect(struct sh2lib_handle *hd)
     nghttp2_session_callbacks_del(callbacks);
 
     /* Create the SETTINGS frame */
-    ret = nghttp2_submit_settings(hd->http2_sess, NGHTTP2_FLAG_NONE, NULL, 0);
+    nghttp2_settings_entry iv[2];
+    size_t niv = 0;
+    if (cfg->initial_window_size) {
+        iv[niv].settings_id = NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE;
+        iv[niv].value = cfg->initial_window_size;
+        niv++;
+    }
+    if (cfg->max_concurrent_streams) {
+        iv[niv].settings_id = NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS;
+        iv[niv].value = cfg->max_concurrent_streams;
+        niv++;
+    }
+    ret = nghttp2_submit_settings(hd->http2_sess, NGHTTP2_FLAG_NONE, iv, niv);
     if (ret != 0) {
         ESP_LOGE(TAG, "[sh2-connect] Submit settings failed");
         return -1;
     }
+
+    /* The connection window can only be changed through WINDOW_UPDATE */
+    if (cfg->connection_window_size) {
+        ret = nghttp2_session_set_local_window_size(hd->http2_sess, NGHTTP2_FLAG_NONE, 0, cfg->connection_window_size);
+        if (ret != 0) {
+            ESP_LOGE(TAG, "[sh2-connect] Setting connection window failed %d", ret);
+            return -1;
+        }
+    }
     return 0;
 }
 
@@ -264,6 +468,10 @@ int sh2lib_connect(struct sh2lib_config_t *cfg, struct sh2lib_handle *hd)
         ESP_LOGE(TAG, "[sh2-connect] pointer to sh2lib configurations cannot be NULL");
         goto error;
     }
+    if (cfg->send_buf_size && cfg->send_buf_size < SH2LIB_MIN_SEND_BUF_SIZE) {
+        ESP_LOGE(TAG, "[sh2-connect] send buffer must be at least %d bytes", SH2LIB_MIN_SEND_BUF_SIZE);
+        goto error;
+    }
 
     const char *proto[] = {"h2", NULL};
     esp_tls_cfg_t tls_cfg = {
@@ -297,8 +505,15 @@ int sh2lib_connect(struct sh2lib_config_t *cfg, struct sh2lib_handle *hd)
     http_parser_parse_url(cfg->uri, strlen(cfg->uri), 0, &u);
     hd->hostname = strndup(&cfg->uri[u.field_data[UF_HOST].off], u.field_data[UF_HOST].len);
 
+    hd->send_buf_size = cfg->send_buf_size ? cfg->send_buf_size : SH2LIB_DEFAULT_SEND_BUF_SIZE;
+    hd->send_buf = malloc(hd->send_buf_size);
+    if (!hd->send_buf) {
+        ESP_LOGE(TAG, "[sh2-connect] Failed to allocate send buffer");
+        goto error;
+    }
+
     /* HTTP/2 Connection */
-    if (do_http2_connect(hd) != 0) {
+    if (do_http2_connect(hd, cfg) != 0) {
         ESP_LOGE(TAG, "[sh2-connect] HTTP2 Connection failed with %s", cfg->uri);
         goto error;
     }
@@ -323,6 +538,15 @@ void sh2lib_free(struct sh2lib_handle *hd)
         free(hd->hostname);
         hd->hostname = NULL;
     }
+    if (hd->send_buf) {
+        free(hd->send_buf);
+        hd->send_buf = NULL;
+        hd->send_buf_len = 0;
+    }
+    /* nghttp2_session_del() does not report the streams that are still open */
+    while (hd->streams) {
+        sh2lib_stream_free(hd, hd->streams);
+    }
 }
 
 int sh2lib_execute(struct sh2lib_handle *hd)
@@ -366,14 +590,46 @@ int sh2lib_execute_send(struct sh2lib_handle *hd)
     int ret = nghttp2_session_send(hd->http2_sess);
     if (ret != 0) {
         ESP_LOGE(TAG, "[sh2-execute-send] HTTP2 session send failed %d", ret);
+        return ret;
     }
 
+    /*
+     * nghttp2_session_send() returns once nghttp2_session_want_write() goes false
+     * (or the transport would block), push out whatever is still coalesced
+     */
+    ret = sh2lib_flush_send_buf(hd);
+    if (ret == NGHTTP2_ERR_WOULDBLOCK) {
+        /* The rest is flushed by the next call */
+        ret = 0;
+    } else if (ret != 0) {
+        ESP_LOGE(TAG, "[sh2-execute-send] TLS write failed %d", hd->http2_tls_rc);
+    }
+
+    return ret;
+}
+
+static int sh2lib_submit_request(struct sh2lib_handle *hd, const nghttp2_priority_spec *pri_spec,
+                                 const nghttp2_nv *nva, size_t nvlen, const nghttp2_data_provider *data_prd,
+                                 struct sh2lib_stream *stream)
+{
+    int ret = nghttp2_submit_request(hd->http2_sess, pri_spec, nva, nvlen, data_prd, stream);
+    if (ret < 0) {
+        sh2lib_stream_free(hd, stream);
+    } else {
+        stream->stream_id = ret;
+    }
     return ret;
 }
 
 int sh2lib_do_get_with_nv(struct sh2lib_handle *hd, const nghttp2_nv *nva, size_t nvlen, sh2lib_frame_data_recv_cb_t recv_cb)
 {
-    int ret = nghttp2_submit_request(hd->http2_sess, NULL, nva, nvlen, NULL, recv_cb);
+    struct sh2lib_stream *stream = sh2lib_stream_new(hd);
+    if (!stream) {
+        ESP_LOGE(TAG, "[sh2-do-get] Failed to allocate stream");
+        return NGHTTP2_ERR_NOMEM;
+    }
+    stream->legacy_recv_cb = recv_cb;
+    int ret = sh2lib_submit_request(hd, NULL, nva, nvlen, NULL, stream);
     if (ret < 0) {
         ESP_LOGE(TAG, "[sh2-do-get] HEADERS call failed %i", ret);
     }
@@ -404,16 +660,65 @@ int sh2lib_do_putpost_with_nv(struct sh2lib_handle *hd, const nghttp2_nv *nva, s
                               sh2lib_frame_data_recv_cb_t recv_cb)
 {
 
+    struct sh2lib_stream *stream = sh2lib_stream_new(hd);
+    if (!stream) {
+        ESP_LOGE(TAG, "[sh2-do-putpost] Failed to allocate stream");
+        return NGHTTP2_ERR_NOMEM;
+    }
+    stream->legacy_recv_cb = recv_cb;
+
     nghttp2_data_provider sh2lib_data_provider;
     sh2lib_data_provider.read_callback = sh2lib_data_provider_cb;
     sh2lib_data_provider.source.ptr = send_cb;
-    int ret = nghttp2_submit_request(hd->http2_sess, NULL, nva, nvlen, &sh2lib_data_provider, recv_cb);
+    int ret = sh2lib_submit_request(hd, NULL, nva, nvlen, &sh2lib_data_provider, stream);
     if (ret < 0) {
         ESP_LOGE(TAG, "[sh2-do-putpost] HEADERS call failed %i", ret);
     }
     return ret;
 }
 
+/*
+ * nghttp2 prepares and sends one outbound frame at a time, so the buffer of the
+ * DATA frame in flight can be kept in the handle until callback_send_data() runs.
+ */
+static ssize_t sh2lib_data_provider_nocopy_cb(nghttp2_session *session, int32_t stream_id, uint8_t *buf,
+                                              size_t length, uint32_t *data_flags,
+                                              nghttp2_data_source *source, void *user_data)
+{
+    struct sh2lib_handle *h2 = user_data;
+    sh2lib_putpost_data_nocopy_cb_t data_cb = source->ptr;
+    const uint8_t *data = NULL;
+    int ret = (*data_cb)(h2, &data, length, data_flags);
+    if (ret > 0) {
+        *data_flags |= NGHTTP2_DATA_FLAG_NO_COPY;
+        h2->nocopy_data = data;
+        h2->nocopy_sent = 0;
+        h2->nocopy_hdr_queued = false;
+    }
+    return ret;
+}
+
+int sh2lib_do_putpost_with_nv_nocopy(struct sh2lib_handle *hd, const nghttp2_nv *nva, size_t nvlen,
+                                     sh2lib_putpost_data_nocopy_cb_t send_cb,
+                                     sh2lib_frame_data_recv_cb_t recv_cb)
+{
+    struct sh2lib_stream *stream = sh2lib_stream_new(hd);
+    if (!stream) {
+        ESP_LOGE(TAG, "[sh2-do-putpost-nocopy] Failed to allocate stream");
+        return NGHTTP2_ERR_NOMEM;
+    }
+    stream->legacy_recv_cb = recv_cb;
+
+    nghttp2_data_provider sh2lib_data_provider;
+    sh2lib_data_provider.read_callback = sh2lib_data_provider_nocopy_cb;
+    sh2lib_data_provider.source.ptr = send_cb;
+    int ret = sh2lib_submit_request(hd, NULL, nva, nvlen, &sh2lib_data_provider, stream);
+    if (ret < 0) {
+        ESP_LOGE(TAG, "[sh2-do-putpost-nocopy] HEADERS call failed %i", ret);
+    }
+    return ret;
+}
+
 int sh2lib_do_post(struct sh2lib_handle *hd, const char *path,
                    sh2lib_putpost_data_cb_t send_cb,
                    sh2lib_frame_data_recv_cb_t recv_cb)
@@ -437,3 +742,66 @@ int sh2lib_do_put(struct sh2lib_handle *hd, const char *path,
                              };
     return sh2lib_do_putpost_with_nv(hd, nva, sizeof(nva) / sizeof(nva[0]), send_cb, recv_cb);
 }
+
+static ssize_t sh2lib_stream_data_provider_cb(nghttp2_session *session, int32_t stream_id, uint8_t *buf,
+                                              size_t length, uint32_t *data_flags,
+                                              nghttp2_data_source *source, void *user_data)
+{
+    struct sh2lib_handle *h2 = user_data;
+    struct sh2lib_stream *stream = source->ptr;
+    return (*stream->cfg.send_cb)(h2, stream_id, (char *)buf, length, data_flags, stream->cfg.user_ctx);
+}
+
+int sh2lib_stream_request(struct sh2lib_handle *hd, const nghttp2_nv *nva, size_t nvlen, const sh2lib_stream_config_t *cfg)
+{
+    if (cfg == NULL) {
+        ESP_LOGE(TAG, "[sh2-stream-request] pointer to stream configuration cannot be NULL");
+        return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+
+    struct sh2lib_stream *stream = sh2lib_stream_new(hd);
+    if (!stream) {
+        ESP_LOGE(TAG, "[sh2-stream-request] Failed to allocate stream");
+        return NGHTTP2_ERR_NOMEM;
+    }
+    stream->cfg = *cfg;
+
+    nghttp2_priority_spec pri_spec;
+    nghttp2_priority_spec_init(&pri_spec, cfg->dep_stream_id, cfg->weight ? cfg->weight : NGHTTP2_DEFAULT_WEIGHT, cfg->exclusive);
+
+    nghttp2_data_provider sh2lib_data_provider;
+    sh2lib_data_provider.read_callback = sh2lib_stream_data_provider_cb;
+    sh2lib_data_provider.source.ptr = stream;
+    int ret = sh2lib_submit_request(hd, &pri_spec, nva, nvlen, cfg->send_cb ? &sh2lib_data_provider : NULL, stream);
+    if (ret < 0) {
+        ESP_LOGE(TAG, "[sh2-stream-request] HEADERS call failed %i", ret);
+    }
+    return ret;
+}
+
+int sh2lib_stream_set_priority(struct sh2lib_handle *hd, int32_t stream_id, int32_t weight, int32_t dep_stream_id, bool exclusive)
+{
+    nghttp2_priority_spec pri_spec;
+    nghttp2_priority_spec_init(&pri_spec, dep_stream_id, weight, exclusive);
+    int ret = nghttp2_submit_priority(hd->http2_sess, NGHTTP2_FLAG_NONE, stream_id, &pri_spec);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "[sh2-stream-priority] PRIORITY call failed %i", ret);
+    }
+    return ret;
+}
+
+void *sh2lib_stream_get_user_ctx(struct sh2lib_handle *hd, int32_t stream_id)
+{
+    struct sh2lib_stream *stream = sh2lib_stream_find(hd, stream_id);
+    return stream ? stream->cfg.user_ctx : NULL;
+}
+
+int sh2lib_stream_get_stats(struct sh2lib_handle *hd, int32_t stream_id, sh2lib_stream_stats_t *stats)
+{
+    struct sh2lib_stream *stream = sh2lib_stream_find(hd, stream_id);
+    if (!stream || !stats) {
+        return -1;
+    }
+    *stats = stream->stats;
+    return 0;
+}
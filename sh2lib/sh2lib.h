@@ -7,6 +7,8 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "sdkconfig.h"
 #include "esp_tls.h"
 #include <nghttp2/nghttp2.h>
 
@@ -29,14 +31,39 @@ extern "C" {
 /**
  * @brief Handle for working with sh2lib APIs
  */
+struct sh2lib_stream;
+
 struct sh2lib_handle {
     nghttp2_session *http2_sess;   /*!< Pointer to the HTTP2 session handle */
     char            *hostname;     /*!< The hostname we are connected to */
     struct esp_tls  *http2_tls;    /*!< Pointer to the TLS session handle */
     int             http2_tls_rc;  /*!< Error code from http2_tls */
     bool            http2_goaway;  /*!< HTTP2 server sent GOAWAY */
+    uint8_t         *send_buf;     /*!< Buffer that coalesces the nghttp2 output into TLS record sized writes */
+    size_t          send_buf_size; /*!< Capacity of send_buf */
+    size_t          send_buf_len;  /*!< Number of pending bytes in send_buf */
+    uint32_t        tls_write_count; /*!< Number of successful writes to the TLS connection, for diagnostics */
+    uint64_t        tls_write_bytes; /*!< Number of bytes written to the TLS connection, for diagnostics */
+    const uint8_t   *nocopy_data;  /*!< Application buffer of the zero-copy DATA frame being sent */
+    size_t          nocopy_sent;   /*!< Number of bytes of nocopy_data already written to the TLS connection */
+    bool            nocopy_hdr_queued; /*!< Frame header of the zero-copy DATA frame is already queued */
+    struct sh2lib_stream *streams; /*!< List of the streams that are not closed yet */
 };
 
+/**
+ * @brief Default size of the output coalescing buffer, matches the max outgoing TLS record payload
+ */
+#ifdef CONFIG_MBEDTLS_SSL_OUT_CONTENT_LEN
+#define SH2LIB_DEFAULT_SEND_BUF_SIZE CONFIG_MBEDTLS_SSL_OUT_CONTENT_LEN
+#else
+#define SH2LIB_DEFAULT_SEND_BUF_SIZE 4096
+#endif
+
+/**
+ * @brief Smallest accepted size of the send buffer, it has to hold at least one HTTP/2 frame header
+ */
+#define SH2LIB_MIN_SEND_BUF_SIZE 9
+
 /**
  * @brief sh2lib configuration structure
  */
@@ -48,6 +75,15 @@ struct sh2lib_config_t {
     /*!< Function pointer to esp_crt_bundle_attach. Enables the use of certification
          bundle for server verification, must be enabled in menuconfig */
     tls_keep_alive_cfg_t *keep_alive_cfg;/*!< Enable TCP keep-alive timeout for SSL connection */
+    size_t send_buf_size;               /*!< Size of the buffer that coalesces small HTTP/2 frames into one TLS record.
+                                             Should not exceed the max TLS record payload and must be at least SH2LIB_MIN_SEND_BUF_SIZE,
+                                             set to 0 to use SH2LIB_DEFAULT_SEND_BUF_SIZE */
+    uint32_t initial_window_size;       /*!< Receive window of every stream (SETTINGS_INITIAL_WINDOW_SIZE),
+                                             set to 0 to keep the HTTP/2 default of 65535 bytes */
+    uint32_t connection_window_size;    /*!< Receive window of the whole connection, shared by all the streams,
+                                             set to 0 to keep the HTTP/2 default of 65535 bytes */
+    uint32_t max_concurrent_streams;    /*!< Max number of streams the server may open towards us (SETTINGS_MAX_CONCURRENT_STREAMS),
+                                             set to 0 to leave it unlimited */
 };
 
 /** Flag indicating receive stream is reset */
@@ -92,6 +128,107 @@ typedef int (*sh2lib_frame_data_recv_cb_t)(struct sh2lib_handle *handle, const c
  */
 typedef int (*sh2lib_putpost_data_cb_t)(struct sh2lib_handle *handle, char *data, size_t len, uint32_t *data_flags);
 
+/**
+ * @brief Function Prototype for zero-copy callback to send data in PUT/POST
+ *
+ * Same as sh2lib_putpost_data_cb_t, but instead of copying the data into a
+ * buffer provided by nghttp2, the function hands over a pointer to its own
+ * buffer. The data is then written to the TLS connection directly after the
+ * DATA frame header, without any intermediate copy.
+ *
+ * The buffer must stay valid and unmodified until this function is called again
+ * for the same stream, or the stream is closed.
+ *
+ * @param[in] handle       Pointer to the sh2lib handle.
+ * @param[out] data        Should be set to point to the data to send.
+ * @param[in] len          The maximum length of data that can be sent out by this function.
+ * @param[out] data_flags  Pointer to the data flags. The NGHTTP2_DATA_FLAG_EOF
+ *                         should be set in the data flags to indicate end of new data.
+ *
+ * @return The function should return the number of valid bytes pointed by 'data'
+ */
+typedef int (*sh2lib_putpost_data_nocopy_cb_t)(struct sh2lib_handle *handle, const uint8_t **data, size_t len, uint32_t *data_flags);
+
+/**
+ * @brief Statistics of a single stream
+ */
+typedef struct {
+    size_t bytes_sent;          /*!< Number of request body bytes sent */
+    size_t bytes_recv;          /*!< Number of response body bytes received */
+    uint32_t data_frames_sent;  /*!< Number of DATA frames sent */
+    uint32_t data_frames_recv;  /*!< Number of DATA frames received */
+} sh2lib_stream_stats_t;
+
+/**
+ * @brief Function Prototype for stream data receive callback
+ *
+ * Same as sh2lib_frame_data_recv_cb_t, with the stream ID and the user context
+ * of the stream passed along, so that many streams can share one callback.
+ *
+ * @param[in] handle     Pointer to the sh2lib handle.
+ * @param[in] stream_id  ID of the stream the data belongs to.
+ * @param[in] data       Pointer to a buffer that contains the data received.
+ * @param[in] len        The length of valid data stored at the 'data' pointer.
+ * @param[in] flags      Flags indicating whether the stream is reset (DATA_RECV_RST_STREAM) or
+ *                       this particularly frame is completely received
+ *                       DATA_RECV_FRAME_COMPLETE).
+ * @param[in] user_ctx   User context of the stream, see sh2lib_stream_config_t.
+ *
+ * @return The function should return 0
+ */
+typedef int (*sh2lib_stream_data_recv_cb_t)(struct sh2lib_handle *handle, int32_t stream_id, const char *data, size_t len,
+                                            int flags, void *user_ctx);
+
+/**
+ * @brief Function Prototype for stream data send callback
+ *
+ * Same as sh2lib_putpost_data_cb_t, with the stream ID and the user context
+ * of the stream passed along.
+ *
+ * @param[in] handle       Pointer to the sh2lib handle.
+ * @param[in] stream_id    ID of the stream the data is sent on.
+ * @param[out] data        Pointer to a buffer that should contain the data to send.
+ * @param[in] len          The maximum length of data that can be sent out by this function.
+ * @param[out] data_flags  Pointer to the data flags. The NGHTTP2_DATA_FLAG_EOF
+ *                         should be set in the data flags to indicate end of new data.
+ * @param[in] user_ctx     User context of the stream, see sh2lib_stream_config_t.
+ *
+ * @return The function should return the number of valid bytes stored in the
+ * data pointer
+ */
+typedef int (*sh2lib_stream_data_send_cb_t)(struct sh2lib_handle *handle, int32_t stream_id, char *data, size_t len,
+                                            uint32_t *data_flags, void *user_ctx);
+
+/**
+ * @brief Function Prototype for stream close callback
+ *
+ * Called once the stream is closed, after the last receive callback. The stream
+ * ID is no longer valid after this function returns. A request whose HEADERS
+ * could not be sent, e.g. after the server sent GOAWAY, is closed with
+ * NGHTTP2_REFUSED_STREAM.
+ *
+ * @param[in] handle      Pointer to the sh2lib handle.
+ * @param[in] stream_id   ID of the closed stream.
+ * @param[in] error_code  HTTP/2 error code the stream was closed with, NGHTTP2_NO_ERROR on a clean close.
+ * @param[in] stats       Final statistics of the stream.
+ * @param[in] user_ctx    User context of the stream, see sh2lib_stream_config_t.
+ */
+typedef void (*sh2lib_stream_close_cb_t)(struct sh2lib_handle *handle, int32_t stream_id, uint32_t error_code,
+                                         const sh2lib_stream_stats_t *stats, void *user_ctx);
+
+/**
+ * @brief Stream configuration, see sh2lib_stream_request()
+ */
+typedef struct {
+    sh2lib_stream_data_recv_cb_t recv_cb;   /*!< Callback for the response data, can be NULL */
+    sh2lib_stream_data_send_cb_t send_cb;   /*!< Callback for the request body, NULL if the request has no body */
+    sh2lib_stream_close_cb_t close_cb;      /*!< Callback for the stream close, can be NULL */
+    void *user_ctx;                         /*!< User context passed to the callbacks */
+    int32_t weight;                         /*!< Priority weight of the stream (1 to 256), set to 0 to use the default of 16 */
+    int32_t dep_stream_id;                  /*!< Stream this stream depends on, 0 for the root */
+    bool exclusive;                         /*!< Make this stream the sole dependency of dep_stream_id */
+} sh2lib_stream_config_t;
+
 /**
  * @brief Connect to a URI using HTTP/2
  *
@@ -302,6 +439,88 @@ int sh2lib_do_putpost_with_nv(struct sh2lib_handle *hd, const nghttp2_nv *nva, s
                               sh2lib_putpost_data_cb_t send_cb,
                               sh2lib_frame_data_recv_cb_t recv_cb);
 
+/**
+ * @brief Setup an HTTP PUT/POST request stream with custom name-value pairs, sending the data without copying
+ *
+ * Same as sh2lib_do_putpost_with_nv(), except that the request body is provided
+ * through a sh2lib_putpost_data_nocopy_cb_t callback. This saves one copy of every
+ * uploaded byte, which is useful for large buffers like camera frames or files
+ * mapped to memory.
+ *
+ * @param[in] hd        Pointer to a variable of the type 'struct sh2lib_handle'.
+ * @param[in] nva       An array of name-value pairs that should be part of the request.
+ * @param[in] nvlen     The number of elements in the array pointed to by 'nva'.
+ * @param[in] send_cb   The callback function that should be called for
+ *                      providing the data sent as part of this request.
+ * @param[in] recv_cb   The callback function that should be called for
+ *                      processing the request's response
+ *
+ * @return
+ *             - Stream ID (positive integer) if request setup is successful
+ *             - Negative error code if the request setup fails
+ */
+int sh2lib_do_putpost_with_nv_nocopy(struct sh2lib_handle *hd, const nghttp2_nv *nva, size_t nvlen,
+                                     sh2lib_putpost_data_nocopy_cb_t send_cb,
+                                     sh2lib_frame_data_recv_cb_t recv_cb);
+
+/**
+ * @brief Setup a request stream with a user context, priority and per-stream statistics
+ *
+ * This API sets up a request with the name-value pairs 'nva' (see
+ * sh2lib_do_get_with_nv() for the mandatory ones). Any number of streams can be
+ * open at the same time, up to the limit announced by the server, and are
+ * multiplexed over the connection by sh2lib_execute(). The server shares the
+ * bandwidth among them according to their weights and dependencies.
+ *
+ * @param[in] hd        Pointer to a variable of the type 'struct sh2lib_handle'.
+ * @param[in] nva       An array of name-value pairs that should be part of the request.
+ * @param[in] nvlen     The number of elements in the array pointed to by 'nva'.
+ * @param[in] cfg       Pointer to the stream configuration.
+ *
+ * @return
+ *             - Stream ID (positive integer) if request setup is successful
+ *             - Negative error code if the request setup fails
+ */
+int sh2lib_stream_request(struct sh2lib_handle *hd, const nghttp2_nv *nva, size_t nvlen, const sh2lib_stream_config_t *cfg);
+
+/**
+ * @brief Change the priority of an open stream
+ *
+ * @param[in] hd             Pointer to a variable of the type 'struct sh2lib_handle'.
+ * @param[in] stream_id      ID of the stream.
+ * @param[in] weight         Priority weight of the stream (1 to 256).
+ * @param[in] dep_stream_id  Stream this stream depends on, 0 for the root.
+ * @param[in] exclusive      Make this stream the sole dependency of dep_stream_id.
+ *
+ * @return
+ *             - 0 if it succeeds
+ *             - Negative error code from nghttp2 on failure
+ */
+int sh2lib_stream_set_priority(struct sh2lib_handle *hd, int32_t stream_id, int32_t weight, int32_t dep_stream_id, bool exclusive);
+
+/**
+ * @brief Get the user context of an open stream
+ *
+ * @param[in] hd         Pointer to a variable of the type 'struct sh2lib_handle'.
+ * @param[in] stream_id  ID of the stream.
+ *
+ * @return User context of the stream, NULL if the stream is not open or has no context
+ */
+void *sh2lib_stream_get_user_ctx(struct sh2lib_handle *hd, int32_t stream_id);
+
+/**
+ * @brief Get the statistics of an open stream
+ *
+ * @param[in]  hd         Pointer to a variable of the type 'struct sh2lib_handle'.
+ * @param[in]  stream_id  ID of the stream.
+ * @param[out] stats      Statistics of the stream.
+ *
+ * @return
+ *             - 0 if it succeeds
+ *             - -1 if the stream is not open
+ */
+int sh2lib_stream_get_stats(struct sh2lib_handle *hd, int32_t stream_id, sh2lib_stream_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,567 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include "esp_tls.h"
+#include "sh2lib.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "esp_heap_caps.h"
+
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_newlib.h"
+#endif // !CONFIG_IDF_TARGET_LINUX
+
+#include "unity_test_utils_memory.h"
+
+// Several DATA frames, within the initial flow control window of the stream
+#define TEST_BODY_SIZE      (48 * 1024)
+#define TEST_HOSTNAME       "test.example.com"
+#define TEST_WIRE_SIZE      (64 * 1024)
+#define TEST_STREAM_COUNT   4
+#define TEST_BENCH_ROUNDS   50
+
+#define TEST_FRAME_HDR_LEN  9
+#define TEST_PREFACE_LEN    (sizeof(NGHTTP2_CLIENT_MAGIC) - 1)
+
+typedef struct {
+    uint32_t count;
+    uint64_t bytes;
+} test_writes_t;
+
+typedef struct {
+    test_writes_t writes;
+    uint64_t elapsed_us;
+} test_bench_t;
+
+static int s_tls;
+static test_writes_t s_writes;
+static uint8_t s_body[TEST_BODY_SIZE];
+static size_t s_body_sent;
+
+// Transport limits: largest write accepted at once (0 for no limit), every other write would block
+static size_t s_write_limit;
+static bool s_write_block;
+static uint32_t s_write_calls;
+static uint32_t s_write_blocked;
+
+// Bytes written by the client, the first TEST_WIRE_SIZE of them are kept
+static uint8_t s_wire[TEST_WIRE_SIZE];
+// Bytes the server sends next, handed out by the reads
+static uint8_t s_server[256];
+static size_t s_server_len;
+static size_t s_server_off;
+
+// Stub transport: the accepted writes are counted and captured, the reads return what the test queued
+
+esp_tls_t *__wrap_esp_tls_init(void)
+{
+    return (esp_tls_t *) &s_tls;
+}
+
+int __wrap_esp_tls_conn_http_new_sync(const char *url, const esp_tls_cfg_t *cfg, esp_tls_t *tls)
+{
+    return 1;
+}
+
+ssize_t __wrap_esp_tls_conn_write(esp_tls_t *tls, const void *data, size_t datalen)
+{
+    if (s_write_block && s_write_calls++ % 2 == 0) {
+        s_write_blocked++;
+        return ESP_TLS_ERR_SSL_WANT_WRITE;
+    }
+    if (s_write_limit && datalen > s_write_limit) {
+        datalen = s_write_limit;
+    }
+    if (s_writes.bytes + datalen <= TEST_WIRE_SIZE) {
+        memcpy(s_wire + s_writes.bytes, data, datalen);
+    }
+    s_writes.count++;
+    s_writes.bytes += datalen;
+    return datalen;
+}
+
+ssize_t __wrap_esp_tls_conn_read(esp_tls_t *tls, void *data, size_t datalen)
+{
+    if (s_server_off == s_server_len) {
+        return ESP_TLS_ERR_SSL_WANT_READ;
+    }
+    size_t len = s_server_len - s_server_off;
+    if (len > datalen) {
+        len = datalen;
+    }
+    memcpy(data, s_server + s_server_off, len);
+    s_server_off += len;
+    return len;
+}
+
+int __wrap_esp_tls_conn_destroy(esp_tls_t *tls)
+{
+    return 0;
+}
+
+void setUp(void)
+{
+    memset(&s_writes, 0, sizeof(s_writes));
+    s_body_sent = 0;
+    s_server_len = 0;
+    s_server_off = 0;
+    s_write_limit = 0;
+    s_write_block = false;
+    s_write_calls = 0;
+    s_write_blocked = 0;
+    for (size_t i = 0; i < TEST_BODY_SIZE; i++) {
+        s_body[i] = 'a' + i % 26;
+    }
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+#if !CONFIG_IDF_TARGET_LINUX
+    esp_reent_cleanup();    //clean up some of the newlib's lazy allocations
+#endif // !CONFIG_IDF_TARGET_LINUX
+    unity_utils_evaluate_leaks_direct(0);
+}
+
+static int test_body_cb(struct sh2lib_handle *handle, char *data, size_t len, uint32_t *data_flags)
+{
+    size_t copy_len = TEST_BODY_SIZE - s_body_sent;
+    if (copy_len > len) {
+        copy_len = len;
+    }
+    memcpy(data, s_body + s_body_sent, copy_len);
+    s_body_sent += copy_len;
+    if (s_body_sent == TEST_BODY_SIZE) {
+        *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    }
+    return copy_len;
+}
+
+static int test_recv_cb(struct sh2lib_handle *handle, const char *data, size_t len, int flags)
+{
+    return 0;
+}
+
+static const nghttp2_nv s_nva[] = { SH2LIB_MAKE_NV(":method", "POST"),
+                                    SH2LIB_MAKE_NV(":scheme", "https"),
+                                    SH2LIB_MAKE_NV(":authority", TEST_HOSTNAME),
+                                    SH2LIB_MAKE_NV(":path", "/upload"),
+                                  };
+
+// Send path of sh2lib before the output was coalesced: every piece handed over by nghttp2 is written on its own,
+// in chunks of at most 1000 bytes
+static ssize_t baseline_send_cb(nghttp2_session *session, const uint8_t *data, size_t length, int flags, void *user_data)
+{
+    size_t offset = 0;
+    while (offset < length) {
+        size_t chunk_len = length - offset > 1000 ? 1000 : length - offset;
+        offset += esp_tls_conn_write(NULL, data + offset, chunk_len);
+    }
+    return length;
+}
+
+static ssize_t baseline_data_cb(nghttp2_session *session, int32_t stream_id, uint8_t *buf, size_t length,
+                                uint32_t *data_flags, nghttp2_data_source *source, void *user_data)
+{
+    return test_body_cb(NULL, (char *) buf, length, data_flags);
+}
+
+static test_writes_t run_baseline(void)
+{
+    nghttp2_session_callbacks *callbacks;
+    nghttp2_session *session;
+    TEST_ASSERT_EQUAL(0, nghttp2_session_callbacks_new(&callbacks));
+    nghttp2_session_callbacks_set_send_callback(callbacks, baseline_send_cb);
+    TEST_ASSERT_EQUAL(0, nghttp2_session_client_new(&session, callbacks, NULL));
+    nghttp2_session_callbacks_del(callbacks);
+
+    nghttp2_data_provider data_prd = {
+        .read_callback = baseline_data_cb,
+    };
+    memset(&s_writes, 0, sizeof(s_writes));
+    s_body_sent = 0;
+    TEST_ASSERT_EQUAL(0, nghttp2_submit_settings(session, NGHTTP2_FLAG_NONE, NULL, 0));
+    TEST_ASSERT_GREATER_THAN(0, nghttp2_submit_request(session, NULL, s_nva, sizeof(s_nva) / sizeof(s_nva[0]), &data_prd, NULL));
+    TEST_ASSERT_EQUAL(0, nghttp2_session_send(session));
+    TEST_ASSERT_EQUAL(TEST_BODY_SIZE, s_body_sent);
+    nghttp2_session_del(session);
+    return s_writes;
+}
+
+static test_writes_t run_sh2lib(void)
+{
+    struct sh2lib_config_t cfg = {
+        .uri = "https://" TEST_HOSTNAME,
+    };
+    struct sh2lib_handle hd;
+    memset(&s_writes, 0, sizeof(s_writes));
+    s_body_sent = 0;
+    TEST_ASSERT_EQUAL(0, sh2lib_connect(&cfg, &hd));
+    TEST_ASSERT_GREATER_THAN(0, sh2lib_do_putpost_with_nv(&hd, s_nva, sizeof(s_nva) / sizeof(s_nva[0]), test_body_cb, test_recv_cb));
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_send(&hd));
+    TEST_ASSERT_EQUAL(TEST_BODY_SIZE, s_body_sent);
+    TEST_ASSERT_EQUAL(s_writes.count, hd.tls_write_count);
+    TEST_ASSERT_EQUAL(s_writes.bytes, hd.tls_write_bytes);
+    sh2lib_free(&hd);
+    return s_writes;
+}
+
+static uint64_t test_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static test_bench_t run_bench(test_writes_t (*run)(void))
+{
+    test_bench_t bench = {0};
+    uint64_t start = test_time_us();
+    for (int i = 0; i < TEST_BENCH_ROUNDS; i++) {
+        test_writes_t writes = run();
+        bench.writes.count += writes.count;
+        bench.writes.bytes += writes.bytes;
+    }
+    bench.elapsed_us = test_time_us() - start;
+    if (bench.elapsed_us == 0) {
+        bench.elapsed_us = 1;
+    }
+    return bench;
+}
+
+static void print_bench(const char *name, const test_bench_t *bench)
+{
+    printf("%s: %" PRIu32 " TLS writes per request, %" PRIu64 " TLS records per MB, %" PRIu64 " KB/s\n", name,
+           bench->writes.count / TEST_BENCH_ROUNDS, (uint64_t) bench->writes.count * 1024 * 1024 / bench->writes.bytes,
+           bench->writes.bytes * 1000000 / 1024 / bench->elapsed_us);
+}
+
+/*
+ * Each TLS write becomes one TLS record, so the records per MB is what the coalescing
+ * saves on a device: one mbedtls_ssl_write() call, record header and authentication
+ * tag per record. The stub transport does no encryption, so the throughput only covers
+ * the framing and copies of the send path on the machine running the test, it is not
+ * the throughput of a TLS connection.
+ */
+TEST_CASE("sh2lib: multi-frame request output is coalesced into fewer TLS writes", "[sh2lib][benchmark]")
+{
+    test_bench_t baseline = run_bench(run_baseline);
+    test_bench_t coalesced = run_bench(run_sh2lib);
+
+    printf("%d byte POST, %d rounds, %d byte coalescing buffer\n", TEST_BODY_SIZE, TEST_BENCH_ROUNDS,
+           SH2LIB_DEFAULT_SEND_BUF_SIZE);
+    print_bench("writing every nghttp2 piece", &baseline);
+    print_bench("coalesced", &coalesced);
+    // Same bytes on the wire, in fewer and larger TLS records
+    TEST_ASSERT_EQUAL(baseline.writes.bytes, coalesced.writes.bytes);
+    TEST_ASSERT_LESS_THAN(baseline.writes.count, coalesced.writes.count);
+}
+
+static int test_body_nocopy_cb(struct sh2lib_handle *handle, const uint8_t **data, size_t len, uint32_t *data_flags)
+{
+    size_t send_len = TEST_BODY_SIZE - s_body_sent;
+    if (send_len > len) {
+        send_len = len;
+    }
+    *data = s_body + s_body_sent;
+    s_body_sent += send_len;
+    if (s_body_sent == TEST_BODY_SIZE) {
+        *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    }
+    return send_len;
+}
+
+// Send the POST through the copy or the zero-copy path until nothing is left, keeping the bytes on the wire
+static size_t run_putpost(bool nocopy, uint8_t *wire)
+{
+    struct sh2lib_config_t cfg = {
+        .uri = "https://" TEST_HOSTNAME,
+    };
+    struct sh2lib_handle hd;
+    memset(&s_writes, 0, sizeof(s_writes));
+    s_body_sent = 0;
+    TEST_ASSERT_EQUAL(0, sh2lib_connect(&cfg, &hd));
+    if (nocopy) {
+        TEST_ASSERT_GREATER_THAN(0, sh2lib_do_putpost_with_nv_nocopy(&hd, s_nva, sizeof(s_nva) / sizeof(s_nva[0]),
+                                 test_body_nocopy_cb, test_recv_cb));
+    } else {
+        TEST_ASSERT_GREATER_THAN(0, sh2lib_do_putpost_with_nv(&hd, s_nva, sizeof(s_nva) / sizeof(s_nva[0]),
+                                 test_body_cb, test_recv_cb));
+    }
+    // A blocked write is retried by the next call, as the application loop does
+    int calls = 0;
+    do {
+        TEST_ASSERT_EQUAL(0, sh2lib_execute_send(&hd));
+        TEST_ASSERT_LESS_THAN(TEST_WIRE_SIZE, ++calls);
+    } while (nghttp2_session_want_write(hd.http2_sess) || hd.send_buf_len);
+    TEST_ASSERT_EQUAL(TEST_BODY_SIZE, s_body_sent);
+    TEST_ASSERT_EQUAL(s_writes.count, hd.tls_write_count);
+    TEST_ASSERT_EQUAL(s_writes.bytes, hd.tls_write_bytes);
+    sh2lib_free(&hd);
+
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_WIRE_SIZE, s_writes.bytes);
+    memcpy(wire, s_wire, s_writes.bytes);
+    return s_writes.bytes;
+}
+
+TEST_CASE("sh2lib: zero-copy request resumes after short and blocked writes", "[sh2lib]")
+{
+    uint8_t *expected = malloc(TEST_WIRE_SIZE);
+    uint8_t *wire = malloc(TEST_WIRE_SIZE);
+    TEST_ASSERT_NOT_NULL(expected);
+    TEST_ASSERT_NOT_NULL(wire);
+    size_t expected_len = run_putpost(false, expected);
+    TEST_ASSERT_GREATER_THAN(TEST_BODY_SIZE, expected_len);
+
+    // Writes shorter than a frame header, than a DATA frame and than the coalescing buffer
+    const size_t limits[] = { 0, 7, 1000, 5000 };
+    for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+        for (int block = 0; block < 2; block++) {
+            s_write_limit = limits[i];
+            s_write_block = block;
+            s_write_calls = 0;
+            s_write_blocked = 0;
+            printf("write limit %d bytes%s\n", (int) limits[i], block ? ", every other write blocked" : "");
+
+            // The zero-copy path puts the same bytes on the wire as the copy path
+            memset(wire, 0, TEST_WIRE_SIZE);
+            TEST_ASSERT_EQUAL(expected_len, run_putpost(true, wire));
+            TEST_ASSERT_EQUAL_MEMORY(expected, wire, expected_len);
+            TEST_ASSERT_EQUAL(block != 0, s_write_blocked != 0);
+
+            memset(wire, 0, TEST_WIRE_SIZE);
+            TEST_ASSERT_EQUAL(expected_len, run_putpost(false, wire));
+            TEST_ASSERT_EQUAL_MEMORY(expected, wire, expected_len);
+        }
+    }
+    free(wire);
+    free(expected);
+}
+
+// Queue a frame from the server, read by the next sh2lib_execute_recv()
+static void test_server_frame(uint8_t type, uint8_t flags, int32_t stream_id, const uint8_t *payload, size_t len)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(s_server), s_server_len + TEST_FRAME_HDR_LEN + len);
+    uint8_t *hdr = s_server + s_server_len;
+    hdr[0] = len >> 16;
+    hdr[1] = len >> 8;
+    hdr[2] = len;
+    hdr[3] = type;
+    hdr[4] = flags;
+    hdr[5] = stream_id >> 24;
+    hdr[6] = stream_id >> 16;
+    hdr[7] = stream_id >> 8;
+    hdr[8] = stream_id;
+    if (len) {
+        memcpy(hdr + TEST_FRAME_HDR_LEN, payload, len);
+    }
+    s_server_len += TEST_FRAME_HDR_LEN + len;
+}
+
+static uint32_t test_get_u32(const uint8_t *p)
+{
+    return (uint32_t) p[0] << 24 | (uint32_t) p[1] << 16 | (uint32_t) p[2] << 8 | p[3];
+}
+
+// Find the n-th frame of the given type the client has written, returns its payload
+static const uint8_t *test_wire_frame(uint8_t type, int n, size_t *len, int32_t *stream_id)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_WIRE_SIZE, s_writes.bytes);
+    TEST_ASSERT_EQUAL_MEMORY(NGHTTP2_CLIENT_MAGIC, s_wire, TEST_PREFACE_LEN);
+    size_t off = TEST_PREFACE_LEN;
+    while (off + TEST_FRAME_HDR_LEN <= s_writes.bytes) {
+        const uint8_t *hdr = s_wire + off;
+        size_t frame_len = (size_t) hdr[0] << 16 | hdr[1] << 8 | hdr[2];
+        if (hdr[3] == type && n-- == 0) {
+            *len = frame_len;
+            *stream_id = test_get_u32(hdr + 5) & 0x7fffffff;
+            return hdr + TEST_FRAME_HDR_LEN;
+        }
+        off += TEST_FRAME_HDR_LEN + frame_len;
+    }
+    return NULL;
+}
+
+static int test_wire_frame_count(uint8_t type)
+{
+    int count = 0;
+    size_t len;
+    int32_t stream_id;
+    while (test_wire_frame(type, count, &len, &stream_id)) {
+        count++;
+    }
+    return count;
+}
+
+// Value of a setting in the first SETTINGS frame of the client, -1 if it is not sent
+static int64_t test_wire_setting(uint16_t id)
+{
+    size_t len;
+    int32_t stream_id;
+    const uint8_t *payload = test_wire_frame(NGHTTP2_SETTINGS, 0, &len, &stream_id);
+    TEST_ASSERT_NOT_NULL(payload);
+    for (size_t off = 0; off + 6 <= len; off += 6) {
+        if ((payload[off] << 8 | payload[off + 1]) == id) {
+            return test_get_u32(payload + off + 2);
+        }
+    }
+    return -1;
+}
+
+TEST_CASE("sh2lib: window and concurrency settings are sent to the server", "[sh2lib]")
+{
+    struct sh2lib_config_t cfg = {
+        .uri = "https://" TEST_HOSTNAME,
+        .initial_window_size = 256 * 1024,
+        .connection_window_size = 1024 * 1024,
+        .max_concurrent_streams = 8,
+    };
+    struct sh2lib_handle hd;
+    TEST_ASSERT_EQUAL(0, sh2lib_connect(&cfg, &hd));
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_send(&hd));
+
+    TEST_ASSERT_EQUAL(256 * 1024, test_wire_setting(NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE));
+    TEST_ASSERT_EQUAL(8, test_wire_setting(NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS));
+    // The connection window starts at 65535 bytes and is raised by a WINDOW_UPDATE on stream 0
+    size_t len;
+    int32_t stream_id;
+    const uint8_t *payload = test_wire_frame(NGHTTP2_WINDOW_UPDATE, 0, &len, &stream_id);
+    TEST_ASSERT_NOT_NULL(payload);
+    TEST_ASSERT_EQUAL(0, stream_id);
+    TEST_ASSERT_EQUAL(1024 * 1024 - NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE, test_get_u32(payload) & 0x7fffffff);
+    sh2lib_free(&hd);
+
+    // Nothing but the empty SETTINGS frame with the defaults
+    struct sh2lib_config_t default_cfg = {
+        .uri = "https://" TEST_HOSTNAME,
+    };
+    memset(&s_writes, 0, sizeof(s_writes));
+    TEST_ASSERT_EQUAL(0, sh2lib_connect(&default_cfg, &hd));
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_send(&hd));
+    TEST_ASSERT_EQUAL(-1, test_wire_setting(NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE));
+    TEST_ASSERT_EQUAL(-1, test_wire_setting(NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS));
+    TEST_ASSERT_EQUAL(0, test_wire_frame_count(NGHTTP2_WINDOW_UPDATE));
+    sh2lib_free(&hd);
+}
+
+typedef struct {
+    int closed;
+    uint32_t error_code;
+} test_stream_ctx_t;
+
+static void test_stream_close_cb(struct sh2lib_handle *handle, int32_t stream_id, uint32_t error_code,
+                                 const sh2lib_stream_stats_t *stats, void *user_ctx)
+{
+    test_stream_ctx_t *ctx = user_ctx;
+    ctx->closed++;
+    ctx->error_code = error_code;
+}
+
+static const nghttp2_nv s_get_nva[] = { SH2LIB_MAKE_NV(":method", "GET"),
+                                        SH2LIB_MAKE_NV(":scheme", "https"),
+                                        SH2LIB_MAKE_NV(":authority", TEST_HOSTNAME),
+                                        SH2LIB_MAKE_NV(":path", "/"),
+                                      };
+
+static int32_t test_stream_request(struct sh2lib_handle *hd, test_stream_ctx_t *ctx)
+{
+    sh2lib_stream_config_t stream_cfg = {
+        .close_cb = test_stream_close_cb,
+        .user_ctx = ctx,
+    };
+    int32_t stream_id = sh2lib_stream_request(hd, s_get_nva, sizeof(s_get_nva) / sizeof(s_get_nva[0]), &stream_cfg);
+    TEST_ASSERT_GREATER_THAN(0, stream_id);
+    return stream_id;
+}
+
+TEST_CASE("sh2lib: requests beyond the server's max_concurrent_streams wait for a closed stream", "[sh2lib]")
+{
+    struct sh2lib_config_t cfg = {
+        .uri = "https://" TEST_HOSTNAME,
+    };
+    struct sh2lib_handle hd;
+    TEST_ASSERT_EQUAL(0, sh2lib_connect(&cfg, &hd));
+
+    // The server allows two streams at a time
+    const uint8_t settings[] = { 0x00, NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, 0x00, 0x00, 0x00, 0x02 };
+    test_server_frame(NGHTTP2_SETTINGS, NGHTTP2_FLAG_NONE, 0, settings, sizeof(settings));
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_recv(&hd));
+
+    test_stream_ctx_t ctx[TEST_STREAM_COUNT] = {0};
+    int32_t stream_ids[TEST_STREAM_COUNT];
+    for (int i = 0; i < TEST_STREAM_COUNT; i++) {
+        stream_ids[i] = test_stream_request(&hd, &ctx[i]);
+    }
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_send(&hd));
+    TEST_ASSERT_EQUAL(2, test_wire_frame_count(NGHTTP2_HEADERS));
+    // The held requests keep their context and statistics
+    sh2lib_stream_stats_t stats;
+    TEST_ASSERT_EQUAL_PTR(&ctx[3], sh2lib_stream_get_user_ctx(&hd, stream_ids[3]));
+    TEST_ASSERT_EQUAL(0, sh2lib_stream_get_stats(&hd, stream_ids[3], &stats));
+    TEST_ASSERT_EQUAL(0, stats.bytes_sent);
+
+    // Resetting the first stream lets the third one go out
+    const uint8_t rst[] = { 0x00, 0x00, 0x00, NGHTTP2_CANCEL };
+    test_server_frame(NGHTTP2_RST_STREAM, NGHTTP2_FLAG_NONE, stream_ids[0], rst, sizeof(rst));
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_recv(&hd));
+    TEST_ASSERT_EQUAL(1, ctx[0].closed);
+    TEST_ASSERT_EQUAL(NGHTTP2_CANCEL, ctx[0].error_code);
+    TEST_ASSERT_NULL(sh2lib_stream_get_user_ctx(&hd, stream_ids[0]));
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_send(&hd));
+    TEST_ASSERT_EQUAL(3, test_wire_frame_count(NGHTTP2_HEADERS));
+    size_t len;
+    int32_t stream_id;
+    TEST_ASSERT_NOT_NULL(test_wire_frame(NGHTTP2_HEADERS, 2, &len, &stream_id));
+    TEST_ASSERT_EQUAL(stream_ids[2], stream_id);
+
+    // The streams still open or held are released with the handle
+    sh2lib_free(&hd);
+}
+
+TEST_CASE("sh2lib: requests whose HEADERS are not sent after GOAWAY are closed and released", "[sh2lib]")
+{
+    struct sh2lib_config_t cfg = {
+        .uri = "https://" TEST_HOSTNAME,
+    };
+    struct sh2lib_handle hd;
+    TEST_ASSERT_EQUAL(0, sh2lib_connect(&cfg, &hd));
+
+    test_stream_ctx_t ctx[2] = {0};
+    int32_t stream_ids[2];
+    for (int i = 0; i < 2; i++) {
+        stream_ids[i] = test_stream_request(&hd, &ctx[i]);
+    }
+    // The server goes away before the requests are sent
+    const uint8_t goaway[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, NGHTTP2_NO_ERROR };
+    test_server_frame(NGHTTP2_SETTINGS, NGHTTP2_FLAG_NONE, 0, NULL, 0);
+    test_server_frame(NGHTTP2_GOAWAY, NGHTTP2_FLAG_NONE, 0, goaway, sizeof(goaway));
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_recv(&hd));
+    TEST_ASSERT_TRUE(hd.http2_goaway);
+    TEST_ASSERT_EQUAL(0, sh2lib_execute_send(&hd));
+
+    TEST_ASSERT_EQUAL(0, test_wire_frame_count(NGHTTP2_HEADERS));
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(1, ctx[i].closed);
+        TEST_ASSERT_EQUAL(NGHTTP2_REFUSED_STREAM, ctx[i].error_code);
+        TEST_ASSERT_NULL(sh2lib_stream_get_user_ctx(&hd, stream_ids[i]));
+    }
+    TEST_ASSERT_NULL(hd.streams);
+    sh2lib_free(&hd);
+}
+
+void app_main(void)
+{
+    printf("Running sh2lib component tests\n");
+    unity_run_menu();
+}